@@ -0,0 +1,226 @@
+/*
+ * BACnetBoard.h - Board detection and tier feature switches
+ * Part of BACnet-for-Arduino library
+ *
+ * Copyright (c) 2025 George Arun <argeorun@gmail.com>
+ * Licensed under MIT License (see LICENSE file)
+ *
+ * This file holds the board detection and the tier-based feature switches
+ * that both the C++ library (through BACnetConfig.h) and the C protocol
+ * stack (through bacnet/config.h) compile with, so that both see the same
+ * features and the same layout of the structures that depend on them.
+ * It uses only preprocessor symbols, and is safe to include from C.
+ */
+
+#ifndef BACNET_BOARD_H
+#define BACNET_BOARD_H
+
+/*=============================================================================
+ * AUTOMATIC BOARD DETECTION
+ *============================================================================*/
+
+// Detect board type and assign RAM tier
+#if defined(ARDUINO_AVR_UNO) || defined(ARDUINO_AVR_NANO)
+    #define BOARD_NAME "Arduino Uno/Nano"
+    #define BOARD_RAM_KB 2
+    #define BOARD_TIER 1
+    #define BOARD_TIER_NAME "Tier 1 (Minimal)"
+
+#elif defined(ARDUINO_AVR_MEGA) || defined(ARDUINO_AVR_MEGA2560)
+    #define BOARD_NAME "Arduino Mega 2560"
+    #define BOARD_RAM_KB 8
+    #define BOARD_TIER 2
+    #define BOARD_TIER_NAME "Tier 2 (Standard)"
+
+#elif defined(ARDUINO_SAM_DUE)
+    #define BOARD_NAME "Arduino Due"
+    #define BOARD_RAM_KB 96
+    #define BOARD_TIER 3
+    #define BOARD_TIER_NAME "Tier 3 (Advanced)"
+
+#elif defined(ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_SAMD)
+    #define BOARD_NAME "Arduino Zero/SAMD"
+    #define BOARD_RAM_KB 32
+    #define BOARD_TIER 3
+    #define BOARD_TIER_NAME "Tier 3 (Advanced)"
+
+#elif defined(ESP32) || defined(ARDUINO_ARCH_ESP32)
+    #define BOARD_NAME "ESP32"
+    #define BOARD_RAM_KB 520
+    #define BOARD_TIER 4
+    #define BOARD_TIER_NAME "Tier 4 (Full Featured)"
+
+#elif defined(ARDUINO_ARCH_STM32) || defined(STM32F4)
+    #define BOARD_NAME "STM32"
+    #define BOARD_RAM_KB 128
+    #define BOARD_TIER 4
+    #define BOARD_TIER_NAME "Tier 4 (Full Featured)"
+
+#elif defined(TEENSYDUINO)
+    #if defined(__MK20DX256__)
+        #define BOARD_NAME "Teensy 3.2"
+        #define BOARD_RAM_KB 64
+        #define BOARD_TIER 3
+        #define BOARD_TIER_NAME "Tier 3 (Advanced)"
+    #elif defined(__MK64FX512__) || defined(__MK66FX1M0__)
+        #define BOARD_NAME "Teensy 3.5/3.6"
+        #define BOARD_RAM_KB 256
+        #define BOARD_TIER 4
+        #define BOARD_TIER_NAME "Tier 4 (Full Featured)"
+    #else
+        #define BOARD_NAME "Teensy (Unknown)"
+        #define BOARD_RAM_KB 32
+        #define BOARD_TIER 3
+        #define BOARD_TIER_NAME "Tier 3 (Advanced)"
+    #endif
+
+#else
+    // Unknown board - use conservative defaults
+    #define BOARD_UNKNOWN 1
+    #define BOARD_NAME "Unknown Board"
+    #define BOARD_RAM_KB 2
+    #define BOARD_TIER 1
+    #define BOARD_TIER_NAME "Tier 1 (Minimal - Unknown Board)"
+#endif
+
+/*=============================================================================
+ * TIER-BASED FEATURE ENABLEMENT
+ *============================================================================*/
+
+// Tier 1 Features (Uno): Basic Read/Write only
+#define BACNET_FEATURE_READ_PROPERTY 1
+#define BACNET_FEATURE_WRITE_PROPERTY 1
+#define BACNET_FEATURE_WHO_IS 1
+#define BACNET_FEATURE_I_AM 1
+
+// Tier 2 Features (Mega): Add COV and Priority
+#if BOARD_TIER >= 2
+    #define BACNET_FEATURE_COV 1
+    #define BACNET_FEATURE_PRIORITY_ARRAY 1
+    #define BACNET_FEATURE_READ_PROPERTY_MULTIPLE 1
+    #define BACNET_FEATURE_WRITE_PROPERTY_MULTIPLE 1
+#else
+    #define BACNET_FEATURE_COV 0
+    #define BACNET_FEATURE_PRIORITY_ARRAY 0
+    #define BACNET_FEATURE_READ_PROPERTY_MULTIPLE 0
+    #define BACNET_FEATURE_WRITE_PROPERTY_MULTIPLE 0
+#endif
+
+// Tier 3 Features (Due): Add Scheduling and Trending
+#if BOARD_TIER >= 3
+    #define BACNET_FEATURE_INTRINSIC_REPORTING 1
+    #define BACNET_FEATURE_TREND_LOG 1
+    #define BACNET_FEATURE_SCHEDULE 1
+    #define BACNET_FEATURE_CALENDAR 1
+#else
+    #define BACNET_FEATURE_INTRINSIC_REPORTING 0
+    #define BACNET_FEATURE_TREND_LOG 0
+    #define BACNET_FEATURE_SCHEDULE 0
+    #define BACNET_FEATURE_CALENDAR 0
+#endif
+
+// Tier 4 Features (ESP32): Full BACnet feature set
+#if BOARD_TIER >= 4
+    #define BACNET_FEATURE_SECURE_CONNECT 1
+    #define BACNET_FEATURE_NETWORK_PORT 1
+    #define BACNET_FEATURE_ROUTING 1
+    #define BACNET_FEATURE_SEGMENTATION 1
+#else
+    #define BACNET_FEATURE_SECURE_CONNECT 0
+    #define BACNET_FEATURE_NETWORK_PORT 0
+    #define BACNET_FEATURE_ROUTING 0
+    #define BACNET_FEATURE_SEGMENTATION 0
+#endif
+
+// Segmented responses (Tier 4): whole Object_List or large RPM replies
+#if BACNET_FEATURE_SEGMENTATION && !defined(BACNET_SEGMENTATION_ENABLED)
+    #define BACNET_SEGMENTATION_ENABLED 1
+    #define BACNET_SEGMENTATION_WINDOW_SIZE 4
+    #define BACNET_SEGMENTATION_BUFFERS 2
+#endif
+
+// ReadProperty cache (Tier 3+): encoded values of static properties
+#if BOARD_TIER >= 3 && !defined(BACNET_RP_CACHE_ENABLED)
+    #define BACNET_RP_CACHE_ENABLED 1
+    #define BACNET_RP_CACHE_ENTRIES 32
+#endif
+
+// Object name index (Tier 3+): Who-Has by name without a scan
+#if BOARD_TIER >= 3 && !defined(BACNET_OBJECT_NAME_INDEX_ENABLED)
+    #define BACNET_OBJECT_NAME_INDEX_ENABLED 1
+    #define BACNET_OBJECT_NAME_INDEX_SIZE 256
+#endif
+
+// Event notification outbox (Tier 3+): confirmed alarms wait for the TSM
+#if BOARD_TIER >= 3 && !defined(BACNET_EVENT_OUTBOX_ENABLED)
+    #define BACNET_EVENT_OUTBOX_ENABLED 1
+    #define BACNET_EVENT_OUTBOX_MESSAGES 4
+    #define BACNET_EVENT_OUTBOX_DELIVERIES 16
+#endif
+
+// Intrinsic reporting engine (Tier 3+): evaluate objects on change only
+#if BACNET_FEATURE_INTRINSIC_REPORTING && \
+    !defined(BACNET_EVENT_ENGINE_ENABLED)
+    #define BACNET_EVENT_ENGINE_ENABLED 1
+    #define BACNET_EVENT_ENGINE_OBJECTS MAX_BACNET_OBJECTS
+#endif
+
+// The MS/TP switches below change the node state machines in mstp.c and
+// the send queue in dlmstp.c, which run only when dlmstp.c is built; it
+// ships as dlmstp.c.disabled, so they stay off unless the application
+// builds it and defines BACNET_DLMSTP_ENABLED.
+#if defined(BACNET_DLMSTP_ENABLED) && BACNET_DLMSTP_ENABLED
+
+// Adaptive MS/TP Poll For Master (Tier 2+): back off polling empty addresses
+#if BOARD_TIER >= 2 && !defined(BACNET_MSTP_ADAPTIVE_POLL_ENABLED)
+    #define BACNET_MSTP_ADAPTIVE_POLL_ENABLED 1
+#endif
+
+// Dynamic MS/TP Max_Info_Frames (Tier 2+): empty a deep send queue per token
+#if BOARD_TIER >= 2 && !defined(BACNET_MSTP_DYNAMIC_INFO_FRAMES_ENABLED)
+    #define BACNET_MSTP_DYNAMIC_INFO_FRAMES_ENABLED 1
+    #define BACNET_MSTP_INFO_FRAMES_CAP 4
+    #define DLMSTP_MAX_INFO_FRAMES 4
+#endif
+
+// MS/TP transmit classes (Tier 2+): replies ahead of COV and broadcasts
+#if BOARD_TIER >= 2 && !defined(BACNET_MSTP_PRIORITY_QUEUE_ENABLED)
+    #define BACNET_MSTP_PRIORITY_QUEUE_ENABLED 1
+#endif
+
+// MS/TP link statistics and timing histograms (Tier 3+)
+#if BOARD_TIER >= 3 && !defined(BACNET_MSTP_STATISTICS_ENABLED)
+    #define BACNET_MSTP_STATISTICS_ENABLED 1
+#endif
+
+// Fast MS/TP answers (Tier 2+): ReadProperty replies within Treply_delay
+#if BOARD_TIER >= 2 && !defined(BACNET_MSTP_FAST_REPLY_ENABLED)
+    #define BACNET_MSTP_FAST_REPLY_ENABLED 1
+    #define BACNET_FAST_REPLY_ENTRIES 12
+    #define BACNET_FAST_REPLY_VALUE_SIZE 24
+#endif
+
+#endif
+
+// Fixed point color conversions on boards without a floating point unit
+#if (defined(__AVR__) || (defined(__arm__) && !defined(__ARM_FP))) && \
+    !defined(BACNET_COLOR_RGB_FIXED_POINT)
+    #define BACNET_COLOR_RGB_FIXED_POINT 1
+#endif
+
+/*=============================================================================
+ * OBJECT LIMITS
+ *============================================================================*/
+
+// Maximum number of objects (scaled by tier)
+#if BOARD_TIER >= 4
+    #define MAX_BACNET_OBJECTS 128
+#elif BOARD_TIER >= 3
+    #define MAX_BACNET_OBJECTS 64
+#elif BOARD_TIER >= 2
+    #define MAX_BACNET_OBJECTS 32
+#else
+    #define MAX_BACNET_OBJECTS 8  // Uno: Keep it minimal
+#endif
+
+#endif // BACNET_BOARD_H
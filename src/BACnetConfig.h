@@ -16,70 +16,13 @@
 
 /*=============================================================================
  * AUTOMATIC BOARD DETECTION
+ * See BACnetBoard.h, which the C protocol stack shares
  *============================================================================*/
 
-// Detect board type and assign RAM tier
-#if defined(ARDUINO_AVR_UNO) || defined(ARDUINO_AVR_NANO)
-    #define BOARD_NAME "Arduino Uno/Nano"
-    #define BOARD_RAM_KB 2
-    #define BOARD_TIER 1
-    #define BOARD_TIER_NAME "Tier 1 (Minimal)"
-
-#elif defined(ARDUINO_AVR_MEGA) || defined(ARDUINO_AVR_MEGA2560)
-    #define BOARD_NAME "Arduino Mega 2560"
-    #define BOARD_RAM_KB 8
-    #define BOARD_TIER 2
-    #define BOARD_TIER_NAME "Tier 2 (Standard)"
-
-#elif defined(ARDUINO_SAM_DUE)
-    #define BOARD_NAME "Arduino Due"
-    #define BOARD_RAM_KB 96
-    #define BOARD_TIER 3
-    #define BOARD_TIER_NAME "Tier 3 (Advanced)"
-
-#elif defined(ARDUINO_SAMD_ZERO) || defined(ARDUINO_ARCH_SAMD)
-    #define BOARD_NAME "Arduino Zero/SAMD"
-    #define BOARD_RAM_KB 32
-    #define BOARD_TIER 3
-    #define BOARD_TIER_NAME "Tier 3 (Advanced)"
-
-#elif defined(ESP32) || defined(ARDUINO_ARCH_ESP32)
-    #define BOARD_NAME "ESP32"
-    #define BOARD_RAM_KB 520
-    #define BOARD_TIER 4
-    #define BOARD_TIER_NAME "Tier 4 (Full Featured)"
-
-#elif defined(ARDUINO_ARCH_STM32) || defined(STM32F4)
-    #define BOARD_NAME "STM32"
-    #define BOARD_RAM_KB 128
-    #define BOARD_TIER 4
-    #define BOARD_TIER_NAME "Tier 4 (Full Featured)"
-
-#elif defined(TEENSYDUINO)
-    #if defined(__MK20DX256__)
-        #define BOARD_NAME "Teensy 3.2"
-        #define BOARD_RAM_KB 64
-        #define BOARD_TIER 3
-        #define BOARD_TIER_NAME "Tier 3 (Advanced)"
-    #elif defined(__MK64FX512__) || defined(__MK66FX1M0__)
-        #define BOARD_NAME "Teensy 3.5/3.6"
-        #define BOARD_RAM_KB 256
-        #define BOARD_TIER 4
-        #define BOARD_TIER_NAME "Tier 4 (Full Featured)"
-    #else
-        #define BOARD_NAME "Teensy (Unknown)"
-        #define BOARD_RAM_KB 32
-        #define BOARD_TIER 3
-        #define BOARD_TIER_NAME "Tier 3 (Advanced)"
-    #endif
+#include "BACnetBoard.h"
 
-#else
-    // Unknown board - use conservative defaults
+#if defined(BOARD_UNKNOWN)
     #warning "Unknown board detected - using Tier 1 (minimal) configuration"
-    #define BOARD_NAME "Unknown Board"
-    #define BOARD_RAM_KB 2
-    #define BOARD_TIER 1
-    #define BOARD_TIER_NAME "Tier 1 (Minimal - Unknown Board)"
 #endif
 
 /*=============================================================================
@@ -398,51 +341,8 @@
 
 /*=============================================================================
  * TIER-BASED FEATURE ENABLEMENT
+ * See BACnetBoard.h, which the C protocol stack shares
  *============================================================================*/
-
-// Tier 1 Features (Uno): Basic Read/Write only
-#define BACNET_FEATURE_READ_PROPERTY 1
-#define BACNET_FEATURE_WRITE_PROPERTY 1
-#define BACNET_FEATURE_WHO_IS 1
-#define BACNET_FEATURE_I_AM 1
-
-// Tier 2 Features (Mega): Add COV and Priority
-#if BOARD_TIER >= 2
-    #define BACNET_FEATURE_COV 1
-    #define BACNET_FEATURE_PRIORITY_ARRAY 1
-    #define BACNET_FEATURE_READ_PROPERTY_MULTIPLE 1
-    #define BACNET_FEATURE_WRITE_PROPERTY_MULTIPLE 1
-#else
-    #define BACNET_FEATURE_COV 0
-    #define BACNET_FEATURE_PRIORITY_ARRAY 0
-    #define BACNET_FEATURE_READ_PROPERTY_MULTIPLE 0
-    #define BACNET_FEATURE_WRITE_PROPERTY_MULTIPLE 0
-#endif
-
-// Tier 3 Features (Due): Add Scheduling and Trending
-#if BOARD_TIER >= 3
-    #define BACNET_FEATURE_INTRINSIC_REPORTING 1
-    #define BACNET_FEATURE_TREND_LOG 1
-    #define BACNET_FEATURE_SCHEDULE 1
-    #define BACNET_FEATURE_CALENDAR 1
-#else
-    #define BACNET_FEATURE_INTRINSIC_REPORTING 0
-    #define BACNET_FEATURE_TREND_LOG 0
-    #define BACNET_FEATURE_SCHEDULE 0
-    #define BACNET_FEATURE_CALENDAR 0
-#endif
-
-// Tier 4 Features (ESP32): Full BACnet feature set
-#if BOARD_TIER >= 4
-    #define BACNET_FEATURE_SECURE_CONNECT 1
-    #define BACNET_FEATURE_NETWORK_PORT 1
-    #define BACNET_FEATURE_ROUTING 1
-#else
-    #define BACNET_FEATURE_SECURE_CONNECT 0
-    #define BACNET_FEATURE_NETWORK_PORT 0
-    #define BACNET_FEATURE_ROUTING 0
-#endif
-
 /*=============================================================================
  * PROTOCOL CONFIGURATION
  *============================================================================*/
@@ -450,17 +350,6 @@
 // MS/TP Datalink Layer
 #define BACDL_MSTP 1
 
-// Maximum number of objects (scaled by tier)
-#if BOARD_TIER >= 4
-    #define MAX_BACNET_OBJECTS 128
-#elif BOARD_TIER >= 3
-    #define MAX_BACNET_OBJECTS 64
-#elif BOARD_TIER >= 2
-    #define MAX_BACNET_OBJECTS 32
-#else
-    #define MAX_BACNET_OBJECTS 8  // Uno: Keep it minimal
-#endif
-
 // Maximum property list size (per object)
 #if BOARD_TIER >= 3
     #define MAX_PROPERTY_LIST 64
@@ -599,6 +488,8 @@ static inline void printBACnetConfig(void) {
     Serial.println(BACNET_FEATURE_COV ? F("Yes") : F("No"));
     Serial.print(F("  - Priority Arrays: "));
     Serial.println(BACNET_FEATURE_PRIORITY_ARRAY ? F("Yes") : F("No"));
+    Serial.print(F("  - Segmentation: "));
+    Serial.println(BACNET_FEATURE_SEGMENTATION ? F("Yes") : F("No"));
     
     Serial.println(F("============================\n"));
 }
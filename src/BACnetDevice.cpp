@@ -16,6 +16,8 @@ extern "C" {
     #include "bacnet/basic/services.h"
     #include "bacnet/basic/tsm/tsm.h"
     #include "bacnet/basic/object/device.h"
+    #include "bacnet/basic/object/event_engine.h"
+    #include "bacnet/basic/object/fast_reply.h"
 }
 
 // Constructor
@@ -67,6 +69,14 @@ void BACnetDevice::task() {
     
     // Process TSM (Transaction State Machine)
     tsm_timer_milliseconds(1);
+#if BACNET_EVENT_OUTBOX_ENABLED
+    // Send queued confirmed event notifications as transactions free up
+    Event_Outbox_Timer(1);
+#endif
+#if BACNET_EVENT_ENGINE_ENABLED
+    // Evaluate the event state of objects whose time delay has run out
+    event_engine_timer(1);
+#endif
     
     // Update all objects
     for (uint8_t i = 0; i < _object_count; i++) {
@@ -196,6 +206,11 @@ void BACnetDevice::initializeStack() {
 void BACnetDevice::initializeDatalink() {
     // Initialize the datalink
     datalink_init(nullptr);
+#if BACNET_DLMSTP_ENABLED && BACNET_MSTP_FAST_REPLY_ENABLED
+    // Answer simple ReadProperty requests within Treply_delay; the
+    // setter is in dlmstp.c, which is built only with BACNET_DLMSTP_ENABLED
+    dlmstp_set_fast_reply_callback(fast_reply_handler);
+#endif
 }
 
 void BACnetDevice::initializeDevice() {
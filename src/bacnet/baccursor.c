@@ -0,0 +1,721 @@
+/**
+ * @file
+ * @brief A pull-style cursor that decodes BACnet tags in place
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "bacdef.h"
+/* BACnet Stack API */
+//#include "bacnet/bacdcode.h"
+#include "bacdcode.h"
+//#include "bacnet/bacstr.h"
+#include "bacstr.h"
+//#include "bacnet/baccursor.h"
+#include "baccursor.h"
+
+/**
+ * @brief Initialize a cursor at the start of an encoded buffer
+ * @param cursor - cursor to be initialized
+ * @param apdu - buffer of encoded data
+ * @param apdu_size - number of bytes in the buffer
+ */
+void bacnet_tag_cursor_init(
+    BACNET_TAG_CURSOR *cursor, const uint8_t *apdu, uint32_t apdu_size)
+{
+    if (cursor) {
+        cursor->apdu = apdu;
+        cursor->apdu_size = apdu ? apdu_size : 0;
+        cursor->offset = 0;
+        cursor->error = false;
+    }
+}
+
+/**
+ * @brief Decode the tag at the cursor without moving it
+ * @param cursor - cursor to be examined
+ * @param tag - decoded tag, if there is one
+ * @return the number of bytes in the tag, or zero if there is none.
+ *  A malformed tag sets the cursor error.
+ */
+static int cursor_tag_decode(BACNET_TAG_CURSOR *cursor, BACNET_TAG *tag)
+{
+    int len = 0;
+
+    if (!cursor || cursor->error) {
+        return 0;
+    }
+    if (cursor->offset < cursor->apdu_size) {
+        len = bacnet_tag_decode(
+            &cursor->apdu[cursor->offset], cursor->apdu_size - cursor->offset,
+            tag);
+        if (len <= 0) {
+            cursor->error = true;
+            len = 0;
+        }
+    }
+
+    return len;
+}
+
+/**
+ * @brief Number of data bytes that follow a decoded tag
+ * @param tag - decoded tag
+ * @return number of data bytes
+ */
+static uint32_t cursor_data_length(const BACNET_TAG *tag)
+{
+    if (tag->opening || tag->closing) {
+        return 0;
+    }
+    if (tag->application && (tag->number == BACNET_APPLICATION_TAG_BOOLEAN)) {
+        /* the value is held in the tag itself */
+        return 0;
+    }
+
+    return tag->len_value_type;
+}
+
+/**
+ * @brief Find the primitive value at the cursor, if it has the given tag
+ * @param cursor - cursor to be examined
+ * @param context - true for a context tag, false for an application tag
+ * @param tag_number - expected tag number
+ * @param tag - decoded tag
+ * @return offset of the value data, or zero if the tag is not the one
+ *  expected or the data is malformed
+ */
+static uint32_t cursor_primitive(
+    BACNET_TAG_CURSOR *cursor,
+    bool context,
+    uint8_t tag_number,
+    BACNET_TAG *tag)
+{
+    int len;
+
+    len = cursor_tag_decode(cursor, tag);
+    if (len == 0) {
+        return 0;
+    }
+    if (context) {
+        if (!tag->context || (tag->number != tag_number)) {
+            return 0;
+        }
+    } else if (!tag->application || (tag->number != tag_number)) {
+        return 0;
+    }
+    if (cursor_data_length(tag) >
+        (cursor->apdu_size - cursor->offset - (uint32_t)len)) {
+        cursor->error = true;
+        return 0;
+    }
+
+    return cursor->offset + (uint32_t)len;
+}
+
+/**
+ * @brief Move the cursor past a decoded value, or flag it as malformed
+ * @param cursor - cursor to be moved
+ * @param offset - offset of the value data
+ * @param len - number of bytes decoded from the value data
+ * @param len_value - number of bytes given in the tag
+ * @return true if the value was decoded as a whole
+ */
+static bool cursor_advance(
+    BACNET_TAG_CURSOR *cursor, uint32_t offset, int len, uint32_t len_value)
+{
+    if ((len < 0) || ((uint32_t)len != len_value)) {
+        cursor->error = true;
+        return false;
+    }
+    cursor->offset = offset + len_value;
+
+    return true;
+}
+
+/**
+ * @brief Decode the tag at the cursor without moving it
+ * @param cursor - cursor to be examined
+ * @param tag - decoded tag
+ * @return true if there is a well formed tag at the cursor
+ */
+bool bacnet_tag_cursor_peek(BACNET_TAG_CURSOR *cursor, BACNET_TAG *tag)
+{
+    BACNET_TAG local_tag = { 0 };
+
+    return cursor_tag_decode(cursor, tag ? tag : &local_tag) > 0;
+}
+
+/**
+ * @brief Determine if another element follows at the current level
+ * @param cursor - cursor to be examined
+ * @return true if there is a tag at the cursor that is not a closing tag
+ */
+bool bacnet_tag_cursor_more(BACNET_TAG_CURSOR *cursor)
+{
+    BACNET_TAG tag = { 0 };
+
+    if (cursor_tag_decode(cursor, &tag) > 0) {
+        return !tag.closing;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Skip the element at the cursor. A constructed element is skipped
+ *  as a whole, up to and including its matching closing tag.
+ * @param cursor - cursor to be moved
+ * @return true if an element was skipped
+ */
+bool bacnet_tag_cursor_next(BACNET_TAG_CURSOR *cursor)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+    uint32_t depth = 0;
+    uint32_t len_value;
+    int len;
+
+    if (!cursor || cursor->error) {
+        return false;
+    }
+    offset = cursor->offset;
+    do {
+        if (offset >= cursor->apdu_size) {
+            /* a constructed element without its closing tag */
+            cursor->error = (depth > 0);
+            return false;
+        }
+        len = bacnet_tag_decode(
+            &cursor->apdu[offset], cursor->apdu_size - offset, &tag);
+        if (len <= 0) {
+            cursor->error = true;
+            return false;
+        }
+        if (tag.closing) {
+            if (depth == 0) {
+                /* the end of the enclosing element, not ours to skip */
+                return false;
+            }
+            depth--;
+        } else if (tag.opening) {
+            depth++;
+        }
+        offset += (uint32_t)len;
+        len_value = cursor_data_length(&tag);
+        if (len_value > (cursor->apdu_size - offset)) {
+            cursor->error = true;
+            return false;
+        }
+        offset += len_value;
+    } while (depth > 0);
+    cursor->offset = offset;
+
+    return true;
+}
+
+/**
+ * @brief Move into a constructed element
+ * @param cursor - cursor to be moved
+ * @param tag_number - number of the expected opening tag
+ * @return true if the opening tag was at the cursor and was passed
+ */
+bool bacnet_tag_cursor_enter(BACNET_TAG_CURSOR *cursor, uint8_t tag_number)
+{
+    BACNET_TAG tag = { 0 };
+    int len;
+
+    len = cursor_tag_decode(cursor, &tag);
+    if ((len > 0) && tag.opening && (tag.number == tag_number)) {
+        cursor->offset += (uint32_t)len;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Move out of a constructed element
+ * @param cursor - cursor to be moved
+ * @param tag_number - number of the expected closing tag
+ * @return true if the closing tag was at the cursor and was passed
+ */
+bool bacnet_tag_cursor_leave(BACNET_TAG_CURSOR *cursor, uint8_t tag_number)
+{
+    BACNET_TAG tag = { 0 };
+    int len;
+
+    len = cursor_tag_decode(cursor, &tag);
+    if ((len > 0) && tag.closing && (tag.number == tag_number)) {
+        cursor->offset += (uint32_t)len;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Get the number of bytes decoded so far
+ * @param cursor - cursor to be examined
+ * @return offset of the cursor from the start of the buffer
+ */
+uint32_t bacnet_tag_cursor_offset(const BACNET_TAG_CURSOR *cursor)
+{
+    return cursor ? cursor->offset : 0;
+}
+
+/**
+ * @brief Determine if the cursor stopped at malformed data
+ * @param cursor - cursor to be examined
+ * @return true if malformed data was found
+ */
+bool bacnet_tag_cursor_error(const BACNET_TAG_CURSOR *cursor)
+{
+    return cursor ? cursor->error : true;
+}
+
+/**
+ * @brief Read an application tagged NULL
+ * @param cursor - cursor to be moved
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_null(BACNET_TAG_CURSOR *cursor)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+
+    offset = cursor_primitive(cursor, false, BACNET_APPLICATION_TAG_NULL, &tag);
+    if (offset == 0) {
+        return false;
+    }
+
+    return cursor_advance(cursor, offset, 0, tag.len_value_type);
+}
+
+/**
+ * @brief Read an application tagged BOOLEAN
+ * @param cursor - cursor to be moved
+ * @param value - decoded value
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_boolean(BACNET_TAG_CURSOR *cursor, bool *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+
+    offset =
+        cursor_primitive(cursor, false, BACNET_APPLICATION_TAG_BOOLEAN, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    if (tag.len_value_type > 1) {
+        cursor->error = true;
+        return false;
+    }
+    if (value) {
+        *value = tag.len_value_type ? true : false;
+    }
+    cursor->offset = offset;
+
+    return true;
+}
+
+/**
+ * @brief Read an application tagged Unsigned Integer
+ * @param cursor - cursor to be moved
+ * @param value - decoded value
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_unsigned(
+    BACNET_TAG_CURSOR *cursor, BACNET_UNSIGNED_INTEGER *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+    int len;
+
+    offset = cursor_primitive(
+        cursor, false, BACNET_APPLICATION_TAG_UNSIGNED_INT, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    len = bacnet_unsigned_decode(
+        &cursor->apdu[offset], cursor->apdu_size - offset, tag.len_value_type,
+        value);
+
+    return cursor_advance(cursor, offset, len, tag.len_value_type);
+}
+
+/**
+ * @brief Read an application tagged Signed Integer
+ * @param cursor - cursor to be moved
+ * @param value - decoded value
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_signed(BACNET_TAG_CURSOR *cursor, int32_t *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+    int len;
+
+    offset = cursor_primitive(
+        cursor, false, BACNET_APPLICATION_TAG_SIGNED_INT, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    len = bacnet_signed_decode(
+        &cursor->apdu[offset], cursor->apdu_size - offset, tag.len_value_type,
+        value);
+
+    return cursor_advance(cursor, offset, len, tag.len_value_type);
+}
+
+/**
+ * @brief Read an application tagged REAL
+ * @param cursor - cursor to be moved
+ * @param value - decoded value
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_real(BACNET_TAG_CURSOR *cursor, float *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+    int len;
+
+    offset = cursor_primitive(cursor, false, BACNET_APPLICATION_TAG_REAL, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    len = bacnet_real_decode(
+        &cursor->apdu[offset], cursor->apdu_size - offset, tag.len_value_type,
+        value);
+
+    return cursor_advance(cursor, offset, len, tag.len_value_type);
+}
+
+/**
+ * @brief Read an application tagged Double
+ * @param cursor - cursor to be moved
+ * @param value - decoded value
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_double(BACNET_TAG_CURSOR *cursor, double *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+    int len;
+
+    offset =
+        cursor_primitive(cursor, false, BACNET_APPLICATION_TAG_DOUBLE, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    len = bacnet_double_decode(
+        &cursor->apdu[offset], cursor->apdu_size - offset, tag.len_value_type,
+        value);
+
+    return cursor_advance(cursor, offset, len, tag.len_value_type);
+}
+
+/**
+ * @brief Read an application tagged Enumerated
+ * @param cursor - cursor to be moved
+ * @param value - decoded value
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_enumerated(BACNET_TAG_CURSOR *cursor, uint32_t *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+    int len;
+
+    offset = cursor_primitive(
+        cursor, false, BACNET_APPLICATION_TAG_ENUMERATED, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    len = bacnet_enumerated_decode(
+        &cursor->apdu[offset], cursor->apdu_size - offset, tag.len_value_type,
+        value);
+
+    return cursor_advance(cursor, offset, len, tag.len_value_type);
+}
+
+/**
+ * @brief Read an application tagged Bit String
+ * @param cursor - cursor to be moved
+ * @param value - decoded value
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_bit_string(
+    BACNET_TAG_CURSOR *cursor, BACNET_BIT_STRING *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+    int len;
+
+    offset = cursor_primitive(
+        cursor, false, BACNET_APPLICATION_TAG_BIT_STRING, &tag);
+    if ((offset == 0) || !value) {
+        return false;
+    }
+    len = bacnet_bitstring_decode(
+        &cursor->apdu[offset], cursor->apdu_size - offset, tag.len_value_type,
+        value);
+
+    return cursor_advance(cursor, offset, len, tag.len_value_type);
+}
+
+/**
+ * @brief Read an application tagged BACnetObjectIdentifier
+ * @param cursor - cursor to be moved
+ * @param object_type - decoded object type
+ * @param instance - decoded object instance
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_object_id(
+    BACNET_TAG_CURSOR *cursor,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *instance)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+    int len;
+
+    offset =
+        cursor_primitive(cursor, false, BACNET_APPLICATION_TAG_OBJECT_ID, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    len = bacnet_object_id_decode(
+        &cursor->apdu[offset], cursor->apdu_size - offset, tag.len_value_type,
+        object_type, instance);
+
+    return cursor_advance(cursor, offset, len, tag.len_value_type);
+}
+
+/**
+ * @brief Read an application tagged Character String as a view into
+ *  the buffer, without copying it
+ * @param cursor - cursor to be moved
+ * @param value - view of the string
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_character_string(
+    BACNET_TAG_CURSOR *cursor, BACNET_CHARACTER_STRING_VIEW *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+
+    offset = cursor_primitive(
+        cursor, false, BACNET_APPLICATION_TAG_CHARACTER_STRING, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    if (tag.len_value_type == 0) {
+        /* the encoding octet is missing */
+        cursor->error = true;
+        return false;
+    }
+    if (value) {
+        characterstring_view_init(
+            value, cursor->apdu[offset],
+            (const char *)&cursor->apdu[offset + 1], tag.len_value_type - 1);
+    }
+    cursor->offset = offset + tag.len_value_type;
+
+    return true;
+}
+
+#if BACNET_USE_OCTETSTRING
+/**
+ * @brief Read an application tagged Octet String as a view into
+ *  the buffer, without copying it
+ * @param cursor - cursor to be moved
+ * @param value - view of the octets
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_octet_string(
+    BACNET_TAG_CURSOR *cursor, BACNET_OCTET_STRING_VIEW *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+
+    offset = cursor_primitive(
+        cursor, false, BACNET_APPLICATION_TAG_OCTET_STRING, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    if (value) {
+        octetstring_view_init(
+            value, &cursor->apdu[offset], tag.len_value_type);
+    }
+    cursor->offset = offset + tag.len_value_type;
+
+    return true;
+}
+#endif
+
+/**
+ * @brief Read a context tagged BOOLEAN
+ * @param cursor - cursor to be moved
+ * @param tag_number - expected context tag number
+ * @param value - decoded value
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_context_boolean(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number, bool *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+
+    offset = cursor_primitive(cursor, true, tag_number, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    if (tag.len_value_type != 1) {
+        cursor->error = true;
+        return false;
+    }
+    if (value) {
+        *value = cursor->apdu[offset] ? true : false;
+    }
+    cursor->offset = offset + 1;
+
+    return true;
+}
+
+/**
+ * @brief Read a context tagged Unsigned Integer
+ * @param cursor - cursor to be moved
+ * @param tag_number - expected context tag number
+ * @param value - decoded value
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_context_unsigned(
+    BACNET_TAG_CURSOR *cursor,
+    uint8_t tag_number,
+    BACNET_UNSIGNED_INTEGER *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+    int len;
+
+    offset = cursor_primitive(cursor, true, tag_number, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    len = bacnet_unsigned_decode(
+        &cursor->apdu[offset], cursor->apdu_size - offset, tag.len_value_type,
+        value);
+
+    return cursor_advance(cursor, offset, len, tag.len_value_type);
+}
+
+/**
+ * @brief Read a context tagged Signed Integer
+ * @param cursor - cursor to be moved
+ * @param tag_number - expected context tag number
+ * @param value - decoded value
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_context_signed(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number, int32_t *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+    int len;
+
+    offset = cursor_primitive(cursor, true, tag_number, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    len = bacnet_signed_decode(
+        &cursor->apdu[offset], cursor->apdu_size - offset, tag.len_value_type,
+        value);
+
+    return cursor_advance(cursor, offset, len, tag.len_value_type);
+}
+
+/**
+ * @brief Read a context tagged REAL
+ * @param cursor - cursor to be moved
+ * @param tag_number - expected context tag number
+ * @param value - decoded value
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_context_real(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number, float *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+    int len;
+
+    offset = cursor_primitive(cursor, true, tag_number, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    len = bacnet_real_decode(
+        &cursor->apdu[offset], cursor->apdu_size - offset, tag.len_value_type,
+        value);
+
+    return cursor_advance(cursor, offset, len, tag.len_value_type);
+}
+
+/**
+ * @brief Read a context tagged Enumerated
+ * @param cursor - cursor to be moved
+ * @param tag_number - expected context tag number
+ * @param value - decoded value
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_context_enumerated(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number, uint32_t *value)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+    int len;
+
+    offset = cursor_primitive(cursor, true, tag_number, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    len = bacnet_enumerated_decode(
+        &cursor->apdu[offset], cursor->apdu_size - offset, tag.len_value_type,
+        value);
+
+    return cursor_advance(cursor, offset, len, tag.len_value_type);
+}
+
+/**
+ * @brief Read a context tagged BACnetObjectIdentifier
+ * @param cursor - cursor to be moved
+ * @param tag_number - expected context tag number
+ * @param object_type - decoded object type
+ * @param instance - decoded object instance
+ * @return true if the value was read
+ */
+bool bacnet_tag_cursor_context_object_id(
+    BACNET_TAG_CURSOR *cursor,
+    uint8_t tag_number,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *instance)
+{
+    BACNET_TAG tag = { 0 };
+    uint32_t offset;
+    int len;
+
+    offset = cursor_primitive(cursor, true, tag_number, &tag);
+    if (offset == 0) {
+        return false;
+    }
+    len = bacnet_object_id_decode(
+        &cursor->apdu[offset], cursor->apdu_size - offset, tag.len_value_type,
+        object_type, instance);
+
+    return cursor_advance(cursor, offset, len, tag.len_value_type);
+}
@@ -0,0 +1,120 @@
+/**
+ * @file
+ * @brief API for a pull-style cursor that decodes BACnet tags in place
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_TAG_CURSOR_H
+#define BACNET_TAG_CURSOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "bacdef.h"
+/* BACnet Stack API */
+//#include "bacnet/bacdcode.h"
+#include "bacdcode.h"
+//#include "bacnet/bacstr.h"
+#include "bacstr.h"
+
+/**
+ * A position within an encoded APDU. Each read decodes one tag and its
+ * value straight from the buffer and moves past it; a read of the wrong
+ * type leaves the cursor where it was, so the caller can try another.
+ * Malformed data sets the error flag and stops the cursor.
+ * @{
+ */
+struct bacnet_tag_cursor {
+    const uint8_t *apdu;
+    uint32_t apdu_size;
+    uint32_t offset;
+    bool error;
+};
+typedef struct bacnet_tag_cursor BACNET_TAG_CURSOR;
+/** @} */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+void bacnet_tag_cursor_init(
+    BACNET_TAG_CURSOR *cursor, const uint8_t *apdu, uint32_t apdu_size);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_peek(BACNET_TAG_CURSOR *cursor, BACNET_TAG *tag);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_more(BACNET_TAG_CURSOR *cursor);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_next(BACNET_TAG_CURSOR *cursor);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_enter(BACNET_TAG_CURSOR *cursor, uint8_t tag_number);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_leave(BACNET_TAG_CURSOR *cursor, uint8_t tag_number);
+BACNET_STACK_EXPORT
+uint32_t bacnet_tag_cursor_offset(const BACNET_TAG_CURSOR *cursor);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_error(const BACNET_TAG_CURSOR *cursor);
+
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_null(BACNET_TAG_CURSOR *cursor);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_boolean(BACNET_TAG_CURSOR *cursor, bool *value);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_unsigned(
+    BACNET_TAG_CURSOR *cursor, BACNET_UNSIGNED_INTEGER *value);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_signed(BACNET_TAG_CURSOR *cursor, int32_t *value);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_real(BACNET_TAG_CURSOR *cursor, float *value);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_double(BACNET_TAG_CURSOR *cursor, double *value);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_enumerated(BACNET_TAG_CURSOR *cursor, uint32_t *value);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_bit_string(
+    BACNET_TAG_CURSOR *cursor, BACNET_BIT_STRING *value);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_object_id(
+    BACNET_TAG_CURSOR *cursor,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *instance);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_character_string(
+    BACNET_TAG_CURSOR *cursor, BACNET_CHARACTER_STRING_VIEW *value);
+#if BACNET_USE_OCTETSTRING
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_octet_string(
+    BACNET_TAG_CURSOR *cursor, BACNET_OCTET_STRING_VIEW *value);
+#endif
+
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_context_boolean(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number, bool *value);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_context_unsigned(
+    BACNET_TAG_CURSOR *cursor,
+    uint8_t tag_number,
+    BACNET_UNSIGNED_INTEGER *value);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_context_signed(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number, int32_t *value);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_context_real(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number, float *value);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_context_enumerated(
+    BACNET_TAG_CURSOR *cursor, uint8_t tag_number, uint32_t *value);
+BACNET_STACK_EXPORT
+bool bacnet_tag_cursor_context_object_id(
+    BACNET_TAG_CURSOR *cursor,
+    uint8_t tag_number,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *instance);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
@@ -499,6 +499,25 @@ int bacnet_tag_encode(uint8_t *apdu, uint32_t apdu_size, const BACNET_TAG *tag)
     return apdu_len;
 }
 
+/* class and length of a tag held in a single octet, indexed by the
+   low nibble of the octet: bits 0..2 hold the length, and a length of
+   TAG_OCTET_EXTENDED means the length is in the following octets */
+#define TAG_OCTET_EXTENDED 0x07
+#define TAG_OCTET_APPLICATION 0x10
+#define TAG_OCTET_CONTEXT 0x20
+#define TAG_OCTET_OPENING 0x40
+#define TAG_OCTET_CLOSING 0x80
+static const uint8_t Tag_Octet_Class[16] = {
+    TAG_OCTET_APPLICATION | 0, TAG_OCTET_APPLICATION | 1,
+    TAG_OCTET_APPLICATION | 2, TAG_OCTET_APPLICATION | 3,
+    TAG_OCTET_APPLICATION | 4, TAG_OCTET_EXTENDED,
+    TAG_OCTET_APPLICATION, TAG_OCTET_APPLICATION,
+    TAG_OCTET_CONTEXT | 0, TAG_OCTET_CONTEXT | 1,
+    TAG_OCTET_CONTEXT | 2, TAG_OCTET_CONTEXT | 3,
+    TAG_OCTET_CONTEXT | 4, TAG_OCTET_EXTENDED,
+    TAG_OCTET_OPENING, TAG_OCTET_CLOSING
+};
+
 /**
  * @brief Decode the BACnet Tag Number and Value
  * as defined in clause 20.2.1 General Rules For Encoding BACnet Tags
@@ -518,7 +537,24 @@ int bacnet_tag_decode(const uint8_t *apdu, uint32_t apdu_size, BACNET_TAG *tag)
     bool opening_tag = false;
     bool closing_tag = false;
     uint32_t len_value_type = 0;
-
+    uint8_t tag_class;
+
+    if (apdu && (apdu_size > 0) && !IS_EXTENDED_TAG_NUMBER(apdu[0])) {
+        /* most tags fit in one octet: decode them without the checks
+           that the longer forms need */
+        tag_class = Tag_Octet_Class[apdu[0] & 0x0F];
+        if (tag_class != TAG_OCTET_EXTENDED) {
+            if (tag) {
+                tag->number = (uint8_t)(apdu[0] >> 4);
+                tag->application = (tag_class & TAG_OCTET_APPLICATION) != 0;
+                tag->context = (tag_class & TAG_OCTET_CONTEXT) != 0;
+                tag->opening = (tag_class & TAG_OCTET_OPENING) != 0;
+                tag->closing = (tag_class & TAG_OCTET_CLOSING) != 0;
+                tag->len_value_type = tag_class & 0x07;
+            }
+            return 1;
+        }
+    }
     if (apdu && (apdu_size > 0)) {
         len = bacnet_tag_number_decode(&apdu[0], apdu_size, &tag_number);
     }
@@ -2494,6 +2530,55 @@ int bacnet_octet_string_context_decode(
 
     return apdu_len;
 }
+
+/**
+ * @brief Encode a view of octets as an application tagged BACnet Octet
+ *  String, without first copying them into a BACNET_OCTET_STRING
+ * @param apdu - buffer to hold the bytes, or NULL for length
+ * @param value - the octet string view to be encoded
+ * @return returns the number of apdu bytes consumed
+ */
+int encode_application_octet_string_view(
+    uint8_t *apdu, const BACNET_OCTET_STRING_VIEW *value)
+{
+    int len = 0;
+
+    if (value) {
+        len = encode_tag(
+            apdu, BACNET_APPLICATION_TAG_OCTET_STRING, false,
+            (uint32_t)value->length);
+        if (apdu && (value->length > 0)) {
+            memcpy(&apdu[len], value->value, value->length);
+        }
+        len += (int)value->length;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Encode a view of octets as a context tagged BACnet Octet String,
+ *  without first copying them into a BACNET_OCTET_STRING
+ * @param apdu - buffer to hold the bytes, or NULL for length
+ * @param tag_number - context tag number to be encoded
+ * @param value - the octet string view to be encoded
+ * @return returns the number of apdu bytes consumed
+ */
+int encode_context_octet_string_view(
+    uint8_t *apdu, uint8_t tag_number, const BACNET_OCTET_STRING_VIEW *value)
+{
+    int len = 0;
+
+    if (value) {
+        len = encode_tag(apdu, tag_number, true, (uint32_t)value->length);
+        if (apdu && (value->length > 0)) {
+            memcpy(&apdu[len], value->value, value->length);
+        }
+        len += (int)value->length;
+    }
+
+    return len;
+}
 #endif
 
 /**
@@ -2627,6 +2712,81 @@ int encode_context_character_string(
     return apdu_len;
 }
 
+/**
+ * @brief Encode a view of characters as a BACnet Character String Value,
+ *  without first copying them into a BACNET_CHARACTER_STRING
+ * @param apdu - buffer to hold the bytes, or NULL for length
+ * @param view - the character string view to be encoded
+ * @return returns the number of apdu bytes consumed
+ */
+int encode_bacnet_character_string_view(
+    uint8_t *apdu, const BACNET_CHARACTER_STRING_VIEW *view)
+{
+    if (!view) {
+        return 0;
+    }
+    if (apdu) {
+        apdu[0] = view->encoding;
+        if (view->length > 0) {
+            memcpy(&apdu[1], view->value, view->length);
+        }
+    }
+
+    return 1 + (int)view->length;
+}
+
+/**
+ * @brief Encode a view of characters as an application tagged BACnet
+ *  Character String, without first copying them into a
+ *  BACNET_CHARACTER_STRING
+ * @param apdu - buffer to hold the bytes, or NULL for length
+ * @param view - the character string view to be encoded
+ * @return returns the number of apdu bytes consumed
+ */
+int encode_application_character_string_view(
+    uint8_t *apdu, const BACNET_CHARACTER_STRING_VIEW *view)
+{
+    int len = 0;
+
+    if (view) {
+        len = encode_tag(
+            apdu, BACNET_APPLICATION_TAG_CHARACTER_STRING, false,
+            (uint32_t)(1 + view->length));
+        if (apdu) {
+            apdu += len;
+        }
+        len += encode_bacnet_character_string_view(apdu, view);
+    }
+
+    return len;
+}
+
+/**
+ * @brief Encode a view of characters as a context tagged BACnet Character
+ *  String, without first copying them into a BACNET_CHARACTER_STRING
+ * @param apdu - buffer to hold the bytes, or NULL for length
+ * @param tag_number - context tag number to encode
+ * @param view - the character string view to be encoded
+ * @return returns the number of apdu bytes consumed
+ */
+int encode_context_character_string_view(
+    uint8_t *apdu,
+    uint8_t tag_number,
+    const BACNET_CHARACTER_STRING_VIEW *view)
+{
+    int len = 0;
+
+    if (view) {
+        len = encode_tag(apdu, tag_number, true, (uint32_t)(1 + view->length));
+        if (apdu) {
+            apdu += len;
+        }
+        len += encode_bacnet_character_string_view(apdu, view);
+    }
+
+    return len;
+}
+
 /**
  * @brief Decodes from bytes into a BACnet Character String value
  * from clause 20.2.9 Encoding of a Character String Value
@@ -2855,6 +3015,18 @@ int bacnet_unsigned_decode(
     uint64_t unsigned64_value = 0;
 #endif
 
+    if (apdu && (len_value >= 1) && (len_value <= 4) &&
+        (len_value <= apdu_size)) {
+        /* the common short values, without a call per width */
+        unsigned32_value = apdu[0];
+        for (len = 1; len < (int)len_value; len++) {
+            unsigned32_value = (unsigned32_value << 8) | apdu[len];
+        }
+        if (value) {
+            *value = unsigned32_value;
+        }
+        return len;
+    }
     if (len_value <= apdu_size) {
         switch (len_value) {
             case 1:
@@ -5033,6 +5205,143 @@ int encode_simple_ack(uint8_t *apdu, uint8_t invoke_id, uint8_t service_choice)
     return 3;
 }
 
+/**
+ * @brief Determine the number of bytes in an encoded tag, without
+ *  encoding it
+ * @param tag_number - tag number, or the number of an opening or
+ *  closing tag
+ * @param len_value_type - length of the tagged data, or zero
+ * @return number of bytes the tag occupies
+ */
+int bacnet_tag_encoded_size(uint8_t tag_number, uint32_t len_value_type)
+{
+    int len = 1;
+
+    if (tag_number > 14) {
+        len++;
+    }
+    if (len_value_type > 4) {
+        if (len_value_type <= 253) {
+            len++;
+        } else if (len_value_type <= 65535) {
+            len += 3;
+        } else {
+            len += 5;
+        }
+    }
+
+    return len;
+}
+
+/**
+ * @brief Determine the number of bytes in an application tagged
+ *  Unsigned Integer, without encoding it
+ * @param value - value to be encoded
+ * @return number of bytes the value occupies
+ */
+int bacnet_unsigned_application_encoded_size(BACNET_UNSIGNED_INTEGER value)
+{
+    int len = bacnet_unsigned_length(value);
+
+    return bacnet_tag_encoded_size(
+               BACNET_APPLICATION_TAG_UNSIGNED_INT, (uint32_t)len) +
+        len;
+}
+
+/**
+ * @brief Determine the number of bytes in a context tagged
+ *  Unsigned Integer, without encoding it
+ * @param tag_number - context tag number
+ * @param value - value to be encoded
+ * @return number of bytes the value occupies
+ */
+int bacnet_unsigned_context_encoded_size(
+    uint8_t tag_number, BACNET_UNSIGNED_INTEGER value)
+{
+    int len = bacnet_unsigned_length(value);
+
+    return bacnet_tag_encoded_size(tag_number, (uint32_t)len) + len;
+}
+
+/**
+ * @brief Determine the number of bytes in an application tagged
+ *  Enumerated value, without encoding it
+ * @param value - value to be encoded
+ * @return number of bytes the value occupies
+ */
+int bacnet_enumerated_application_encoded_size(uint32_t value)
+{
+    int len = bacnet_unsigned_length(value);
+
+    return bacnet_tag_encoded_size(
+               BACNET_APPLICATION_TAG_ENUMERATED, (uint32_t)len) +
+        len;
+}
+
+/**
+ * @brief Determine the number of bytes in a context tagged
+ *  Enumerated value, without encoding it
+ * @param tag_number - context tag number
+ * @param value - value to be encoded
+ * @return number of bytes the value occupies
+ */
+int bacnet_enumerated_context_encoded_size(uint8_t tag_number, uint32_t value)
+{
+    int len = bacnet_unsigned_length(value);
+
+    return bacnet_tag_encoded_size(tag_number, (uint32_t)len) + len;
+}
+
+/**
+ * @brief Determine the number of bytes in a context tagged
+ *  BACnetObjectIdentifier, without encoding it
+ * @param tag_number - context tag number
+ * @return number of bytes the value occupies
+ */
+int bacnet_object_id_context_encoded_size(uint8_t tag_number)
+{
+    return bacnet_tag_encoded_size(tag_number, 4) + 4;
+}
+
+/**
+ * @brief Determine the number of bytes in a context tagged BOOLEAN,
+ *  without encoding it
+ * @param tag_number - context tag number
+ * @return number of bytes the value occupies
+ */
+int bacnet_boolean_context_encoded_size(uint8_t tag_number)
+{
+    return bacnet_tag_encoded_size(tag_number, 1) + 1;
+}
+
+/**
+ * @brief Determine the number of bytes in an application tagged
+ *  Octet String, without encoding it
+ * @param length - number of octets in the string
+ * @return number of bytes the value occupies
+ */
+int bacnet_octet_string_application_encoded_size(size_t length)
+{
+    return bacnet_tag_encoded_size(
+               BACNET_APPLICATION_TAG_OCTET_STRING, (uint32_t)length) +
+        (int)length;
+}
+
+/**
+ * @brief Determine the number of bytes in an application tagged
+ *  Character String, without encoding it
+ * @param length - number of bytes in the string, not counting the
+ *  character set octet
+ * @return number of bytes the value occupies
+ */
+int bacnet_character_string_application_encoded_size(size_t length)
+{
+    return bacnet_tag_encoded_size(
+               BACNET_APPLICATION_TAG_CHARACTER_STRING,
+               (uint32_t)length + 1) +
+        (int)length + 1;
+}
+
 /**
  * @brief Encode a BACnetARRAY property value
  * @param object_instance [in] BACnet network port object instance number
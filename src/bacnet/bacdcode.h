@@ -391,6 +391,12 @@ BACNET_STACK_EXPORT
 int encode_context_octet_string(
     uint8_t *apdu, uint8_t tag_number, const BACNET_OCTET_STRING *octet_string);
 BACNET_STACK_EXPORT
+int encode_application_octet_string_view(
+    uint8_t *apdu, const BACNET_OCTET_STRING_VIEW *value);
+BACNET_STACK_EXPORT
+int encode_context_octet_string_view(
+    uint8_t *apdu, uint8_t tag_number, const BACNET_OCTET_STRING_VIEW *value);
+BACNET_STACK_EXPORT
 BACNET_STACK_DEPRECATED("Use bacnet_octet_string_decode() instead")
 int decode_octet_string(
     const uint8_t *apdu, uint32_t len_value, BACNET_OCTET_STRING *octet_string);
@@ -436,6 +442,17 @@ int encode_context_character_string(
     uint8_t *apdu,
     uint8_t tag_number,
     const BACNET_CHARACTER_STRING *char_string);
+BACNET_STACK_EXPORT
+int encode_bacnet_character_string_view(
+    uint8_t *apdu, const BACNET_CHARACTER_STRING_VIEW *view);
+BACNET_STACK_EXPORT
+int encode_application_character_string_view(
+    uint8_t *apdu, const BACNET_CHARACTER_STRING_VIEW *view);
+BACNET_STACK_EXPORT
+int encode_context_character_string_view(
+    uint8_t *apdu,
+    uint8_t tag_number,
+    const BACNET_CHARACTER_STRING_VIEW *view);
 BACNET_STACK_DEPRECATED("Use bacnet_character_string_decode() instead")
 BACNET_STACK_EXPORT
 int decode_character_string(
@@ -688,6 +705,26 @@ int decode_max_apdu(uint8_t octet);
 BACNET_STACK_EXPORT
 int encode_simple_ack(uint8_t *apdu, uint8_t invoke_id, uint8_t service_choice);
 
+BACNET_STACK_EXPORT
+int bacnet_tag_encoded_size(uint8_t tag_number, uint32_t len_value_type);
+BACNET_STACK_EXPORT
+int bacnet_unsigned_application_encoded_size(BACNET_UNSIGNED_INTEGER value);
+BACNET_STACK_EXPORT
+int bacnet_unsigned_context_encoded_size(
+    uint8_t tag_number, BACNET_UNSIGNED_INTEGER value);
+BACNET_STACK_EXPORT
+int bacnet_enumerated_application_encoded_size(uint32_t value);
+BACNET_STACK_EXPORT
+int bacnet_enumerated_context_encoded_size(uint8_t tag_number, uint32_t value);
+BACNET_STACK_EXPORT
+int bacnet_object_id_context_encoded_size(uint8_t tag_number);
+BACNET_STACK_EXPORT
+int bacnet_boolean_context_encoded_size(uint8_t tag_number);
+BACNET_STACK_EXPORT
+int bacnet_octet_string_application_encoded_size(size_t length);
+BACNET_STACK_EXPORT
+int bacnet_character_string_application_encoded_size(size_t length);
+
 BACNET_STACK_EXPORT
 int bacnet_array_encode(
     uint32_t object_instance,
@@ -737,6 +774,15 @@ BACNET_ERROR_CODE bacnet_list_write(
 /* true if the tag is a closing tag */
 #define IS_CLOSING_TAG(x) (((x) & 0x07) == 7)
 
+/* from clause 20.2.1 General Rules for Encoding BACnet Tags */
+/* the initial octet of a tag with tag number 0..14 and length 0..4,
+   for encoders that emit a fixed layout */
+#define BACNET_APPLICATION_TAG_OCTET(n, len) ((uint8_t)(((n) << 4) | (len)))
+#define BACNET_CONTEXT_TAG_OCTET(n, len) \
+    ((uint8_t)(((n) << 4) | BIT(3) | (len)))
+#define BACNET_OPENING_TAG_OCTET(n) ((uint8_t)(((n) << 4) | 0x0E))
+#define BACNET_CLOSING_TAG_OCTET(n) ((uint8_t)(((n) << 4) | 0x0F))
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
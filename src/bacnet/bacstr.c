@@ -995,6 +995,137 @@ bool characterstring_valid(const BACNET_CHARACTER_STRING *char_string)
     return valid;
 }
 
+/**
+ * @brief Initialize a view of characters held elsewhere, without copying
+ * @param view - the character string view
+ * @param encoding - BACnet character string encoding of the value
+ * @param value - characters, which must outlive the view
+ * @param length - number of characters, not including any NUL
+ * @return true if the characters would fit in a BACnet character string
+ */
+bool characterstring_view_init(
+    BACNET_CHARACTER_STRING_VIEW *view,
+    uint8_t encoding,
+    const char *value,
+    size_t length)
+{
+    if (!view) {
+        return false;
+    }
+    if (!value) {
+        length = 0;
+    }
+    view->value = value;
+    view->length = 0;
+    view->encoding = encoding;
+    if (length > CHARACTER_STRING_CAPACITY) {
+        return false;
+    }
+    view->length = length;
+
+    return true;
+}
+
+/**
+ * @brief Initialize a view of a C string, without copying
+ * @param view - the character string view
+ * @param value - NUL terminated ANSI X3.4 string, or NULL for empty,
+ *  which must outlive the view
+ * @return true if the characters would fit in a BACnet character string
+ */
+bool characterstring_view_init_ansi(
+    BACNET_CHARACTER_STRING_VIEW *view, const char *value)
+{
+    return characterstring_view_init(
+        view, CHARACTER_ANSI_X34, value, value ? strlen(value) : 0);
+}
+
+/**
+ * @brief Initialize a view of an object name, which is either the name
+ *  stored in the object or a default name made from the instance number
+ * @param view - the character string view
+ * @param name - stored object name, or NULL to use the default name
+ * @param format - printf format of the default name, taking one
+ *  unsigned long, e.g. "ANALOG INPUT %lu"
+ * @param object_instance - object-instance number of the object
+ * @param text - buffer for the default name, which must outlive the view
+ * @param text_size - size of the text buffer
+ * @return true if the view was initialized
+ */
+bool characterstring_view_object_name(
+    BACNET_CHARACTER_STRING_VIEW *view,
+    const char *name,
+    const char *format,
+    uint32_t object_instance,
+    char *text,
+    size_t text_size)
+{
+    if (name) {
+        return characterstring_view_init_ansi(view, name);
+    }
+    snprintf(text, text_size, format, (unsigned long)object_instance);
+
+    return characterstring_view_init_ansi(view, text);
+}
+
+/**
+ * @brief Initialize a view of a BACnet character string, without copying
+ * @param view - the character string view
+ * @param char_string - the character string, which must outlive the view
+ * @return true if the view was initialized
+ */
+bool characterstring_view_from(
+    BACNET_CHARACTER_STRING_VIEW *view,
+    const BACNET_CHARACTER_STRING *char_string)
+{
+    if (!char_string) {
+        return false;
+    }
+
+    return characterstring_view_init(
+        view, char_string->encoding, char_string->value, char_string->length);
+}
+
+/**
+ * @brief Copy the characters of a view into a BACnet character string
+ * @param dest - the character string
+ * @param src - the character string view
+ * @return true if the characters fit
+ */
+bool characterstring_view_copy(
+    BACNET_CHARACTER_STRING *dest, const BACNET_CHARACTER_STRING_VIEW *src)
+{
+    if (!src) {
+        return false;
+    }
+
+    return characterstring_init(dest, src->encoding, src->value, src->length);
+}
+
+/**
+ * @brief Compare a view with a BACnet character string
+ * @param view - the character string view
+ * @param char_string - the character string
+ * @return true if the encoding, length, and characters are the same
+ */
+bool characterstring_view_same(
+    const BACNET_CHARACTER_STRING_VIEW *view,
+    const BACNET_CHARACTER_STRING *char_string)
+{
+    if (!view || !char_string) {
+        return false;
+    }
+    if ((view->encoding != char_string->encoding) ||
+        (view->length != char_string->length)) {
+        return false;
+    }
+    if (view->length == 0) {
+        return true;
+    }
+
+    return memcmp(view->value, char_string->value, view->length) == 0;
+}
+
 #if BACNET_USE_OCTETSTRING
 /**
  * @brief Initialize an octet string with the given bytes or
@@ -1273,6 +1404,49 @@ bool octetstring_value_same(
 
     return false;
 }
+
+/**
+ * @brief Initialize a view of octets held elsewhere, without copying
+ * @param view - the octet string view
+ * @param value - octets, which must outlive the view
+ * @param length - number of octets
+ * @return true if the octets would fit in a BACnet octet string
+ */
+bool octetstring_view_init(
+    BACNET_OCTET_STRING_VIEW *view, const uint8_t *value, size_t length)
+{
+    if (!view) {
+        return false;
+    }
+    if (!value) {
+        length = 0;
+    }
+    view->value = value;
+    view->length = 0;
+    if (length > MAX_OCTET_STRING_BYTES) {
+        return false;
+    }
+    view->length = length;
+
+    return true;
+}
+
+/**
+ * @brief Initialize a view of a BACnet octet string, without copying
+ * @param view - the octet string view
+ * @param octet_string - the octet string, which must outlive the view
+ * @return true if the view was initialized
+ */
+bool octetstring_view_from(
+    BACNET_OCTET_STRING_VIEW *view, const BACNET_OCTET_STRING *octet_string)
+{
+    if (!octet_string) {
+        return false;
+    }
+
+    return octetstring_view_init(
+        view, octet_string->value, octet_string->length);
+}
 #endif
 
 /**
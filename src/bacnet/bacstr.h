@@ -33,6 +33,22 @@ typedef struct BACnet_Octet_String {
     uint8_t value[MAX_OCTET_STRING_BYTES];
 } BACNET_OCTET_STRING;
 
+/* string views
+   They borrow the characters or octets from the caller, such as an
+   object name held by an object, instead of copying them, so they are
+   small enough to keep on the stack. The borrowed value must outlive
+   the view. */
+typedef struct BACnet_Character_String_View {
+    const char *value;
+    size_t length;
+    uint8_t encoding;
+} BACNET_CHARACTER_STRING_VIEW;
+
+typedef struct BACnet_Octet_String_View {
+    const uint8_t *value;
+    size_t length;
+} BACNET_OCTET_STRING_VIEW;
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -134,6 +150,36 @@ bool characterstring_valid(const BACNET_CHARACTER_STRING *char_string);
 BACNET_STACK_EXPORT
 bool utf8_isvalid(const char *str, size_t length);
 
+/* returns false if the string exceeds the capacity of a character string */
+BACNET_STACK_EXPORT
+bool characterstring_view_init(
+    BACNET_CHARACTER_STRING_VIEW *view,
+    uint8_t encoding,
+    const char *value,
+    size_t length);
+BACNET_STACK_EXPORT
+bool characterstring_view_init_ansi(
+    BACNET_CHARACTER_STRING_VIEW *view, const char *value);
+BACNET_STACK_EXPORT
+bool characterstring_view_object_name(
+    BACNET_CHARACTER_STRING_VIEW *view,
+    const char *name,
+    const char *format,
+    uint32_t object_instance,
+    char *text,
+    size_t text_size);
+BACNET_STACK_EXPORT
+bool characterstring_view_from(
+    BACNET_CHARACTER_STRING_VIEW *view,
+    const BACNET_CHARACTER_STRING *char_string);
+BACNET_STACK_EXPORT
+bool characterstring_view_copy(
+    BACNET_CHARACTER_STRING *dest, const BACNET_CHARACTER_STRING_VIEW *src);
+BACNET_STACK_EXPORT
+bool characterstring_view_same(
+    const BACNET_CHARACTER_STRING_VIEW *view,
+    const BACNET_CHARACTER_STRING *char_string);
+
 /* returns false if the string exceeds capacity
    initialize by using length=0 */
 BACNET_STACK_EXPORT
@@ -172,6 +218,13 @@ BACNET_STACK_EXPORT
 bool octetstring_value_same(
     const BACNET_OCTET_STRING *octet_string1,
     const BACNET_OCTET_STRING *octet_string2);
+/* returns false if the octets exceed the capacity of an octet string */
+BACNET_STACK_EXPORT
+bool octetstring_view_init(
+    BACNET_OCTET_STRING_VIEW *view, const uint8_t *value, size_t length);
+BACNET_STACK_EXPORT
+bool octetstring_view_from(
+    BACNET_OCTET_STRING_VIEW *view, const BACNET_OCTET_STRING *octet_string);
 
 BACNET_STACK_EXPORT
 int bacnet_stricmp(const char *a, const char *b);
@@ -19,6 +19,8 @@
 #include "../../../bacnet/datalink/bvlc.h"
 //#include "bacnet/basic/sys/debug.h"
 #include "../../../bacnet/basic/sys/debug.h"
+//#include "bacnet/basic/sys/pktbuf.h"
+#include "../../../bacnet/basic/sys/pktbuf.h"
 //#include "bacnet/basic/object/device.h"
 #include "../../../bacnet/basic/object/device.h"
 //#include "bacnet/basic/bbmd/h_bbmd.h"
@@ -59,6 +61,8 @@ static BACNET_IP_ADDRESS Remote_BBMD;
 static uint16_t Remote_BBMD_TTL_Seconds;
 /** Dynamic enable or disable of accepting FD registrations */
 static bool BBMD_Accept_FD_Registrations = 1;
+/** writable bytes in front of each received BVLL message */
+static uint16_t BVLC_Receive_Headroom;
 #if BBMD_ENABLED || BBMD_CLIENT_ENABLED
 /* local buffer & length for sending */
 static uint8_t BVLC_Buffer[BIP_MPDU_MAX];
@@ -75,6 +79,41 @@ static BACNET_IP_BROADCAST_DISTRIBUTION_TABLE_ENTRY
 #define MAX_FD_ENTRIES 128
 #endif
 static BACNET_IP_FOREIGN_DEVICE_TABLE_ENTRY FD_Table[MAX_FD_ENTRIES];
+/* Forwarded-NPDU built from an NPDU without enough headroom */
+static uint8_t BBMD_Forward_Buffer[BIP_MPDU_MAX];
+#if (MAX_FD_ENTRIES > 32767) || (MAX_BBMD_ENTRIES > 32767)
+#error "MAX_FD_ENTRIES and MAX_BBMD_ENTRIES must be less than 32768"
+#endif
+/* The FDT and BDT are indexed by an open addressing hash of the
+ * B/IPv4 address and port, sized to a power of two that is at least
+ * twice the table so that linear probe sequences stay short. */
+#define BBMD_HASH_BITS(n)                                               \
+    ((n) <= 8 ? 4 : (n) <= 16 ? 5 : (n) <= 32 ? 6 : (n) <= 64 ? 7    \
+         : (n) <= 128 ? 8 : (n) <= 256 ? 9 : (n) <= 512 ? 10          \
+         : (n) <= 1024 ? 11 : (n) <= 2048 ? 12 : (n) <= 4096 ? 13     \
+         : (n) <= 8192 ? 14 : (n) <= 16384 ? 15 : 16)
+#define BBMD_INDEX_NONE UINT16_MAX
+#define FDT_HASH_BITS BBMD_HASH_BITS(MAX_FD_ENTRIES)
+#define FDT_HASH_SIZE (1UL << FDT_HASH_BITS)
+#define BDT_HASH_BITS BBMD_HASH_BITS(MAX_BBMD_ENTRIES)
+#define BDT_HASH_SIZE (1UL << BDT_HASH_BITS)
+/* FD_Table index for each hash bucket, or BBMD_INDEX_NONE */
+static uint16_t FDT_Hash[FDT_HASH_SIZE];
+/* Expiry queue: FDT_Queue[0..FDT_Queue_Count-1] is a binary min-heap of
+ * the active FD_Table indices ordered by FDT_Deadline, and the rest of
+ * the array holds the free FD_Table indices. */
+static uint16_t FDT_Queue[MAX_FD_ENTRIES];
+static uint16_t FDT_Queue_Position[MAX_FD_ENTRIES];
+static uint16_t FDT_Queue_Count;
+/* expiry time of each FDT entry, in BBMD_Uptime_Seconds */
+static uint32_t FDT_Deadline[MAX_FD_ENTRIES];
+/* seconds accumulated by the maintenance timer */
+static uint32_t BBMD_Uptime_Seconds;
+/* BBMD_Table index for each hash bucket, or BBMD_INDEX_NONE.
+ * Every path that changes the BDT clears BDT_Hash_Valid; a writer through
+ * bvlc_bdt_list() calls bvlc_bdt_list_changed(). */
+static uint16_t BDT_Hash[BDT_HASH_SIZE];
+static bool BDT_Hash_Valid;
 #endif
 
 /**
@@ -165,6 +204,373 @@ static void debug_print_string(const char *str)
 }
 
 #if BBMD_ENABLED
+/**
+ * @brief Compute the hash bucket of a B/IPv4 address and port
+ * @param addr - B/IPv4 address
+ * @param bits - number of bits in the hash table size
+ * @return hash bucket index
+ */
+static unsigned bbmd_address_hash(const BACNET_IP_ADDRESS *addr, unsigned bits)
+{
+    uint32_t key;
+
+    key = ((uint32_t)addr->address[0] << 24) |
+        ((uint32_t)addr->address[1] << 16) |
+        ((uint32_t)addr->address[2] << 8) | (uint32_t)addr->address[3];
+    key ^= ((uint32_t)addr->port << 16) | addr->port;
+    /* Fibonacci hashing - keep the well mixed upper bits */
+    key *= 2654435761UL;
+
+    return (unsigned)((key & 0xFFFFFFFFUL) >> (32 - bits));
+}
+
+/**
+ * @brief Find the FDT hash bucket for a B/IPv4 address
+ * @param addr - B/IPv4 address
+ * @return bucket holding the address, or the empty bucket where
+ *  the address would be inserted
+ */
+static unsigned bbmd_fdt_hash_bucket(const BACNET_IP_ADDRESS *addr)
+{
+    unsigned bucket;
+    uint16_t index;
+
+    bucket = bbmd_address_hash(addr, FDT_HASH_BITS);
+    for (;;) {
+        index = FDT_Hash[bucket];
+        if (index == BBMD_INDEX_NONE) {
+            break;
+        }
+        if (!bvlc_address_different(&FD_Table[index].dest_address, addr)) {
+            break;
+        }
+        bucket = (bucket + 1) & (FDT_HASH_SIZE - 1);
+    }
+
+    return bucket;
+}
+
+/**
+ * @brief Remove a bucket from the FDT hash, shifting back any entries
+ *  of the probe sequence that follow it so that no tombstones are needed.
+ * @param bucket - bucket to be emptied
+ */
+static void bbmd_fdt_hash_remove(unsigned bucket)
+{
+    unsigned next = bucket;
+    unsigned home;
+    uint16_t index;
+
+    for (;;) {
+        next = (next + 1) & (FDT_HASH_SIZE - 1);
+        index = FDT_Hash[next];
+        if (index == BBMD_INDEX_NONE) {
+            break;
+        }
+        home = bbmd_address_hash(&FD_Table[index].dest_address, FDT_HASH_BITS);
+        /* move the entry back if its home is not cyclically
+           within (bucket, next] */
+        if (((next - home) & (FDT_HASH_SIZE - 1)) >=
+            ((next - bucket) & (FDT_HASH_SIZE - 1))) {
+            FDT_Hash[bucket] = index;
+            bucket = next;
+        }
+    }
+    FDT_Hash[bucket] = BBMD_INDEX_NONE;
+}
+
+/**
+ * @brief Swap two positions of the FDT expiry queue
+ * @param a - queue position
+ * @param b - queue position
+ */
+static void bbmd_fdt_queue_swap(uint16_t a, uint16_t b)
+{
+    uint16_t index = FDT_Queue[a];
+
+    FDT_Queue[a] = FDT_Queue[b];
+    FDT_Queue[b] = index;
+    FDT_Queue_Position[FDT_Queue[a]] = a;
+    FDT_Queue_Position[FDT_Queue[b]] = b;
+}
+
+/**
+ * @brief Restore the expiry queue ordering around one position
+ * @param position - queue position whose deadline has changed
+ */
+static void bbmd_fdt_queue_fix(uint16_t position)
+{
+    uint16_t parent, child;
+
+    while (position > 0) {
+        parent = (position - 1) / 2;
+        if (FDT_Deadline[FDT_Queue[parent]] <=
+            FDT_Deadline[FDT_Queue[position]]) {
+            break;
+        }
+        bbmd_fdt_queue_swap(parent, position);
+        position = parent;
+    }
+    for (;;) {
+        child = (2 * position) + 1;
+        if (child >= FDT_Queue_Count) {
+            break;
+        }
+        if (((child + 1) < FDT_Queue_Count) &&
+            (FDT_Deadline[FDT_Queue[child + 1]] <
+             FDT_Deadline[FDT_Queue[child]])) {
+            child++;
+        }
+        if (FDT_Deadline[FDT_Queue[position]] <=
+            FDT_Deadline[FDT_Queue[child]]) {
+            break;
+        }
+        bbmd_fdt_queue_swap(position, child);
+        position = child;
+    }
+}
+
+/**
+ * @brief Set the time-to-live of an FDT entry and its expiry deadline
+ * @param index - FD_Table index
+ * @param ttl_seconds - Time-to-Live T, in seconds
+ */
+static void bbmd_fdt_entry_ttl_set(uint16_t index, uint16_t ttl_seconds)
+{
+    BACNET_IP_FOREIGN_DEVICE_TABLE_ENTRY *fdt_entry = &FD_Table[index];
+
+    fdt_entry->ttl_seconds = ttl_seconds;
+    /* Upon receipt of a BVLL Register-Foreign-Device message,
+       a BBMD shall start a timer with a value equal to the
+       Time-to-Live parameter supplied plus a fixed grace
+       period of 30 seconds. */
+    if (ttl_seconds < (UINT16_MAX - 30)) {
+        fdt_entry->ttl_seconds_remaining = ttl_seconds + 30;
+    } else {
+        fdt_entry->ttl_seconds_remaining = UINT16_MAX;
+    }
+    FDT_Deadline[index] =
+        BBMD_Uptime_Seconds + fdt_entry->ttl_seconds_remaining;
+}
+
+/**
+ * @brief Remove an active entry from the FDT, its hash and its queue
+ * @param index - FD_Table index
+ */
+static void bbmd_fdt_entry_remove(uint16_t index)
+{
+    uint16_t position = FDT_Queue_Position[index];
+
+    bbmd_fdt_hash_remove(bbmd_fdt_hash_bucket(&FD_Table[index].dest_address));
+    FD_Table[index].valid = false;
+    FD_Table[index].ttl_seconds_remaining = 0;
+    /* move the last active entry into the hole; the removed index
+       becomes the first free index beyond the heap */
+    FDT_Queue_Count--;
+    if (position != FDT_Queue_Count) {
+        bbmd_fdt_queue_swap(position, FDT_Queue_Count);
+        bbmd_fdt_queue_fix(position);
+    }
+}
+
+/**
+ * @brief Add or renew an entry in the Foreign-Device-Table
+ * @param addr - B/IPv4 address to be added
+ * @param ttl_seconds - Time-to-Live T, in seconds
+ * @return true if the Foreign Device entry was added or already exists
+ */
+static bool
+bbmd_fdt_entry_add(const BACNET_IP_ADDRESS *addr, uint16_t ttl_seconds)
+{
+    unsigned bucket;
+    uint16_t index;
+
+    bucket = bbmd_fdt_hash_bucket(addr);
+    index = FDT_Hash[bucket];
+    if (index != BBMD_INDEX_NONE) {
+        /* am I here already?  If so, update my time to live... */
+        bbmd_fdt_entry_ttl_set(index, ttl_seconds);
+        bbmd_fdt_queue_fix(FDT_Queue_Position[index]);
+        return true;
+    }
+    if (FDT_Queue_Count >= MAX_FD_ENTRIES) {
+        return false;
+    }
+    /* take the first free index, which already sits at the end of the heap */
+    index = FDT_Queue[FDT_Queue_Count];
+    FDT_Queue_Count++;
+    bvlc_address_copy(&FD_Table[index].dest_address, addr);
+    FD_Table[index].valid = true;
+    bbmd_fdt_entry_ttl_set(index, ttl_seconds);
+    FDT_Hash[bucket] = index;
+    bbmd_fdt_queue_fix(FDT_Queue_Position[index]);
+
+    return true;
+}
+
+/**
+ * @brief Delete an entry in the Foreign-Device-Table
+ * @param addr - B/IPv4 address to be deleted
+ * @return true if the Foreign Device entry was found and removed.
+ */
+static bool bbmd_fdt_entry_delete(const BACNET_IP_ADDRESS *addr)
+{
+    uint16_t index;
+
+    index = FDT_Hash[bbmd_fdt_hash_bucket(addr)];
+    if (index == BBMD_INDEX_NONE) {
+        return false;
+    }
+    bbmd_fdt_entry_remove(index);
+
+    return true;
+}
+
+/**
+ * @brief Update the ttl_seconds_remaining of each active FDT entry
+ *  from its deadline. Called only where the FDT is read, so the
+ *  maintenance timer does not walk the table.
+ */
+static void bbmd_fdt_remaining_update(void)
+{
+    uint16_t position, index;
+
+    for (position = 0; position < FDT_Queue_Count; position++) {
+        index = FDT_Queue[position];
+        FD_Table[index].ttl_seconds_remaining =
+            (uint16_t)(FDT_Deadline[index] - BBMD_Uptime_Seconds);
+    }
+}
+
+/**
+ * @brief Advance the FDT clock and clear the entries whose timer expired.
+ *  Only the expired entries are visited.
+ * @param seconds - number of elapsed seconds since the last call
+ */
+static void bbmd_fdt_expire(uint16_t seconds)
+{
+    uint16_t index;
+
+    BBMD_Uptime_Seconds += seconds;
+    while (FDT_Queue_Count > 0) {
+        index = FDT_Queue[0];
+        if ((int32_t)(FDT_Deadline[index] - BBMD_Uptime_Seconds) > 0) {
+            break;
+        }
+        debug_print_bip("FDT Entry Expired", &FD_Table[index].dest_address);
+        bbmd_fdt_entry_remove(index);
+    }
+}
+
+/**
+ * @brief Rebuild the FDT hash and expiry queue from the FDT entries
+ */
+static void bbmd_fdt_index_rebuild(void)
+{
+    uint16_t index, position;
+    unsigned bucket;
+
+    for (bucket = 0; bucket < FDT_HASH_SIZE; bucket++) {
+        FDT_Hash[bucket] = BBMD_INDEX_NONE;
+    }
+    FDT_Queue_Count = 0;
+    for (index = 0; index < MAX_FD_ENTRIES; index++) {
+        if (FD_Table[index].valid && FD_Table[index].ttl_seconds_remaining) {
+            bucket = bbmd_fdt_hash_bucket(&FD_Table[index].dest_address);
+            if (FDT_Hash[bucket] != BBMD_INDEX_NONE) {
+                /* duplicate address - keep the first entry */
+                FD_Table[index].valid = false;
+                continue;
+            }
+            FDT_Hash[bucket] = index;
+            FDT_Deadline[index] =
+                BBMD_Uptime_Seconds + FD_Table[index].ttl_seconds_remaining;
+            FDT_Queue[FDT_Queue_Count] = index;
+            FDT_Queue_Position[index] = FDT_Queue_Count;
+            FDT_Queue_Count++;
+        } else {
+            FD_Table[index].valid = false;
+        }
+    }
+    /* the free indices follow the active ones */
+    position = FDT_Queue_Count;
+    for (index = 0; index < MAX_FD_ENTRIES; index++) {
+        if (!FD_Table[index].valid) {
+            FDT_Queue[position] = index;
+            FDT_Queue_Position[index] = position;
+            position++;
+        }
+    }
+    for (index = FDT_Queue_Count / 2; index > 0; index--) {
+        bbmd_fdt_queue_fix(index - 1);
+    }
+}
+
+/**
+ * @brief Rebuild the BDT hash from the BDT entries
+ */
+static void bbmd_bdt_index_rebuild(void)
+{
+    uint16_t index, other;
+    unsigned bucket;
+
+    for (bucket = 0; bucket < BDT_HASH_SIZE; bucket++) {
+        BDT_Hash[bucket] = BBMD_INDEX_NONE;
+    }
+    for (index = 0; index < MAX_BBMD_ENTRIES; index++) {
+        if (!BBMD_Table[index].valid) {
+            continue;
+        }
+        bucket =
+            bbmd_address_hash(&BBMD_Table[index].dest_address, BDT_HASH_BITS);
+        for (;;) {
+            other = BDT_Hash[bucket];
+            if ((other == BBMD_INDEX_NONE) ||
+                !bvlc_address_different(
+                    &BBMD_Table[other].dest_address,
+                    &BBMD_Table[index].dest_address)) {
+                break;
+            }
+            bucket = (bucket + 1) & (BDT_HASH_SIZE - 1);
+        }
+        if (other == BBMD_INDEX_NONE) {
+            BDT_Hash[bucket] = index;
+        }
+    }
+    BDT_Hash_Valid = true;
+}
+
+/**
+ * @brief Look up a BDT entry by its B/IPv4 address
+ * @param addr - B/IPv4 address of the BDT entry
+ * @return the first valid BDT entry with the address, or NULL
+ */
+static BACNET_IP_BROADCAST_DISTRIBUTION_TABLE_ENTRY *
+bbmd_bdt_entry_find(const BACNET_IP_ADDRESS *addr)
+{
+    BACNET_IP_BROADCAST_DISTRIBUTION_TABLE_ENTRY *bdt_entry = NULL;
+    unsigned bucket;
+    uint16_t index;
+
+    if (!BDT_Hash_Valid) {
+        bbmd_bdt_index_rebuild();
+    }
+    bucket = bbmd_address_hash(addr, BDT_HASH_BITS);
+    for (;;) {
+        index = BDT_Hash[bucket];
+        if ((index == BBMD_INDEX_NONE) ||
+            !bvlc_address_different(&BBMD_Table[index].dest_address, addr)) {
+            break;
+        }
+        bucket = (bucket + 1) & (BDT_HASH_SIZE - 1);
+    }
+    if ((index != BBMD_INDEX_NONE) && BBMD_Table[index].valid) {
+        bdt_entry = &BBMD_Table[index];
+    }
+
+    return bdt_entry;
+}
+
 /* Define BBMD_BACKUP_FILE if the contents of the BDT
  * (broadcast distribution table) are to be stored in
  * a backup file, so the contents are not lost across
@@ -233,6 +639,7 @@ void bvlc_bdt_restore_local(void)
                 BBMD_Table, BBMD_Table_tmp,
                 sizeof(BACNET_IP_BROADCAST_DISTRIBUTION_TABLE_ENTRY) *
                     MAX_BBMD_ENTRIES);
+            BDT_Hash_Valid = false;
         }
     }
 }
@@ -253,7 +660,7 @@ void bvlc_bdt_restore_local(void)
 void bvlc_maintenance_timer(uint16_t seconds)
 {
 #if BBMD_ENABLED
-    bvlc_foreign_device_table_maintenance_timer(&FD_Table[0], seconds);
+    bbmd_fdt_expire(seconds);
 #else
     (void)seconds;
 #endif
@@ -292,94 +699,118 @@ static bool bbmd_bdt_member_mask_is_unicast(const BACNET_IP_ADDRESS *addr)
     bool unicast = false;
     BACNET_IP_ADDRESS my_addr = { 0 };
     BACNET_IP_BROADCAST_DISTRIBUTION_MASK unicast_mask = { 0 };
-    BACNET_IP_ADDRESS *dest_address = NULL;
-    BACNET_IP_BROADCAST_DISTRIBUTION_MASK *broadcast_mask = NULL;
-    unsigned i = 0; /* loop counter */
+    BACNET_IP_BROADCAST_DISTRIBUTION_TABLE_ENTRY *bdt_entry = NULL;
 
     bip_get_addr(&my_addr);
     bvlc_broadcast_distribution_mask_from_host(&unicast_mask, 0xFFFFFFFFL);
-    for (i = 0; i < MAX_BBMD_ENTRIES; i++) {
-        if (BBMD_Table[i].valid) {
-            dest_address = &BBMD_Table[i].dest_address;
-            broadcast_mask = &BBMD_Table[i].broadcast_mask;
-            if (bvlc_address_different(&my_addr, dest_address) &&
-                !bvlc_address_different(addr, dest_address) &&
-                !bvlc_broadcast_distribution_mask_different(
-                    broadcast_mask, &unicast_mask)) {
-                unicast = true;
-                break;
-            }
-        }
+    bdt_entry = bbmd_bdt_entry_find(addr);
+    if (bdt_entry &&
+        bvlc_address_different(&my_addr, &bdt_entry->dest_address) &&
+        !bvlc_broadcast_distribution_mask_different(
+            &bdt_entry->broadcast_mask, &unicast_mask)) {
+        unicast = true;
     }
 
     return unicast;
 }
 
-/** Send a BVLL Forwarded-NPDU message on its local IP subnet using
- * the local B/IP broadcast address as the destination address.
+/** Build a BVLL Forwarded-NPDU in place by encoding its header into the
+ * headroom in front of the NPDU. When the packet does not have enough
+ * headroom, the NPDU is copied once into the BBMD forwarding buffer.
+ * The same Forwarded-NPDU is then sent to the local subnet, the BDT
+ * and the FDT without being encoded again.
  *
+ * @param pkt - packet holding the NPDU; returns holding the Forwarded-NPDU
  * @param bip_src - source IP address and UDP port
- * @param npdu - returns the NPDU
- * @param max_npdu - amount of space available in the NPDU
- * @param npdu_length - reported length of the NPDU
- * @return number of bytes encoded in the Forwarded NPDU
+ * @param original - was the message an original (not forwarded)
+ * @return number of bytes in the Forwarded NPDU, or 0 if it didn't fit
  */
-static uint16_t bbmd_forward_npdu(
-    const BACNET_IP_ADDRESS *bip_src, const uint8_t *npdu, uint16_t npdu_length)
+static uint16_t bbmd_forwarded_npdu_prepare(
+    BACNET_PACKET_BUFFER *pkt, const BACNET_IP_ADDRESS *bip_src, bool original)
 {
-    BACNET_IP_ADDRESS broadcast_address = { 0 };
-    uint8_t mtu[BIP_MPDU_MAX] = { 0 };
-    uint16_t mtu_len = 0;
+    uint8_t *npdu = pktbuf_data(pkt);
+    uint16_t npdu_len = pktbuf_length(pkt);
+    uint8_t *header = NULL;
 
-    mtu_len = (uint16_t)bvlc_encode_forwarded_npdu(
-        &mtu[0], (uint16_t)sizeof(mtu), bip_src, npdu, npdu_length);
-    if (mtu_len > 0) {
-        bip_get_broadcast_addr(&broadcast_address);
-        bip_send_mpdu(&broadcast_address, mtu, mtu_len);
-        debug_printf("BVLC: Sent Forwarded-NPDU as local broadcast.\n");
+    if (!npdu) {
+        return 0;
     }
+    if (pktbuf_headroom(pkt) < BVLC_FORWARDED_NPDU_HEADER_LEN) {
+        if (npdu_len > (sizeof(BBMD_Forward_Buffer) -
+                        BVLC_FORWARDED_NPDU_HEADER_LEN)) {
+            return 0;
+        }
+        memmove(
+            &BBMD_Forward_Buffer[BVLC_FORWARDED_NPDU_HEADER_LEN], npdu,
+            npdu_len);
+        (void)pktbuf_attach(
+            pkt, BBMD_Forward_Buffer, sizeof(BBMD_Forward_Buffer),
+            BVLC_FORWARDED_NPDU_HEADER_LEN, npdu_len);
+    }
+    header = pktbuf_push(pkt, BVLC_FORWARDED_NPDU_HEADER_LEN);
+    /* If we are forwarding an original broadcast message and the NAT
+     * handling is enabled, change the source address to NAT routers
+     * global IP address so the recipient can reply (local IP address
+     * is not accessible from internet side.
+     *
+     * If we are forwarding a message from peer BBMD or foreign device
+     * or the NAT handling is disabled, leave the source address as is.
+     */
+    if (BVLC_NAT_Handling && original) {
+        bip_src = &BVLC_Global_Address;
+    }
+    (void)bvlc_encode_forwarded_npdu_header(
+        header, BVLC_FORWARDED_NPDU_HEADER_LEN, bip_src, npdu_len);
+
+    return pktbuf_length(pkt);
+}
+
+/** Wrap a received NPDU, including the receive headroom and the BVLC
+ * header in front of it, in a packet buffer.
+ *
+ * @param pkt - packet buffer structure to initialize
+ * @param mtu - the received BVLL message
+ * @param offset - offset of the NPDU in the BVLL message
+ * @param npdu_len - length of the NPDU
+ */
+static void bbmd_received_npdu_attach(
+    BACNET_PACKET_BUFFER *pkt, uint8_t *mtu, uint16_t offset, uint16_t npdu_len)
+{
+    uint16_t headroom = BVLC_Receive_Headroom + offset;
 
-    return mtu_len;
+    (void)pktbuf_attach(
+        pkt, &mtu[offset] - headroom, headroom + npdu_len, headroom, npdu_len);
+}
+
+/** Send a BVLL Forwarded-NPDU message on its local IP subnet using
+ * the local B/IP broadcast address as the destination address.
+ *
+ * @param mtu - the Forwarded-NPDU
+ * @param mtu_len - length of the Forwarded-NPDU
+ */
+static void bbmd_forward_npdu(const uint8_t *mtu, uint16_t mtu_len)
+{
+    BACNET_IP_ADDRESS broadcast_address = { 0 };
+
+    bip_get_broadcast_addr(&broadcast_address);
+    bip_send_mpdu(&broadcast_address, mtu, mtu_len);
+    debug_printf("BVLC: Sent Forwarded-NPDU as local broadcast.\n");
 }
 
 /** Sends all Broadcast Devices a Forwarded NPDU
  *
  * @param bip_src - source IP address and UDP port
- * @param npdu - returns the NPDU
- * @param max_npdu - amount of space available in the NPDU
- * @param npdu_length - reported length of the NPDU
- * @param original - was the message an original (not forwarded)
- * @return number of bytes encoded in the Forwarded NPDU
+ * @param mtu - the Forwarded-NPDU
+ * @param mtu_len - length of the Forwarded-NPDU
  */
-static uint16_t bbmd_bdt_forward_npdu(
-    const BACNET_IP_ADDRESS *bip_src,
-    const uint8_t *npdu,
-    uint16_t npdu_length,
-    bool original)
+static void bbmd_bdt_forward_npdu(
+    const BACNET_IP_ADDRESS *bip_src, const uint8_t *mtu, uint16_t mtu_len)
 {
-    uint8_t mtu[BIP_MPDU_MAX] = { 0 };
-    uint16_t mtu_len = 0;
     unsigned i = 0; /* loop counter */
     BACNET_IP_ADDRESS bip_dest = { 0 };
     BACNET_IP_ADDRESS my_addr = { 0 };
 
     bip_get_addr(&my_addr);
-    /* If we are forwarding an original broadcast message and the NAT
-     * handling is enabled, change the source address to NAT routers
-     * global IP address so the recipient can reply (local IP address
-     * is not accessible from internet side.
-     *
-     * If we are forwarding a message from peer BBMD or foreign device
-     * or the NAT handling is disabled, leave the source address as is.
-     */
-    if (BVLC_NAT_Handling && original) {
-        mtu_len = (uint16_t)bvlc_encode_forwarded_npdu(
-            &mtu[0], (uint16_t)sizeof(mtu), &BVLC_Global_Address, npdu,
-            npdu_length);
-    } else {
-        mtu_len = (uint16_t)bvlc_encode_forwarded_npdu(
-            &mtu[0], (uint16_t)sizeof(mtu), bip_src, npdu, npdu_length);
-    }
     /* loop through the BDT and send one to each entry */
     for (i = 0; i < MAX_BBMD_ENTRIES; i++) {
         if (BBMD_Table[i].valid) {
@@ -405,75 +836,46 @@ static uint16_t bbmd_bdt_forward_npdu(
             debug_print_bip("BDT Send Forwarded-NPDU", &bip_dest);
         }
     }
-
-    return mtu_len;
 }
 
 /** Sends all Foreign Devices a Forwarded NPDU
  *
  * @param bip_src - source IP address and UDP port
- * @param npdu - returns the NPDU
- * @param max_npdu - amount of space available in the NPDU
- * @param npdu_length - reported length of the NPDU
- * @param original - was the message an original (not forwarded)
- * @return number of bytes encoded in the Forwarded NPDU
+ * @param mtu - the Forwarded-NPDU
+ * @param mtu_len - length of the Forwarded-NPDU
  */
-static uint16_t bbmd_fdt_forward_npdu(
-    const BACNET_IP_ADDRESS *bip_src,
-    const uint8_t *npdu,
-    uint16_t npdu_length,
-    bool original)
+static void bbmd_fdt_forward_npdu(
+    const BACNET_IP_ADDRESS *bip_src, const uint8_t *mtu, uint16_t mtu_len)
 {
-    uint8_t mtu[BIP_MPDU_MAX] = { 0 };
-    uint16_t mtu_len = 0;
-    unsigned i = 0; /* loop counter */
+    uint16_t position = 0; /* loop counter */
+    uint16_t index = 0;
     BACNET_IP_ADDRESS bip_dest = { 0 };
     BACNET_IP_ADDRESS my_addr = { 0 };
 
     bip_get_addr(&my_addr);
-    /* If we are forwarding an original broadcast message and the NAT
-     * handling is enabled, change the source address to NAT routers
-     * global IP address so the recipient can reply (local IP address
-     * is not accessible from internet side.
-     *
-     * If we are forwarding a message from peer BBMD or foreign device
-     * or the NAT handling is disabled, leave the source address as is.
-     */
-    if (BVLC_NAT_Handling && original) {
-        mtu_len = (uint16_t)bvlc_encode_forwarded_npdu(
-            &mtu[0], (uint16_t)sizeof(mtu), &BVLC_Global_Address, npdu,
-            npdu_length);
-    } else {
-        mtu_len = (uint16_t)bvlc_encode_forwarded_npdu(
-            &mtu[0], (uint16_t)sizeof(mtu), bip_src, npdu, npdu_length);
-    }
-
-    /* loop through the FDT and send one to each entry */
-    for (i = 0; i < MAX_FD_ENTRIES; i++) {
-        if (FD_Table[i].valid && FD_Table[i].ttl_seconds_remaining) {
-            bvlc_address_copy(&bip_dest, &FD_Table[i].dest_address);
-            if (!bvlc_address_different(&bip_dest, &my_addr)) {
-                /* don't forward to our selves */
-                continue;
-            }
-            if (!bvlc_address_different(&bip_dest, bip_src)) {
-                /* don't forward back to origin */
+    /* loop through the active FDT entries and send one to each entry */
+    for (position = 0; position < FDT_Queue_Count; position++) {
+        index = FDT_Queue[position];
+        bvlc_address_copy(&bip_dest, &FD_Table[index].dest_address);
+        if (!bvlc_address_different(&bip_dest, &my_addr)) {
+            /* don't forward to our selves */
+            continue;
+        }
+        if (!bvlc_address_different(&bip_dest, bip_src)) {
+            /* don't forward back to origin */
+            continue;
+        }
+        if (BVLC_NAT_Handling) {
+            if (bvlc_address_different(&bip_dest, &BVLC_Global_Address)) {
+                /* NAT router port forwards BACnet packets from global IP.
+                   Packets sent to that global IP by us would end up back,
+                   creating a loop. */
                 continue;
             }
-            if (BVLC_NAT_Handling) {
-                if (bvlc_address_different(&bip_dest, &BVLC_Global_Address)) {
-                    /* NAT router port forwards BACnet packets from global IP.
-                       Packets sent to that global IP by us would end up back,
-                       creating a loop. */
-                    continue;
-                }
-            }
-            bip_send_mpdu(&bip_dest, mtu, mtu_len);
-            debug_print_bip("FDT Send Forwarded-NPDU", &bip_dest);
         }
+        bip_send_mpdu(&bip_dest, mtu, mtu_len);
+        debug_print_bip("FDT Send Forwarded-NPDU", &bip_dest);
     }
-
-    return mtu_len;
 }
 
 /** Prints the Read-BDT-Ack NPDU
@@ -598,6 +1000,8 @@ int bvlc_send_pdu(
     uint16_t mtu_len = 0;
 #if BBMD_ENABLED
     BACNET_IP_ADDRESS bip_src = { 0 };
+    BACNET_PACKET_BUFFER pkt = { 0 };
+    uint16_t fwd_len = 0;
 #endif
 
     /* this datalink doesn't need to know the npdu data */
@@ -620,8 +1024,18 @@ int bvlc_send_pdu(
 #if BBMD_ENABLED
             if (mtu_len > 0) {
                 bip_get_addr(&bip_src);
-                (void)bbmd_fdt_forward_npdu(&bip_src, pdu, pdu_len, true);
-                (void)bbmd_bdt_forward_npdu(&bip_src, pdu, pdu_len, true);
+                /* encode the Forwarded-NPDU once for the BDT and FDT */
+                (void)pktbuf_init(
+                    &pkt, BBMD_Forward_Buffer, sizeof(BBMD_Forward_Buffer),
+                    BVLC_FORWARDED_NPDU_HEADER_LEN);
+                if (pktbuf_append(&pkt, pdu, (uint16_t)pdu_len)) {
+                    fwd_len =
+                        bbmd_forwarded_npdu_prepare(&pkt, &bip_src, true);
+                }
+                if (fwd_len > 0) {
+                    bbmd_fdt_forward_npdu(&bip_src, pktbuf_data(&pkt), fwd_len);
+                    bbmd_bdt_forward_npdu(&bip_src, pktbuf_data(&pkt), fwd_len);
+                }
             }
 #endif
         }
@@ -863,6 +1277,8 @@ int bvlc_bbmd_enabled_handler(
     uint16_t ttl_seconds = 0;
     BACNET_IP_ADDRESS fwd_address = { 0 };
     BACNET_IP_ADDRESS broadcast_address = { 0 };
+    BACNET_PACKET_BUFFER pkt = { 0 };
+    uint16_t fwd_len = 0;
 
     header_len =
         bvlc_decode_header(mtu, mtu_len, &message_type, &message_length);
@@ -901,6 +1317,7 @@ int bvlc_bbmd_enabled_handler(
             debug_print_bip("Received Write-BDT", addr);
             function_len = bvlc_decode_write_broadcast_distribution_table(
                 pdu, pdu_len, &BBMD_Table[0]);
+            BDT_Hash_Valid = false;
             if (function_len > 0) {
                 /* BDT changed! Save backup to file */
                 bvlc_bdt_backup_local();
@@ -978,9 +1395,9 @@ int bvlc_bbmd_enabled_handler(
                     message shall be unicast to each foreign device in
                     the BBMD's FDT. */
                 offset = header_len + function_len - npdu_len;
-                npdu = &mtu[offset];
-                (void)bbmd_fdt_forward_npdu(
-                    &fwd_address, npdu, npdu_len, false);
+                /* the received message already is that Forwarded-NPDU,
+                   so it is sent on as-is */
+                bbmd_fdt_forward_npdu(&fwd_address, mtu, offset + npdu_len);
                 /* prepare the message for me! */
                 bvlc_ip_address_to_bacnet_local(src, &fwd_address);
                 debug_print_npdu("Forwarded-NPDU", offset, npdu_len);
@@ -1007,8 +1424,7 @@ int bvlc_bbmd_enabled_handler(
             function_len =
                 bvlc_decode_register_foreign_device(pdu, pdu_len, &ttl_seconds);
             if (function_len) {
-                if (bvlc_foreign_device_table_entry_add(
-                        &FD_Table[0], addr, ttl_seconds)) {
+                if (bbmd_fdt_entry_add(addr, ttl_seconds)) {
                     result_code = BVLC_RESULT_SUCCESSFUL_COMPLETION;
                     send_result = true;
                 } else {
@@ -1028,6 +1444,7 @@ int bvlc_bbmd_enabled_handler(
                it shall return a BVLC-Result message to the originating device
                with a result code of X'0040' indicating that the read attempt
                has failed. */
+            bbmd_fdt_remaining_update();
             BVLC_Buffer_Len = bvlc_encode_read_foreign_device_table_ack(
                 BVLC_Buffer, sizeof(BVLC_Buffer), &FD_Table[0]);
             if (BVLC_Buffer_Len > 0) {
@@ -1058,8 +1475,7 @@ int bvlc_bbmd_enabled_handler(
             function_len =
                 bvlc_decode_delete_foreign_device(pdu, pdu_len, &fwd_address);
             if (function_len > 0) {
-                if (bvlc_foreign_device_table_entry_delete(
-                        &FD_Table[0], &fwd_address)) {
+                if (bbmd_fdt_entry_delete(&fwd_address)) {
                     result_code = BVLC_RESULT_SUCCESSFUL_COMPLETION;
                     send_result = true;
                 } else {
@@ -1088,10 +1504,13 @@ int bvlc_bbmd_enabled_handler(
                it shall return a BVLC-Result message to the foreign device
                with a result code of X'0060' indicating that the forwarding
                attempt was unsuccessful */
-            npdu_len = bbmd_forward_npdu(addr, pdu, pdu_len);
-            if (npdu_len > 0) {
-                (void)bbmd_fdt_forward_npdu(addr, pdu, pdu_len, false);
-                (void)bbmd_bdt_forward_npdu(addr, pdu, pdu_len, false);
+            bbmd_received_npdu_attach(&pkt, mtu, header_len, pdu_len);
+            fwd_len = bbmd_forwarded_npdu_prepare(&pkt, addr, false);
+            if (fwd_len > 0) {
+                npdu = pktbuf_data(&pkt);
+                bbmd_forward_npdu(npdu, fwd_len);
+                bbmd_fdt_forward_npdu(addr, npdu, fwd_len);
+                bbmd_bdt_forward_npdu(addr, npdu, fwd_len);
             } else {
                 result_code = BVLC_RESULT_DISTRIBUTE_BROADCAST_TO_NETWORK_NAK;
                 send_result = true;
@@ -1156,8 +1575,14 @@ int bvlc_bbmd_enabled_handler(
                     debug_print_string("Dropped Original-Broadcast-NPDU: "
                                        "Confirmed Service!");
                 } else {
-                    (void)bbmd_fdt_forward_npdu(addr, npdu, npdu_len, true);
-                    (void)bbmd_bdt_forward_npdu(addr, npdu, npdu_len, true);
+                    bbmd_received_npdu_attach(&pkt, mtu, offset, npdu_len);
+                    fwd_len = bbmd_forwarded_npdu_prepare(&pkt, addr, true);
+                    if (fwd_len > 0) {
+                        bbmd_fdt_forward_npdu(
+                            addr, pktbuf_data(&pkt), fwd_len);
+                        bbmd_bdt_forward_npdu(
+                            addr, pktbuf_data(&pkt), fwd_len);
+                    }
                     debug_print_npdu(
                         "Original-Broadcast-NPDU", offset, npdu_len);
                 }
@@ -1255,6 +1680,22 @@ void bvlc_bbmd_accept_fd_registrations_set(bool flag)
     BBMD_Accept_FD_Registrations = flag;
 }
 
+/**
+ * @brief Declare how many writable bytes the datalink reserves in front
+ *  of each BVLL message passed to bvlc_handler(). With at least
+ *  BVLC_RECEIVE_HEADROOM bytes, the BBMD encodes Forwarded-NPDU headers
+ *  in place instead of copying the NPDU. The bytes in front of the NPDU,
+ *  including the received BVLC header, may be overwritten.
+ * @note The receive tasks reserve the headroom in front of the buffer
+ *  they give datalink_receive(), which bip_receive() passes on to
+ *  bvlc_handler() in place.
+ * @param octets - number of writable bytes in front of the BVLL message
+ */
+void bvlc_receive_headroom_set(uint16_t octets)
+{
+    BVLC_Receive_Headroom = octets;
+}
+
 #if BBMD_CLIENT_ENABLED
 /** Register as a foreign device with the indicated BBMD.
  * @param bbmd_addr - IPv4 address of BBMD with which to register
@@ -1413,13 +1854,26 @@ void bvlc_set_function_code(uint8_t function_code)
 #if BBMD_ENABLED
 /**
  * @brief Get handle to foreign device table (FDT).
+ *  The remaining time-to-live of each entry is brought up to date on
+ *  each call, so call it again before reading the entries.
  * @return pointer to first entry of foreign device table
  */
 BACNET_IP_FOREIGN_DEVICE_TABLE_ENTRY *bvlc_fdt_list(void)
 {
+    bbmd_fdt_remaining_update();
+
     return &FD_Table[0];
 }
 
+/**
+ * @brief Rebuild the FDT index after the FDT entries were modified
+ *  through the handle from bvlc_fdt_list().
+ */
+void bvlc_fdt_list_changed(void)
+{
+    bbmd_fdt_index_rebuild();
+}
+
 /**
  * @brief Get handle to broadcast distribution table (BDT).
  * @return pointer to first entry of broadcast distribution table
@@ -1429,12 +1883,23 @@ BACNET_IP_BROADCAST_DISTRIBUTION_TABLE_ENTRY *bvlc_bdt_list(void)
     return &BBMD_Table[0];
 }
 
+/**
+ * @brief Drop the BDT index after the BDT entries were modified
+ *  through the handle from bvlc_bdt_list(). It is rebuilt by the
+ *  next lookup.
+ */
+void bvlc_bdt_list_changed(void)
+{
+    BDT_Hash_Valid = false;
+}
+
 /**
  * @brief Invalidate all entries in the broadcast distribution table (BDT).
  */
 void bvlc_bdt_list_clear(void)
 {
     bvlc_broadcast_distribution_table_valid_clear(&BBMD_Table[0]);
+    BDT_Hash_Valid = false;
     /* BDT changed! Save backup to file */
     bvlc_bdt_backup_local();
 }
@@ -1478,6 +1943,8 @@ void bvlc_init(void)
     bvlc_broadcast_distribution_table_link_array(
         &BBMD_Table[0], MAX_BBMD_ENTRIES);
     bvlc_foreign_device_table_link_array(&FD_Table[0], MAX_FD_ENTRIES);
+    bbmd_fdt_index_rebuild();
+    BDT_Hash_Valid = false;
 #else
     debug_print_string("Initializing (BBMD Disabled).");
 #endif
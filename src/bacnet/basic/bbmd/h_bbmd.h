@@ -107,6 +107,13 @@ bool bvlc_bbmd_accept_fd_registrations(void);
 BACNET_STACK_EXPORT
 void bvlc_bbmd_accept_fd_registrations_set(bool flag);
 
+/* Receive buffers may reserve this many bytes in front of each BVLL
+ * message, so that a Forwarded-NPDU header can replace the 4 octet
+ * Original-Broadcast-NPDU or Distribute-Broadcast-To-Network header. */
+#define BVLC_RECEIVE_HEADROOM (BVLC_FORWARDED_NPDU_HEADER_LEN - 4)
+BACNET_STACK_EXPORT
+void bvlc_receive_headroom_set(uint16_t octets);
+
 /* Local interface to manage BBMD.
  * The interface user needs to handle mutual exclusion if needed i.e.
  * BACnet packet is not being handled when the BBMD table is modified.
@@ -116,6 +123,11 @@ void bvlc_bbmd_accept_fd_registrations_set(bool flag);
 BACNET_STACK_EXPORT
 BACNET_IP_BROADCAST_DISTRIBUTION_TABLE_ENTRY *bvlc_bdt_list(void);
 
+/* Rebuild the broadcast distribution table index after the list
+   was modified */
+BACNET_STACK_EXPORT
+void bvlc_bdt_list_changed(void);
+
 /* Invalidate all entries in the broadcast distribution table */
 BACNET_STACK_EXPORT
 void bvlc_bdt_list_clear(void);
@@ -123,6 +135,10 @@ void bvlc_bdt_list_clear(void);
 /* Get foreign device table list */
 BACNET_IP_FOREIGN_DEVICE_TABLE_ENTRY *bvlc_fdt_list(void);
 
+/* Rebuild the foreign device table index after the list was modified */
+BACNET_STACK_EXPORT
+void bvlc_fdt_list_changed(void);
+
 /* Backup broadcast distribution table to a file.
  * Filename is the BBMD_BACKUP_FILE constant
  */
@@ -716,6 +716,62 @@ unsigned address_count(void)
     return count;
 }
 
+/**
+ * Determine the number of bytes in an encoded address binding, without
+ * encoding it.
+ *
+ * @param pMatch  Pointer to the bound cache entry.
+ *
+ * @return Count of bytes the entry occupies.
+ */
+static int address_entry_encoded_size(const struct Address_Cache_Entry *pMatch)
+{
+    int len;
+
+    len = bacnet_tag_encoded_size(BACNET_APPLICATION_TAG_OBJECT_ID, 4) + 4;
+    len += bacnet_unsigned_application_encoded_size(pMatch->address.net);
+    if (pMatch->address.len != 0) {
+        len += bacnet_octet_string_application_encoded_size(
+            pMatch->address.len);
+    } else {
+        len += bacnet_octet_string_application_encoded_size(
+            pMatch->address.mac_len);
+    }
+
+    return len;
+}
+
+/**
+ * Encode one address binding.
+ *
+ * @param apdu  Pointer to the encode buffer.
+ * @param pMatch  Pointer to the bound cache entry.
+ *
+ * @return Count of encoded bytes.
+ */
+static int address_entry_encode(
+    uint8_t *apdu, const struct Address_Cache_Entry *pMatch)
+{
+    int len;
+    BACNET_OCTET_STRING MAC_Address;
+
+    len = encode_application_object_id(apdu, OBJECT_DEVICE, pMatch->device_id);
+    len += encode_application_unsigned(&apdu[len], pMatch->address.net);
+    /* pick the appropriate type of entry from the cache */
+    if (pMatch->address.len != 0) {
+        /* BAC */
+        octetstring_init(
+            &MAC_Address, pMatch->address.adr, pMatch->address.len);
+    } else {
+        /* MAC */
+        octetstring_init(
+            &MAC_Address, pMatch->address.mac, pMatch->address.mac_len);
+    }
+    len += encode_application_octet_string(&apdu[len], &MAC_Address);
+
+    return len;
+}
+
 /**
  * Build a list of the current bindings for the device address binding
  * property. Basically encode the address list to be send out.
@@ -728,8 +784,8 @@ unsigned address_count(void)
 int address_list_encode(uint8_t *apdu, unsigned apdu_len)
 {
     int iLen = 0;
+    int iTemp = 0;
     struct Address_Cache_Entry *pMatch;
-    BACNET_OCTET_STRING MAC_Address;
     unsigned index;
 
     /* Look for matching address. */
@@ -737,39 +793,12 @@ int address_list_encode(uint8_t *apdu, unsigned apdu_len)
         pMatch = &Address_Cache[index];
         if ((pMatch->Flags & (BAC_ADDR_IN_USE | BAC_ADDR_BIND_REQ)) ==
             BAC_ADDR_IN_USE) {
-            iLen += encode_application_object_id(
-                &apdu[iLen], OBJECT_DEVICE, pMatch->device_id);
-            iLen +=
-                encode_application_unsigned(&apdu[iLen], pMatch->address.net);
-            if ((unsigned)iLen >= apdu_len) {
-                break;
-            }
-
-            /* pick the appropriate type of entry from the cache */
-
-            if (pMatch->address.len != 0) {
-                /* BAC */
-                if ((unsigned)(iLen + pMatch->address.len) >= apdu_len) {
-                    break;
-                }
-                octetstring_init(
-                    &MAC_Address, pMatch->address.adr, pMatch->address.len);
-                iLen +=
-                    encode_application_octet_string(&apdu[iLen], &MAC_Address);
-            } else {
-                /* MAC*/
-                if ((unsigned)(iLen + pMatch->address.mac_len) >= apdu_len) {
-                    break;
-                }
-                octetstring_init(
-                    &MAC_Address, pMatch->address.mac, pMatch->address.mac_len);
-                iLen +=
-                    encode_application_octet_string(&apdu[iLen], &MAC_Address);
-            }
             /* Any space left? */
-            if ((unsigned)iLen >= apdu_len) {
+            iTemp = address_entry_encoded_size(pMatch);
+            if ((unsigned)(iLen + iTemp) > apdu_len) {
                 break;
             }
+            iLen += address_entry_encode(&apdu[iLen], pMatch);
         }
     }
 
@@ -789,28 +818,19 @@ int address_list_encode(uint8_t *apdu, unsigned apdu_len)
  * We do assume the list cannot change whilst we are accessing it so would
  * not be multithread safe if there are other tasks that change the cache.
  *
- * We take the simple approach here to filling the buffer by taking a max   *
- * size for a single entry and then stopping if there is less than that
- * left in the buffer. You could build each entry in a separate buffer and
- * determine the exact length before copying but this is time consuming,
- * requires more memory and would probably only let you sqeeeze one more
- * entry in on occasion. The value is calculated as 5 bytes for the device
- * ID + 3 bytes for the network number and nine bytes for the MAC address
- * oct string to give 17 bytes (the minimum possible is 5 + 2 + 3 = 10).
+ * The exact size of each entry is known before it is encoded, so entries
+ * are encoded in place until the next one would not fit.
  *
  * @param apdu  Pointer to the encode buffer.
  * @param pRequest  Pointer to the read_range request structure.
  *
  * @return Bytes encoded.
  */
-#define ACACHE_MAX_ENC 17 /* Maximum size of encoded cache entry, see above */
-
 int rr_address_list_encode(uint8_t *apdu, BACNET_READ_RANGE_DATA *pRequest)
 {
     int iLen = 0;
     int32_t iTemp = 0;
     struct Address_Cache_Entry *pMatch = NULL;
-    BACNET_OCTET_STRING MAC_Address;
     uint32_t uiTotal = 0; /* Number of bound entries in the cache */
     uint32_t uiIndex = 0; /* Current entry number */
     uint32_t uiFirst = 0; /* Entry number we started encoding from */
@@ -917,7 +937,8 @@ int rr_address_list_encode(uint8_t *apdu, BACNET_READ_RANGE_DATA *pRequest)
 
     uiFirst = uiIndex; /* Record where we started from */
     while (uiIndex <= uiTarget) {
-        if (uiRemaining < ACACHE_MAX_ENC) {
+        iTemp = (int32_t)address_entry_encoded_size(pMatch);
+        if (uiRemaining < (uint32_t)iTemp) {
             /*
              * Can't fit any more in! We just set the result flag to say there
              * was more and drop out of the loop early
@@ -926,23 +947,7 @@ int rr_address_list_encode(uint8_t *apdu, BACNET_READ_RANGE_DATA *pRequest)
                 &pRequest->ResultFlags, RESULT_FLAG_MORE_ITEMS, true);
             break;
         }
-        iTemp = (int32_t)encode_application_object_id(
-            &apdu[iLen], OBJECT_DEVICE, pMatch->device_id);
-        iTemp += encode_application_unsigned(
-            &apdu[iLen + iTemp], pMatch->address.net);
-
-        /* pick the appropriate type of entry from the cache */
-        if (pMatch->address.len != 0) {
-            octetstring_init(
-                &MAC_Address, pMatch->address.adr, pMatch->address.len);
-            iTemp += encode_application_octet_string(
-                &apdu[iLen + iTemp], &MAC_Address);
-        } else {
-            octetstring_init(
-                &MAC_Address, pMatch->address.mac, pMatch->address.mac_len);
-            iTemp += encode_application_octet_string(
-                &apdu[iLen + iTemp], &MAC_Address);
-        }
+        iTemp = (int32_t)address_entry_encode(&apdu[iLen], pMatch);
         /* Reduce the remaining space */
         uiRemaining -= iTemp;
         /* and increase the length consumed */
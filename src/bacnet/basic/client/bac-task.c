@@ -49,6 +49,8 @@
 #include "../../../bacnet/datalink/dlenv.h"
 //#include "bacnet/basic/object/device.h"
 #include "../../../bacnet/basic/object/device.h"
+//#include "bacnet/basic/object/event_engine.h"
+#include "../../../bacnet/basic/object/event_engine.h"
 /* us */
 //#include "bacnet/basic/client/bac-rw.h"
 #include "../../../bacnet/basic/client/bac-rw.h"
@@ -57,8 +59,15 @@
 //#include "bacnet/basic/client/bac-task.h"
 #include "../../../bacnet/basic/client/bac-task.h"
 
+#if defined(BACDL_BIP) && BBMD_ENABLED
+/* room in front of each received BVLL message, so that the BBMD
+   forwards broadcasts without copying them */
+#define RX_HEADROOM BVLC_RECEIVE_HEADROOM
+#else
+#define RX_HEADROOM 0
+#endif
 /** Buffer used for receiving */
-static uint8_t Rx_Buf[MAX_MPDU];
+static uint8_t Rx_Buf[RX_HEADROOM + MAX_MPDU];
 /* task timer for various BACnet timeouts */
 static struct mstimer BACnet_Task_Timer;
 /* task timer for TSM timeouts */
@@ -81,10 +90,11 @@ void bacnet_task(void)
     }
     /* input */
     /* returns 0 bytes on timeout */
-    pdu_len = datalink_receive(&src, &Rx_Buf[0], MAX_MPDU, timeout_ms);
+    pdu_len =
+        datalink_receive(&src, &Rx_Buf[RX_HEADROOM], MAX_MPDU, timeout_ms);
     /* process */
     if (pdu_len) {
-        npdu_handler(&src, &Rx_Buf[0], pdu_len);
+        npdu_handler(&src, &Rx_Buf[RX_HEADROOM], pdu_len);
     }
     /* 1 second tasks */
     if (mstimer_expired(&BACnet_Task_Timer)) {
@@ -96,6 +106,12 @@ void bacnet_task(void)
     if (mstimer_expired(&BACnet_TSM_Timer)) {
         mstimer_reset(&BACnet_TSM_Timer);
         tsm_timer_milliseconds(mstimer_interval(&BACnet_TSM_Timer));
+#if BACNET_EVENT_OUTBOX_ENABLED
+        Event_Outbox_Timer(mstimer_interval(&BACnet_TSM_Timer));
+#endif
+#if BACNET_EVENT_ENGINE_ENABLED
+        event_engine_timer(mstimer_interval(&BACnet_TSM_Timer));
+#endif
     }
     bacnet_data_task();
 }
@@ -123,6 +139,14 @@ void bacnet_task_init(void)
     apdu_set_confirmed_handler(
         SERVICE_CONFIRMED_DEVICE_COMMUNICATION_CONTROL,
         handler_device_communication_control);
+#if BACNET_EVENT_OUTBOX_ENABLED
+    /* count only acknowledged event notifications as delivered */
+    apdu_set_confirmed_simple_ack_handler(
+        SERVICE_CONFIRMED_EVENT_NOTIFICATION, Event_Outbox_SimpleACK_Handler);
+#endif
+#if defined(BACDL_BIP) && BBMD_ENABLED
+    bvlc_receive_headroom_set(RX_HEADROOM);
+#endif
     bacnet_data_init();
     mstimer_set(&BACnet_Task_Timer, 1000);
     mstimer_set(&BACnet_TSM_Timer, 50);
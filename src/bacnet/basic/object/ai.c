@@ -30,6 +30,16 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/event_engine.h"
+#include "../../../bacnet/basic/object/event_engine.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
+//#include "bacnet/basic/object/fast_reply.h"
+#include "../../../bacnet/basic/object/fast_reply.h"
 //#include "bacnet/basic/sys/debug.h"
 #include "../../../bacnet/basic/sys/debug.h"
 /* me! */
@@ -120,6 +130,25 @@ static struct analog_input_descr *Analog_Input_Object_Index(int index)
 }
 #endif
 
+/**
+ * @brief Set the Present_Value and Status_Flags of an object in the
+ *  table of fast ReadProperty answers
+ * @param  object_instance - object-instance number of the object
+ * @param  pObject - the object
+ */
+static void Analog_Input_Fast_Reply_Update(
+    uint32_t object_instance, const struct analog_input_descr *pObject)
+{
+    fast_reply_real_set(
+        Object_Type, object_instance, PROP_PRESENT_VALUE,
+        pObject->Present_Value);
+    fast_reply_status_flags_set(
+        Object_Type, object_instance,
+        pObject->Event_State != EVENT_STATE_NORMAL,
+        pObject->Reliability != RELIABILITY_NO_FAULT_DETECTED, false,
+        pObject->Out_Of_Service);
+}
+
 /**
  * @brief Determines if a given object instance is valid
  * @param  object_instance - object-instance number of the object
@@ -237,8 +266,61 @@ void Analog_Input_Present_Value_Set(uint32_t object_instance, float value)
     pObject = Analog_Input_Object(object_instance);
     if (pObject) {
         Analog_Input_COV_Detect(pObject, value);
+        if (pObject->Present_Value != value) {
+            /* check the limits again */
+            event_engine_trigger(Object_Type, object_instance);
+        }
         pObject->Present_Value = value;
+        Analog_Input_Fast_Reply_Update(object_instance, pObject);
+    }
+}
+
+/**
+ * @brief For a given object instance-number, gets a view of the
+ *  object-name, without copying it
+ * @param  object_instance - object-instance number of the object
+ * @param  object_name - holds the view of the object-name
+ * @param  text - buffer for a default object-name, which must outlive
+ *  the view
+ * @param  text_size - size of the text buffer
+ * @return  true if object-name was retrieved
+ */
+static bool Analog_Input_Object_Name_View(
+    uint32_t object_instance,
+    BACNET_CHARACTER_STRING_VIEW *object_name,
+    char *text,
+    size_t text_size)
+{
+    struct analog_input_descr *pObject;
+
+    pObject = Analog_Input_Object(object_instance);
+    if (!pObject) {
+        return false;
     }
+
+    return characterstring_view_object_name(
+        object_name, pObject->Object_Name, "ANALOG INPUT %lu",
+        object_instance, text, text_size);
+}
+
+/**
+ * @brief Set the Object_Name of an object in the table of fast
+ *  ReadProperty answers
+ * @param  object_instance - object-instance number of the object
+ */
+static void Analog_Input_Fast_Reply_Name(uint32_t object_instance)
+{
+#if BACNET_MSTP_FAST_REPLY_ENABLED
+    BACNET_CHARACTER_STRING_VIEW name;
+    char name_text[32];
+
+    if (Analog_Input_Object_Name_View(
+            object_instance, &name, name_text, sizeof(name_text))) {
+        fast_reply_name_set(Object_Type, object_instance, &name);
+    }
+#else
+    (void)object_instance;
+#endif
 }
 
 /**
@@ -254,21 +336,13 @@ void Analog_Input_Present_Value_Set(uint32_t object_instance, float value)
 bool Analog_Input_Object_Name(
     uint32_t object_instance, BACNET_CHARACTER_STRING *object_name)
 {
-    char text_string[32] = "";
     bool status = false;
-    struct analog_input_descr *pObject;
+    BACNET_CHARACTER_STRING_VIEW name;
+    char name_text[32];
 
-    pObject = Analog_Input_Object(object_instance);
-    if (pObject) {
-        if (pObject->Object_Name) {
-            status =
-                characterstring_init_ansi(object_name, pObject->Object_Name);
-        } else {
-            snprintf(
-                text_string, sizeof(text_string), "ANALOG INPUT %lu",
-                (unsigned long)object_instance);
-            status = characterstring_init_ansi(object_name, text_string);
-        }
+    if (Analog_Input_Object_Name_View(
+            object_instance, &name, name_text, sizeof(name_text))) {
+        status = characterstring_view_copy(object_name, &name);
     }
 
     return status;
@@ -291,6 +365,9 @@ bool Analog_Input_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(OBJECT_ANALOG_INPUT, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_ANALOG_INPUT, object_instance);
+        Analog_Input_Fast_Reply_Name(object_instance);
     }
 
     return status;
@@ -378,6 +455,7 @@ bool Analog_Input_Event_Detection_Enable_Set(
 
     if (pObject) {
         pObject->Event_Detection_Enable = value;
+        event_engine_trigger(Object_Type, object_instance);
         retval = true;
     }
 
@@ -419,6 +497,7 @@ bool Analog_Input_Description_Set(
     if (pObject) {
         pObject->Description = new_name;
         status = true;
+        rp_cache_object_invalidate(OBJECT_ANALOG_INPUT, object_instance);
     }
 
     return status;
@@ -480,6 +559,7 @@ bool Analog_Input_Reliability_Set(
         if (fault != Analog_Input_Object_Fault(pObject)) {
             pObject->Changed = true;
         }
+        Analog_Input_Fast_Reply_Update(object_instance, pObject);
         status = true;
     }
 
@@ -641,6 +721,7 @@ bool Analog_Input_Units_Set(
     if (pObject) {
         pObject->Units = units;
         status = true;
+        rp_cache_object_invalidate(OBJECT_ANALOG_INPUT, object_instance);
     }
 
     return status;
@@ -682,6 +763,7 @@ void Analog_Input_Out_Of_Service_Set(uint32_t object_instance, bool value)
             pObject->Changed = true;
         }
         pObject->Out_Of_Service = value;
+        Analog_Input_Fast_Reply_Update(object_instance, pObject);
     }
 }
 
@@ -745,7 +827,8 @@ int Analog_Input_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
     int apdu_len = 0; /* return value */
     uint8_t *apdu = NULL;
     BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
+    BACNET_CHARACTER_STRING_VIEW char_string;
+    char name_text[32];
     float real_value = (float)1.414;
     bool state = false;
 #if defined(INTRINSIC_REPORTING)
@@ -771,9 +854,11 @@ int Analog_Input_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
                 &apdu[0], Object_Type, rpdata->object_instance);
             break;
         case PROP_OBJECT_NAME:
-            Analog_Input_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            Analog_Input_Object_Name_View(
+                rpdata->object_instance, &char_string, name_text,
+                sizeof(name_text));
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len = encode_application_enumerated(&apdu[0], Object_Type);
@@ -810,11 +895,11 @@ int Analog_Input_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             apdu_len = encode_application_enumerated(&apdu[0], pObject->Units);
             break;
         case PROP_DESCRIPTION:
-            characterstring_init_ansi(
+            characterstring_view_init_ansi(
                 &char_string,
                 Analog_Input_Description(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_COV_INCREMENT:
             apdu_len =
@@ -920,39 +1005,40 @@ int Analog_Input_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
 bool Analog_Input_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
 {
     bool status = false; /* return value */
-    int len = 0;
-    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    BACNET_TAG_CURSOR cursor = { 0 };
+    float real_value = 0.0f;
+    uint32_t enumerated_value = 0;
+    bool boolean_value = false;
+#if defined(INTRINSIC_REPORTING)
+    BACNET_UNSIGNED_INTEGER unsigned_value = 0;
+    BACNET_BIT_STRING bit_string = { 0 };
+#endif
     struct analog_input_descr *pObject;
 
     /* Valid data? */
     if (wp_data == NULL) {
         return false;
     }
-    if (wp_data->application_data_len == 0) {
-        return false;
-    }
-    /* decode the some of the request */
-    len = bacapp_decode_application_data(
-        wp_data->application_data, wp_data->application_data_len, &value);
-    /* FIXME: len < application_data_len: more data? */
-    if (len < 0) {
-        /* error while decoding - a value larger than we can handle */
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
+    if (wp_data->application_data_len <= 0) {
         return false;
     }
+    /* decode the value in place as each property needs it */
+    bacnet_tag_cursor_init(
+        &cursor, wp_data->application_data,
+        (uint32_t)wp_data->application_data_len);
     pObject = Analog_Input_Object(wp_data->object_instance);
     if (!pObject) {
         return false;
     }
     switch (wp_data->object_property) {
         case PROP_PRESENT_VALUE:
-            status = write_property_type_valid(
-                wp_data, &value, BACNET_APPLICATION_TAG_REAL);
+            status = write_property_cursor_type_valid(
+                       wp_data, &cursor, BACNET_APPLICATION_TAG_REAL) &&
+                bacnet_tag_cursor_real(&cursor, &real_value);
             if (status) {
                 if (pObject->Out_Of_Service == true) {
                     Analog_Input_Present_Value_Set(
-                        wp_data->object_instance, value.type.Real);
+                        wp_data->object_instance, real_value);
                 } else {
                     wp_data->error_class = ERROR_CLASS_PROPERTY;
                     wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
@@ -961,19 +1047,21 @@ bool Analog_Input_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
             }
             break;
         case PROP_OUT_OF_SERVICE:
-            status = write_property_type_valid(
-                wp_data, &value, BACNET_APPLICATION_TAG_BOOLEAN);
+            status = write_property_cursor_type_valid(
+                       wp_data, &cursor, BACNET_APPLICATION_TAG_BOOLEAN) &&
+                bacnet_tag_cursor_boolean(&cursor, &boolean_value);
             if (status) {
                 Analog_Input_Out_Of_Service_Set(
-                    wp_data->object_instance, value.type.Boolean);
+                    wp_data->object_instance, boolean_value);
             }
             break;
         case PROP_UNITS:
-            status = write_property_type_valid(
-                wp_data, &value, BACNET_APPLICATION_TAG_ENUMERATED);
+            status = write_property_cursor_type_valid(
+                       wp_data, &cursor, BACNET_APPLICATION_TAG_ENUMERATED) &&
+                bacnet_tag_cursor_enumerated(&cursor, &enumerated_value);
             if (status) {
-                if (value.type.Enumerated <= UINT16_MAX) {
-                    pObject->Units = value.type.Enumerated;
+                if (enumerated_value <= UINT16_MAX) {
+                    pObject->Units = enumerated_value;
                 } else {
                     status = false;
                     wp_data->error_class = ERROR_CLASS_PROPERTY;
@@ -982,12 +1070,13 @@ bool Analog_Input_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
             }
             break;
         case PROP_COV_INCREMENT:
-            status = write_property_type_valid(
-                wp_data, &value, BACNET_APPLICATION_TAG_REAL);
+            status = write_property_cursor_type_valid(
+                       wp_data, &cursor, BACNET_APPLICATION_TAG_REAL) &&
+                bacnet_tag_cursor_real(&cursor, &real_value);
             if (status) {
-                if (value.type.Real >= 0.0f) {
+                if (real_value >= 0.0f) {
                     Analog_Input_COV_Increment_Set(
-                        wp_data->object_instance, value.type.Real);
+                        wp_data->object_instance, real_value);
                 } else {
                     status = false;
                     wp_data->error_class = ERROR_CLASS_PROPERTY;
@@ -997,47 +1086,53 @@ bool Analog_Input_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
             break;
 #if defined(INTRINSIC_REPORTING)
         case PROP_TIME_DELAY:
-            status = write_property_type_valid(
-                wp_data, &value, BACNET_APPLICATION_TAG_UNSIGNED_INT);
+            status = write_property_cursor_type_valid(
+                       wp_data, &cursor, BACNET_APPLICATION_TAG_UNSIGNED_INT) &&
+                bacnet_tag_cursor_unsigned(&cursor, &unsigned_value);
             if (status) {
-                pObject->Time_Delay = value.type.Unsigned_Int;
+                pObject->Time_Delay = unsigned_value;
                 pObject->Remaining_Time_Delay = pObject->Time_Delay;
             }
             break;
         case PROP_NOTIFICATION_CLASS:
-            status = write_property_type_valid(
-                wp_data, &value, BACNET_APPLICATION_TAG_UNSIGNED_INT);
+            status = write_property_cursor_type_valid(
+                       wp_data, &cursor, BACNET_APPLICATION_TAG_UNSIGNED_INT) &&
+                bacnet_tag_cursor_unsigned(&cursor, &unsigned_value);
             if (status) {
-                pObject->Notification_Class = value.type.Unsigned_Int;
+                pObject->Notification_Class = unsigned_value;
             }
             break;
         case PROP_HIGH_LIMIT:
-            status = write_property_type_valid(
-                wp_data, &value, BACNET_APPLICATION_TAG_REAL);
+            status = write_property_cursor_type_valid(
+                       wp_data, &cursor, BACNET_APPLICATION_TAG_REAL) &&
+                bacnet_tag_cursor_real(&cursor, &real_value);
             if (status) {
-                pObject->High_Limit = value.type.Real;
+                pObject->High_Limit = real_value;
             }
             break;
         case PROP_LOW_LIMIT:
-            status = write_property_type_valid(
-                wp_data, &value, BACNET_APPLICATION_TAG_REAL);
+            status = write_property_cursor_type_valid(
+                       wp_data, &cursor, BACNET_APPLICATION_TAG_REAL) &&
+                bacnet_tag_cursor_real(&cursor, &real_value);
             if (status) {
-                pObject->Low_Limit = value.type.Real;
+                pObject->Low_Limit = real_value;
             }
             break;
         case PROP_DEADBAND:
-            status = write_property_type_valid(
-                wp_data, &value, BACNET_APPLICATION_TAG_REAL);
+            status = write_property_cursor_type_valid(
+                       wp_data, &cursor, BACNET_APPLICATION_TAG_REAL) &&
+                bacnet_tag_cursor_real(&cursor, &real_value);
             if (status) {
-                pObject->Deadband = value.type.Real;
+                pObject->Deadband = real_value;
             }
             break;
         case PROP_LIMIT_ENABLE:
-            status = write_property_type_valid(
-                wp_data, &value, BACNET_APPLICATION_TAG_BIT_STRING);
+            status = write_property_cursor_type_valid(
+                       wp_data, &cursor, BACNET_APPLICATION_TAG_BIT_STRING) &&
+                bacnet_tag_cursor_bit_string(&cursor, &bit_string);
             if (status) {
-                if (value.type.Bit_String.bits_used == 2) {
-                    pObject->Limit_Enable = value.type.Bit_String.value[0];
+                if (bitstring_bits_used(&bit_string) == 2) {
+                    pObject->Limit_Enable = bitstring_octet(&bit_string, 0);
                 } else {
                     wp_data->error_class = ERROR_CLASS_PROPERTY;
                     wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
@@ -1046,11 +1141,12 @@ bool Analog_Input_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
             }
             break;
         case PROP_EVENT_ENABLE:
-            status = write_property_type_valid(
-                wp_data, &value, BACNET_APPLICATION_TAG_BIT_STRING);
+            status = write_property_cursor_type_valid(
+                       wp_data, &cursor, BACNET_APPLICATION_TAG_BIT_STRING) &&
+                bacnet_tag_cursor_bit_string(&cursor, &bit_string);
             if (status) {
-                if (value.type.Bit_String.bits_used == 3) {
-                    pObject->Event_Enable = value.type.Bit_String.value[0];
+                if (bitstring_bits_used(&bit_string) == 3) {
+                    pObject->Event_Enable = bitstring_octet(&bit_string, 0);
                 } else {
                     wp_data->error_class = ERROR_CLASS_PROPERTY;
                     wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
@@ -1059,10 +1155,11 @@ bool Analog_Input_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
             }
             break;
         case PROP_NOTIFY_TYPE:
-            status = write_property_type_valid(
-                wp_data, &value, BACNET_APPLICATION_TAG_ENUMERATED);
+            status = write_property_cursor_type_valid(
+                       wp_data, &cursor, BACNET_APPLICATION_TAG_ENUMERATED) &&
+                bacnet_tag_cursor_enumerated(&cursor, &enumerated_value);
             if (status) {
-                switch ((BACNET_NOTIFY_TYPE)value.type.Enumerated) {
+                switch ((BACNET_NOTIFY_TYPE)enumerated_value) {
                     case NOTIFY_EVENT:
                         pObject->Notify_Type = 1;
                         break;
@@ -1090,6 +1187,16 @@ bool Analog_Input_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
             }
             break;
     }
+    if (bacnet_tag_cursor_error(&cursor)) {
+        /* error while decoding - a value larger than we can handle */
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
+        status = false;
+    }
+    if (status) {
+        /* limits or event configuration may have changed */
+        event_engine_trigger(Object_Type, wp_data->object_instance);
+    }
 
     return status;
 }
@@ -1246,6 +1353,8 @@ void Analog_Input_Intrinsic_Reporting(uint32_t object_instance)
         } /* switch (FromState) */
         ToState = CurrentAI->Event_State;
         if (FromState != ToState) {
+            /* the IN_ALARM status flag may have changed */
+            Analog_Input_Fast_Reply_Update(object_instance, CurrentAI);
             /* Event_State has changed.
                Need to fill only the basic parameters of this type of event.
                Other parameters will be filled in common function. */
@@ -1433,6 +1542,38 @@ void Analog_Input_Intrinsic_Reporting(uint32_t object_instance)
 }
 
 #if defined(INTRINSIC_REPORTING)
+/**
+ * @brief Reports on the time delay of the intrinsic reporting of the
+ *  Analog Input Object, for the event engine
+ * @param  object_instance - object-instance number of the object
+ * @param  elapsed - seconds to take off the remaining time delay
+ * @param  remaining - filled with the seconds left in the time delay
+ * @return true if a transition is waiting out its time delay
+ */
+bool Analog_Input_Event_Time_Delay(
+    uint32_t object_instance, uint32_t elapsed, uint32_t *remaining)
+{
+    struct analog_input_descr *pObject;
+
+    pObject = Analog_Input_Object(object_instance);
+    if (!pObject || !pObject->Event_Detection_Enable) {
+        return false;
+    }
+    /* the delay is reloaded whenever the event state is not changing */
+    if (pObject->Remaining_Time_Delay >= pObject->Time_Delay) {
+        return false;
+    }
+    if (elapsed > pObject->Remaining_Time_Delay) {
+        elapsed = pObject->Remaining_Time_Delay;
+    }
+    pObject->Remaining_Time_Delay -= elapsed;
+    if (remaining) {
+        *remaining = pObject->Remaining_Time_Delay;
+    }
+
+    return true;
+}
+
 /**
  * @brief Handles getting the Event Information for the Analog Input Object
  * @param  index - index number of the object 0..count
@@ -1759,10 +1900,18 @@ uint32_t Analog_Input_Create(uint32_t object_instance)
                 free(pObject);
                 return BACNET_MAX_INSTANCE;
             }
+#if defined(INTRINSIC_REPORTING)
+            (void)event_engine_add(Object_Type, object_instance);
+#endif
+            Analog_Input_Fast_Reply_Update(object_instance, pObject);
+            Analog_Input_Fast_Reply_Name(object_instance);
         } else {
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -1780,7 +1929,11 @@ bool Analog_Input_Delete(uint32_t object_instance)
     pObject = Keylist_Data_Delete(Object_List, object_instance);
     if (pObject) {
         free(pObject);
+        event_engine_remove(Object_Type, object_instance);
+        fast_reply_object_remove(Object_Type, object_instance);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
@@ -1792,8 +1945,18 @@ bool Analog_Input_Delete(uint32_t object_instance)
 void Analog_Input_Cleanup(void)
 {
     struct analog_input_descr *pObject;
+#if BACNET_MSTP_FAST_REPLY_ENABLED
+    KEY key;
+    int index;
+#endif
 
     if (Object_List) {
+#if BACNET_MSTP_FAST_REPLY_ENABLED
+        for (index = 0; Keylist_Index_Key(Object_List, index, &key);
+             index++) {
+            fast_reply_object_remove(Object_Type, key);
+        }
+#endif
         do {
             pObject = Keylist_Data_Pop(Object_List);
             if (pObject) {
@@ -1805,6 +1968,16 @@ void Analog_Input_Cleanup(void)
     }
 }
 
+#if defined(INTRINSIC_REPORTING) && BACNET_EVENT_ENGINE_ENABLED
+/* functions used by the event engine */
+static const EVENT_ENGINE_FUNCTIONS Event_Engine_Functions = {
+    Analog_Input_Intrinsic_Reporting, Analog_Input_Event_Time_Delay,
+    Analog_Input_Count, Analog_Input_Index_To_Instance,
+    Analog_Input_Instance_To_Index, Analog_Input_Event_Information,
+    Analog_Input_Alarm_Summary
+};
+#endif
+
 /**
  * @brief Initializes the Analog Input object data
  */
@@ -1821,5 +1994,9 @@ void Analog_Input_Init(void)
     handler_alarm_ack_set(Object_Type, Analog_Input_Alarm_Ack);
     /* Set handler for GetAlarmSummary Service */
     handler_get_alarm_summary_set(Object_Type, Analog_Input_Alarm_Summary);
+#if BACNET_EVENT_ENGINE_ENABLED
+    /* evaluate the limits on change instead of every second */
+    event_engine_type_set(Object_Type, &Event_Engine_Functions);
+#endif
 #endif
 }
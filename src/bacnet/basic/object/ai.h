@@ -202,6 +202,10 @@ BACNET_STACK_EXPORT
 bool Analog_Input_Notify_Type_Set(
     uint32_t object_instance, BACNET_NOTIFY_TYPE notify_type);
 
+BACNET_STACK_EXPORT
+bool Analog_Input_Event_Time_Delay(
+    uint32_t object_instance, uint32_t elapsed, uint32_t *remaining);
+
 BACNET_STACK_EXPORT
 int Analog_Input_Event_Information(
     unsigned index, BACNET_GET_EVENT_INFORMATION_DATA *getevent_data);
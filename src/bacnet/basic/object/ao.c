@@ -42,6 +42,12 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 /* me! */
 #include "ao.h"
 
@@ -540,6 +546,34 @@ static bool Analog_Output_Present_Value_Relinquish_Write(
     return status;
 }
 
+/**
+ * @brief For a given object instance-number, gets a view of the
+ *  object-name, without copying it
+ * @param  object_instance - object-instance number of the object
+ * @param  object_name - holds the view of the object-name
+ * @param  text - buffer for a default object-name, which must outlive
+ *  the view
+ * @param  text_size - size of the text buffer
+ * @return  true if object-name was retrieved
+ */
+static bool Analog_Output_Object_Name_View(
+    uint32_t object_instance,
+    BACNET_CHARACTER_STRING_VIEW *object_name,
+    char *text,
+    size_t text_size)
+{
+    struct object_data *pObject;
+
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (!pObject) {
+        return false;
+    }
+
+    return characterstring_view_object_name(
+        object_name, pObject->Object_Name, "ANALOG OUTPUT %lu",
+        object_instance, text, text_size);
+}
+
 /**
  * For a given object instance-number, loads the object-name into
  * a characterstring. Note that the object name must be unique
@@ -554,20 +588,12 @@ bool Analog_Output_Object_Name(
     uint32_t object_instance, BACNET_CHARACTER_STRING *object_name)
 {
     bool status = false;
-    struct object_data *pObject;
+    BACNET_CHARACTER_STRING_VIEW name;
     char name_text[32];
 
-    pObject = Keylist_Data(Object_List, object_instance);
-    if (pObject) {
-        if (pObject->Object_Name) {
-            status =
-                characterstring_init_ansi(object_name, pObject->Object_Name);
-        } else {
-            snprintf(
-                name_text, sizeof(name_text), "ANALOG OUTPUT %lu",
-                (unsigned long)object_instance);
-            status = characterstring_init_ansi(object_name, name_text);
-        }
+    if (Analog_Output_Object_Name_View(
+            object_instance, &name, name_text, sizeof(name_text))) {
+        status = characterstring_view_copy(object_name, &name);
     }
 
     return status;
@@ -590,6 +616,8 @@ bool Analog_Output_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(OBJECT_ANALOG_OUTPUT, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_ANALOG_OUTPUT, object_instance);
     }
 
     return status;
@@ -651,6 +679,7 @@ bool Analog_Output_Units_Set(
     if (pObject) {
         pObject->Units = units;
         status = true;
+        rp_cache_object_invalidate(OBJECT_ANALOG_OUTPUT, object_instance);
     }
 
     return status;
@@ -846,6 +875,7 @@ bool Analog_Output_Description_Set(
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_ANALOG_OUTPUT, object_instance);
         pObject->Description = new_name;
     }
 
@@ -1036,7 +1066,8 @@ int Analog_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
     int apdu_len = 0; /* return value */
     int apdu_size = 0;
     BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
+    BACNET_CHARACTER_STRING_VIEW char_string;
+    char name_text[32];
     uint8_t *apdu = NULL;
     uint32_t units = 0;
     float real_value = 0.0;
@@ -1062,9 +1093,11 @@ int Analog_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
                 &apdu[0], Object_Type, rpdata->object_instance);
             break;
         case PROP_OBJECT_NAME:
-            Analog_Output_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            Analog_Output_Object_Name_View(
+                rpdata->object_instance, &char_string, name_text,
+                sizeof(name_text));
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len = encode_application_enumerated(&apdu[0], Object_Type);
@@ -1127,11 +1160,11 @@ int Analog_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             apdu_len = encode_application_real(&apdu[0], real_value);
             break;
         case PROP_DESCRIPTION:
-            characterstring_init_ansi(
+            characterstring_view_init_ansi(
                 &char_string,
                 Analog_Output_Description(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_COV_INCREMENT:
             apdu_len = encode_application_real(
@@ -1360,6 +1393,9 @@ uint32_t Analog_Output_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -1378,6 +1414,8 @@ bool Analog_Output_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
@@ -99,6 +99,12 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 /* me! */
 #include "auditlog.h"
 
@@ -106,18 +112,43 @@
 #define BACNET_AUDIT_LOG_RECORDS_MAX 128
 #endif
 
+/* largest encoded log record that is copied to or from a segment store */
+#ifndef BACNET_AUDIT_LOG_SEGMENT_RECORD_MAX
+#define BACNET_AUDIT_LOG_SEGMENT_RECORD_MAX MAX_APDU
+#endif
+
+/* The log records are kept in time order, oldest first, in a contiguous
+   circular buffer that grows on demand up to Buffer_Size records.
+   Record_Sequence holds the sequence number of the record in each slot,
+   so a sequence number maps to a slot with simple arithmetic, and
+   timestamps and sequence numbers can be binary searched.
+   Record_Key holds a hash of the exact-match fields of each record, so
+   the duplicate scan compares one word per record before falling back
+   to the full comparison.
+   An optional segment store in flash or EEPROM keeps a copy of each
+   record, so the log can be reloaded after a reset. */
 struct object_data {
     bool Enable;
     bool Out_Of_Service;
     int Buffer_Size;
-    OS_Keylist Records;
+    BACNET_AUDIT_LOG_RECORD *Records;
+    uint32_t *Record_Sequence;
+    uint32_t *Record_Key;
+    int Records_Capacity;
+    int Records_Head;
+    int Records_Count;
     int Record_Count_Total;
+    BACNET_LOG_SEGMENT *Segment;
+    /* records that could not be copied into the segment store */
+    uint32_t Segment_Errors;
     const char *Object_Name;
     const char *Description;
     void *Context;
 };
 /* Key List for storing the object data sorted by instance number  */
 static OS_Keylist Object_List;
+/* encoding buffer shared by all the segment stores */
+static uint8_t Segment_Buffer[BACNET_AUDIT_LOG_SEGMENT_RECORD_MAX];
 
 static const int32_t Properties_Required[] = {
     /* required properties that are supported for this object */
@@ -249,6 +280,120 @@ unsigned Audit_Log_Instance_To_Index(uint32_t object_instance)
     return Keylist_Index(Object_List, object_instance);
 }
 
+/**
+ * @brief Get the buffer slot of a log record
+ * @param pObject - object data
+ * @param index - 0..N-1 index of the record, oldest first
+ * @return slot in the circular buffer
+ */
+static int Audit_Log_Record_Slot(const struct object_data *pObject, int index)
+{
+    int slot = pObject->Records_Head + index;
+
+    if (slot >= pObject->Records_Capacity) {
+        slot -= pObject->Records_Capacity;
+    }
+
+    return slot;
+}
+
+/**
+ * @brief Reallocate the circular buffer, keeping the records in order
+ *  and starting at the first slot. When the buffer shrinks, the oldest
+ *  records are dropped, as when the log overwrites them.
+ * @param pObject - object data
+ * @param capacity - number of records to allocate
+ * @return true if the buffer was reallocated
+ */
+static bool
+Audit_Log_Records_Resize(struct object_data *pObject, int capacity)
+{
+    BACNET_AUDIT_LOG_RECORD *records = NULL;
+    uint32_t *sequence = NULL;
+    uint32_t *key = NULL;
+    int count, first, slot, i;
+
+    if (capacity > 0) {
+        records = calloc((size_t)capacity, sizeof(BACNET_AUDIT_LOG_RECORD));
+        sequence = calloc((size_t)capacity, sizeof(uint32_t));
+        key = calloc((size_t)capacity, sizeof(uint32_t));
+        if (!records || !sequence || !key) {
+            free(records);
+            free(sequence);
+            free(key);
+            return false;
+        }
+    }
+    count = pObject->Records_Count;
+    first = 0;
+    if (count > capacity) {
+        first = count - capacity;
+        count = capacity;
+    }
+    for (i = 0; i < count; i++) {
+        slot = Audit_Log_Record_Slot(pObject, first + i);
+        records[i] = pObject->Records[slot];
+        sequence[i] = pObject->Record_Sequence[slot];
+        key[i] = pObject->Record_Key[slot];
+    }
+    free(pObject->Records);
+    free(pObject->Record_Sequence);
+    free(pObject->Record_Key);
+    pObject->Records = records;
+    pObject->Record_Sequence = sequence;
+    pObject->Record_Key = key;
+    pObject->Records_Capacity = capacity;
+    pObject->Records_Head = 0;
+    pObject->Records_Count = count;
+
+    return true;
+}
+
+/**
+ * @brief Get the sequence number of a log record
+ * @param pObject - object data
+ * @param index - 0..N-1 index of the record, oldest first
+ * @return sequence number of the record
+ */
+static uint32_t
+Audit_Log_Record_Sequence(const struct object_data *pObject, int index)
+{
+    return pObject->Record_Sequence[Audit_Log_Record_Slot(pObject, index)];
+}
+
+/**
+ * @brief Compute the match key of a log record from the fields that
+ *  the duplicate search compares for exact equality
+ * @param record - log record
+ * @return match key; equal records always have equal keys
+ */
+static uint32_t Audit_Log_Record_Key(const BACNET_AUDIT_LOG_RECORD *record)
+{
+    uint32_t key = record->tag;
+
+    if (record->tag == AUDIT_LOG_DATUM_TAG_STATUS) {
+        key ^= (uint32_t)record->log_datum.log_status << 8;
+    } else if (record->tag == AUDIT_LOG_DATUM_TAG_NOTIFICATION) {
+        key ^= (uint32_t)record->log_datum.notification.operation << 8;
+#ifdef BACNET_AUDIT_NOTIFICATION_TARGET_OBJECT_ENABLE
+        key ^= BACNET_ID_VALUE(
+                   record->log_datum.notification.target_object.instance,
+                   record->log_datum.notification.target_object.type) *
+            2654435761UL;
+#endif
+#ifdef BACNET_AUDIT_NOTIFICATION_TARGET_PROPERTY_ENABLE
+        key ^= (uint32_t)record->log_datum.notification.target_property
+                   .property_identifier *
+            2246822519UL;
+        key ^= record->log_datum.notification.target_property
+                   .property_array_index *
+            3266489917UL;
+#endif
+    }
+
+    return key;
+}
+
 /**
  * For a given object instance-number, returns the Audit Log entity by index.
  *
@@ -264,8 +409,8 @@ Audit_Log_Record_Entry(uint32_t object_instance, uint32_t index)
     struct object_data *pObject;
 
     pObject = Object_Data(object_instance);
-    if (pObject) {
-        entry = Keylist_Data_Index(pObject->Records, index);
+    if (pObject && (index < (uint32_t)pObject->Records_Count)) {
+        entry = &pObject->Records[Audit_Log_Record_Slot(pObject, index)];
     }
 
     return entry;
@@ -278,22 +423,58 @@ Audit_Log_Record_Entry(uint32_t object_instance, uint32_t index)
  */
 void Audit_Log_Record_Entry_Delete(uint32_t object_instance, uint32_t index)
 {
-    BACNET_AUDIT_LOG_RECORD *entry = NULL;
     struct object_data *pObject;
+    int i, slot, next;
 
     pObject = Object_Data(object_instance);
-    if (pObject) {
-        entry = Keylist_Data_Delete(pObject->Records, index);
-        free(entry);
+    if (pObject && (index < (uint32_t)pObject->Records_Count)) {
+        /* close the gap by moving the newer records down one slot */
+        for (i = index; i < (pObject->Records_Count - 1); i++) {
+            slot = Audit_Log_Record_Slot(pObject, i);
+            next = Audit_Log_Record_Slot(pObject, i + 1);
+            pObject->Records[slot] = pObject->Records[next];
+            pObject->Record_Sequence[slot] = pObject->Record_Sequence[next];
+            pObject->Record_Key[slot] = pObject->Record_Key[next];
+        }
+        pObject->Records_Count--;
     }
 }
 
+/**
+ * @brief Copy a log record into a segment store
+ * @param store - segment store
+ * @param sequence - sequence number of the record
+ * @param value - log record
+ * @return true if the record was stored, or false if it did not encode,
+ *  was larger than the buffer or a store page, or the write failed
+ */
+static bool Audit_Log_Segment_Append(
+    BACNET_LOG_SEGMENT *store,
+    uint32_t sequence,
+    const BACNET_AUDIT_LOG_RECORD *value)
+{
+    int len;
+
+    len = bacnet_audit_log_record_encode(NULL, value);
+    if ((len <= 0) || (len > (int)sizeof(Segment_Buffer)) ||
+        (len > logseg_record_size_max(store))) {
+        return false;
+    }
+    len = bacnet_audit_log_record_encode(Segment_Buffer, value);
+
+    return logseg_append(store, sequence, Segment_Buffer, (uint16_t)len);
+}
+
 /**
  * For a given object instance-number, adds a Audit Log entity to entities list.
  *
  * @note If the log buffer becomes full, the least recent log records are
  *  overwritten when new log records are added.
  *
+ * @note When the log has a segment store and the record cannot be copied
+ *  into it, the record is still added to the log, and the failure is
+ *  counted by Audit_Log_Segment_Errors().
+ *
  * @param  object_instance - object-instance number of the object
  * @param  entity - Audit Log entity
  *
@@ -302,36 +483,125 @@ void Audit_Log_Record_Entry_Delete(uint32_t object_instance, uint32_t index)
 bool Audit_Log_Record_Entry_Add(
     uint32_t object_instance, const BACNET_AUDIT_LOG_RECORD *value)
 {
-    BACNET_AUDIT_LOG_RECORD *entry = NULL;
     struct object_data *pObject;
-    int index;
+    int capacity;
+    int slot;
 
     pObject = Object_Data(object_instance);
-    if (!pObject) {
+    if (!pObject || (pObject->Buffer_Size <= 0)) {
         return false;
     }
-    if (Keylist_Count(pObject->Records) >= pObject->Buffer_Size) {
-        /* log is full, so delete oldest record before adding a new record */
-        entry = Keylist_Data_Delete_By_Index(pObject->Records, 0);
-    }
-    if (!entry) {
-        entry = calloc(1, sizeof(BACNET_AUDIT_LOG_RECORD));
-        if (!entry) {
+    if (pObject->Records_Count >= pObject->Buffer_Size) {
+        /* log is full, so overwrite the oldest record */
+        pObject->Records_Head =
+            Audit_Log_Record_Slot(pObject, 1) % pObject->Records_Capacity;
+        pObject->Records_Count--;
+    } else if (pObject->Records_Count >= pObject->Records_Capacity) {
+        /* grow the buffer geometrically, up to the Buffer_Size */
+        capacity = pObject->Records_Capacity;
+        if (capacity < 8) {
+            capacity = 8;
+        } else if (capacity <= (pObject->Buffer_Size / 2)) {
+            capacity *= 2;
+        } else {
+            capacity = pObject->Buffer_Size;
+        }
+        if (capacity > pObject->Buffer_Size) {
+            capacity = pObject->Buffer_Size;
+        }
+        if (!Audit_Log_Records_Resize(pObject, capacity)) {
             return false;
         }
     }
-    memcpy(entry, value, sizeof(BACNET_AUDIT_LOG_RECORD));
-    index =
-        Keylist_Data_Add(pObject->Records, pObject->Record_Count_Total, entry);
-    if (index < 0) {
-        free(entry);
+    slot = Audit_Log_Record_Slot(pObject, pObject->Records_Count);
+    memcpy(&pObject->Records[slot], value, sizeof(BACNET_AUDIT_LOG_RECORD));
+    /* Each log record in the log buffer has an implied sequence number
+       that is equal to the value of the Total_Record_Count property
+       immediately after the record is added. */
+    pObject->Record_Count_Total++;
+    pObject->Record_Sequence[slot] = (uint32_t)pObject->Record_Count_Total;
+    pObject->Record_Key[slot] = Audit_Log_Record_Key(value);
+    pObject->Records_Count++;
+    if (pObject->Segment &&
+        !Audit_Log_Segment_Append(
+            pObject->Segment, (uint32_t)pObject->Record_Count_Total, value)) {
+        pObject->Segment_Errors++;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Give an Audit Log a segment store in flash or EEPROM, which
+ *  keeps a copy of every record added to the log.
+ * @note The newest records already in the store, up to Buffer_Size of
+ *  them, replace the records in the log, so the log carries on after a
+ *  reset from where it left off.
+ * @param object_instance - object-instance number of the object
+ * @param store - segment store, already initialized, or NULL for none
+ * @return true if the store was set
+ */
+bool Audit_Log_Segment_Store_Set(
+    uint32_t object_instance, BACNET_LOG_SEGMENT *store)
+{
+    struct object_data *pObject;
+    BACNET_AUDIT_LOG_RECORD record = { 0 };
+    uint32_t sequence;
+    uint32_t last;
+    int len;
+
+    pObject = Object_Data(object_instance);
+    if (!pObject) {
         return false;
     }
-    pObject->Record_Count_Total++;
+    pObject->Segment = NULL;
+    pObject->Records_Head = 0;
+    pObject->Records_Count = 0;
+    if (store && (logseg_count(store) > 0)) {
+        last = logseg_first_sequence(store) + logseg_count(store) - 1;
+        sequence = logseg_first_sequence(store);
+        if ((pObject->Buffer_Size > 0) &&
+            (logseg_count(store) > (uint32_t)pObject->Buffer_Size)) {
+            sequence = last - (uint32_t)pObject->Buffer_Size + 1;
+        }
+        pObject->Record_Count_Total = (int)(sequence - 1);
+        for (; sequence != (last + 1); sequence++) {
+            len = logseg_read(
+                store, sequence, Segment_Buffer, sizeof(Segment_Buffer));
+            if ((len > 0) &&
+                (bacnet_audit_log_record_decode(Segment_Buffer, len, &record) >
+                 0)) {
+                (void)Audit_Log_Record_Entry_Add(object_instance, &record);
+            } else {
+                /* the record is corrupt, so skip its sequence number */
+                pObject->Record_Count_Total++;
+            }
+        }
+    }
+    pObject->Segment = store;
+    pObject->Segment_Errors = 0;
 
     return true;
 }
 
+/**
+ * @brief Get the number of records added to an Audit Log that could not
+ *  be copied into its segment store, since the store was set
+ * @param object_instance - object-instance number of the object
+ * @return number of records kept only in RAM
+ */
+uint32_t Audit_Log_Segment_Errors(uint32_t object_instance)
+{
+    struct object_data *pObject;
+
+    pObject = Object_Data(object_instance);
+    if (!pObject) {
+        return 0;
+    }
+
+    return pObject->Segment_Errors;
+}
+
 /**
  * @brief Get the log record maximum length for this object instance
  * @param  object_instance - object-instance number of the object
@@ -360,8 +630,6 @@ uint32_t Audit_Log_Buffer_Size(uint32_t object_instance)
 bool Audit_Log_Buffer_Size_Set(uint32_t object_instance, uint32_t buffer_size)
 {
     struct object_data *pObject;
-    BACNET_AUDIT_LOG_RECORD *entry = NULL;
-    int i;
 
     pObject = Object_Data(object_instance);
     if (!pObject) {
@@ -370,12 +638,11 @@ bool Audit_Log_Buffer_Size_Set(uint32_t object_instance, uint32_t buffer_size)
     if (buffer_size > INT_MAX) {
         return false;
     }
-    if (buffer_size < pObject->Buffer_Size) {
+    if ((int)buffer_size < pObject->Records_Capacity) {
         /* The disposition of existing log records when Buffer_Size is written
             is a local matter. We can shrink the log buffer. */
-        for (i = buffer_size; i < pObject->Buffer_Size; i++) {
-            entry = Keylist_Data_Delete_By_Index(pObject->Records, i);
-            free(entry);
+        if (!Audit_Log_Records_Resize(pObject, (int)buffer_size)) {
+            return false;
         }
     }
     pObject->Buffer_Size = buffer_size;
@@ -434,6 +701,8 @@ bool Audit_Log_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(OBJECT_AUDIT_LOG, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_AUDIT_LOG, object_instance);
     }
 
     return status;
@@ -495,6 +764,7 @@ bool Audit_Log_Description_Set(uint32_t object_instance, const char *new_name)
     pObject = Object_Data(object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_AUDIT_LOG, object_instance);
         pObject->Description = new_name;
     }
 
@@ -591,7 +861,7 @@ uint32_t Audit_Log_Record_Count(uint32_t object_instance)
 
     pObject = Object_Data(object_instance);
     if (pObject) {
-        record_count = Keylist_Count(pObject->Records);
+        record_count = pObject->Records_Count;
     }
 
     return record_count;
@@ -639,7 +909,7 @@ bool Audit_Log_Buffer_Size_Write(
             *error_class = ERROR_CLASS_PROPERTY;
             *error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
         } else if (buffer_size > INT_MAX) {
-            /* keylist library uses 'int' so that is our limit */
+            /* record counts are kept as 'int' so that is our limit */
             *error_class = ERROR_CLASS_PROPERTY;
             *error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
         } else {
@@ -868,7 +1138,8 @@ void Audit_Log_Record_Status_Insert(
 static int Audit_Log_Record_Search(
     uint32_t object_instance, BACNET_AUDIT_LOG_RECORD *record)
 {
-    int i;
+    int i, slot;
+    uint32_t key;
     BACNET_AUDIT_LOG_RECORD *entry;
     struct object_data *pObject;
 
@@ -879,11 +1150,15 @@ static int Audit_Log_Record_Search(
     if (!pObject) {
         return -1;
     }
-    for (i = 0; i < pObject->Buffer_Size; i++) {
-        entry = Audit_Log_Record_Entry(object_instance, i);
-        if (!entry) {
-            break;
+    /* records match by content rather than by time or sequence number,
+       so this is a linear pass, but over the keys rather than the records */
+    key = Audit_Log_Record_Key(record);
+    for (i = 0; i < pObject->Records_Count; i++) {
+        slot = Audit_Log_Record_Slot(pObject, i);
+        if (pObject->Record_Key[slot] != key) {
+            continue;
         }
+        entry = &pObject->Records[slot];
         if (entry->tag == record->tag) {
             if (entry->tag == AUDIT_LOG_DATUM_TAG_STATUS) {
                 if (entry->log_datum.log_status ==
@@ -974,30 +1249,89 @@ int Audit_Log_Read_Range(uint8_t *apdu, BACNET_READ_RANGE_DATA *pRequest)
 }
 
 /**
- * @brief Handle encoding for the By Position and All options.
- *  Does All option by converting to a By Position request starting at index
- *  1 and of maximum log size length.
+ * @brief Encode a run of log records into a read range response
+ * @param pObject - object data
  * @param pRequest - the read range request
+ * @param index - 0..N-1 index of the first record to encode
+ * @param count - number of records to encode
  * @return  number of bytes encoded, or 0 if unable to encode.
  */
-int Audit_Log_Read_Range_By_Position(BACNET_READ_RANGE_DATA *pRequest)
+static int Audit_Log_Read_Range_Encode(
+    const struct object_data *pObject,
+    BACNET_READ_RANGE_DATA *pRequest,
+    uint32_t index,
+    uint32_t count)
 {
-    int log_index = 0;
     int apdu_len = 0;
     size_t apdu_size;
     int len;
     uint8_t *apdu;
-    uint32_t record_count = 0;
     BACNET_AUDIT_LOG_RECORD *entry = NULL;
-    int32_t iTemp = 0;
-    uint32_t uiIndex = 0; /* Current entry number */
-    uint32_t uiFirst = 0; /* Entry number we started encoding from */
-    uint32_t uiLast = 0; /* Entry number we finished encoding on */
-    uint32_t uiTarget = 0; /* Last entry we are required to encode */
+    uint32_t record_count;
+    uint32_t last = 0; /* Entry number we finished encoding on */
 
-    record_count = Audit_Log_Record_Count(pRequest->object_instance);
     /* See how much space we have */
+    apdu = pRequest->application_data;
     apdu_size = pRequest->application_data_len - pRequest->Overhead;
+    record_count = (uint32_t)pObject->Records_Count;
+    if (index >= record_count) {
+        return 0;
+    }
+    if (count > (record_count - index)) {
+        /* Capped at end of list if necessary */
+        count = record_count - index;
+    }
+    /* Set the first item flag if the request starts with the oldest record */
+    if (index == 0) {
+        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_FIRST_ITEM, true);
+    }
+    while (count > 0) {
+        entry = &pObject->Records[Audit_Log_Record_Slot(pObject, index)];
+        len = bacnet_audit_log_record_encode(NULL, entry);
+        if (len > (apdu_size - apdu_len)) {
+            /*
+             * Can't fit any more in! We just set the result flag to say there
+             * was more and drop out of the loop early
+             */
+            bitstring_set_bit(
+                &pRequest->ResultFlags, RESULT_FLAG_MORE_ITEMS, true);
+            break;
+        }
+        len = bacnet_audit_log_record_encode(apdu, entry);
+        apdu += len;
+        apdu_len += len;
+        /* Record the last entry encoded, 1 based */
+        index++;
+        last = index;
+        count--;
+        /* Chalk up another one for the response count */
+        pRequest->ItemCount++;
+    }
+    if (last == record_count) {
+        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_LAST_ITEM, true);
+    }
+
+    return apdu_len;
+}
+
+/**
+ * @brief Handle encoding for the By Position and All options.
+ *  Does All option by converting to a By Position request starting at index
+ *  1 and of maximum log size length.
+ * @param pRequest - the read range request
+ * @return  number of bytes encoded, or 0 if unable to encode.
+ */
+int Audit_Log_Read_Range_By_Position(BACNET_READ_RANGE_DATA *pRequest)
+{
+    struct object_data *pObject;
+    uint32_t record_count = 0;
+    int32_t iTemp = 0;
+
+    pObject = Object_Data(pRequest->object_instance);
+    if (!pObject) {
+        return 0;
+    }
+    record_count = pObject->Records_Count;
     if (pRequest->RequestType == RR_READ_ALL) {
         /*
          * Read all the list or as much as will fit in the buffer by selecting
@@ -1038,356 +1372,213 @@ int Audit_Log_Read_Range_By_Position(BACNET_READ_RANGE_DATA *pRequest)
         }
     }
     /* From here on in we only have a starting point and a positive count */
-    if (pRequest->Range.RefIndex > record_count) {
+    if ((pRequest->Range.RefIndex == 0) ||
+        (pRequest->Range.RefIndex > record_count)) {
         /* Nothing to return as we are past the end of the list */
         return 0;
     }
-    /* Index of last required entry */
-    uiTarget = pRequest->Range.RefIndex + pRequest->Count - 1;
-    if (uiTarget > record_count) {
-        /* Capped at end of list if necessary */
-        uiTarget = record_count;
+
+    return Audit_Log_Read_Range_Encode(
+        pObject, pRequest, pRequest->Range.RefIndex - 1, pRequest->Count);
+}
+
+/**
+ * @brief Find the first log record at or after a sequence number
+ * @param pObject - object data
+ * @param offset - sequence number, relative to the oldest record
+ * @return 0..N-1 index of the record, or N if none
+ * @note Sequence numbers are contiguous unless records have been deleted,
+ *  so the record is usually found directly at its offset and the binary
+ *  search is only needed after a deletion.
+ */
+static uint32_t Audit_Log_Record_Sequence_Index(
+    const struct object_data *pObject, uint32_t offset)
+{
+    uint32_t first_sequence;
+    uint32_t low = 0;
+    uint32_t high;
+    uint32_t mid;
+
+    high = pObject->Records_Count;
+    if (high == 0) {
+        return 0;
     }
-    uiIndex = pRequest->Range.RefIndex;
-    /* Record where we started from */
-    uiFirst = uiIndex;
-    apdu = pRequest->application_data;
-    while (uiIndex <= uiTarget) {
-        log_index = uiIndex - 1;
-        entry = Audit_Log_Record_Entry(pRequest->object_instance, log_index);
-        len = bacnet_audit_log_record_encode(NULL, entry);
-        if (len > (apdu_size - apdu_len)) {
-            /*
-             * Can't fit any more in! We just set the result flag to say there
-             * was more and drop out of the loop early
-             */
-            bitstring_set_bit(
-                &pRequest->ResultFlags, RESULT_FLAG_MORE_ITEMS, true);
-            break;
+    first_sequence = Audit_Log_Record_Sequence(pObject, 0);
+    if ((offset < high) &&
+        ((Audit_Log_Record_Sequence(pObject, offset) - first_sequence) ==
+         offset)) {
+        return offset;
+    }
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+        if ((Audit_Log_Record_Sequence(pObject, mid) - first_sequence) <
+            offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
-        len = bacnet_audit_log_record_encode(apdu, entry);
-        apdu += len;
-        apdu_len += len;
-        /* Record the last entry encoded */
-        uiLast = uiIndex;
-        /* and get ready for next one */
-        uiIndex++;
-        /* Chalk up another one for the response count */
-        pRequest->ItemCount++;
-    }
-    /* Set remaining result flags if necessary */
-    if (uiFirst == 1) {
-        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_FIRST_ITEM, true);
-    }
-    if (uiLast == record_count) {
-        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_LAST_ITEM, true);
     }
 
-    return apdu_len;
+    return low;
 }
 
 /**
  * Handle encoding for the By Sequence option.
- * The fact that the buffer always has at least a single entry is used
- * implicetly in the following as we don't have to handle the case of an
- * empty buffer.
  *
- * @param apdu - buffer to hold the bytes
+ * Sequence numbers are handled as offsets from the sequence number of the
+ * oldest record in the log, using unsigned arithmetic, so a log or request
+ * range that wraps past the maximum for uint32_t needs no special cases.
+ *
  * @param pRequest - the read range request
  *
  * @return  number of bytes encoded, or 0 if unable to encode.
  */
 int Audit_Log_Read_Range_By_Sequence(BACNET_READ_RANGE_DATA *pRequest)
 {
-    int apdu_len = 0;
-    size_t apdu_size;
-    int len;
-    uint8_t *apdu;
-    int record_index = 0;
-    uint32_t record_count;
-    uint32_t total_record_count;
-    BACNET_AUDIT_LOG_RECORD *entry = NULL;
-    uint32_t uiIndex = 0; /* Current entry number */
-    uint32_t uiFirst = 0; /* Entry number we started encoding from */
-    uint32_t uiLast = 0; /* Entry number we finished encoding on */
-    uint32_t uiSequence = 0; /* Tracking sequence number when encoding */
-    uint32_t uiFirstSeq = 0; /* Sequence number for 1st record in log */
-    uint32_t uiBegin = 0; /* Starting Sequence number for request */
-    uint32_t uiEnd = 0; /* Ending Sequence number for request */
-    bool bWrapReq =
-        false; /* Has request sequence range spanned the max for uint32_t? */
-    bool bWrapLog =
-        false; /* Has log sequence range spanned the max for uint32_t? */
-
-    /* See how much space we have */
-    apdu = pRequest->application_data;
-    apdu_size = pRequest->application_data_len - pRequest->Overhead;
-    record_count = Audit_Log_Record_Count(pRequest->object_instance);
-    total_record_count =
-        Audit_Log_Total_Record_Count(pRequest->object_instance);
-    /* Figure out the sequence number for the first record, last is
-     * ulTotalRecordCount */
-    uiFirstSeq = total_record_count - record_count - 1;
-    /* Calculate start and end sequence numbers from request */
+    struct object_data *pObject;
+    uint32_t first_sequence; /* Sequence number for 1st record in log */
+    uint32_t span; /* Offset of the last record in the log */
+    uint32_t length; /* Number of sequence numbers requested, less one */
+    uint32_t begin; /* Starting offset for request */
+    uint32_t end; /* Ending offset for request */
+    uint32_t first_index;
+    uint32_t last_index;
+
+    pObject = Object_Data(pRequest->object_instance);
+    if (!pObject || (pObject->Records_Count == 0)) {
+        return 0;
+    }
+    first_sequence = Audit_Log_Record_Sequence(pObject, 0);
+    span = Audit_Log_Record_Sequence(pObject, pObject->Records_Count - 1) -
+        first_sequence;
+    /* Calculate start offset and range length from request */
     if (pRequest->Count < 0) {
-        uiBegin = pRequest->Range.RefSeqNum + pRequest->Count + 1;
-        uiEnd = pRequest->Range.RefSeqNum;
+        length = (uint32_t)(-(pRequest->Count + 1));
+        begin = pRequest->Range.RefSeqNum - length - first_sequence;
+    } else if (pRequest->Count > 0) {
+        length = (uint32_t)(pRequest->Count - 1);
+        begin = pRequest->Range.RefSeqNum - first_sequence;
     } else {
-        uiBegin = pRequest->Range.RefSeqNum;
-        uiEnd = pRequest->Range.RefSeqNum + pRequest->Count - 1;
-    }
-    /* See if we have any wrap around situations */
-    if (uiBegin > uiEnd) {
-        bWrapReq = true;
-    }
-    if (uiFirstSeq > total_record_count) {
-        bWrapLog = true;
+        return 0;
     }
-
-    if ((bWrapReq == false) && (bWrapLog == false)) {
-        /* Simple case no wraps */
-        /* If no overlap between request range and buffer contents bail out */
-        if ((uiEnd < uiFirstSeq) || (uiBegin > total_record_count)) {
-            return (0);
+    /* Truncate range if necessary so it is guaranteed to lie
+     * between the first and last sequence numbers in the buffer
+     * inclusive. */
+    if (begin <= span) {
+        if (length > (span - begin)) {
+            end = span;
+        } else {
+            end = begin + length;
         }
-        /* Truncate range if necessary so it is guaranteed to lie
-         * between the first and last sequence numbers in the buffer
-         * inclusive.
-         */
-        if (uiBegin < uiFirstSeq) {
-            uiBegin = uiFirstSeq;
-        }
-
-        if (uiEnd > total_record_count) {
-            uiEnd = total_record_count;
+    } else if ((0U - begin) <= length) {
+        /* request range starts before the log and wraps into it */
+        end = begin + length;
+        if (end > span) {
+            end = span;
         }
+        begin = 0;
     } else {
-        /* There are wrap arounds to contend with */
-        /* First check for non overlap condition as it is common to all */
-        if ((uiBegin > total_record_count) && (uiEnd < uiFirstSeq)) {
-            return (0);
-        }
-
-        if (bWrapLog == false) {
-            /* Only request range wraps */
-            if (uiEnd < uiFirstSeq) {
-                uiEnd = total_record_count;
-                if (uiBegin < uiFirstSeq) {
-                    uiBegin = uiFirstSeq;
-                }
-            } else {
-                uiBegin = uiFirstSeq;
-                if (uiEnd > total_record_count) {
-                    uiEnd = total_record_count;
-                }
-            }
-        } else if (bWrapReq == false) {
-            /* Only log wraps */
-            if (uiBegin > total_record_count) {
-                if (uiBegin > uiFirstSeq) {
-                    uiBegin = uiFirstSeq;
-                }
-            } else {
-                if (uiEnd > total_record_count) {
-                    uiEnd = total_record_count;
-                }
-            }
-        } else { /* Both wrap */
-            if (uiBegin < uiFirstSeq) {
-                uiBegin = uiFirstSeq;
-            }
-
-            if (uiEnd > total_record_count) {
-                uiEnd = total_record_count;
-            }
-        }
+        /* no overlap between request range and buffer contents */
+        return 0;
     }
-    /* We now have a range that lies completely within the log buffer
-     * and we need to figure out where that starts in the buffer.
-     */
-    uiIndex = uiBegin - uiFirstSeq + 1;
-    uiSequence = uiBegin;
-    uiFirst = uiIndex; /* Record where we started from */
-    while (uiSequence != uiEnd + 1) {
-        record_index = uiIndex - 1;
-        entry = Audit_Log_Record_Entry(pRequest->object_instance, record_index);
-        len = bacnet_audit_log_record_encode(NULL, entry);
-        if (len > (apdu_size - apdu_len)) {
-            /*
-             * Can't fit any more in! We just set the result flag to say there
-             * was more and drop out of the loop early
-             */
-            bitstring_set_bit(
-                &pRequest->ResultFlags, RESULT_FLAG_MORE_ITEMS, true);
-            break;
-        }
-        len = bacnet_audit_log_record_encode(apdu, entry);
-        apdu += len;
-        apdu_len += len;
-        uiLast = uiIndex; /* Record the last entry encoded */
-        uiIndex++; /* and get ready for next one */
-        uiSequence++;
-        pRequest->ItemCount++; /* Chalk up another one for the response count */
+    first_index = Audit_Log_Record_Sequence_Index(pObject, begin);
+    last_index = Audit_Log_Record_Sequence_Index(pObject, end + 1);
+    if (first_index >= last_index) {
+        return 0;
     }
+    pRequest->FirstSequence = Audit_Log_Record_Sequence(pObject, first_index);
 
-    /* Set remaining result flags if necessary */
-    if (uiFirst == 1) {
-        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_FIRST_ITEM, true);
-    }
+    return Audit_Log_Read_Range_Encode(
+        pObject, pRequest, first_index, last_index - first_index);
+}
 
-    if (uiLast == record_count) {
-        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_LAST_ITEM, true);
+/**
+ * @brief Find the first log record with a timestamp after a reference time
+ * @param pObject - object data
+ * @param timestamp - reference time
+ * @param inclusive - true to also match records at the reference time
+ * @return 0..N-1 index of the record, or N if none
+ * @note The log records are added in time order, so the timestamps are
+ *  sorted and can be binary searched.
+ */
+static uint32_t Audit_Log_Record_Time_Index(
+    const struct object_data *pObject,
+    BACNET_DATE_TIME *timestamp,
+    bool inclusive)
+{
+    BACNET_AUDIT_LOG_RECORD *entry;
+    uint32_t low = 0;
+    uint32_t high;
+    uint32_t mid;
+    int diff;
+
+    high = pObject->Records_Count;
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+        entry = &pObject->Records[Audit_Log_Record_Slot(pObject, mid)];
+        diff = datetime_compare(&entry->timestamp, timestamp);
+        if ((diff < 0) || ((diff == 0) && !inclusive)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
     }
-    pRequest->FirstSequence = uiBegin;
 
-    return apdu_len;
+    return low;
 }
 
 /**
  * Handle encoding for the By Time option.
- * The fact that the buffer always has at least a single entry is used
- * implicetly in the following as we don't have to handle the case of an
- * empty buffer.
  *
- * @param apdu - buffer to hold the bytes
  * @param pRequest - the read range request
  *
  * @return  number of bytes encoded, or 0 if unable to encode.
  */
 int Audit_Log_Read_Range_By_Time(BACNET_READ_RANGE_DATA *pRequest)
 {
-    int apdu_len = 0;
-    size_t apdu_size;
-    int len;
-    uint8_t *apdu;
-    int record_index = 0;
-    uint32_t record_count;
-    uint32_t total_record_count;
-    BACNET_AUDIT_LOG_RECORD *entry = NULL;
-    int diff;
-
-    int32_t iTemp = 0;
-    int iCount = 0;
-    uint32_t uiIndex = 0; /* Current entry number */
-    uint32_t uiFirst = 0; /* Entry number we started encoding from */
-    uint32_t uiLast = 0; /* Entry number we finished encoding on */
-    uint32_t uiFirstSeq = 0; /* Sequence number for 1st record in log */
+    struct object_data *pObject;
+    uint32_t index;
+    uint32_t count;
 
-    /* See how much space we have */
-    apdu = pRequest->application_data;
-    apdu_size = pRequest->application_data_len - pRequest->Overhead;
-    record_count = Audit_Log_Record_Count(pRequest->object_instance);
-    total_record_count =
-        Audit_Log_Total_Record_Count(pRequest->object_instance);
+    pObject = Object_Data(pRequest->object_instance);
+    if (!pObject || (pObject->Records_Count == 0)) {
+        return 0;
+    }
     if (pRequest->Count < 0) {
-        /* Start at end of log and look for record which has
-         * timestamp greater than or equal to the reference.
-         */
-        iCount = record_count - 1;
-        /* Start out with the sequence number for the last record */
-        uiFirstSeq = total_record_count;
-        for (;;) {
-            record_index = iCount;
-            entry =
-                Audit_Log_Record_Entry(pRequest->object_instance, record_index);
-            diff =
-                datetime_compare(&entry->timestamp, &pRequest->Range.RefTime);
-            if (diff < 0) {
-                /* If datetime1 is before datetime2, returns negative.*/
-                break;
-            }
-            uiFirstSeq--;
-            if (iCount) {
-                iCount--;
-            } else {
-                /* end of records, not found */
-                return 0;
-            }
+        /* Look for the last record which has a timestamp
+         * before the reference time. */
+        index = Audit_Log_Record_Time_Index(
+            pObject, &pRequest->Range.RefTime, true);
+        if (index == 0) {
+            /* end of records, not found */
+            return 0;
         }
-        /* We have an and point for our request,
-         * now work backwards to find where we should start from
-         */
-        pRequest->Count = -pRequest->Count; /* Convert to +ve count */
-        /* If count would bring us back beyond the limits
-         * Of the buffer then pin it to the start of the buffer
-         * otherwise adjust starting point and sequence number
-         * appropriately.
-         */
-        iTemp = pRequest->Count - 1;
-        if (iTemp > iCount) {
-            uiFirstSeq -= iCount;
-            pRequest->Count = iCount + 1;
-            iCount = 0;
+        index--;
+        /* We have an end point for our request,
+         * now work backwards to find where we should start from.
+         * If count would bring us back beyond the limits
+         * of the buffer then pin it to the start of the buffer. */
+        count = (uint32_t)(-(pRequest->Count + 1)) + 1;
+        if ((count - 1) > index) {
+            count = index + 1;
+            index = 0;
         } else {
-            uiFirstSeq -= iTemp;
-            iCount -= iTemp;
+            index -= count - 1;
         }
+        pRequest->Count = count;
     } else {
-        /* Start at beginning of log and look for 1st record which has
-         * timestamp greater than the reference time.
-         */
-        iCount = 0;
-        /* Figure out the sequence number for the first record, last is
-         * ulTotalRecordCount */
-        uiFirstSeq = total_record_count - record_count - 1;
-        for (;;) {
-            record_index = iCount;
-            entry =
-                Audit_Log_Record_Entry(pRequest->object_instance, record_index);
-            diff =
-                datetime_compare(&entry->timestamp, &pRequest->Range.RefTime);
-            if (diff > 0) {
-                /* If datetime1 is after datetime2, returns positive.*/
-                break;
-            }
-            uiFirstSeq++;
-            iCount++;
-            if ((uint32_t)iCount == record_count) {
-                return (0);
-            }
+        /* Look for the 1st record which has a timestamp
+         * after the reference time. */
+        index = Audit_Log_Record_Time_Index(
+            pObject, &pRequest->Range.RefTime, false);
+        if (index >= (uint32_t)pObject->Records_Count) {
+            return 0;
         }
+        count = pRequest->Count;
     }
+    pRequest->FirstSequence = Audit_Log_Record_Sequence(pObject, index);
 
-    /* We now have a starting point for the operation and a +ve count */
-    uiIndex = iCount + 1; /* Convert to BACnet 1 based reference */
-    uiFirst = uiIndex; /* Record where we started from */
-    iCount = pRequest->Count;
-    while (iCount != 0) {
-        record_index = uiIndex - 1;
-        entry = Audit_Log_Record_Entry(pRequest->object_instance, record_index);
-        len = bacnet_audit_log_record_encode(NULL, entry);
-        if (len > (apdu_size - apdu_len)) {
-            /*
-             * Can't fit any more in! We just set the result flag to say there
-             * was more and drop out of the loop early
-             */
-            bitstring_set_bit(
-                &pRequest->ResultFlags, RESULT_FLAG_MORE_ITEMS, true);
-            break;
-        }
-        len = bacnet_audit_log_record_encode(apdu, entry);
-        apdu += len;
-        apdu_len += len;
-        uiLast = uiIndex; /* Record the last entry encoded */
-        uiIndex++; /* and get ready for next one */
-        pRequest->ItemCount++; /* Chalk up another one for the response count */
-        iCount--; /* And finally cross another one off the requested count */
-
-        if (uiIndex > record_count) {
-            /* Finish up if we hit the end of the log */
-            break;
-        }
-    }
-    /* Set remaining result flags if necessary */
-    if (uiFirst == 1) {
-        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_FIRST_ITEM, true);
-    }
-    if (uiLast == record_count) {
-        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_LAST_ITEM, true);
-    }
-    pRequest->FirstSequence = uiFirstSeq;
-
-    return apdu_len;
+    return Audit_Log_Read_Range_Encode(pObject, pRequest, index, count);
 }
 
 /**
@@ -1453,7 +1644,13 @@ uint32_t Audit_Log_Create(uint32_t object_instance)
         }
         pObject->Object_Name = NULL;
         pObject->Description = NULL;
-        pObject->Records = Keylist_Create();
+        pObject->Records = NULL;
+        pObject->Record_Sequence = NULL;
+        pObject->Record_Key = NULL;
+        pObject->Records_Capacity = 0;
+        pObject->Records_Head = 0;
+        pObject->Records_Count = 0;
+        pObject->Segment = NULL;
         pObject->Buffer_Size = BACNET_AUDIT_LOG_RECORDS_MAX;
         pObject->Enable = false;
         pObject->Out_Of_Service = false;
@@ -1464,22 +1661,28 @@ uint32_t Audit_Log_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
 
 /**
- * @brief Deletes all the Audit Logs and their data
+ * @brief Deletes all the log records of an Audit Log
+ * @param pObject - object data
  */
-static void Audit_Log_Records_Cleanup(OS_Keylist list)
+static void Audit_Log_Records_Cleanup(struct object_data *pObject)
 {
-    BACNET_AUDIT_LOG_RECORD *entry;
-
-    while (Keylist_Count(list) > 0) {
-        entry = Keylist_Data_Pop(list);
-        free(entry);
-    }
-    Keylist_Delete(list);
+    free(pObject->Records);
+    free(pObject->Record_Sequence);
+    free(pObject->Record_Key);
+    pObject->Records = NULL;
+    pObject->Record_Sequence = NULL;
+    pObject->Record_Key = NULL;
+    pObject->Records_Capacity = 0;
+    pObject->Records_Head = 0;
+    pObject->Records_Count = 0;
 }
 
 /**
@@ -1494,9 +1697,11 @@ bool Audit_Log_Delete(uint32_t object_instance)
 
     pObject = Keylist_Data_Delete(Object_List, object_instance);
     if (pObject) {
-        Audit_Log_Records_Cleanup(pObject->Records);
+        Audit_Log_Records_Cleanup(pObject);
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
@@ -1513,7 +1718,7 @@ void Audit_Log_Cleanup(void)
         do {
             pObject = Keylist_Data_Pop(Object_List);
             if (pObject) {
-                Audit_Log_Records_Cleanup(pObject->Records);
+                Audit_Log_Records_Cleanup(pObject);
                 free(pObject);
             }
         } while (pObject);
@@ -40,6 +40,8 @@
 #include "../../../bacnet/rp.h"
 //#include "bacnet/wp.h"
 #include "../../../bacnet/wp.h"
+//#include "bacnet/basic/sys/logseg.h"
+#include "../../../bacnet/basic/sys/logseg.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -90,6 +92,12 @@ uint32_t Audit_Log_Create(uint32_t object_instance);
 BACNET_STACK_EXPORT
 bool Audit_Log_Delete(uint32_t object_instance);
 
+BACNET_STACK_EXPORT
+bool Audit_Log_Segment_Store_Set(
+    uint32_t object_instance, BACNET_LOG_SEGMENT *store);
+BACNET_STACK_EXPORT
+uint32_t Audit_Log_Segment_Errors(uint32_t object_instance);
+
 BACNET_STACK_EXPORT
 void Audit_Log_Cleanup(void);
 BACNET_STACK_EXPORT
@@ -38,6 +38,16 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/event_engine.h"
+#include "../../../bacnet/basic/object/event_engine.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
+//#include "bacnet/basic/object/fast_reply.h"
+#include "../../../bacnet/basic/object/fast_reply.h"
 //#include "bacnet/basic/sys/debug.h"
 #include "../../../bacnet/basic/sys/debug.h"
 /* me! */
@@ -290,6 +300,25 @@ BACNET_BINARY_PV Binary_Input_Present_Value(uint32_t object_instance)
     return value;
 }
 
+/**
+ * @brief Set the Present_Value and Status_Flags of an object in the
+ *  table of fast ReadProperty answers
+ * @param  object_instance - object-instance number of the object
+ * @param  pObject - the object
+ */
+static void Binary_Input_Fast_Reply_Update(
+    uint32_t object_instance, const struct object_data *pObject)
+{
+    fast_reply_enumerated_set(
+        Object_Type, object_instance, PROP_PRESENT_VALUE,
+        Binary_Input_Present_Value(object_instance));
+    fast_reply_status_flags_set(
+        Object_Type, object_instance,
+        pObject->Event_State != EVENT_STATE_NORMAL,
+        pObject->Reliability != RELIABILITY_NO_FAULT_DETECTED, false,
+        pObject->Out_Of_Service);
+}
+
 /**
  * @brief For a given object instance-number, checks the present-value for COV
  * @param  pObject - specific object with valid data
@@ -354,6 +383,7 @@ void Binary_Input_Out_Of_Service_Set(uint32_t object_instance, bool value)
     if (pObject) {
         Binary_Input_Out_Of_Service_COV_Detect(pObject, value);
         pObject->Out_Of_Service = value;
+        Binary_Input_Fast_Reply_Update(object_instance, pObject);
     }
 
     return;
@@ -419,6 +449,7 @@ bool Binary_Input_Reliability_Set(
             if (fault != Binary_Input_Object_Fault(pObject)) {
                 pObject->Change_Of_Value = true;
             }
+            Binary_Input_Fast_Reply_Update(object_instance, pObject);
             status = true;
         }
     }
@@ -532,7 +563,13 @@ bool Binary_Input_Present_Value_Set(
                 }
             }
             Binary_Input_Present_Value_COV_Detect(pObject, value);
+            if (pObject->Present_Value !=
+                Binary_Present_Value_Boolean(value)) {
+                /* check the alarm value again */
+                event_engine_trigger(Object_Type, object_instance);
+            }
             pObject->Present_Value = Binary_Present_Value_Boolean(value);
+            Binary_Input_Fast_Reply_Update(object_instance, pObject);
             status = true;
         }
     }
@@ -567,6 +604,7 @@ static bool Binary_Input_Present_Value_Write(
                 old_value = Binary_Present_Value(pObject->Present_Value);
                 Binary_Input_Present_Value_COV_Detect(pObject, value);
                 pObject->Present_Value = Binary_Present_Value_Boolean(value);
+                Binary_Input_Fast_Reply_Update(object_instance, pObject);
                 if (pObject->Out_Of_Service) {
                     /* The physical point that the object represents
                         is not in service. This means that changes to the
@@ -618,6 +656,7 @@ static bool Binary_Input_Out_Of_Service_Write(
         if (pObject->Write_Enabled) {
             Binary_Input_Out_Of_Service_COV_Detect(pObject, value);
             pObject->Out_Of_Service = value;
+            Binary_Input_Fast_Reply_Update(object_instance, pObject);
             status = true;
         } else {
             *error_class = ERROR_CLASS_PROPERTY;
@@ -631,6 +670,34 @@ static bool Binary_Input_Out_Of_Service_Write(
     return status;
 }
 
+/**
+ * @brief For a given object instance-number, gets a view of the
+ *  object-name, without copying it
+ * @param  object_instance - object-instance number of the object
+ * @param  object_name - holds the view of the object-name
+ * @param  text - buffer for a default object-name, which must outlive
+ *  the view
+ * @param  text_size - size of the text buffer
+ * @return  true if object-name was retrieved
+ */
+static bool Binary_Input_Object_Name_View(
+    uint32_t object_instance,
+    BACNET_CHARACTER_STRING_VIEW *object_name,
+    char *text,
+    size_t text_size)
+{
+    struct object_data *pObject;
+
+    pObject = Binary_Input_Object(object_instance);
+    if (!pObject) {
+        return false;
+    }
+
+    return characterstring_view_object_name(
+        object_name, pObject->Object_Name, "BINARY INPUT %lu",
+        object_instance, text, text_size);
+}
+
 /**
  * @brief Get the object name
  * @param  object_instance - object-instance number of the object
@@ -640,26 +707,38 @@ static bool Binary_Input_Out_Of_Service_Write(
 bool Binary_Input_Object_Name(
     uint32_t object_instance, BACNET_CHARACTER_STRING *object_name)
 {
-    char text[32] = "";
     bool status = false;
-    struct object_data *pObject;
+    BACNET_CHARACTER_STRING_VIEW name;
+    char name_text[32];
 
-    pObject = Binary_Input_Object(object_instance);
-    if (pObject) {
-        if (pObject->Object_Name == NULL) {
-            snprintf(
-                text, sizeof(text), "BINARY INPUT %lu",
-                (unsigned long)object_instance);
-            status = characterstring_init_ansi(object_name, text);
-        } else {
-            status =
-                characterstring_init_ansi(object_name, pObject->Object_Name);
-        }
+    if (Binary_Input_Object_Name_View(
+            object_instance, &name, name_text, sizeof(name_text))) {
+        status = characterstring_view_copy(object_name, &name);
     }
 
     return status;
 }
 
+/**
+ * @brief Set the Object_Name of an object in the table of fast
+ *  ReadProperty answers
+ * @param  object_instance - object-instance number of the object
+ */
+static void Binary_Input_Fast_Reply_Name(uint32_t object_instance)
+{
+#if BACNET_MSTP_FAST_REPLY_ENABLED
+    BACNET_CHARACTER_STRING_VIEW name;
+    char name_text[32];
+
+    if (Binary_Input_Object_Name_View(
+            object_instance, &name, name_text, sizeof(name_text))) {
+        fast_reply_name_set(Object_Type, object_instance, &name);
+    }
+#else
+    (void)object_instance;
+#endif
+}
+
 /**
  * @brief For a given object instance-number, sets the object-name
  * @param  object_instance - object-instance number of the object
@@ -675,6 +754,9 @@ bool Binary_Input_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(OBJECT_BINARY_INPUT, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_BINARY_INPUT, object_instance);
+        Binary_Input_Fast_Reply_Name(object_instance);
     }
 
     return status;
@@ -731,6 +813,8 @@ bool Binary_Input_Polarity_Set(
     pObject = Binary_Input_Object(object_instance);
     if (pObject) {
         pObject->Polarity = Binary_Polarity_Boolean(polarity);
+        event_engine_trigger(Object_Type, object_instance);
+        Binary_Input_Fast_Reply_Update(object_instance, pObject);
     }
 
     return status;
@@ -773,6 +857,7 @@ bool Binary_Input_Description_Set(
     pObject = Binary_Input_Object(object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_BINARY_INPUT, object_instance);
         pObject->Description = new_name;
     }
 
@@ -924,7 +1009,8 @@ int Binary_Input_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
 {
     int apdu_len = 0; /* return value */
     BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
+    BACNET_CHARACTER_STRING_VIEW char_string;
+    char name_text[32];
     uint8_t *apdu = NULL;
     bool state = false;
     struct object_data *pObject;
@@ -953,9 +1039,11 @@ int Binary_Input_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_OBJECT_NAME:
             /* note: object name must be unique in our device */
-            Binary_Input_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            Binary_Input_Object_Name_View(
+                rpdata->object_instance, &char_string, name_text,
+                sizeof(name_text));
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len = encode_application_enumerated(&apdu[0], Object_Type);
@@ -994,25 +1082,25 @@ int Binary_Input_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
                 &apdu[0], Binary_Input_Reliability(rpdata->object_instance));
             break;
         case PROP_DESCRIPTION:
-            characterstring_init_ansi(
+            characterstring_view_init_ansi(
                 &char_string,
                 Binary_Input_Description(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_ACTIVE_TEXT:
-            characterstring_init_ansi(
+            characterstring_view_init_ansi(
                 &char_string,
                 Binary_Input_Active_Text(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_INACTIVE_TEXT:
-            characterstring_init_ansi(
+            characterstring_view_init_ansi(
                 &char_string,
                 Binary_Input_Inactive_Text(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
 #if defined(INTRINSIC_REPORTING) && (BINARY_INPUT_INTRINSIC_REPORTING)
         case PROP_ALARM_VALUE:
@@ -1242,6 +1330,10 @@ bool Binary_Input_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
             }
             break;
     }
+    if (status) {
+        /* the alarm value or event configuration may have changed */
+        event_engine_trigger(Object_Type, wp_data->object_instance);
+    }
 
     return status;
 }
@@ -1334,6 +1426,17 @@ void Binary_Input_Context_Set(uint32_t object_instance, void *context)
     }
 }
 
+#if defined(INTRINSIC_REPORTING) && (BINARY_INPUT_INTRINSIC_REPORTING) && \
+    BACNET_EVENT_ENGINE_ENABLED
+/* functions used by the event engine */
+static const EVENT_ENGINE_FUNCTIONS Event_Engine_Functions = {
+    Binary_Input_Intrinsic_Reporting, Binary_Input_Event_Time_Delay,
+    Binary_Input_Count, Binary_Input_Index_To_Instance,
+    Binary_Input_Instance_To_Index, Binary_Input_Event_Information,
+    Binary_Input_Alarm_Summary
+};
+#endif
+
 /**
  * Creates a Binary Input object
  * @param object_instance - object-instance number of the object
@@ -1394,6 +1497,10 @@ uint32_t Binary_Input_Create(uint32_t object_instance)
             /* Set handler for GetAlarmSummary Service */
             handler_get_alarm_summary_set(
                 Object_Type, Binary_Input_Alarm_Summary);
+#if BACNET_EVENT_ENGINE_ENABLED
+            /* evaluate the alarm value on change instead of every second */
+            event_engine_type_set(Object_Type, &Event_Engine_Functions);
+#endif
 #endif
             /* add to list */
             index = Keylist_Data_Add(Object_List, object_instance, pObject);
@@ -1401,10 +1508,18 @@ uint32_t Binary_Input_Create(uint32_t object_instance)
                 free(pObject);
                 return BACNET_MAX_INSTANCE;
             }
+#if defined(INTRINSIC_REPORTING) && (BINARY_INPUT_INTRINSIC_REPORTING)
+            (void)event_engine_add(Object_Type, object_instance);
+#endif
+            Binary_Input_Fast_Reply_Update(object_instance, pObject);
+            Binary_Input_Fast_Reply_Name(object_instance);
         } else {
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -1415,8 +1530,18 @@ uint32_t Binary_Input_Create(uint32_t object_instance)
 void Binary_Input_Cleanup(void)
 {
     struct object_data *pObject;
+#if BACNET_MSTP_FAST_REPLY_ENABLED
+    KEY key;
+    int index;
+#endif
 
     if (Object_List) {
+#if BACNET_MSTP_FAST_REPLY_ENABLED
+        for (index = 0; Keylist_Index_Key(Object_List, index, &key);
+             index++) {
+            fast_reply_object_remove(Object_Type, key);
+        }
+#endif
         do {
             pObject = Keylist_Data_Pop(Object_List);
             if (pObject) {
@@ -1441,7 +1566,11 @@ bool Binary_Input_Delete(uint32_t object_instance)
     pObject = Keylist_Data_Delete(Object_List, object_instance);
     if (pObject) {
         free(pObject);
+        event_engine_remove(Object_Type, object_instance);
+        fast_reply_object_remove(Object_Type, object_instance);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
@@ -1525,6 +1654,7 @@ bool Binary_Input_Event_Detection_Enable_Set(
 
     if (pObject) {
         pObject->Event_Detection_Enable = value;
+        event_engine_trigger(Object_Type, object_instance);
         retval = true;
     }
 #endif
@@ -1583,6 +1713,7 @@ bool Binary_Input_Event_Enable_Set(
               ~(EVENT_ENABLE_TO_OFFNORMAL | EVENT_ENABLE_TO_FAULT |
                 EVENT_ENABLE_TO_NORMAL))) {
             pObject->Event_Enable = event_enable;
+            event_engine_trigger(Object_Type, object_instance);
             status = true;
         }
     }
@@ -1888,6 +2019,7 @@ bool Binary_Input_Time_Delay_Set(uint32_t object_instance, uint32_t time_delay)
 
     if (pObject) {
         pObject->Time_Delay = time_delay;
+        event_engine_trigger(Object_Type, object_instance);
         status = true;
     }
 
@@ -1968,11 +2100,43 @@ bool Binary_Input_Alarm_Value_Set(
                 (value == BINARY_INACTIVE) ? BINARY_ACTIVE : BINARY_INACTIVE;
         }
         pObject->Alarm_Value = value;
+        event_engine_trigger(Object_Type, object_instance);
         status = true;
     }
 
     return status;
 }
+
+/**
+ * @brief Reports on the time delay of the intrinsic reporting of the
+ *  Binary Input Object, for the event engine
+ * @param  object_instance - object-instance number of the object
+ * @param  elapsed - seconds to take off the remaining time delay
+ * @param  remaining - filled with the seconds left in the time delay
+ * @return true if a transition is waiting out its time delay
+ */
+bool Binary_Input_Event_Time_Delay(
+    uint32_t object_instance, uint32_t elapsed, uint32_t *remaining)
+{
+    struct object_data *pObject = Binary_Input_Object(object_instance);
+
+    if (!pObject || !pObject->Event_Detection_Enable) {
+        return false;
+    }
+    /* the delay is reloaded whenever the event state is not changing */
+    if (pObject->Remaining_Time_Delay >= pObject->Time_Delay) {
+        return false;
+    }
+    if (elapsed > pObject->Remaining_Time_Delay) {
+        elapsed = pObject->Remaining_Time_Delay;
+    }
+    pObject->Remaining_Time_Delay -= elapsed;
+    if (remaining) {
+        *remaining = pObject->Remaining_Time_Delay;
+    }
+
+    return true;
+}
 #endif
 
 void Binary_Input_Intrinsic_Reporting(uint32_t object_instance)
@@ -2065,6 +2229,8 @@ void Binary_Input_Intrinsic_Reporting(uint32_t object_instance)
         ToState = pObject->Event_State;
 
         if (FromState != ToState) {
+            /* the IN_ALARM status flag may have changed */
+            Binary_Input_Fast_Reply_Update(object_instance, pObject);
             /* Event_State has changed.
                Need to fill only the basic parameters of this type of event.
                Other parameters will be filled in common function. */
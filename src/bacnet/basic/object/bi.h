@@ -203,6 +203,10 @@ BACNET_NOTIFY_TYPE Binary_Input_Notify_Type(uint32_t object_instance);
 BACNET_STACK_EXPORT
 bool Binary_Input_Notify_Type_Set(
     uint32_t object_instance, BACNET_NOTIFY_TYPE notify_type);
+
+BACNET_STACK_EXPORT
+bool Binary_Input_Event_Time_Delay(
+    uint32_t object_instance, uint32_t elapsed, uint32_t *remaining);
 #endif
 
 BACNET_STACK_EXPORT
@@ -33,6 +33,12 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 /* me! */
 #include "bitstring_value.h"
 
@@ -536,6 +542,9 @@ bool BitString_Value_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(
+            OBJECT_BITSTRING_VALUE, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_BITSTRING_VALUE, object_instance);
     }
 
     return status;
@@ -600,6 +609,7 @@ bool BitString_Value_Description_Set(
     pObject = BitString_Value_Object(object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_BITSTRING_VALUE, object_instance);
         pObject->Description = value;
     }
 
@@ -879,6 +889,9 @@ uint32_t BitString_Value_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -897,6 +910,8 @@ bool BitString_Value_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
@@ -28,6 +28,12 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 //#include "bacnet/proplist.h"
 #include "../../../bacnet/proplist.h"
 /* me! */
@@ -872,6 +878,10 @@ bool Binary_Lighting_Output_Name_Set(
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(
+            OBJECT_BINARY_LIGHTING_OUTPUT, object_instance, new_name);
+        rp_cache_object_invalidate(
+            OBJECT_BINARY_LIGHTING_OUTPUT, object_instance);
     }
 
     return status;
@@ -936,6 +946,8 @@ bool Binary_Lighting_Output_Description_Set(
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(
+            OBJECT_BINARY_LIGHTING_OUTPUT, object_instance);
         pObject->Description = new_name;
     }
 
@@ -1614,6 +1626,9 @@ uint32_t Binary_Lighting_Output_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -1632,6 +1647,8 @@ bool Binary_Lighting_Output_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
@@ -43,6 +43,12 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 /* me! */
 #include "bo.h"
 
@@ -568,6 +574,34 @@ void Binary_Output_Out_Of_Service_Set(uint32_t object_instance, bool value)
     }
 }
 
+/**
+ * @brief For a given object instance-number, gets a view of the
+ *  object-name, without copying it
+ * @param  object_instance - object-instance number of the object
+ * @param  object_name - holds the view of the object-name
+ * @param  text - buffer for a default object-name, which must outlive
+ *  the view
+ * @param  text_size - size of the text buffer
+ * @return  true if object-name was retrieved
+ */
+static bool Binary_Output_Object_Name_View(
+    uint32_t object_instance,
+    BACNET_CHARACTER_STRING_VIEW *object_name,
+    char *text,
+    size_t text_size)
+{
+    struct object_data *pObject;
+
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (!pObject) {
+        return false;
+    }
+
+    return characterstring_view_object_name(
+        object_name, pObject->Object_Name, "BINARY OUTPUT %lu",
+        object_instance, text, text_size);
+}
+
 /**
  * For a given object instance-number, loads the object-name into
  * a characterstring. Note that the object name must be unique
@@ -582,20 +616,12 @@ bool Binary_Output_Object_Name(
     uint32_t object_instance, BACNET_CHARACTER_STRING *object_name)
 {
     bool status = false;
-    struct object_data *pObject;
+    BACNET_CHARACTER_STRING_VIEW name;
     char name_text[32];
 
-    pObject = Keylist_Data(Object_List, object_instance);
-    if (pObject) {
-        if (pObject->Object_Name) {
-            status =
-                characterstring_init_ansi(object_name, pObject->Object_Name);
-        } else {
-            snprintf(
-                name_text, sizeof(name_text), "BINARY OUTPUT %lu",
-                (unsigned long)object_instance);
-            status = characterstring_init_ansi(object_name, name_text);
-        }
+    if (Binary_Output_Object_Name_View(
+            object_instance, &name, name_text, sizeof(name_text))) {
+        status = characterstring_view_copy(object_name, &name);
     }
 
     return status;
@@ -619,6 +645,8 @@ bool Binary_Output_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(OBJECT_BINARY_OUTPUT, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_BINARY_OUTPUT, object_instance);
     }
 
     return status;
@@ -870,6 +898,7 @@ bool Binary_Output_Description_Set(
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_BINARY_OUTPUT, object_instance);
         pObject->Description = new_name;
     }
 
@@ -1040,7 +1069,8 @@ int Binary_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
 {
     int apdu_len = 0; /* return value */
     BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
+    BACNET_CHARACTER_STRING_VIEW char_string;
+    char name_text[32];
     BACNET_BINARY_PV present_value = BINARY_INACTIVE;
     BACNET_POLARITY polarity = POLARITY_NORMAL;
     unsigned i = 0;
@@ -1067,9 +1097,11 @@ int Binary_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
                 &apdu[0], Object_Type, rpdata->object_instance);
             break;
         case PROP_OBJECT_NAME:
-            Binary_Output_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            Binary_Output_Object_Name_View(
+                rpdata->object_instance, &char_string, name_text,
+                sizeof(name_text));
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len = encode_application_enumerated(&apdu[0], Object_Type);
@@ -1125,25 +1157,25 @@ int Binary_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             apdu_len = encode_application_enumerated(&apdu[0], present_value);
             break;
         case PROP_DESCRIPTION:
-            characterstring_init_ansi(
+            characterstring_view_init_ansi(
                 &char_string,
                 Binary_Output_Description(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_ACTIVE_TEXT:
-            characterstring_init_ansi(
+            characterstring_view_init_ansi(
                 &char_string,
                 Binary_Output_Active_Text(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_INACTIVE_TEXT:
-            characterstring_init_ansi(
+            characterstring_view_init_ansi(
                 &char_string,
                 Binary_Output_Inactive_Text(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_CURRENT_COMMAND_PRIORITY:
             i = Binary_Output_Present_Value_Priority(rpdata->object_instance);
@@ -1334,6 +1366,9 @@ uint32_t Binary_Output_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -1369,6 +1404,8 @@ bool Binary_Output_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
@@ -45,6 +45,12 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 /* me! */
 #include "calendar.h"
 
@@ -378,6 +384,34 @@ bool Calendar_Present_Value(uint32_t object_instance)
     return false;
 }
 
+/**
+ * @brief For a given object instance-number, gets a view of the
+ *  object-name, without copying it
+ * @param  object_instance - object-instance number of the object
+ * @param  object_name - holds the view of the object-name
+ * @param  text - buffer for a default object-name, which must outlive
+ *  the view
+ * @param  text_size - size of the text buffer
+ * @return  true if object-name was retrieved
+ */
+static bool Calendar_Object_Name_View(
+    uint32_t object_instance,
+    BACNET_CHARACTER_STRING_VIEW *object_name,
+    char *text,
+    size_t text_size)
+{
+    struct object_data *pObject;
+
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (!pObject) {
+        return false;
+    }
+
+    return characterstring_view_object_name(
+        object_name, pObject->Object_Name, "CALENDAR-%lu",
+        object_instance, text, text_size);
+}
+
 /**
  * For a given object instance-number, loads the object-name into
  * a characterstring. Note that the object name must be unique
@@ -392,20 +426,12 @@ bool Calendar_Object_Name(
     uint32_t object_instance, BACNET_CHARACTER_STRING *object_name)
 {
     bool status = false;
-    struct object_data *pObject;
-    char name_text[32] = "CALENDAR-4194303";
+    BACNET_CHARACTER_STRING_VIEW name;
+    char name_text[32];
 
-    pObject = Keylist_Data(Object_List, object_instance);
-    if (pObject) {
-        if (pObject->Object_Name) {
-            status =
-                characterstring_init_ansi(object_name, pObject->Object_Name);
-        } else {
-            snprintf(
-                name_text, sizeof(name_text), "CALENDAR-%lu",
-                (unsigned long)object_instance);
-            status = characterstring_init_ansi(object_name, name_text);
-        }
+    if (Calendar_Object_Name_View(
+            object_instance, &name, name_text, sizeof(name_text))) {
+        status = characterstring_view_copy(object_name, &name);
     }
 
     return status;
@@ -429,6 +455,8 @@ bool Calendar_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(OBJECT_CALENDAR, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_CALENDAR, object_instance);
     }
 
     return status;
@@ -492,6 +520,7 @@ bool Calendar_Description_Set(uint32_t object_instance, const char *new_name)
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_CALENDAR, object_instance);
         pObject->Description = new_name;
     }
 
@@ -511,7 +540,8 @@ bool Calendar_Description_Set(uint32_t object_instance, const char *new_name)
 int Calendar_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
 {
     int apdu_len = 0; /* return value */
-    BACNET_CHARACTER_STRING char_string;
+    BACNET_CHARACTER_STRING_VIEW char_string;
+    char name_text[32];
     uint8_t *apdu = NULL;
     int apdu_max = 0;
     bool value = false;
@@ -529,9 +559,11 @@ int Calendar_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
                 &apdu[0], rpdata->object_type, rpdata->object_instance);
             break;
         case PROP_OBJECT_NAME:
-            Calendar_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            Calendar_Object_Name_View(
+                rpdata->object_instance, &char_string, name_text,
+                sizeof(name_text));
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len =
@@ -546,9 +578,10 @@ int Calendar_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
                 rpdata->object_instance, apdu, apdu_max);
             break;
         case PROP_DESCRIPTION:
-            characterstring_init_ansi(
+            characterstring_view_init_ansi(
                 &char_string, Calendar_Description(rpdata->object_instance));
-            apdu_len = encode_application_character_string(apdu, &char_string);
+            apdu_len =
+                encode_application_character_string_view(apdu, &char_string);
             break;
         default:
             rpdata->error_class = ERROR_CLASS_PROPERTY;
@@ -759,6 +792,9 @@ uint32_t Calendar_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -779,6 +815,8 @@ bool Calendar_Delete(uint32_t object_instance)
         Keylist_Delete(pObject->Date_List);
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
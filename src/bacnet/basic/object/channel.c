@@ -33,6 +33,12 @@
 #include "../../../bacnet/basic/sys/debug.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 #if defined(CHANNEL_LIGHTING_COMMAND) || defined(CHANNEL_COLOR_COMMAND)
 //#include "bacnet/lighting.h"
 #include "../../../bacnet/lighting.h"
@@ -848,6 +854,34 @@ static bool Channel_Present_Value_Write(
     return status;
 }
 
+/**
+ * @brief For a given object instance-number, gets a view of the
+ *  object-name, without copying it
+ * @param  object_instance - object-instance number of the object
+ * @param  object_name - holds the view of the object-name
+ * @param  text - buffer for a default object-name, which must outlive
+ *  the view
+ * @param  text_size - size of the text buffer
+ * @return  true if object-name was retrieved
+ */
+static bool Channel_Object_Name_View(
+    uint32_t object_instance,
+    BACNET_CHARACTER_STRING_VIEW *object_name,
+    char *text,
+    size_t text_size)
+{
+    struct object_data *pObject;
+
+    pObject = Object_Data(object_instance);
+    if (!pObject) {
+        return false;
+    }
+
+    return characterstring_view_object_name(
+        object_name, pObject->Object_Name, "CHANNEL-%lu", object_instance, text,
+        text_size);
+}
+
 /**
  * For a given object instance-number, loads the object-name into
  * a characterstring. Note that the object name must be unique
@@ -862,20 +896,12 @@ bool Channel_Object_Name(
     uint32_t object_instance, BACNET_CHARACTER_STRING *object_name)
 {
     bool status = false;
-    char name_text[32] = "CHANNEL-4194303";
-    struct object_data *pObject;
+    BACNET_CHARACTER_STRING_VIEW name;
+    char name_text[32];
 
-    pObject = Object_Data(object_instance);
-    if (pObject) {
-        if (pObject->Object_Name) {
-            status =
-                characterstring_init_ansi(object_name, pObject->Object_Name);
-        } else {
-            snprintf(
-                name_text, sizeof(name_text), "CHANNEL-%lu",
-                (unsigned long)object_instance);
-            status = characterstring_init_ansi(object_name, name_text);
-        }
+    if (Channel_Object_Name_View(
+            object_instance, &name, name_text, sizeof(name_text))) {
+        status = characterstring_view_copy(object_name, &name);
     }
 
     return status;
@@ -898,6 +924,8 @@ bool Channel_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(OBJECT_CHANNEL, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_CHANNEL, object_instance);
     }
 
     return status;
@@ -974,7 +1002,8 @@ int Channel_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
 {
     int apdu_len = 0; /* return value */
     BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
+    BACNET_CHARACTER_STRING_VIEW char_string;
+    char name_text[32];
     const BACNET_CHANNEL_VALUE *cvalue = NULL;
     uint32_t unsigned_value = 0;
     unsigned count = 0;
@@ -994,8 +1023,11 @@ int Channel_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
                 apdu, OBJECT_CHANNEL, rpdata->object_instance);
             break;
         case PROP_OBJECT_NAME:
-            Channel_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len = encode_application_character_string(apdu, &char_string);
+            Channel_Object_Name_View(
+                rpdata->object_instance, &char_string, name_text,
+                sizeof(name_text));
+            apdu_len =
+                encode_application_character_string_view(apdu, &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len = encode_application_enumerated(apdu, OBJECT_CHANNEL);
@@ -1478,6 +1510,9 @@ uint32_t Channel_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -1496,6 +1531,8 @@ bool Channel_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
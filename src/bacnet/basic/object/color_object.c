@@ -45,6 +45,12 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 //#include "bacnet/basic/sys/linear.h"
 #include "../../../bacnet/basic/sys/linear.h"
 /* me! */
@@ -751,6 +757,8 @@ bool Color_Name_Set(uint32_t object_instance, const char *new_name)
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
         pObject->Object_Name = new_name;
+        object_name_index_set(OBJECT_COLOR, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_COLOR, object_instance);
         status = true;
     }
 
@@ -815,6 +823,7 @@ bool Color_Description_Set(uint32_t object_instance, const char *new_name)
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_COLOR, object_instance);
         pObject->Description = new_name;
     }
 
@@ -1240,6 +1249,9 @@ uint32_t Color_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -1258,6 +1270,8 @@ bool Color_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
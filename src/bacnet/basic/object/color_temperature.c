@@ -43,6 +43,12 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 //#include "bacnet/basic/sys/linear.h"
 #include "../../../bacnet/basic/sys/linear.h"
 /* me! */
@@ -989,6 +995,9 @@ bool Color_Temperature_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(
+            OBJECT_COLOR_TEMPERATURE, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_COLOR_TEMPERATURE, object_instance);
     }
 
     return status;
@@ -1053,6 +1062,7 @@ bool Color_Temperature_Description_Set(
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_COLOR_TEMPERATURE, object_instance);
         pObject->Description = new_name;
     }
 
@@ -1683,6 +1693,9 @@ uint32_t Color_Temperature_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -1701,6 +1714,8 @@ bool Color_Temperature_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
@@ -29,6 +29,12 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 
 /* Key List for storing the object data sorted by instance number  */
 static OS_Keylist Object_List = NULL;
@@ -163,6 +169,9 @@ uint32_t CharacterString_Value_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -181,6 +190,8 @@ bool CharacterString_Value_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
@@ -506,6 +517,8 @@ bool CharacterString_Value_Description_Set(
     pObject = CharacterString_Value_Object(object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(
+            OBJECT_CHARACTERSTRING_VALUE, object_instance);
         pObject->Description = new_name;
     }
 
@@ -557,6 +570,10 @@ bool CharacterString_Value_Name_Set(
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(
+            OBJECT_CHARACTERSTRING_VALUE, object_instance, new_name);
+        rp_cache_object_invalidate(
+            OBJECT_CHARACTERSTRING_VALUE, object_instance);
     }
 
     return status;
@@ -299,6 +299,8 @@ bool Device_Object_List_Identifier(
 BACNET_STACK_EXPORT
 int Device_Object_List_Element_Encode(
     uint32_t object_instance, BACNET_ARRAY_INDEX array_index, uint8_t *apdu);
+BACNET_STACK_EXPORT
+void Device_Object_List_Rebuild(void);
 
 BACNET_STACK_EXPORT
 bool Device_Create_Object(BACNET_CREATE_OBJECT_DATA *data);
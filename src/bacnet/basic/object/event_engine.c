@@ -0,0 +1,745 @@
+/**
+ * @file
+ * @brief A change-driven scheduler of intrinsic reporting, with the list
+ *  of objects that have an active event
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "../../../bacnet/bacdef.h"
+/* BACnet Stack API */
+//#include "bacnet/basic/object/event_engine.h"
+#include "../../../bacnet/basic/object/event_engine.h"
+
+#if BACNET_EVENT_ENGINE_ENABLED
+/* end of the queue, or an entry that is not in use */
+#define EVENT_ENGINE_NONE UINT16_MAX
+/* the entry tracks an object */
+#define EVENT_ENGINE_USED 0x01
+/* the entry is in the queue */
+#define EVENT_ENGINE_QUEUED 0x02
+/* the value or configuration of the object changed */
+#define EVENT_ENGINE_CHANGED 0x04
+/* an acknowledgment notification is to be sent */
+#define EVENT_ENGINE_ACK 0x08
+/* a transition is waiting out its time delay */
+#define EVENT_ENGINE_DELAY 0x10
+/* the object has an active event */
+#define EVENT_ENGINE_ACTIVE 0x20
+/* the entries are found by a chained hash of the object identifier,
+   with about one bucket per entry */
+#define EVENT_ENGINE_HASH_BITS                                    \
+    ((BACNET_EVENT_ENGINE_OBJECTS) <= 8        ? 3               \
+         : (BACNET_EVENT_ENGINE_OBJECTS) <= 16  ? 4               \
+         : (BACNET_EVENT_ENGINE_OBJECTS) <= 32  ? 5               \
+         : (BACNET_EVENT_ENGINE_OBJECTS) <= 64  ? 6               \
+         : (BACNET_EVENT_ENGINE_OBJECTS) <= 128 ? 7               \
+         : (BACNET_EVENT_ENGINE_OBJECTS) <= 256 ? 8               \
+         : (BACNET_EVENT_ENGINE_OBJECTS) <= 512 ? 9               \
+                                                : 10)
+#define EVENT_ENGINE_HASH_SIZE (1U << EVENT_ENGINE_HASH_BITS)
+
+/* one object whose intrinsic reporting is run by the engine */
+struct event_engine_entry {
+    uint32_t object_instance;
+    /* engine time of the last evaluation */
+    uint32_t stamp;
+    /* engine time when the time delay runs out */
+    uint32_t delay_time;
+    /* engine time when the entry is due, while it is in the queue */
+    uint32_t due_time;
+    uint16_t object_type;
+    /* next entry in the queue */
+    uint16_t next;
+    /* next entry in the same hash bucket, plus one, or zero at the end */
+    uint16_t hash_next;
+    uint8_t flags;
+};
+/* an object type and its functions */
+struct event_engine_type {
+    uint16_t object_type;
+    const EVENT_ENGINE_FUNCTIONS *functions;
+};
+static struct event_engine_entry Engine_Entry[BACNET_EVENT_ENGINE_OBJECTS];
+static struct event_engine_type Engine_Type[BACNET_EVENT_ENGINE_TYPES];
+/* first entry of each hash bucket, plus one, so that the zeroed table
+   is empty before event_engine_init() */
+static uint16_t Engine_Hash[EVENT_ENGINE_HASH_SIZE];
+/* first entry of the queue of entries waiting for evaluation */
+static uint16_t Engine_Queue = EVENT_ENGINE_NONE;
+/* entries of objects with an active event, sorted by object identifier,
+   so that a GetEventInformation continuation finds its place at once */
+static uint16_t Engine_Active[BACNET_EVENT_ENGINE_OBJECTS];
+static uint16_t Engine_Active_Count;
+/* set when an object could not be added; the lists are then not used
+   until a removal makes room for every object again */
+static bool Engine_Overflow;
+/* milliseconds, advanced by event_engine_timer() */
+static uint32_t Engine_Time;
+
+/**
+ * @brief Compare two engine times, which wrap around
+ * @param time - engine time to check
+ * @param now - engine time to compare with
+ * @return true if time is at or before now
+ */
+static bool event_engine_time_reached(uint32_t time, uint32_t now)
+{
+    return (int32_t)(now - time) >= 0;
+}
+
+/**
+ * @brief Compare the object of an entry with an object identifier
+ * @param entry - the entry to compare
+ * @param object_type - BACnet object type
+ * @param object_instance - instance number of the object
+ * @return true if the object of the entry is before the given object
+ */
+static bool event_engine_before(
+    uint16_t entry, BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    const struct event_engine_entry *pEntry = &Engine_Entry[entry];
+
+    if (pEntry->object_type != object_type) {
+        return pEntry->object_type < object_type;
+    }
+
+    return pEntry->object_instance < object_instance;
+}
+
+/**
+ * @brief Find where an object is, or would be, in the list of active
+ *  events
+ * @param object_type - BACnet object type
+ * @param object_instance - instance number of the object
+ * @return position of the first active event not before the object
+ */
+static uint16_t event_engine_active_search(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    uint16_t low = 0;
+    uint16_t high = Engine_Active_Count;
+    uint16_t middle;
+
+    while (low < high) {
+        middle = low + ((high - low) / 2);
+        if (event_engine_before(
+                Engine_Active[middle], object_type, object_instance)) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * @brief Find the functions of an object type
+ * @param object_type - BACnet object type
+ * @return the functions given for the type, or NULL
+ */
+static const EVENT_ENGINE_FUNCTIONS *
+event_engine_functions(BACNET_OBJECT_TYPE object_type)
+{
+    unsigned i;
+
+    for (i = 0; i < BACNET_EVENT_ENGINE_TYPES; i++) {
+        if (Engine_Type[i].functions &&
+            (Engine_Type[i].object_type == object_type)) {
+            return Engine_Type[i].functions;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Get the hash bucket of an object
+ * @param object_type - BACnet object type
+ * @param object_instance - instance number of the object
+ * @return hash bucket
+ */
+static unsigned
+event_engine_hash(BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    uint32_t key;
+
+    key = ((uint32_t)object_type << 22) ^ object_instance;
+    key = (uint32_t)(key * 2654435761UL);
+
+    return (unsigned)(key >> (32 - EVENT_ENGINE_HASH_BITS));
+}
+
+/**
+ * @brief Find the entry that tracks an object
+ * @param object_type - BACnet object type
+ * @param object_instance - instance number of the object
+ * @return the entry, or EVENT_ENGINE_NONE
+ */
+static uint16_t
+event_engine_find(BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    uint16_t link;
+    uint16_t entry;
+
+    link = Engine_Hash[event_engine_hash(object_type, object_instance)];
+    while (link != 0) {
+        entry = link - 1;
+        if ((Engine_Entry[entry].object_instance == object_instance) &&
+            (Engine_Entry[entry].object_type == object_type)) {
+            return entry;
+        }
+        link = Engine_Entry[entry].hash_next;
+    }
+
+    return EVENT_ENGINE_NONE;
+}
+
+/**
+ * @brief Take an entry out of its hash bucket
+ * @param entry - the entry to take out
+ */
+static void event_engine_hash_remove(uint16_t entry)
+{
+    uint16_t *link;
+
+    link = &Engine_Hash[event_engine_hash(
+        (BACNET_OBJECT_TYPE)Engine_Entry[entry].object_type,
+        Engine_Entry[entry].object_instance)];
+    while (*link != 0) {
+        if (*link == (entry + 1)) {
+            *link = Engine_Entry[entry].hash_next;
+            break;
+        }
+        link = &Engine_Entry[*link - 1].hash_next;
+    }
+    Engine_Entry[entry].hash_next = 0;
+}
+
+/**
+ * @brief Take an entry out of the queue
+ * @param entry - the entry to take out
+ */
+static void event_engine_unlink(uint16_t entry)
+{
+    uint16_t *link = &Engine_Queue;
+
+    if (!(Engine_Entry[entry].flags & EVENT_ENGINE_QUEUED)) {
+        return;
+    }
+    while (*link != EVENT_ENGINE_NONE) {
+        if (*link == entry) {
+            *link = Engine_Entry[entry].next;
+            break;
+        }
+        link = &Engine_Entry[*link].next;
+    }
+    Engine_Entry[entry].next = EVENT_ENGINE_NONE;
+    Engine_Entry[entry].flags &= ~EVENT_ENGINE_QUEUED;
+}
+
+/**
+ * @brief Put an entry in the queue at the time its earliest pending work
+ *  is due, or leave it out when there is none. A change during a time
+ *  delay is looked at no sooner than a second after the last evaluation,
+ *  since each evaluation counts for a second of the delay.
+ * @param entry - the entry to schedule
+ */
+static void event_engine_schedule(uint16_t entry)
+{
+    struct event_engine_entry *pEntry = &Engine_Entry[entry];
+    uint32_t due_time = 0;
+    bool due = false;
+    uint16_t *link = &Engine_Queue;
+
+    event_engine_unlink(entry);
+    if (pEntry->flags & EVENT_ENGINE_ACK) {
+        due_time = Engine_Time;
+        due = true;
+    } else if (pEntry->flags & EVENT_ENGINE_CHANGED) {
+        due_time = Engine_Time;
+        if ((pEntry->flags & EVENT_ENGINE_DELAY) &&
+            !event_engine_time_reached(pEntry->stamp + 1000UL, Engine_Time)) {
+            due_time = pEntry->stamp + 1000UL;
+        }
+        due = true;
+    }
+    if ((pEntry->flags & EVENT_ENGINE_DELAY) &&
+        (!due || event_engine_time_reached(pEntry->delay_time, due_time))) {
+        due_time = pEntry->delay_time;
+        due = true;
+    }
+    if (!due) {
+        return;
+    }
+    /* after the entries due at the same time, so none waits forever */
+    while ((*link != EVENT_ENGINE_NONE) &&
+           event_engine_time_reached(Engine_Entry[*link].due_time, due_time)) {
+        link = &Engine_Entry[*link].next;
+    }
+    pEntry->due_time = due_time;
+    pEntry->next = *link;
+    *link = entry;
+    pEntry->flags |= EVENT_ENGINE_QUEUED;
+}
+
+/**
+ * @brief Take an entry out of the list of active events, keeping the
+ *  order of the others
+ * @param entry - the entry to take out
+ */
+static void event_engine_active_remove(uint16_t entry)
+{
+    uint16_t i;
+
+    if (!(Engine_Entry[entry].flags & EVENT_ENGINE_ACTIVE)) {
+        return;
+    }
+    i = event_engine_active_search(
+        (BACNET_OBJECT_TYPE)Engine_Entry[entry].object_type,
+        Engine_Entry[entry].object_instance);
+    if ((i < Engine_Active_Count) && (Engine_Active[i] == entry)) {
+        Engine_Active_Count--;
+        memmove(
+            &Engine_Active[i], &Engine_Active[i + 1],
+            (Engine_Active_Count - i) * sizeof(Engine_Active[0]));
+    }
+    Engine_Entry[entry].flags &= ~EVENT_ENGINE_ACTIVE;
+}
+
+/**
+ * @brief Add an entry to the list of active events, or take it out,
+ *  after its event state or acknowledgments may have changed
+ * @param entry - the entry to look at
+ * @param functions - the functions of its object type
+ */
+static void event_engine_active_update(
+    uint16_t entry, const EVENT_ENGINE_FUNCTIONS *functions)
+{
+    struct event_engine_entry *pEntry = &Engine_Entry[entry];
+    BACNET_GET_EVENT_INFORMATION_DATA getevent_data = { 0 };
+    bool active = false;
+    uint16_t i;
+
+    if (functions->Event_Information && functions->Instance_To_Index) {
+        active = functions->Event_Information(
+                     functions->Instance_To_Index(pEntry->object_instance),
+                     &getevent_data) > 0;
+    }
+    if (active == ((pEntry->flags & EVENT_ENGINE_ACTIVE) != 0)) {
+        return;
+    }
+    if (active) {
+        i = event_engine_active_search(
+            (BACNET_OBJECT_TYPE)pEntry->object_type, pEntry->object_instance);
+        memmove(
+            &Engine_Active[i + 1], &Engine_Active[i],
+            (Engine_Active_Count - i) * sizeof(Engine_Active[0]));
+        Engine_Active[i] = entry;
+        Engine_Active_Count++;
+        pEntry->flags |= EVENT_ENGINE_ACTIVE;
+    } else {
+        event_engine_active_remove(entry);
+    }
+}
+
+/**
+ * @brief Run the pending work of an entry that has come due
+ * @param entry - the entry taken from the head of the queue
+ */
+static void event_engine_evaluate(uint16_t entry)
+{
+    struct event_engine_entry *pEntry = &Engine_Entry[entry];
+    const EVENT_ENGINE_FUNCTIONS *functions;
+    uint32_t elapsed = 0;
+    uint32_t remaining = 0;
+    bool evaluate = false;
+
+    functions = event_engine_functions(pEntry->object_type);
+    if (!functions || !functions->Intrinsic_Reporting) {
+        pEntry->flags &= ~(
+            EVENT_ENGINE_ACK | EVENT_ENGINE_CHANGED | EVENT_ENGINE_DELAY);
+        return;
+    }
+    if (pEntry->flags & EVENT_ENGINE_ACK) {
+        /* this call sends the acknowledgment and nothing else */
+        pEntry->flags &= ~EVENT_ENGINE_ACK;
+        functions->Intrinsic_Reporting(pEntry->object_instance);
+    }
+    if (pEntry->flags & EVENT_ENGINE_DELAY) {
+        elapsed = (Engine_Time - pEntry->stamp) / 1000UL;
+        if (event_engine_time_reached(pEntry->delay_time, Engine_Time)) {
+            evaluate = true;
+        } else if ((pEntry->flags & EVENT_ENGINE_CHANGED) && (elapsed > 0)) {
+            evaluate = true;
+        }
+    } else if (pEntry->flags & EVENT_ENGINE_CHANGED) {
+        evaluate = true;
+    }
+    if (evaluate) {
+        pEntry->flags &= ~EVENT_ENGINE_CHANGED;
+        if (pEntry->flags & EVENT_ENGINE_DELAY) {
+            /* the seconds since the last evaluation, less the one
+               that the evaluation itself counts */
+            if ((elapsed > 1) && functions->Time_Delay) {
+                (void)functions->Time_Delay(
+                    pEntry->object_instance, elapsed - 1, &remaining);
+            }
+            pEntry->stamp += elapsed * 1000UL;
+        } else {
+            pEntry->stamp = Engine_Time;
+        }
+        functions->Intrinsic_Reporting(pEntry->object_instance);
+        pEntry->flags &= ~EVENT_ENGINE_DELAY;
+        if (functions->Time_Delay &&
+            functions->Time_Delay(pEntry->object_instance, 0, &remaining)) {
+            pEntry->delay_time = pEntry->stamp + (remaining + 1UL) * 1000UL;
+            pEntry->flags |= EVENT_ENGINE_DELAY;
+        }
+    }
+    event_engine_active_update(entry, functions);
+}
+
+/**
+ * @brief Forget all of the objects and object types
+ */
+void event_engine_init(void)
+{
+    uint16_t i;
+
+    memset(Engine_Type, 0, sizeof(Engine_Type));
+    for (i = 0; i < BACNET_EVENT_ENGINE_OBJECTS; i++) {
+        Engine_Entry[i].flags = 0;
+        Engine_Entry[i].next = EVENT_ENGINE_NONE;
+        Engine_Entry[i].hash_next = 0;
+    }
+    memset(Engine_Hash, 0, sizeof(Engine_Hash));
+    Engine_Queue = EVENT_ENGINE_NONE;
+    Engine_Active_Count = 0;
+    Engine_Overflow = false;
+}
+
+/**
+ * @brief Give the functions of an object type to the engine
+ * @param object_type - BACnet object type
+ * @param functions - functions of the type, which must stay in memory
+ * @return true if there was room for the object type
+ */
+bool event_engine_type_set(
+    BACNET_OBJECT_TYPE object_type, const EVENT_ENGINE_FUNCTIONS *functions)
+{
+    unsigned i;
+
+    for (i = 0; i < BACNET_EVENT_ENGINE_TYPES; i++) {
+        if (Engine_Type[i].functions &&
+            (Engine_Type[i].object_type == object_type)) {
+            Engine_Type[i].functions = functions;
+            return true;
+        }
+    }
+    for (i = 0; i < BACNET_EVENT_ENGINE_TYPES; i++) {
+        if (!Engine_Type[i].functions) {
+            Engine_Type[i].object_type = (uint16_t)object_type;
+            Engine_Type[i].functions = functions;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Find out if the engine runs the intrinsic reporting of every
+ *  object of a type, so that the type need not be polled or scanned
+ * @param object_type - BACnet object type
+ * @return true if the engine has every object of the type
+ */
+bool event_engine_type_valid(BACNET_OBJECT_TYPE object_type)
+{
+    if (Engine_Overflow) {
+        return false;
+    }
+
+    return event_engine_functions(object_type) != NULL;
+}
+
+/**
+ * @brief Start tracking an object, and evaluate it at the next timer
+ * @param object_type - BACnet object type
+ * @param object_instance - instance number of the object
+ * @return true if the object is tracked
+ */
+bool event_engine_add(BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    uint16_t entry;
+    unsigned bucket;
+
+    entry = event_engine_find(object_type, object_instance);
+    if (entry == EVENT_ENGINE_NONE) {
+        for (entry = 0; entry < BACNET_EVENT_ENGINE_OBJECTS; entry++) {
+            if (!(Engine_Entry[entry].flags & EVENT_ENGINE_USED)) {
+                break;
+            }
+        }
+        if (entry == BACNET_EVENT_ENGINE_OBJECTS) {
+            Engine_Overflow = true;
+            return false;
+        }
+        Engine_Entry[entry].object_instance = object_instance;
+        Engine_Entry[entry].object_type = (uint16_t)object_type;
+        Engine_Entry[entry].stamp = Engine_Time;
+        Engine_Entry[entry].next = EVENT_ENGINE_NONE;
+        Engine_Entry[entry].flags = EVENT_ENGINE_USED;
+        bucket = event_engine_hash(object_type, object_instance);
+        Engine_Entry[entry].hash_next = Engine_Hash[bucket];
+        Engine_Hash[bucket] = entry + 1;
+    }
+    Engine_Entry[entry].flags |= EVENT_ENGINE_CHANGED;
+    event_engine_schedule(entry);
+
+    return true;
+}
+
+/**
+ * @brief After an object could not be added, track the objects of each
+ *  type that are not tracked yet, and put those with an active event in
+ *  the list of active events, so the lists can be used again
+ */
+static void event_engine_overflow_recover(void)
+{
+    const EVENT_ENGINE_FUNCTIONS *functions;
+    BACNET_OBJECT_TYPE object_type;
+    uint32_t object_instance;
+    uint16_t entry;
+    unsigned i, index, count;
+
+    for (i = 0; i < BACNET_EVENT_ENGINE_TYPES; i++) {
+        functions = Engine_Type[i].functions;
+        if (!functions) {
+            continue;
+        }
+        if (!functions->Count || !functions->Index_To_Instance) {
+            /* the missing objects cannot be found */
+            return;
+        }
+    }
+    Engine_Overflow = false;
+    for (i = 0; i < BACNET_EVENT_ENGINE_TYPES; i++) {
+        functions = Engine_Type[i].functions;
+        if (!functions) {
+            continue;
+        }
+        object_type = (BACNET_OBJECT_TYPE)Engine_Type[i].object_type;
+        count = functions->Count();
+        for (index = 0; index < count; index++) {
+            object_instance = functions->Index_To_Instance(index);
+            if (event_engine_find(object_type, object_instance) !=
+                EVENT_ENGINE_NONE) {
+                continue;
+            }
+            if (!event_engine_add(object_type, object_instance)) {
+                /* still more objects than entries */
+                return;
+            }
+            entry = event_engine_find(object_type, object_instance);
+            event_engine_active_update(entry, functions);
+        }
+    }
+}
+
+/**
+ * @brief Stop tracking an object, as when it is deleted
+ * @param object_type - BACnet object type
+ * @param object_instance - instance number of the object
+ */
+void event_engine_remove(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    uint16_t entry;
+
+    entry = event_engine_find(object_type, object_instance);
+    if (entry == EVENT_ENGINE_NONE) {
+        return;
+    }
+    event_engine_unlink(entry);
+    event_engine_active_remove(entry);
+    event_engine_hash_remove(entry);
+    Engine_Entry[entry].flags = 0;
+    if (Engine_Overflow) {
+        event_engine_overflow_recover();
+    }
+}
+
+/**
+ * @brief Tell the engine that the monitored value or the event
+ *  configuration of an object changed, so it is evaluated again
+ * @param object_type - BACnet object type
+ * @param object_instance - instance number of the object
+ */
+void event_engine_trigger(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    uint16_t entry;
+
+    entry = event_engine_find(object_type, object_instance);
+    if (entry == EVENT_ENGINE_NONE) {
+        return;
+    }
+    if (!(Engine_Entry[entry].flags & EVENT_ENGINE_CHANGED)) {
+        Engine_Entry[entry].flags |= EVENT_ENGINE_CHANGED;
+        event_engine_schedule(entry);
+    }
+}
+
+/**
+ * @brief Tell the engine that an alarm of an object was acknowledged. The
+ *  list of active events is updated now, and the acknowledgment
+ *  notification is sent at the next timer.
+ * @param object_type - BACnet object type
+ * @param object_instance - instance number of the object
+ */
+void event_engine_acknowledge(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    const EVENT_ENGINE_FUNCTIONS *functions;
+    uint16_t entry;
+
+    entry = event_engine_find(object_type, object_instance);
+    if (entry == EVENT_ENGINE_NONE) {
+        return;
+    }
+    functions = event_engine_functions(object_type);
+    if (functions) {
+        event_engine_active_update(entry, functions);
+    }
+    if (!(Engine_Entry[entry].flags & EVENT_ENGINE_ACK)) {
+        Engine_Entry[entry].flags |= EVENT_ENGINE_ACK;
+        event_engine_schedule(entry);
+    }
+}
+
+/**
+ * @brief Run the entries that have come due. Call this periodically, in
+ *  place of Device_local_reporting() for the types the engine has.
+ * @param milliseconds - time since the last call
+ */
+void event_engine_timer(uint16_t milliseconds)
+{
+    uint16_t entry;
+
+    Engine_Time += milliseconds;
+    while ((Engine_Queue != EVENT_ENGINE_NONE) &&
+           event_engine_time_reached(
+               Engine_Entry[Engine_Queue].due_time, Engine_Time)) {
+        entry = Engine_Queue;
+        event_engine_unlink(entry);
+        event_engine_evaluate(entry);
+        event_engine_schedule(entry);
+    }
+}
+
+/**
+ * @brief Get the number of objects with an active event
+ * @return number of objects in the list of active events
+ */
+unsigned event_engine_active_count(void)
+{
+    if (Engine_Overflow) {
+        return 0;
+    }
+
+    return Engine_Active_Count;
+}
+
+/**
+ * @brief Find where a GetEventInformation continuation resumes in the
+ *  list of active events
+ * @param object_type - type of the last object received by the client
+ * @param object_instance - instance of the last object received
+ * @return position of the first active event after that object
+ */
+unsigned event_engine_active_next(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    if (Engine_Overflow) {
+        return 0;
+    }
+    if (object_instance >= BACNET_MAX_INSTANCE) {
+        /* after every instance of the type */
+        return event_engine_active_search(
+            (BACNET_OBJECT_TYPE)(object_type + 1), 0);
+    }
+
+    return event_engine_active_search(object_type, object_instance + 1);
+}
+
+/**
+ * @brief Get the event information of an object in the list of active
+ *  events, in the form of a GetEventInformation handler function
+ * @param index - position in the list of active events, 0..count
+ * @param getevent_data - filled with the event information
+ * @return 1 if an active event is found, 0 if no active event, -1 if
+ *  end of list
+ */
+int event_engine_event_information(
+    unsigned index, BACNET_GET_EVENT_INFORMATION_DATA *getevent_data)
+{
+    const struct event_engine_entry *pEntry;
+    const EVENT_ENGINE_FUNCTIONS *functions;
+
+    if (index >= event_engine_active_count()) {
+        return -1;
+    }
+    pEntry = &Engine_Entry[Engine_Active[index]];
+    functions = event_engine_functions(pEntry->object_type);
+    if (!functions || !functions->Event_Information ||
+        !functions->Instance_To_Index) {
+        return 0;
+    }
+    if (functions->Event_Information(
+            functions->Instance_To_Index(pEntry->object_instance),
+            getevent_data) > 0) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get the alarm summary of an object in the list of active
+ *  events, in the form of a GetAlarmSummary handler function
+ * @param index - position in the list of active events, 0..count
+ * @param getalarm_data - filled with the alarm summary
+ * @return 1 if an active alarm is found, 0 if no active alarm, -1 if
+ *  end of list
+ */
+int event_engine_alarm_summary(
+    unsigned index, BACNET_GET_ALARM_SUMMARY_DATA *getalarm_data)
+{
+    const struct event_engine_entry *pEntry;
+    const EVENT_ENGINE_FUNCTIONS *functions;
+
+    if (index >= event_engine_active_count()) {
+        return -1;
+    }
+    pEntry = &Engine_Entry[Engine_Active[index]];
+    functions = event_engine_functions(pEntry->object_type);
+    if (!functions || !functions->Alarm_Summary ||
+        !functions->Instance_To_Index) {
+        return 0;
+    }
+    if (functions->Alarm_Summary(
+            functions->Instance_To_Index(pEntry->object_instance),
+            getalarm_data) > 0) {
+        return 1;
+    }
+
+    return 0;
+}
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file
+ * @brief API for a change-driven scheduler of intrinsic reporting
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_BASIC_OBJECT_EVENT_ENGINE_H
+#define BACNET_BASIC_OBJECT_EVENT_ENGINE_H
+#include <stdbool.h>
+#include <stdint.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "../../../bacnet/bacdef.h"
+/* BACnet Stack API */
+//#include "bacnet/get_alarm_sum.h"
+#include "../../../bacnet/get_alarm_sum.h"
+//#include "bacnet/getevent.h"
+#include "../../../bacnet/getevent.h"
+
+/* The engine runs the intrinsic reporting of an object only when its
+   value or configuration changes, when an acknowledgment is to be sent,
+   or when a time delay runs out, instead of every object every second.
+   Objects waiting for an evaluation are kept in a queue sorted by due
+   time, so event_engine_timer() looks at the head of the queue only.
+   The engine also keeps the list of objects with an active event, sorted
+   by object identifier, which answers GetEventInformation and
+   GetAlarmSummary.  It is updated when the event state changes and when
+   an alarm is acknowledged.  An object type takes part by calling
+   event_engine_type_set() and tracking each of its objects with
+   event_engine_add(). */
+#if BACNET_EVENT_ENGINE_ENABLED
+
+/**
+ * @brief Report on the time delay of the intrinsic reporting of an
+ *  object. Seconds that passed while a transition was waiting out its
+ *  time delay are first taken off the remaining delay.
+ * @param object_instance - instance number of the object
+ * @param elapsed - seconds to take off the remaining delay
+ * @param remaining - filled with the seconds left in the time delay
+ * @return true if a transition is waiting out its time delay
+ */
+typedef bool (*event_engine_time_delay_function)(
+    uint32_t object_instance, uint32_t elapsed, uint32_t *remaining);
+
+/**
+ * The functions of an object type used by the engine.  The event
+ * information and alarm summary functions are the ones given to the
+ * GetEventInformation and GetAlarmSummary handlers, and take the index
+ * of the object.  The count and index functions let the engine pick up
+ * the objects it had no room for, once there is room again.
+ * @{
+ */
+typedef struct event_engine_functions {
+    void (*Intrinsic_Reporting)(uint32_t object_instance);
+    event_engine_time_delay_function Time_Delay;
+    unsigned (*Count)(void);
+    uint32_t (*Index_To_Instance)(unsigned index);
+    unsigned (*Instance_To_Index)(uint32_t object_instance);
+    get_event_info_function Event_Information;
+    get_alarm_summary_function Alarm_Summary;
+} EVENT_ENGINE_FUNCTIONS;
+/** @} */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+void event_engine_init(void);
+BACNET_STACK_EXPORT
+bool event_engine_type_set(
+    BACNET_OBJECT_TYPE object_type, const EVENT_ENGINE_FUNCTIONS *functions);
+BACNET_STACK_EXPORT
+bool event_engine_type_valid(BACNET_OBJECT_TYPE object_type);
+BACNET_STACK_EXPORT
+bool event_engine_add(BACNET_OBJECT_TYPE object_type, uint32_t object_instance);
+BACNET_STACK_EXPORT
+void event_engine_remove(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance);
+BACNET_STACK_EXPORT
+void event_engine_trigger(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance);
+BACNET_STACK_EXPORT
+void event_engine_acknowledge(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance);
+BACNET_STACK_EXPORT
+void event_engine_timer(uint16_t milliseconds);
+BACNET_STACK_EXPORT
+unsigned event_engine_active_count(void);
+BACNET_STACK_EXPORT
+unsigned event_engine_active_next(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance);
+BACNET_STACK_EXPORT
+int event_engine_event_information(
+    unsigned index, BACNET_GET_EVENT_INFORMATION_DATA *getevent_data);
+BACNET_STACK_EXPORT
+int event_engine_alarm_summary(
+    unsigned index, BACNET_GET_ALARM_SUMMARY_DATA *getalarm_data);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#else
+#define event_engine_type_valid(object_type) ((void)(object_type), false)
+#define event_engine_add(object_type, object_instance) \
+    ((void)(object_type), (void)(object_instance), false)
+#define event_engine_remove(object_type, object_instance) \
+    ((void)(object_type), (void)(object_instance))
+#define event_engine_trigger(object_type, object_instance) \
+    ((void)(object_type), (void)(object_instance))
+#define event_engine_acknowledge(object_type, object_instance) \
+    ((void)(object_type), (void)(object_instance))
+#endif
+#endif
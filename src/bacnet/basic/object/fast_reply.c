@@ -0,0 +1,310 @@
+/**
+ * @file
+ * @brief A table of precomputed ReadProperty answers for MS/TP
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "../../../bacnet/bacdef.h"
+/* BACnet Stack API */
+//#include "bacnet/bacdcode.h"
+#include "../../../bacnet/bacdcode.h"
+//#include "bacnet/bacstr.h"
+#include "../../../bacnet/bacstr.h"
+//#include "bacnet/dcc.h"
+#include "../../../bacnet/dcc.h"
+//#include "bacnet/npdu.h"
+#include "../../../bacnet/npdu.h"
+//#include "bacnet/rp.h"
+#include "../../../bacnet/rp.h"
+//#include "bacnet/basic/object/fast_reply.h"
+#include "../../../bacnet/basic/object/fast_reply.h"
+
+#if BACNET_MSTP_FAST_REPLY_ENABLED
+/* one encoded property value */
+struct fast_reply_entry {
+    uint32_t object_instance;
+    BACNET_PROPERTY_ID object_property;
+    BACNET_OBJECT_TYPE object_type;
+    /* length of the value; zero if the entry is empty */
+    uint8_t length;
+    uint8_t value[BACNET_FAST_REPLY_VALUE_SIZE];
+};
+static struct fast_reply_entry Fast_Reply[BACNET_FAST_REPLY_ENTRIES];
+
+/**
+ * @brief Find the entry for a property of an object
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ * @param object_property - BACnet property identifier
+ * @return the entry, or NULL if the property is not in the table
+ */
+static struct fast_reply_entry *fast_reply_entry_find(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property)
+{
+    unsigned i;
+    struct fast_reply_entry *entry;
+
+    for (i = 0; i < BACNET_FAST_REPLY_ENTRIES; i++) {
+        entry = &Fast_Reply[i];
+        if (entry->length && (entry->object_instance == object_instance) &&
+            (entry->object_property == object_property) &&
+            (entry->object_type == object_type)) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Set the encoded value of a property of an object. A property
+ *  that is not yet in the table is added if an entry is free.
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ * @param object_property - BACnet property identifier
+ * @param value - the application tagged value
+ * @param length - number of octets of the value; a value that is empty or
+ *  does not fit an entry is removed, so that it takes the normal path
+ */
+void fast_reply_value_set(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    const uint8_t *value,
+    size_t length)
+{
+    unsigned i;
+    struct fast_reply_entry *entry;
+
+    entry =
+        fast_reply_entry_find(object_type, object_instance, object_property);
+    if (!value || (length == 0) || (length > BACNET_FAST_REPLY_VALUE_SIZE)) {
+        if (entry) {
+            entry->length = 0;
+        }
+        return;
+    }
+    for (i = 0; !entry && (i < BACNET_FAST_REPLY_ENTRIES); i++) {
+        if (Fast_Reply[i].length == 0) {
+            entry = &Fast_Reply[i];
+            entry->object_type = object_type;
+            entry->object_instance = object_instance;
+            entry->object_property = object_property;
+        }
+    }
+    if (entry) {
+        memcpy(entry->value, value, length);
+        entry->length = (uint8_t)length;
+    }
+}
+
+/**
+ * @brief Set the REAL value of a property of an object
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ * @param object_property - BACnet property identifier
+ * @param value - the value
+ */
+void fast_reply_real_set(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    float value)
+{
+    uint8_t apdu[8];
+    int len;
+
+    len = encode_application_real(apdu, value);
+    fast_reply_value_set(
+        object_type, object_instance, object_property, apdu, (size_t)len);
+}
+
+/**
+ * @brief Set the ENUMERATED value of a property of an object
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ * @param object_property - BACnet property identifier
+ * @param value - the value
+ */
+void fast_reply_enumerated_set(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    uint32_t value)
+{
+    uint8_t apdu[8];
+    int len;
+
+    len = encode_application_enumerated(apdu, value);
+    fast_reply_value_set(
+        object_type, object_instance, object_property, apdu, (size_t)len);
+}
+
+/**
+ * @brief Set the Status_Flags of an object
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ * @param in_alarm - the IN_ALARM flag
+ * @param fault - the FAULT flag
+ * @param overridden - the OVERRIDDEN flag
+ * @param out_of_service - the OUT_OF_SERVICE flag
+ */
+void fast_reply_status_flags_set(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    bool in_alarm,
+    bool fault,
+    bool overridden,
+    bool out_of_service)
+{
+    BACNET_BIT_STRING bit_string;
+    uint8_t apdu[8];
+    int len;
+
+    bitstring_init(&bit_string);
+    bitstring_set_bit(&bit_string, STATUS_FLAG_IN_ALARM, in_alarm);
+    bitstring_set_bit(&bit_string, STATUS_FLAG_FAULT, fault);
+    bitstring_set_bit(&bit_string, STATUS_FLAG_OVERRIDDEN, overridden);
+    bitstring_set_bit(&bit_string, STATUS_FLAG_OUT_OF_SERVICE, out_of_service);
+    len = encode_application_bitstring(apdu, &bit_string);
+    fast_reply_value_set(
+        object_type, object_instance, PROP_STATUS_FLAGS, apdu, (size_t)len);
+}
+
+/**
+ * @brief Set the Object_Name of an object
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ * @param object_name - view of the object name
+ */
+void fast_reply_name_set(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    const BACNET_CHARACTER_STRING_VIEW *object_name)
+{
+    uint8_t apdu[BACNET_FAST_REPLY_VALUE_SIZE];
+    int len = 0;
+
+    if (object_name &&
+        (encode_application_character_string_view(NULL, object_name) <=
+         (int)sizeof(apdu))) {
+        len = encode_application_character_string_view(apdu, object_name);
+    }
+    fast_reply_value_set(
+        object_type, object_instance, PROP_OBJECT_NAME, apdu, (size_t)len);
+}
+
+/**
+ * @brief Remove the properties of an object from the table
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ */
+void fast_reply_object_remove(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    unsigned i;
+
+    for (i = 0; i < BACNET_FAST_REPLY_ENTRIES; i++) {
+        if ((Fast_Reply[i].object_instance == object_instance) &&
+            (Fast_Reply[i].object_type == object_type)) {
+            Fast_Reply[i].length = 0;
+        }
+    }
+}
+
+/**
+ * @brief Remove every value from the table
+ */
+void fast_reply_clear(void)
+{
+    unsigned i;
+
+    for (i = 0; i < BACNET_FAST_REPLY_ENTRIES; i++) {
+        Fast_Reply[i].length = 0;
+    }
+}
+
+/**
+ * @brief Answer a ReadProperty request from the table. Only a whole
+ *  property of an object in the table is answered, in a request that is
+ *  not segmented and whose reply would need no network layer routing.
+ * @param src - MS/TP address of the node that sent the request
+ * @param pdu - the NPDU of the Data Expecting Reply frame
+ * @param pdu_len - number of octets in the NPDU
+ * @param reply - buffer for the NPDU of the reply
+ * @param reply_size - size of the reply buffer
+ * @return number of octets of the reply, or 0 if the request takes the
+ *  normal path
+ */
+int fast_reply_handler(
+    uint8_t src,
+    const uint8_t *pdu,
+    uint16_t pdu_len,
+    uint8_t *reply,
+    uint16_t reply_size)
+{
+    BACNET_ADDRESS dest = { 0 };
+    BACNET_ADDRESS source = { 0 };
+    BACNET_NPDU_DATA npdu_data = { 0 };
+    BACNET_READ_PROPERTY_DATA rpdata = { 0 };
+    const struct fast_reply_entry *entry;
+    const uint8_t *apdu;
+    uint16_t apdu_len;
+    uint8_t invoke_id;
+    int offset, len;
+
+    if (!pdu || !reply || !dcc_communication_enabled()) {
+        return 0;
+    }
+    offset = bacnet_npdu_decode(pdu, pdu_len, &dest, &source, &npdu_data);
+    if ((offset <= 0) || npdu_data.network_layer_message ||
+        !npdu_data.data_expecting_reply || (dest.net != 0)) {
+        return 0;
+    }
+    apdu = &pdu[offset];
+    apdu_len = pdu_len - (uint16_t)offset;
+    /* confirmed request, not segmented: type, max-segs/max-apdu,
+       invoke-id, service choice */
+    if ((apdu_len < 4) || (apdu[0] != PDU_TYPE_CONFIRMED_SERVICE_REQUEST) ||
+        (apdu[3] != SERVICE_CONFIRMED_READ_PROPERTY)) {
+        return 0;
+    }
+    invoke_id = apdu[2];
+    len = rp_decode_service_request(&apdu[4], apdu_len - 4, &rpdata);
+    if ((len <= 0) || (rpdata.array_index != BACNET_ARRAY_ALL)) {
+        return 0;
+    }
+    entry = fast_reply_entry_find(
+        rpdata.object_type, rpdata.object_instance, rpdata.object_property);
+    if (!entry) {
+        return 0;
+    }
+    /* the reply goes back the way the request came */
+    source.mac_len = 1;
+    source.mac[0] = src;
+    npdu_encode_npdu_data(&npdu_data, false, npdu_data.priority);
+    offset = npdu_encode_pdu(NULL, &source, NULL, &npdu_data);
+    len = rp_ack_encode_apdu_init(NULL, invoke_id, &rpdata);
+    len += entry->length;
+    len += rp_ack_encode_apdu_object_property_end(NULL);
+    if ((len > decode_max_apdu(apdu[1])) || ((offset + len) > reply_size)) {
+        return 0;
+    }
+    offset = npdu_encode_pdu(reply, &source, NULL, &npdu_data);
+    offset += rp_ack_encode_apdu_init(&reply[offset], invoke_id, &rpdata);
+    memcpy(&reply[offset], entry->value, entry->length);
+    offset += entry->length;
+    offset += rp_ack_encode_apdu_object_property_end(&reply[offset]);
+
+    return offset;
+}
+#endif
@@ -0,0 +1,102 @@
+/**
+ * @file
+ * @brief API for a table of precomputed ReadProperty answers for MS/TP
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_BASIC_OBJECT_FAST_REPLY_H
+#define BACNET_BASIC_OBJECT_FAST_REPLY_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "../../../bacnet/bacdef.h"
+/* BACnet Stack API */
+//#include "bacnet/bacstr.h"
+#include "../../../bacnet/bacstr.h"
+
+/* The table holds the encoded Present_Value, Status_Flags and Object_Name
+   of objects, so that a ReadProperty of one of them can be answered in
+   the MS/TP datalink without waiting for the application.  The object
+   modules set a value in the table when it changes; a value is added
+   while the table has a free entry, and an object that is deleted is
+   removed.  A request for anything not in the table takes the normal
+   path.  fast_reply_handler() is given to dlmstp_set_fast_reply_callback()
+   by the application. */
+#if BACNET_MSTP_FAST_REPLY_ENABLED
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+void fast_reply_value_set(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    const uint8_t *value,
+    size_t length);
+BACNET_STACK_EXPORT
+void fast_reply_real_set(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    float value);
+BACNET_STACK_EXPORT
+void fast_reply_enumerated_set(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    uint32_t value);
+BACNET_STACK_EXPORT
+void fast_reply_status_flags_set(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    bool in_alarm,
+    bool fault,
+    bool overridden,
+    bool out_of_service);
+BACNET_STACK_EXPORT
+void fast_reply_name_set(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    const BACNET_CHARACTER_STRING_VIEW *object_name);
+BACNET_STACK_EXPORT
+void fast_reply_object_remove(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance);
+BACNET_STACK_EXPORT
+void fast_reply_clear(void);
+BACNET_STACK_EXPORT
+int fast_reply_handler(
+    uint8_t src,
+    const uint8_t *pdu,
+    uint16_t pdu_len,
+    uint8_t *reply,
+    uint16_t reply_size);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#else
+#define fast_reply_real_set(                                          \
+    object_type, object_instance, object_property, value)             \
+    ((void)(object_type), (void)(object_instance),                    \
+     (void)(object_property), (void)(value))
+#define fast_reply_enumerated_set(                                    \
+    object_type, object_instance, object_property, value)             \
+    ((void)(object_type), (void)(object_instance),                    \
+     (void)(object_property), (void)(value))
+#define fast_reply_status_flags_set(                                  \
+    object_type, object_instance, in_alarm, fault, overridden,        \
+    out_of_service)                                                   \
+    ((void)(object_type), (void)(object_instance), (void)(in_alarm),  \
+     (void)(fault), (void)(overridden), (void)(out_of_service))
+#define fast_reply_name_set(object_type, object_instance, object_name) \
+    ((void)(object_type), (void)(object_instance), (void)(object_name))
+#define fast_reply_object_remove(object_type, object_instance) \
+    ((void)(object_type), (void)(object_instance))
+#define fast_reply_clear()
+#endif
+#endif
@@ -26,6 +26,8 @@
 #include "../../../../bacnet/wp.h" /* write property handling */
 //#include "bacnet/rp.h"
 #include "../../../../bacnet/rp.h" /* read property handling */
+//#include "bacnet/rp_cache.h"
+#include "../../../../bacnet/rp_cache.h"
 //#include "bacnet/reject.h"
 #include "../../../../bacnet/reject.h"
 //#include "bacnet/version.h"
@@ -593,6 +595,7 @@ void Routed_Device_Inc_Database_Revision(void)
 {
     DEVICE_OBJECT_DATA *pDev = &Devices[iCurrent_Device_Idx];
     pDev->Database_Revision++;
+    rp_cache_invalidate_all();
 }
 
 /** Check to see if the current Device supports this service.
@@ -34,6 +34,12 @@
 #include "../../../bacnet/basic/sys/debug.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 /* me! */
 //#include "bacnet/basic/object/iv.h"
 #include "../../../bacnet/basic/object/iv.h"
@@ -287,6 +293,8 @@ bool Integer_Value_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(OBJECT_INTEGER_VALUE, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_INTEGER_VALUE, object_instance);
     }
 
     return status;
@@ -354,6 +362,7 @@ bool Integer_Value_Description_Set(
     pObject = Integer_Value_Object(object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_INTEGER_VALUE, object_instance);
         pObject->Description = new_name;
     }
 
@@ -418,6 +427,7 @@ bool Integer_Value_Units_Set(
     if (pObject) {
         pObject->Units = units;
         status = true;
+        rp_cache_object_invalidate(OBJECT_INTEGER_VALUE, object_instance);
     }
 
     return status;
@@ -814,6 +824,9 @@ uint32_t Integer_Value_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -832,6 +845,8 @@ bool Integer_Value_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
@@ -29,6 +29,12 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 //#include "bacnet/basic/sys/linear.h"
 #include "../../../bacnet/basic/sys/linear.h"
 //#include "bacnet/basic/sys/debug.h"
@@ -1178,6 +1184,9 @@ bool Lighting_Output_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(
+            OBJECT_LIGHTING_OUTPUT, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_LIGHTING_OUTPUT, object_instance);
     }
 
     return status;
@@ -1242,6 +1251,7 @@ bool Lighting_Output_Description_Set(
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_LIGHTING_OUTPUT, object_instance);
         pObject->Description = new_name;
     }
 
@@ -3506,6 +3516,9 @@ uint32_t Lighting_Output_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -3524,6 +3537,8 @@ bool Lighting_Output_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
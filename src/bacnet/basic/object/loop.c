@@ -41,6 +41,12 @@
 #include "../../../bacnet/basic/sys/debug.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 /* me! */
 //#include "bacnet/basic/object/loop.h"
 #include "../../../bacnet/basic/object/loop.h"
@@ -324,6 +330,8 @@ bool Loop_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(OBJECT_LOOP, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_LOOP, object_instance);
     }
 
     return status;
@@ -386,6 +394,7 @@ bool Loop_Description_Set(uint32_t object_instance, const char *new_name)
     pObject = Object_Data(object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_LOOP, object_instance);
         pObject->Description = new_name;
     }
 
@@ -631,6 +640,7 @@ bool Loop_Output_Units_Set(
     if (pObject) {
         pObject->Output_Units = units;
         status = true;
+        rp_cache_object_invalidate(OBJECT_LOOP, object_instance);
     }
 
     return status;
@@ -860,6 +870,7 @@ bool Loop_Controlled_Variable_Units_Set(
     if (pObject) {
         pObject->Controlled_Variable_Units = units;
         status = true;
+        rp_cache_object_invalidate(OBJECT_LOOP, object_instance);
     }
 
     return status;
@@ -1064,6 +1075,7 @@ bool Loop_Proportional_Constant_Units_Set(
     if (pObject) {
         pObject->Proportional_Constant_Units = units;
         status = true;
+        rp_cache_object_invalidate(OBJECT_LOOP, object_instance);
     }
 
     return status;
@@ -1143,6 +1155,7 @@ bool Loop_Integral_Constant_Units_Set(
     if (pObject) {
         pObject->Integral_Constant_Units = units;
         status = true;
+        rp_cache_object_invalidate(OBJECT_LOOP, object_instance);
     }
 
     return status;
@@ -1223,6 +1236,7 @@ bool Loop_Derivative_Constant_Units_Set(
     if (pObject) {
         pObject->Derivative_Constant_Units = units;
         status = true;
+        rp_cache_object_invalidate(OBJECT_LOOP, object_instance);
     }
 
     return status;
@@ -2250,6 +2264,9 @@ uint32_t Loop_Create(uint32_t object_instance)
     pObject->Out_Of_Service = false;
     pObject->Changed = false;
     pObject->Context = NULL;
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -2268,6 +2285,8 @@ bool Loop_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
@@ -32,6 +32,12 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 //#include "bacnet/proplist.h"
 #include "../../../bacnet/proplist.h"
 /* me! */
@@ -245,6 +251,9 @@ bool Life_Safety_Zone_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(
+            OBJECT_LIFE_SAFETY_ZONE, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_LIFE_SAFETY_ZONE, object_instance);
     }
 
     return status;
@@ -934,6 +943,9 @@ uint32_t Life_Safety_Zone_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -954,6 +966,8 @@ bool Life_Safety_Zone_Delete(uint32_t object_instance)
         Keylist_Delete(pObject->Zone_Members);
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
@@ -43,6 +43,12 @@
 #include "../../../bacnet/basic/services.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 /* me! */
 #include "mso.h"
 
@@ -694,6 +700,34 @@ void Multistate_Output_Out_Of_Service_Set(uint32_t object_instance, bool value)
     }
 }
 
+/**
+ * @brief For a given object instance-number, gets a view of the
+ *  object-name, without copying it
+ * @param  object_instance - object-instance number of the object
+ * @param  object_name - holds the view of the object-name
+ * @param  text - buffer for a default object-name, which must outlive
+ *  the view
+ * @param  text_size - size of the text buffer
+ * @return  true if object-name was retrieved
+ */
+static bool Multistate_Output_Object_Name_View(
+    uint32_t object_instance,
+    BACNET_CHARACTER_STRING_VIEW *object_name,
+    char *text,
+    size_t text_size)
+{
+    struct object_data *pObject;
+
+    pObject = Keylist_Data(Object_List, object_instance);
+    if (!pObject) {
+        return false;
+    }
+
+    return characterstring_view_object_name(
+        object_name, pObject->Object_Name, "MULTI-STATE OUTPUT %lu",
+        object_instance, text, text_size);
+}
+
 /**
  * @brief For a given object instance-number, loads the object-name into
  *  a characterstring. Note that the object name must be unique
@@ -707,20 +741,12 @@ bool Multistate_Output_Object_Name(
     uint32_t object_instance, BACNET_CHARACTER_STRING *object_name)
 {
     bool status = false;
-    struct object_data *pObject;
+    BACNET_CHARACTER_STRING_VIEW name;
     char name_text[32];
 
-    pObject = Keylist_Data(Object_List, object_instance);
-    if (pObject) {
-        if (pObject->Object_Name) {
-            status =
-                characterstring_init_ansi(object_name, pObject->Object_Name);
-        } else {
-            snprintf(
-                name_text, sizeof(name_text), "MULTI-STATE OUTPUT %lu",
-                (unsigned long)object_instance);
-            status = characterstring_init_ansi(object_name, name_text);
-        }
+    if (Multistate_Output_Object_Name_View(
+            object_instance, &name, name_text, sizeof(name_text))) {
+        status = characterstring_view_copy(object_name, &name);
     }
 
     return status;
@@ -742,6 +768,9 @@ bool Multistate_Output_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(
+            OBJECT_MULTI_STATE_OUTPUT, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_MULTI_STATE_OUTPUT, object_instance);
     }
 
     return status;
@@ -803,14 +832,15 @@ static int Multistate_Output_State_Text_Encode(
 {
     int apdu_len = BACNET_STATUS_ERROR;
     const char *pName = NULL; /* return value */
-    BACNET_CHARACTER_STRING char_string = { 0 };
+    BACNET_CHARACTER_STRING_VIEW char_string = { 0 };
     uint32_t state_index = 1;
 
     state_index += index;
     pName = Multistate_Output_State_Text(object_instance, state_index);
     if (pName) {
-        characterstring_init_ansi(&char_string, pName);
-        apdu_len = encode_application_character_string(apdu, &char_string);
+        characterstring_view_init_ansi(&char_string, pName);
+        apdu_len =
+            encode_application_character_string_view(apdu, &char_string);
     }
 
     return apdu_len;
@@ -960,6 +990,7 @@ bool Multistate_Output_Description_Set(
     pObject = Keylist_Data(Object_List, object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_MULTI_STATE_OUTPUT, object_instance);
         pObject->Description = new_name;
     }
 
@@ -1039,7 +1070,8 @@ int Multistate_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
     int apdu_len = 0; /* return value */
     int apdu_size = 0;
     BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
+    BACNET_CHARACTER_STRING_VIEW char_string;
+    char name_text[32];
     uint32_t present_value = 0;
     unsigned i = 0;
     uint32_t max_states = 0;
@@ -1065,10 +1097,11 @@ int Multistate_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
                 &apdu[0], Object_Type, rpdata->object_instance);
             break;
         case PROP_OBJECT_NAME:
-            Multistate_Output_Object_Name(
-                rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            Multistate_Output_Object_Name_View(
+                rpdata->object_instance, &char_string, name_text,
+                sizeof(name_text));
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len = encode_application_enumerated(&apdu[0], Object_Type);
@@ -1141,11 +1174,11 @@ int Multistate_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             }
             break;
         case PROP_DESCRIPTION:
-            characterstring_init_ansi(
+            characterstring_view_init_ansi(
                 &char_string,
                 Multistate_Output_Description(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_CURRENT_COMMAND_PRIORITY:
             i = Multistate_Output_Present_Value_Priority(
@@ -1343,6 +1376,9 @@ uint32_t Multistate_Output_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -1361,6 +1397,8 @@ bool Multistate_Output_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
@@ -25,6 +25,12 @@
 #include "../../../bacnet/wp.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 //#include "bacnet/basic/services.h"
 #include "../../../bacnet/basic/services.h"
 /* me! */
@@ -264,14 +270,15 @@ static int Multistate_Value_State_Text_Encode(
 {
     int apdu_len = BACNET_STATUS_ERROR;
     const char *pName = NULL; /* return value */
-    BACNET_CHARACTER_STRING char_string = { 0 };
+    BACNET_CHARACTER_STRING_VIEW char_string = { 0 };
     uint32_t state_index = 1;
 
     state_index += index;
     pName = Multistate_Value_State_Text(object_instance, state_index);
     if (pName) {
-        characterstring_init_ansi(&char_string, pName);
-        apdu_len = encode_application_character_string(apdu, &char_string);
+        characterstring_view_init_ansi(&char_string, pName);
+        apdu_len =
+            encode_application_character_string_view(apdu, &char_string);
     }
 
     return apdu_len;
@@ -500,6 +507,34 @@ static bool Multistate_Value_Out_Of_Service_Write(
     return status;
 }
 
+/**
+ * @brief For a given object instance-number, gets a view of the
+ *  object-name, without copying it
+ * @param  object_instance - object-instance number of the object
+ * @param  object_name - holds the view of the object-name
+ * @param  text - buffer for a default object-name, which must outlive
+ *  the view
+ * @param  text_size - size of the text buffer
+ * @return  true if object-name was retrieved
+ */
+static bool Multistate_Value_Object_Name_View(
+    uint32_t object_instance,
+    BACNET_CHARACTER_STRING_VIEW *object_name,
+    char *text,
+    size_t text_size)
+{
+    struct object_data *pObject;
+
+    pObject = Multistate_Value_Object(object_instance);
+    if (!pObject) {
+        return false;
+    }
+
+    return characterstring_view_object_name(
+        object_name, pObject->Object_Name, "MULTI-STATE VALUE %lu",
+        object_instance, text, text_size);
+}
+
 /**
  * @brief For a given object instance-number, loads the object-name into
  *  a characterstring. Note that the object name must be unique
@@ -513,20 +548,12 @@ bool Multistate_Value_Object_Name(
     uint32_t object_instance, BACNET_CHARACTER_STRING *object_name)
 {
     bool status = false;
-    struct object_data *pObject;
+    BACNET_CHARACTER_STRING_VIEW name;
     char name_text[32];
 
-    pObject = Multistate_Value_Object(object_instance);
-    if (pObject) {
-        if (pObject->Object_Name) {
-            status =
-                characterstring_init_ansi(object_name, pObject->Object_Name);
-        } else {
-            snprintf(
-                name_text, sizeof(name_text), "MULTI-STATE VALUE %lu",
-                (unsigned long)object_instance);
-            status = characterstring_init_ansi(object_name, name_text);
-        }
+    if (Multistate_Value_Object_Name_View(
+            object_instance, &name, name_text, sizeof(name_text))) {
+        status = characterstring_view_copy(object_name, &name);
     }
 
     return status;
@@ -548,6 +575,9 @@ bool Multistate_Value_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(
+            OBJECT_MULTI_STATE_VALUE, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_MULTI_STATE_VALUE, object_instance);
     }
 
     return status;
@@ -680,6 +710,7 @@ bool Multistate_Value_Description_Set(
     pObject = Multistate_Value_Object(object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_MULTI_STATE_VALUE, object_instance);
         pObject->Description = new_name;
     }
 
@@ -757,7 +788,8 @@ int Multistate_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
     int apdu_len = 0; /* return value */
     int apdu_size = 0;
     BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
+    BACNET_CHARACTER_STRING_VIEW char_string;
+    char name_text[32];
     uint32_t present_value = 0;
     uint32_t max_states = 0;
     bool state = false;
@@ -777,9 +809,11 @@ int Multistate_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             /* note: Name and Description don't have to be the same.
                You could make Description writable and different */
         case PROP_OBJECT_NAME:
-            Multistate_Value_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            Multistate_Value_Object_Name_View(
+                rpdata->object_instance, &char_string, name_text,
+                sizeof(name_text));
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         case PROP_OBJECT_TYPE:
             apdu_len = encode_application_enumerated(&apdu[0], Object_Type);
@@ -834,11 +868,11 @@ int Multistate_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             }
             break;
         case PROP_DESCRIPTION:
-            characterstring_init_ansi(
+            characterstring_view_init_ansi(
                 &char_string,
                 Multistate_Value_Description(rpdata->object_instance));
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
         default:
             rpdata->error_class = ERROR_CLASS_PROPERTY;
@@ -1039,6 +1073,9 @@ uint32_t Multistate_Value_Create(uint32_t object_instance)
             return BACNET_MAX_INSTANCE;
         }
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -1057,6 +1094,8 @@ bool Multistate_Value_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
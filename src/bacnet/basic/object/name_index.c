@@ -0,0 +1,213 @@
+/**
+ * @file
+ * @brief A device-wide index from object name to object identifier
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "../../../bacnet/bacdef.h"
+/* BACnet Stack API */
+//#include "bacnet/bacstr.h"
+#include "../../../bacnet/bacstr.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+
+#if BACNET_OBJECT_NAME_INDEX_ENABLED
+/* marks an empty entry; not a valid object identifier */
+#define NAME_INDEX_EMPTY UINT32_MAX
+/* one name: the hash of the name, and the object that holds it */
+struct name_index_entry {
+    uint32_t hash;
+    uint32_t object_id;
+};
+/* open addressing with linear probing; entries are never removed,
+   so a probe ends at the first empty entry */
+static struct name_index_entry Name_Index[BACNET_OBJECT_NAME_INDEX_SIZE];
+/* number of entries in use, including those left behind */
+static uint32_t Name_Index_Count;
+/* true once every object name has been added */
+static bool Name_Index_Valid;
+
+/**
+ * @brief Hash the octets of a name (FNV-1a)
+ * @param name - octets of the name, not terminated
+ * @param length - number of octets
+ * @return hash of the name
+ */
+static uint32_t name_index_hash(const char *name, size_t length)
+{
+    uint32_t hash = 2166136261UL;
+    size_t i;
+
+    for (i = 0; i < length; i++) {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Add a name hash to the index. When the index is three quarters
+ *  full, mostly with entries left behind by renames, it is dropped so
+ *  that it is filled again from the objects.
+ * @param hash - hash of the name
+ * @param object_id - object that holds the name
+ */
+static void name_index_insert(uint32_t hash, uint32_t object_id)
+{
+    uint32_t index;
+
+    if (!Name_Index_Valid) {
+        return;
+    }
+    if (Name_Index_Count >= BACNET_OBJECT_NAME_INDEX_CAPACITY) {
+        Name_Index_Valid = false;
+        return;
+    }
+    index = hash & (BACNET_OBJECT_NAME_INDEX_SIZE - 1);
+    while (Name_Index[index].object_id != NAME_INDEX_EMPTY) {
+        if ((Name_Index[index].hash == hash) &&
+            (Name_Index[index].object_id == object_id)) {
+            /* already indexed */
+            return;
+        }
+        index = (index + 1) & (BACNET_OBJECT_NAME_INDEX_SIZE - 1);
+    }
+    Name_Index[index].hash = hash;
+    Name_Index[index].object_id = object_id;
+    Name_Index_Count++;
+}
+
+/**
+ * @brief Empty the index and mark it valid, before every object name
+ *  is added to it with object_name_index_add()
+ */
+void object_name_index_clear(void)
+{
+    uint32_t index;
+
+    for (index = 0; index < BACNET_OBJECT_NAME_INDEX_SIZE; index++) {
+        Name_Index[index].object_id = NAME_INDEX_EMPTY;
+    }
+    Name_Index_Count = 0;
+    Name_Index_Valid = true;
+}
+
+/**
+ * @brief Mark the index as incomplete, so that it is filled again from
+ *  the objects before it is next used
+ */
+void object_name_index_invalidate(void)
+{
+    Name_Index_Valid = false;
+}
+
+/**
+ * @brief Determine if the index holds the name of every object
+ * @return true if the index can be used for a lookup
+ */
+bool object_name_index_valid(void)
+{
+    return Name_Index_Valid;
+}
+
+/**
+ * @brief Add the name of an object to the index
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ * @param object_name - the name of the object
+ */
+void object_name_index_add(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    const BACNET_CHARACTER_STRING *object_name)
+{
+    if (object_name) {
+        name_index_insert(
+            name_index_hash(
+                characterstring_value(object_name),
+                characterstring_length(object_name)),
+            BACNET_ID_VALUE(object_instance, object_type));
+    }
+}
+
+/**
+ * @brief Add the new name of an object to the index. Called by the
+ *  *_Name_Set functions of the objects.
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ * @param object_name - the new name, or NULL when the object goes back
+ *  to a default name, which the index does not know
+ */
+void object_name_index_set(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    const char *object_name)
+{
+    if (object_name) {
+        name_index_insert(
+            name_index_hash(object_name, strlen(object_name)),
+            BACNET_ID_VALUE(object_instance, object_type));
+    } else {
+        Name_Index_Valid = false;
+    }
+}
+
+/**
+ * @brief Look up the object that holds a name
+ * @param object_name - the name to look for
+ * @param verify - confirms each object whose name has the same hash
+ * @param object_type - the object type, if found
+ * @param object_instance - the object instance number, if found
+ * @return true if an object holds the name. When false, no object
+ *  holds the name, as long as the index is valid.
+ */
+bool object_name_index_find(
+    const BACNET_CHARACTER_STRING *object_name,
+    object_name_index_verify_function verify,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *object_instance)
+{
+    BACNET_OBJECT_TYPE type;
+    uint32_t instance;
+    uint32_t hash;
+    uint32_t index;
+    uint32_t probes;
+
+    if (!Name_Index_Valid || !object_name || !verify) {
+        return false;
+    }
+    hash = name_index_hash(
+        characterstring_value(object_name),
+        characterstring_length(object_name));
+    index = hash & (BACNET_OBJECT_NAME_INDEX_SIZE - 1);
+    for (probes = 0; probes < BACNET_OBJECT_NAME_INDEX_SIZE; probes++) {
+        if (Name_Index[index].object_id == NAME_INDEX_EMPTY) {
+            break;
+        }
+        if (Name_Index[index].hash == hash) {
+            type = (BACNET_OBJECT_TYPE)BACNET_TYPE(
+                Name_Index[index].object_id);
+            instance = BACNET_INSTANCE(Name_Index[index].object_id);
+            if (verify(type, instance, object_name)) {
+                if (object_type) {
+                    *object_type = type;
+                }
+                if (object_instance) {
+                    *object_instance = instance;
+                }
+                return true;
+            }
+        }
+        index = (index + 1) & (BACNET_OBJECT_NAME_INDEX_SIZE - 1);
+    }
+
+    return false;
+}
+#endif
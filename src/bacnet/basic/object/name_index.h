@@ -0,0 +1,83 @@
+/**
+ * @file
+ * @brief API for a device-wide index from object name to object identifier
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_BASIC_OBJECT_NAME_INDEX_H
+#define BACNET_BASIC_OBJECT_NAME_INDEX_H
+#include <stdbool.h>
+#include <stdint.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "../../../bacnet/bacdef.h"
+/* BACnet Stack API */
+//#include "bacnet/bacstr.h"
+#include "../../../bacnet/bacstr.h"
+
+/* The index maps the hash of each object name to the object that holds
+   it. An entry is only a hint: a lookup asks the owner of the name to
+   confirm it, so an entry left behind by a rename or a delete is
+   skipped. The index is complete only once it has been filled from
+   every object, and stays complete while each name change is added to
+   it. The *_Name_Set functions do that; code that changes a name in
+   another way calls object_name_index_invalidate(). A new object may
+   have a default name that is not stored anywhere, so the *_Create
+   functions invalidate the index as well. */
+#if BACNET_OBJECT_NAME_INDEX_ENABLED
+/* most names the index holds before it is dropped and filled again;
+   a device with more objects than this uses a linear search instead */
+#define BACNET_OBJECT_NAME_INDEX_CAPACITY \
+    ((BACNET_OBJECT_NAME_INDEX_SIZE / 4) * 3)
+
+/**
+ * @brief Confirm that an object currently has a name
+ * @param object_type - BACnet object type of the indexed object
+ * @param object_instance - instance number of the indexed object
+ * @param object_name - the name that was looked up
+ * @return true if the object exists and has the name
+ */
+typedef bool (*object_name_index_verify_function)(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    const BACNET_CHARACTER_STRING *object_name);
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+void object_name_index_clear(void);
+BACNET_STACK_EXPORT
+void object_name_index_invalidate(void);
+BACNET_STACK_EXPORT
+bool object_name_index_valid(void);
+BACNET_STACK_EXPORT
+void object_name_index_add(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    const BACNET_CHARACTER_STRING *object_name);
+BACNET_STACK_EXPORT
+void object_name_index_set(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    const char *object_name);
+BACNET_STACK_EXPORT
+bool object_name_index_find(
+    const BACNET_CHARACTER_STRING *object_name,
+    object_name_index_verify_function verify,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *object_instance);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#else
+#define object_name_index_invalidate()
+#define object_name_index_add(object_type, object_instance, object_name) \
+    ((void)(object_type), (void)(object_instance), (void)(object_name))
+#define object_name_index_set(object_type, object_instance, object_name) \
+    ((void)(object_type), (void)(object_instance), (void)(object_name))
+#endif
+#endif
@@ -632,6 +632,9 @@ void Notification_Class_common_reporting_function(
     BACNET_DESTINATION *pBacDest;
     uint32_t notify_index;
     uint8_t index;
+#if BACNET_EVENT_OUTBOX_ENABLED
+    uint8_t message;
+#endif
 
     notify_index =
         Notification_Class_Instance_To_Index(event_data->notificationClass);
@@ -685,6 +688,10 @@ void Notification_Class_common_reporting_function(
     debug_printf_stderr(
         "Notification Class[%u]: send notifications\n",
         event_data->notificationClass);
+#if BACNET_EVENT_OUTBOX_ENABLED
+    /* encode the notification once, for all of the recipients */
+    message = Event_Outbox_Message_Encode(event_data);
+#endif
     /* pointer to first recipient */
     pBacDest = &CurrentNotify->Recipient_List[0];
     for (index = 0; index < NC_MAX_RECIPIENTS; index++, pBacDest++) {
@@ -699,6 +706,14 @@ void Notification_Class_common_reporting_function(
 
             /* Process Identifier */
             event_data->processIdentifier = pBacDest->ProcessIdentifier;
+#if BACNET_EVENT_OUTBOX_ENABLED
+            if (message) {
+                (void)Event_Outbox_Send(
+                    message, pBacDest->ProcessIdentifier,
+                    &pBacDest->Recipient, pBacDest->ConfirmedNotify);
+                continue;
+            }
+#endif
 
             /* send notification */
             if (pBacDest->Recipient.tag == BACNET_RECIPIENT_TAG_DEVICE) {
@@ -729,6 +744,9 @@ void Notification_Class_common_reporting_function(
             }
         }
     }
+#if BACNET_EVENT_OUTBOX_ENABLED
+    Event_Outbox_Message_Release(message);
+#endif
 }
 
 /* This function tries to find the addresses of the defined devices. */
@@ -38,9 +38,17 @@
 #include "../../../bacnet/basic/binding/address.h"
 //#include "bacnet/basic/object/device.h"
 #include "../../../bacnet/basic/object/device.h"
+#if defined(BACDL_BIP) && BBMD_ENABLED
+//#include "bacnet/basic/bbmd/h_bbmd.h"
+#include "../../../bacnet/basic/bbmd/h_bbmd.h"
+#endif
 /* me */
 //#include "bacnet/basic/object/netport.h"
 #include "../../../bacnet/basic/object/netport.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
 //#include <bacnet/basic/object/netport_internal.h>
 #include "netport_internal.h"
 
@@ -333,6 +341,19 @@ static const int32_t BSC_Port_Properties_Optional[] = {
 
 static const int32_t Network_Port_Properties_Proprietary[] = { -1 };
 
+#if defined(BACDL_MSTP) && (BACNET_MSTP_STATISTICS_ENABLED) && \
+    (BACNET_DLMSTP_ENABLED)
+static const int32_t MSTP_Port_Properties_Proprietary[] = {
+    PROP_MSTP_LINK_COUNTERS,
+    PROP_MSTP_RECEIVE_FRAME_TYPES,
+    PROP_MSTP_TRANSMIT_FRAME_TYPES,
+    PROP_MSTP_TOKEN_ROTATION_HISTOGRAM,
+    PROP_MSTP_REPLY_LATENCY_HISTOGRAM,
+    PROP_MSTP_LINK_STATISTICS,
+    -1
+};
+#endif
+
 /**
  * Returns the list of required, optional, and proprietary properties.
  * Used by ReadPropertyMultiple service.
@@ -384,6 +405,14 @@ void Network_Port_Property_List(
     }
     if (pProprietary) {
         *pProprietary = Network_Port_Properties_Proprietary;
+#if defined(BACDL_MSTP) && (BACNET_MSTP_STATISTICS_ENABLED) && \
+    (BACNET_DLMSTP_ENABLED)
+        index = Network_Port_Instance_To_Index(object_instance);
+        if ((index < BACNET_NETWORK_PORTS_MAX) &&
+            (Object_List[index].Network_Type == PORT_TYPE_MSTP)) {
+            *pProprietary = MSTP_Port_Properties_Proprietary;
+        }
+#endif
     }
 
     return;
@@ -478,6 +507,8 @@ bool Network_Port_Name_Set(uint32_t object_instance, const char *new_name)
     index = Network_Port_Instance_To_Index(object_instance);
     if (index < BACNET_NETWORK_PORTS_MAX) {
         Object_List[index].Object_Name = new_name;
+        object_name_index_set(OBJECT_NETWORK_PORT, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_NETWORK_PORT, object_instance);
         status = true;
     }
 
@@ -537,6 +568,7 @@ bool Network_Port_Description_Set(uint32_t instance, const char *new_name)
     if (index < BACNET_NETWORK_PORTS_MAX) {
         Object_List[index].Description = new_name;
         status = true;
+        rp_cache_object_invalidate(OBJECT_NETWORK_PORT, instance);
     }
 
     return status;
@@ -2070,6 +2102,11 @@ static BACNET_ERROR_CODE BBMD_Broadcast_Distribution_Table_Element_Write(
                     status = bvlc_broadcast_distribution_table_entry_insert(
                         bdt_list, &bdt_entry, array_index);
                     if (status) {
+#if defined(BACDL_BIP) && BBMD_ENABLED
+                        if (bdt_list == bvlc_bdt_list()) {
+                            bvlc_bdt_list_changed();
+                        }
+#endif
                         error_code = ERROR_CODE_SUCCESS;
                     } else {
                         error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
@@ -2117,6 +2154,23 @@ bool Network_Port_BBMD_BD_Table_Set(uint32_t object_instance, void *bdt_head)
     return status;
 }
 
+/**
+ * @brief Bring the remaining time-to-live of the FDT kept by this BBMD
+ *  up to date before it is read or written
+ * @param fdt_list - Foreign Device Table of a network port
+ * @return true if the list is the one kept by this BBMD
+ */
+static bool BBMD_Foreign_Device_Table_Refresh(void *fdt_list)
+{
+#if defined(BACDL_BIP) && BBMD_ENABLED
+    /* bvlc_fdt_list() computes the remaining TTL from the deadlines */
+    return (fdt_list != NULL) && (fdt_list == bvlc_fdt_list());
+#else
+    (void)fdt_list;
+    return false;
+#endif
+}
+
 /**
  * For a given object instance-number, returns the BBMD-FD-Table head
  * property value
@@ -2135,6 +2189,7 @@ void *Network_Port_BBMD_FD_Table(uint32_t object_instance)
     if (index < BACNET_NETWORK_PORTS_MAX) {
         ipv4 = &Object_List[index].Network.IPv4;
         fdt_head = ipv4->BBMD_FD_Table;
+        (void)BBMD_Foreign_Device_Table_Refresh(fdt_head);
     }
 
     return fdt_head;
@@ -2187,6 +2242,7 @@ static int BBMD_Foreign_Device_Table_Encode(
     if (index < BACNET_NETWORK_PORTS_MAX) {
         if (Object_List[index].Network_Type == PORT_TYPE_BIP) {
             ipv4 = &Object_List[index].Network.IPv4;
+            (void)BBMD_Foreign_Device_Table_Refresh(ipv4->BBMD_FD_Table);
             apdu_len = bvlc_foreign_device_table_encode(
                 apdu, apdu_size, ipv4->BBMD_FD_Table);
         } else if (Object_List[index].Network_Type == PORT_TYPE_BIP6) {
@@ -2267,12 +2323,14 @@ static BACNET_ERROR_CODE BBMD_Foreign_Device_Table_Element_Write(
     uint16_t capacity = 0;
     int len;
     bool status = false;
+    bool bbmd_list = false;
     unsigned index = 0;
 
     index = Network_Port_Instance_To_Index(object_instance);
     if (index < BACNET_NETWORK_PORTS_MAX) {
         if (Object_List[index].Network_Type == PORT_TYPE_BIP) {
             fdt_list = Object_List[index].Network.IPv4.BBMD_FD_Table;
+            bbmd_list = BBMD_Foreign_Device_Table_Refresh(fdt_list);
             capacity = bvlc_foreign_device_table_count(fdt_list);
             if (array_index == 0) {
                 error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
@@ -2283,6 +2341,13 @@ static BACNET_ERROR_CODE BBMD_Foreign_Device_Table_Element_Write(
                     status = bvlc_foreign_device_table_entry_insert(
                         fdt_list, &fdt_entry, array_index - 1);
                     if (status) {
+#if defined(BACDL_BIP) && BBMD_ENABLED
+                        if (bbmd_list) {
+                            bvlc_fdt_list_changed();
+                        }
+#else
+                        (void)bbmd_list;
+#endif
                         error_code = ERROR_CODE_SUCCESS;
                     } else {
                         error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
@@ -3958,6 +4023,113 @@ bool Network_Port_MSTP_Max_Info_Frames_Set(
     return status;
 }
 
+#if defined(BACDL_MSTP) && (BACNET_MSTP_STATISTICS_ENABLED) && \
+    (BACNET_DLMSTP_ENABLED)
+/**
+ * @brief Encode a BACnetARRAY element of a table of MS/TP link statistics
+ * @param table [in] one of DLMSTP_STATISTICS_TABLE
+ * @param array_index [in] array index requested:
+ *    0 to N for individual array members
+ * @param apdu [out] Buffer in which the APDU contents are built, or NULL to
+ * return the length of buffer if it had been built
+ * @return The length of the apdu encoded or
+ *   BACNET_STATUS_ERROR for ERROR_CODE_INVALID_ARRAY_INDEX
+ */
+static int Network_Port_MSTP_Statistics_Element_Encode(
+    unsigned table, BACNET_ARRAY_INDEX array_index, uint8_t *apdu)
+{
+    int apdu_len = BACNET_STATUS_ERROR;
+    uint32_t value = 0;
+
+    if (dlmstp_statistics_value(table, array_index, &value)) {
+        apdu_len = encode_application_unsigned(apdu, value);
+    }
+
+    return apdu_len;
+}
+
+static int Network_Port_MSTP_Link_Counters_Encode(
+    uint32_t object_instance, BACNET_ARRAY_INDEX array_index, uint8_t *apdu)
+{
+    (void)object_instance;
+    return Network_Port_MSTP_Statistics_Element_Encode(
+        DLMSTP_STATISTICS_COUNTERS, array_index, apdu);
+}
+
+static int Network_Port_MSTP_Receive_Frame_Types_Encode(
+    uint32_t object_instance, BACNET_ARRAY_INDEX array_index, uint8_t *apdu)
+{
+    (void)object_instance;
+    return Network_Port_MSTP_Statistics_Element_Encode(
+        DLMSTP_STATISTICS_RECEIVE_FRAME_TYPES, array_index, apdu);
+}
+
+static int Network_Port_MSTP_Transmit_Frame_Types_Encode(
+    uint32_t object_instance, BACNET_ARRAY_INDEX array_index, uint8_t *apdu)
+{
+    (void)object_instance;
+    return Network_Port_MSTP_Statistics_Element_Encode(
+        DLMSTP_STATISTICS_TRANSMIT_FRAME_TYPES, array_index, apdu);
+}
+
+static int Network_Port_MSTP_Token_Rotation_Encode(
+    uint32_t object_instance, BACNET_ARRAY_INDEX array_index, uint8_t *apdu)
+{
+    (void)object_instance;
+    return Network_Port_MSTP_Statistics_Element_Encode(
+        DLMSTP_STATISTICS_TOKEN_ROTATION, array_index, apdu);
+}
+
+static int Network_Port_MSTP_Reply_Latency_Encode(
+    uint32_t object_instance, BACNET_ARRAY_INDEX array_index, uint8_t *apdu)
+{
+    (void)object_instance;
+    return Network_Port_MSTP_Statistics_Element_Encode(
+        DLMSTP_STATISTICS_REPLY_LATENCY, array_index, apdu);
+}
+
+/* element encoders of the array properties, in the order of the tables */
+static const bacnet_array_property_element_encode_function
+    Network_Port_MSTP_Statistics_Encoder[DLMSTP_STATISTICS_TABLES] = {
+        Network_Port_MSTP_Link_Counters_Encode,
+        Network_Port_MSTP_Receive_Frame_Types_Encode,
+        Network_Port_MSTP_Transmit_Frame_Types_Encode,
+        Network_Port_MSTP_Token_Rotation_Encode,
+        Network_Port_MSTP_Reply_Latency_Encode
+    };
+
+/**
+ * @brief Encode the compact dump of the MS/TP link statistics as an
+ *  application tagged OctetString.  The dump is built in the APDU after
+ *  room for the largest tag and then moved down behind the actual tag.
+ * @param apdu [out] Buffer in which the APDU contents are built
+ * @param apdu_size [in] size of the buffer
+ * @return The length of the apdu encoded or
+ *   BACNET_STATUS_ABORT if the dump does not fit
+ */
+static int Network_Port_MSTP_Link_Statistics_Encode(
+    uint8_t *apdu, int apdu_size)
+{
+    const int headroom = 5;
+    int len, tag_len;
+
+    if (apdu_size <= headroom) {
+        return BACNET_STATUS_ABORT;
+    }
+    len = dlmstp_statistics_encode(&apdu[headroom], apdu_size - headroom);
+    if (len <= 0) {
+        return BACNET_STATUS_ABORT;
+    }
+    tag_len = encode_tag(
+        NULL, BACNET_APPLICATION_TAG_OCTET_STRING, false, (uint32_t)len);
+    memmove(&apdu[tag_len], &apdu[headroom], (size_t)len);
+    (void)encode_tag(
+        apdu, BACNET_APPLICATION_TAG_OCTET_STRING, false, (uint32_t)len);
+
+    return tag_len + len;
+}
+#endif
+
 /**
  * @brief Encode a Calendar entity list complex data type
  *
@@ -4019,7 +4191,7 @@ int Network_Port_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
     }
     apdu = rpdata->application_data;
     apdu_size = rpdata->application_data_len;
-    switch (rpdata->object_property) {
+    switch ((int)rpdata->object_property) {
         case PROP_OBJECT_IDENTIFIER:
             apdu_len = encode_application_object_id(
                 &apdu[0], OBJECT_NETWORK_PORT, rpdata->object_instance);
@@ -4123,6 +4295,38 @@ int Network_Port_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
                 &apdu[0],
                 Network_Port_MSTP_Max_Info_Frames(rpdata->object_instance));
             break;
+#if defined(BACDL_MSTP) && (BACNET_MSTP_STATISTICS_ENABLED) && \
+    (BACNET_DLMSTP_ENABLED)
+        case PROP_MSTP_LINK_COUNTERS:
+        case PROP_MSTP_RECEIVE_FRAME_TYPES:
+        case PROP_MSTP_TRANSMIT_FRAME_TYPES:
+        case PROP_MSTP_TOKEN_ROTATION_HISTOGRAM:
+        case PROP_MSTP_REPLY_LATENCY_HISTOGRAM:
+            /* the array properties are numbered in the order of the tables */
+            count = dlmstp_statistics_count(
+                rpdata->object_property - PROP_MSTP_LINK_COUNTERS);
+            apdu_len = bacnet_array_encode(
+                rpdata->object_instance, rpdata->array_index,
+                Network_Port_MSTP_Statistics_Encoder[
+                    rpdata->object_property - PROP_MSTP_LINK_COUNTERS],
+                count, apdu, apdu_size);
+            if (apdu_len == BACNET_STATUS_ABORT) {
+                rpdata->error_code =
+                    ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
+            } else if (apdu_len == BACNET_STATUS_ERROR) {
+                rpdata->error_class = ERROR_CLASS_PROPERTY;
+                rpdata->error_code = ERROR_CODE_INVALID_ARRAY_INDEX;
+            }
+            break;
+        case PROP_MSTP_LINK_STATISTICS:
+            apdu_len =
+                Network_Port_MSTP_Link_Statistics_Encode(apdu, apdu_size);
+            if (apdu_len == BACNET_STATUS_ABORT) {
+                rpdata->error_code =
+                    ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
+            }
+            break;
+#endif
         case PROP_BACNET_IP_MODE:
             apdu_len = encode_application_enumerated(
                 &apdu[0], Network_Port_BIP_Mode(rpdata->object_instance));
@@ -38,6 +38,21 @@ typedef void (*bacnet_network_port_activate_changes)(uint32_t object_instance);
  */
 typedef void (*bacnet_network_port_discard_changes)(uint32_t object_instance);
 
+#if defined(BACDL_MSTP) && (BACNET_MSTP_STATISTICS_ENABLED) && \
+    (BACNET_DLMSTP_ENABLED)
+/* proprietary properties of an MS/TP port: a BACnetARRAY of Unsigned
+   for each table of dlmstp link statistics, and an OctetString holding
+   the compact dump of dlmstp_statistics_encode() for host tools; the
+   counters live in dlmstp.c, so the properties exist only when it is
+   built with BACNET_DLMSTP_ENABLED */
+#define PROP_MSTP_LINK_COUNTERS (PROP_PROPRIETARY_RANGE_MIN + 0)
+#define PROP_MSTP_RECEIVE_FRAME_TYPES (PROP_PROPRIETARY_RANGE_MIN + 1)
+#define PROP_MSTP_TRANSMIT_FRAME_TYPES (PROP_PROPRIETARY_RANGE_MIN + 2)
+#define PROP_MSTP_TOKEN_ROTATION_HISTOGRAM (PROP_PROPRIETARY_RANGE_MIN + 3)
+#define PROP_MSTP_REPLY_LATENCY_HISTOGRAM (PROP_PROPRIETARY_RANGE_MIN + 4)
+#define PROP_MSTP_LINK_STATISTICS (PROP_PROPRIETARY_RANGE_MIN + 5)
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
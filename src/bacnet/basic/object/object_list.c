@@ -0,0 +1,312 @@
+/**
+ * @file
+ * @brief A pre-encoded Device Object_List that is patched in place
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "../../../bacnet/bacdef.h"
+/* BACnet Stack API */
+//#include "bacnet/bacdcode.h"
+#include "../../../bacnet/bacdcode.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
+
+/* creates and deletes of objects, counted by the object types */
+static uint32_t Object_List_Changes;
+
+/**
+ * @brief Initialize an empty list
+ * @param list - list to be initialized
+ * @param capacity - number of objects to make room for, or zero
+ *  to allocate room when the first object is added
+ * @return true if the room could be allocated
+ */
+bool bacnet_object_list_init(BACNET_OBJECT_LIST *list, uint32_t capacity)
+{
+    if (!list) {
+        return false;
+    }
+    list->buffer = NULL;
+    list->count = 0;
+    list->capacity = 0;
+    if (capacity > 0) {
+        list->buffer =
+            malloc((size_t)capacity * BACNET_OBJECT_LIST_ELEMENT_SIZE);
+        if (!list->buffer) {
+            return false;
+        }
+        list->capacity = capacity;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Free the room held by a list
+ * @param list - list to be freed
+ */
+void bacnet_object_list_cleanup(BACNET_OBJECT_LIST *list)
+{
+    if (list) {
+        free(list->buffer);
+        list->buffer = NULL;
+        list->count = 0;
+        list->capacity = 0;
+    }
+}
+
+/**
+ * @brief Remove every object from a list, keeping its room
+ * @param list - list to be emptied
+ */
+void bacnet_object_list_clear(BACNET_OBJECT_LIST *list)
+{
+    if (list) {
+        list->count = 0;
+    }
+}
+
+/**
+ * @brief Find the encoded element of an object
+ * @param list - list to search
+ * @param element - encoded object identifier
+ * @return the element index, from zero, or the count if not found
+ */
+static uint32_t bacnet_object_list_find(
+    const BACNET_OBJECT_LIST *list,
+    const uint8_t element[BACNET_OBJECT_LIST_ELEMENT_SIZE])
+{
+    const uint8_t *buffer = list->buffer;
+    uint32_t index;
+
+    for (index = 0; index < list->count; index++) {
+        if (memcmp(buffer, element, BACNET_OBJECT_LIST_ELEMENT_SIZE) == 0) {
+            break;
+        }
+        buffer += BACNET_OBJECT_LIST_ELEMENT_SIZE;
+    }
+
+    return index;
+}
+
+/**
+ * @brief Add an object to the end of a list. The room for the list
+ *  doubles when it is full. The caller makes sure the object is not
+ *  already in the list, so that a whole list is built in linear time.
+ * @param list - list to be added to
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ * @return true if the object was added
+ */
+bool bacnet_object_list_add(
+    BACNET_OBJECT_LIST *list,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance)
+{
+    uint8_t *buffer;
+    uint32_t capacity;
+
+    if (!list) {
+        return false;
+    }
+    if (list->count >= list->capacity) {
+        capacity = list->capacity ? list->capacity * 2 : 16;
+        buffer = realloc(
+            list->buffer, (size_t)capacity * BACNET_OBJECT_LIST_ELEMENT_SIZE);
+        if (!buffer) {
+            return false;
+        }
+        list->buffer = buffer;
+        list->capacity = capacity;
+    }
+    encode_application_object_id(
+        &list->buffer[list->count * BACNET_OBJECT_LIST_ELEMENT_SIZE],
+        object_type, object_instance);
+    list->count++;
+
+    return true;
+}
+
+/**
+ * @brief Remove an object from a list. The objects after it move up
+ *  one place, keeping their order.
+ * @param list - list to be removed from
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ * @return true if the object was found and removed
+ */
+bool bacnet_object_list_remove(
+    BACNET_OBJECT_LIST *list,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance)
+{
+    uint8_t element[BACNET_OBJECT_LIST_ELEMENT_SIZE];
+    uint32_t index;
+
+    if (!list) {
+        return false;
+    }
+    encode_application_object_id(element, object_type, object_instance);
+    index = bacnet_object_list_find(list, element);
+    if (index >= list->count) {
+        return false;
+    }
+    list->count--;
+    memmove(
+        &list->buffer[index * BACNET_OBJECT_LIST_ELEMENT_SIZE],
+        &list->buffer[(index + 1) * BACNET_OBJECT_LIST_ELEMENT_SIZE],
+        (size_t)(list->count - index) * BACNET_OBJECT_LIST_ELEMENT_SIZE);
+
+    return true;
+}
+
+/**
+ * @brief Get the number of objects in a list
+ * @param list - list to be counted
+ * @return number of objects
+ */
+uint32_t bacnet_object_list_count(const BACNET_OBJECT_LIST *list)
+{
+    return list ? list->count : 0;
+}
+
+/**
+ * @brief Get the object at an array index of a list
+ * @param list - list to be read
+ * @param array_index - BACnetARRAY index, 1 to N
+ * @param object_type - the object type, if found
+ * @param object_instance - the object instance number, if found
+ * @return true if the array index holds an object
+ */
+bool bacnet_object_list_identifier(
+    const BACNET_OBJECT_LIST *list,
+    uint32_t array_index,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *object_instance)
+{
+    const uint8_t *element;
+    uint32_t value;
+
+    if (!list || (array_index == 0) || (array_index > list->count)) {
+        return false;
+    }
+    element =
+        &list->buffer[(array_index - 1) * BACNET_OBJECT_LIST_ELEMENT_SIZE];
+    value = ((uint32_t)element[1] << 24) | ((uint32_t)element[2] << 16) |
+        ((uint32_t)element[3] << 8) | (uint32_t)element[4];
+    if (object_type) {
+        *object_type = (BACNET_OBJECT_TYPE)(value >> BACNET_INSTANCE_BITS);
+    }
+    if (object_instance) {
+        *object_instance = value & BACNET_MAX_INSTANCE;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Encode the Object_List property, or one element of it
+ * @param list - list to be encoded
+ * @param array_index - 0 for the size of the array, 1 to N for one
+ *  element, or BACNET_ARRAY_ALL for the whole array
+ * @param apdu - buffer for the encoding, or NULL for the length only
+ * @param apdu_size - number of bytes in the buffer
+ * @return The length of the apdu encoded or
+ *   BACNET_STATUS_ERROR for ERROR_CODE_INVALID_ARRAY_INDEX or
+ *   BACNET_STATUS_ABORT if the buffer is too small.
+ */
+int bacnet_object_list_encode(
+    const BACNET_OBJECT_LIST *list,
+    BACNET_ARRAY_INDEX array_index,
+    uint8_t *apdu,
+    int apdu_size)
+{
+    uint32_t count;
+    int len;
+
+    count = bacnet_object_list_count(list);
+    if (array_index == 0) {
+        len = encode_application_unsigned(NULL, count);
+        if (len > apdu_size) {
+            return BACNET_STATUS_ABORT;
+        }
+        return encode_application_unsigned(apdu, count);
+    }
+    if (array_index == BACNET_ARRAY_ALL) {
+        if (count == 0) {
+            /* an empty BACnetARRAY */
+            return 0;
+        }
+        return bacnet_object_list_range_encode(
+            list, 1, count, apdu, apdu_size);
+    }
+    if (array_index > count) {
+        return BACNET_STATUS_ERROR;
+    }
+
+    return bacnet_object_list_range_encode(
+        list, array_index, 1, apdu, apdu_size);
+}
+
+/**
+ * @brief Copy a run of Object_List elements, as for a ReadRange
+ *  by position
+ * @param list - list to be encoded
+ * @param array_index - BACnetARRAY index of the first element, 1 to N
+ * @param count - number of elements
+ * @param apdu - buffer for the encoding, or NULL for the length only
+ * @param apdu_size - number of bytes in the buffer
+ * @return The length of the apdu encoded or
+ *   BACNET_STATUS_ERROR if the elements are not all in the list or
+ *   BACNET_STATUS_ABORT if the buffer is too small.
+ */
+int bacnet_object_list_range_encode(
+    const BACNET_OBJECT_LIST *list,
+    uint32_t array_index,
+    uint32_t count,
+    uint8_t *apdu,
+    int apdu_size)
+{
+    size_t len;
+
+    if (!list || (array_index == 0) || (array_index > list->count) ||
+        (count > (list->count - array_index + 1))) {
+        return BACNET_STATUS_ERROR;
+    }
+    len = (size_t)count * BACNET_OBJECT_LIST_ELEMENT_SIZE;
+    if ((apdu_size < 0) || (len > (size_t)apdu_size)) {
+        return BACNET_STATUS_ABORT;
+    }
+    if (apdu && (len > 0)) {
+        memcpy(
+            apdu,
+            &list->buffer[(array_index - 1) * BACNET_OBJECT_LIST_ELEMENT_SIZE],
+            len);
+    }
+
+    return (int)len;
+}
+
+/**
+ * @brief Count a create or delete of an object in this device
+ */
+void bacnet_object_list_changed(void)
+{
+    Object_List_Changes++;
+}
+
+/**
+ * @brief Get the count of creates and deletes of objects in this device
+ * @return count, which wraps around; compare it for equality only
+ */
+uint32_t bacnet_object_list_changes(void)
+{
+    return Object_List_Changes;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file
+ * @brief API for a pre-encoded Device Object_List
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_BASIC_OBJECT_LIST_H
+#define BACNET_BASIC_OBJECT_LIST_H
+#include <stdbool.h>
+#include <stdint.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "../../../bacnet/bacdef.h"
+
+/* every element is an application tagged BACnetObjectIdentifier:
+   one tag octet and four value octets */
+#define BACNET_OBJECT_LIST_ELEMENT_SIZE 5
+
+/**
+ * The Object_List of a device, kept in its encoded form. Element N of
+ * the BACnetARRAY starts at octet (N - 1) * 5, so reading one element,
+ * a range or the whole array is a copy from the buffer. Objects are
+ * added at the end and removed in place when they are created and
+ * deleted.
+ * @{
+ */
+struct bacnet_object_list {
+    uint8_t *buffer;
+    /* number of objects in the list */
+    uint32_t count;
+    /* number of objects the buffer can hold */
+    uint32_t capacity;
+};
+typedef struct bacnet_object_list BACNET_OBJECT_LIST;
+/** @} */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+bool bacnet_object_list_init(BACNET_OBJECT_LIST *list, uint32_t capacity);
+BACNET_STACK_EXPORT
+void bacnet_object_list_cleanup(BACNET_OBJECT_LIST *list);
+BACNET_STACK_EXPORT
+void bacnet_object_list_clear(BACNET_OBJECT_LIST *list);
+BACNET_STACK_EXPORT
+bool bacnet_object_list_add(
+    BACNET_OBJECT_LIST *list,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance);
+BACNET_STACK_EXPORT
+bool bacnet_object_list_remove(
+    BACNET_OBJECT_LIST *list,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance);
+BACNET_STACK_EXPORT
+uint32_t bacnet_object_list_count(const BACNET_OBJECT_LIST *list);
+BACNET_STACK_EXPORT
+bool bacnet_object_list_identifier(
+    const BACNET_OBJECT_LIST *list,
+    uint32_t array_index,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *object_instance);
+BACNET_STACK_EXPORT
+int bacnet_object_list_encode(
+    const BACNET_OBJECT_LIST *list,
+    BACNET_ARRAY_INDEX array_index,
+    uint8_t *apdu,
+    int apdu_size);
+BACNET_STACK_EXPORT
+int bacnet_object_list_range_encode(
+    const BACNET_OBJECT_LIST *list,
+    uint32_t array_index,
+    uint32_t count,
+    uint8_t *apdu,
+    int apdu_size);
+
+/* The *_Create and *_Delete functions of each object type count every
+   change to the set of objects, so a cached Object_List can tell that
+   it is out of date however the objects were created or deleted. */
+BACNET_STACK_EXPORT
+void bacnet_object_list_changed(void);
+BACNET_STACK_EXPORT
+uint32_t bacnet_object_list_changes(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
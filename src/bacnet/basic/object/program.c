@@ -35,6 +35,12 @@
 #include "../../../bacnet/basic/sys/debug.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 /* me! */
 //#include "bacnet/basic/object/program.h"
 #include "../../../bacnet/basic/object/program.h"
@@ -271,6 +277,8 @@ bool Program_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(OBJECT_PROGRAM, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_PROGRAM, object_instance);
     }
 
     return status;
@@ -333,6 +341,7 @@ bool Program_Description_Set(uint32_t object_instance, const char *new_name)
     pObject = Object_Data(object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_PROGRAM, object_instance);
         pObject->Description = new_name;
     }
 
@@ -1384,6 +1393,9 @@ uint32_t Program_Create(uint32_t object_instance)
     pObject->Halt = NULL;
     pObject->Restart = NULL;
     pObject->Unload = NULL;
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -1402,6 +1414,8 @@ bool Program_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
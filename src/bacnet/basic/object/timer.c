@@ -38,6 +38,12 @@
 #include "../../../bacnet/basic/sys/debug.h"
 //#include "bacnet/basic/sys/keylist.h"
 #include "../../../bacnet/basic/sys/keylist.h"
+//#include "bacnet/basic/object/name_index.h"
+#include "../../../bacnet/basic/object/name_index.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
+//#include "bacnet/basic/object/object_list.h"
+#include "../../../bacnet/basic/object/object_list.h"
 /* me! */
 //#include "bacnet/basic/object/timer.h"
 #include "../../../bacnet/basic/object/timer.h"
@@ -815,6 +821,8 @@ bool Timer_Name_Set(uint32_t object_instance, const char *new_name)
     if (pObject) {
         status = true;
         pObject->Object_Name = new_name;
+        object_name_index_set(OBJECT_TIMER, object_instance, new_name);
+        rp_cache_object_invalidate(OBJECT_TIMER, object_instance);
     }
 
     return status;
@@ -877,6 +885,7 @@ bool Timer_Description_Set(uint32_t object_instance, const char *new_name)
     pObject = Object_Data(object_instance);
     if (pObject) {
         status = true;
+        rp_cache_object_invalidate(OBJECT_TIMER, object_instance);
         pObject->Description = new_name;
     }
 
@@ -2269,6 +2278,9 @@ uint32_t Timer_Create(uint32_t object_instance)
     for (i = 0; i < BACNET_TIMER_MANIPULATED_PROPERTIES_MAX; i++) {
         List_Of_Object_Property_References_Set(pObject, i, NULL);
     }
+    rp_cache_invalidate_all();
+    bacnet_object_list_changed();
+    object_name_index_invalidate();
 
     return object_instance;
 }
@@ -2287,6 +2299,8 @@ bool Timer_Delete(uint32_t object_instance)
     if (pObject) {
         free(pObject);
         status = true;
+        rp_cache_invalidate_all();
+        bacnet_object_list_changed();
     }
 
     return status;
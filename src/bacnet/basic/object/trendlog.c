@@ -46,7 +46,6 @@
 #define MAX_TREND_LOGS 8
 #endif
 
-static TL_DATA_REC Logs[MAX_TREND_LOGS][TL_MAX_ENTRIES];
 static TL_LOG_INFO LogInfo[MAX_TREND_LOGS];
 
 /* These three arrays are used by the ReadPropertyMultiple handler */
@@ -160,6 +159,708 @@ static bacnet_time_t Trend_Log_Epoch_Seconds_Now(void)
     return datetime_seconds_since_epoch(&bdatetime);
 }
 
+/*
+ * Log buffer storage
+ *
+ * Each log keeps its records packed into a ring of bytes. A packed record
+ * starts with a header octet:
+ *
+ *   b0-b3 record type (TL_TYPE_xxx)
+ *   b4    status flags present
+ *   b5    status flags non-zero - an octet with the flags follows
+ *   b6    time delta repeats - no time stamp follows
+ *   b7    value of a BOOLEAN record
+ *
+ * which is followed by the time stamp as a variable length unsigned
+ * integer (7 bits per octet, least significant first) holding the
+ * signed difference from the time stamp of the previous record, the
+ * status flags octet if any, and the datum. A REAL datum is stored as
+ * the exclusive-or of its bits with the previous REAL value, so a steady
+ * or slowly changing value packs into one to three octets.
+ *
+ * Every TL_CHECKPOINT_RECORDS sequence numbers a record is packed as if it
+ * were the first record, and its buffer offset is kept in a table. Any
+ * record can then be found by unpacking at most TL_CHECKPOINT_RECORDS
+ * records forward from the nearest checkpoint, and the checkpoints can be
+ * binary searched by time.
+ *
+ * A log can also be given a segment store in flash or EEPROM (see
+ * Trend_Log_Segment_Store_Set()). Every record is then also written to the
+ * store, packed as if it were the first record, and the log buffer keeps
+ * only the newest records. Records older than the log buffer are read
+ * back from the store, so the log holds as many records as the store.
+ */
+#ifndef TL_CHECKPOINT_RECORDS
+#define TL_CHECKPOINT_RECORDS 16
+#endif
+/* must be a power of two that covers TL_MAX_ENTRIES */
+#ifndef TL_CHECKPOINT_COUNT
+#define TL_CHECKPOINT_COUNT 64
+#endif
+#if (TL_CHECKPOINT_COUNT & (TL_CHECKPOINT_COUNT - 1)) != 0
+#error "TL_CHECKPOINT_COUNT must be a power of two"
+#endif
+#if ((TL_CHECKPOINT_COUNT - 1) * TL_CHECKPOINT_RECORDS) < TL_MAX_ENTRIES
+#error "TL_CHECKPOINT_COUNT is too small for TL_MAX_ENTRIES"
+#endif
+
+#define TL_PACK_STATUS 0x10
+#define TL_PACK_STATUS_BITS 0x20
+#define TL_PACK_SAME_DELTA 0x40
+#define TL_PACK_TRUE 0x80
+/* header, time stamp, status flags and the largest datum (error) */
+#define TL_PACK_MAX ((int)(1 + ((sizeof(bacnet_time_t) * 8 + 6) / 7) + 1 + 6))
+
+#if TL_LOG_BUFFER_BYTES > 65535
+#error "TL_LOG_BUFFER_BYTES must fit in 16 bits"
+#endif
+
+/* Packing state carried from one record to the next */
+typedef struct tl_pack_state {
+    bacnet_time_t tTimeStamp; /* Time stamp of the previous record */
+    bacnet_time_t tDelta; /* Time between the previous two records */
+    uint32_t ulReal; /* Bits of the previous REAL value */
+} TL_PACK_STATE;
+
+/* Ring buffer bookkeeping for a Trend Log */
+typedef struct tl_log_store {
+    uint16_t usHead; /* Offset where the next record goes */
+    uint16_t usTail; /* Offset of the oldest record */
+    uint16_t usUsed; /* Octets in use */
+    TL_PACK_STATE Head; /* State after the newest record */
+    TL_PACK_STATE Tail; /* State before the oldest record */
+    uint16_t usCheckpoint[TL_CHECKPOINT_COUNT];
+    uint32_t ulCount; /* Records in the log buffer */
+    BACNET_LOG_SEGMENT *Segment; /* Optional store for older records */
+} TL_LOG_STORE;
+
+/* Position of a record in the log while reading */
+typedef struct tl_cursor {
+    uint32_t ulIndex; /* 0 based index of the record in the log */
+    uint16_t usOffset; /* Offset of the record */
+    TL_PACK_STATE State; /* State before the record */
+} TL_CURSOR;
+
+static uint8_t LogData[MAX_TREND_LOGS][TL_LOG_BUFFER_BYTES];
+static TL_LOG_STORE LogStore[MAX_TREND_LOGS];
+
+/**
+ * @brief Pack an unsigned value 7 bits per octet, least significant first
+ * @param buffer - where to put the octets
+ * @param value - value to pack
+ * @return number of octets used
+ */
+static int TL_Varint_Pack(uint8_t *buffer, bacnet_time_t value)
+{
+    int len = 0;
+
+    while (value > 0x7F) {
+        buffer[len++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    buffer[len++] = (uint8_t)value;
+
+    return len;
+}
+
+/**
+ * @brief Unpack an unsigned value packed by TL_Varint_Pack()
+ * @param buffer - packed octets
+ * @param value - where to put the value
+ * @return number of octets used
+ */
+static int TL_Varint_Unpack(const uint8_t *buffer, bacnet_time_t *value)
+{
+    int len = 0;
+    unsigned shift = 0;
+    bacnet_time_t result = 0;
+
+    do {
+        if (shift < (sizeof(bacnet_time_t) * 8)) {
+            result |= (bacnet_time_t)(buffer[len] & 0x7F) << shift;
+        }
+        shift += 7;
+    } while (buffer[len++] & 0x80);
+    *value = result;
+
+    return len;
+}
+
+/**
+ * @brief Pack a log record
+ * @param buffer - where to put the packed record, TL_PACK_MAX octets
+ * @param pState - state after the previous record, updated
+ * @param pSource - record to pack
+ * @return number of octets used
+ */
+static int TL_Record_Pack(
+    uint8_t *buffer, TL_PACK_STATE *pState, const TL_DATA_REC *pSource)
+{
+    int len = 1;
+    uint8_t ucHeader;
+    uint8_t ucCount;
+    bacnet_time_t tDelta;
+    uint32_t ulBits = 0;
+
+    ucHeader = pSource->ucRecType & 0x0F;
+    if ((pSource->ucStatus & 128) == 128) {
+        ucHeader |= TL_PACK_STATUS;
+        if ((pSource->ucStatus & 0x0F) != 0) {
+            ucHeader |= TL_PACK_STATUS_BITS;
+        }
+    }
+    tDelta = pSource->tTimeStamp - pState->tTimeStamp;
+    if (tDelta == pState->tDelta) {
+        ucHeader |= TL_PACK_SAME_DELTA;
+    } else if (pSource->tTimeStamp >= pState->tTimeStamp) {
+        len += TL_Varint_Pack(&buffer[len], tDelta << 1);
+    } else {
+        /* clock went backwards */
+        len += TL_Varint_Pack(
+            &buffer[len],
+            ((pState->tTimeStamp - pSource->tTimeStamp) << 1) | 1);
+    }
+    pState->tTimeStamp = pSource->tTimeStamp;
+    pState->tDelta = tDelta;
+    if (ucHeader & TL_PACK_STATUS_BITS) {
+        buffer[len++] = pSource->ucStatus & 0x0F;
+    }
+    switch (pSource->ucRecType) {
+        case TL_TYPE_STATUS:
+            buffer[len++] = pSource->Datum.ucLogStatus;
+            break;
+        case TL_TYPE_BOOL:
+            if (pSource->Datum.ucBoolean) {
+                ucHeader |= TL_PACK_TRUE;
+            }
+            break;
+        case TL_TYPE_REAL:
+            memcpy(&ulBits, &pSource->Datum.fReal, sizeof(ulBits));
+            len += TL_Varint_Pack(&buffer[len], ulBits ^ pState->ulReal);
+            pState->ulReal = ulBits;
+            break;
+        case TL_TYPE_ENUM:
+            len += TL_Varint_Pack(&buffer[len], pSource->Datum.ulEnum);
+            break;
+        case TL_TYPE_UNSIGN:
+            len += TL_Varint_Pack(&buffer[len], pSource->Datum.ulUValue);
+            break;
+        case TL_TYPE_SIGN:
+            if (pSource->Datum.lSValue < 0) {
+                ulBits = ((uint32_t)(-(pSource->Datum.lSValue + 1)) << 1) | 1;
+            } else {
+                ulBits = (uint32_t)pSource->Datum.lSValue << 1;
+            }
+            len += TL_Varint_Pack(&buffer[len], ulBits);
+            break;
+        case TL_TYPE_BITS:
+            buffer[len++] = pSource->Datum.Bits.ucLen;
+            for (ucCount = 0; ucCount < (pSource->Datum.Bits.ucLen >> 4);
+                 ucCount++) {
+                buffer[len++] = pSource->Datum.Bits.ucStore[ucCount];
+            }
+            break;
+        case TL_TYPE_ERROR:
+            len += TL_Varint_Pack(&buffer[len], pSource->Datum.Error.usClass);
+            len += TL_Varint_Pack(&buffer[len], pSource->Datum.Error.usCode);
+            break;
+        case TL_TYPE_DELTA:
+            memcpy(&ulBits, &pSource->Datum.fTime, sizeof(ulBits));
+            len += TL_Varint_Pack(&buffer[len], ulBits);
+            break;
+        default:
+            break;
+    }
+    buffer[0] = ucHeader;
+
+    return len;
+}
+
+/**
+ * @brief Unpack a log record packed by TL_Record_Pack()
+ * @param buffer - packed record
+ * @param pState - state after the previous record, updated
+ * @param pDest - where to put the unpacked record
+ * @return number of octets used
+ */
+static int TL_Record_Unpack(
+    const uint8_t *buffer, TL_PACK_STATE *pState, TL_DATA_REC *pDest)
+{
+    int len = 1;
+    uint8_t ucHeader;
+    uint8_t ucCount;
+    bacnet_time_t tValue = 0;
+    uint32_t ulBits;
+
+    ucHeader = buffer[0];
+    pDest->ucRecType = ucHeader & 0x0F;
+    if (ucHeader & TL_PACK_SAME_DELTA) {
+        pDest->tTimeStamp = pState->tTimeStamp + pState->tDelta;
+    } else {
+        len += TL_Varint_Unpack(&buffer[len], &tValue);
+        if (tValue & 1) {
+            pDest->tTimeStamp = pState->tTimeStamp - (tValue >> 1);
+        } else {
+            pDest->tTimeStamp = pState->tTimeStamp + (tValue >> 1);
+        }
+    }
+    pState->tDelta = pDest->tTimeStamp - pState->tTimeStamp;
+    pState->tTimeStamp = pDest->tTimeStamp;
+    pDest->ucStatus = 0;
+    if (ucHeader & TL_PACK_STATUS) {
+        pDest->ucStatus = 128;
+        if (ucHeader & TL_PACK_STATUS_BITS) {
+            pDest->ucStatus |= buffer[len++] & 0x0F;
+        }
+    }
+    switch (pDest->ucRecType) {
+        case TL_TYPE_STATUS:
+            pDest->Datum.ucLogStatus = buffer[len++];
+            break;
+        case TL_TYPE_BOOL:
+            pDest->Datum.ucBoolean = (ucHeader & TL_PACK_TRUE) ? 1 : 0;
+            break;
+        case TL_TYPE_REAL:
+            len += TL_Varint_Unpack(&buffer[len], &tValue);
+            pState->ulReal ^= (uint32_t)tValue;
+            memcpy(
+                &pDest->Datum.fReal, &pState->ulReal, sizeof(pState->ulReal));
+            break;
+        case TL_TYPE_ENUM:
+            len += TL_Varint_Unpack(&buffer[len], &tValue);
+            pDest->Datum.ulEnum = (uint32_t)tValue;
+            break;
+        case TL_TYPE_UNSIGN:
+            len += TL_Varint_Unpack(&buffer[len], &tValue);
+            pDest->Datum.ulUValue = (uint32_t)tValue;
+            break;
+        case TL_TYPE_SIGN:
+            len += TL_Varint_Unpack(&buffer[len], &tValue);
+            if (tValue & 1) {
+                pDest->Datum.lSValue = -(int32_t)(tValue >> 1) - 1;
+            } else {
+                pDest->Datum.lSValue = (int32_t)(tValue >> 1);
+            }
+            break;
+        case TL_TYPE_BITS:
+            pDest->Datum.Bits.ucLen = buffer[len++];
+            for (ucCount = 0; ucCount < (pDest->Datum.Bits.ucLen >> 4);
+                 ucCount++) {
+                pDest->Datum.Bits.ucStore[ucCount] = buffer[len++];
+            }
+            break;
+        case TL_TYPE_ERROR:
+            len += TL_Varint_Unpack(&buffer[len], &tValue);
+            pDest->Datum.Error.usClass = (uint16_t)tValue;
+            len += TL_Varint_Unpack(&buffer[len], &tValue);
+            pDest->Datum.Error.usCode = (uint16_t)tValue;
+            break;
+        case TL_TYPE_DELTA:
+            len += TL_Varint_Unpack(&buffer[len], &tValue);
+            ulBits = (uint32_t)tValue;
+            memcpy(&pDest->Datum.fTime, &ulBits, sizeof(ulBits));
+            break;
+        default:
+            break;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Get the sequence number of the oldest record in a log
+ * @param iLog - Index of the log
+ * @return sequence number of the oldest record
+ */
+static uint32_t TL_First_Sequence(int iLog)
+{
+    return LogInfo[iLog].ulTotalRecordCount - LogInfo[iLog].ulRecordCount + 1;
+}
+
+/**
+ * @brief Get the number of records in a log that are only in its
+ *  segment store, being older than the records in the log buffer.
+ * @param iLog - Index of the log
+ * @return number of records, which come before those in the log buffer
+ */
+static uint32_t TL_Segment_Count(int iLog)
+{
+    return LogInfo[iLog].ulRecordCount - LogStore[iLog].ulCount;
+}
+
+/**
+ * @brief Read a record from the segment store of a log
+ * @param iLog - Index of the log
+ * @param ulSequence - sequence number of the record
+ * @param pDest - where to put the unpacked record
+ */
+static void TL_Segment_Record_Read(
+    int iLog, uint32_t ulSequence, TL_DATA_REC *pDest)
+{
+    uint8_t buffer[TL_PACK_MAX];
+    TL_PACK_STATE State = { 0 };
+    int len;
+
+    len = logseg_read(
+        LogStore[iLog].Segment, ulSequence, buffer, sizeof(buffer));
+    if (len > 0) {
+        (void)TL_Record_Unpack(buffer, &State, pDest);
+    } else {
+        /* the record is corrupt, so report it as a failed reading */
+        memset(pDest, 0, sizeof(TL_DATA_REC));
+        pDest->ucRecType = TL_TYPE_ERROR;
+        pDest->Datum.Error.usClass = ERROR_CLASS_DEVICE;
+        pDest->Datum.Error.usCode = ERROR_CODE_OPERATIONAL_PROBLEM;
+    }
+}
+
+/**
+ * @brief Unpack the record at a cursor and move the cursor to the next one
+ * @param iLog - Index of the log
+ * @param pCursor - position in the log
+ * @param pDest - where to put the unpacked record
+ * @return number of octets the record uses in the log buffer
+ */
+static int TL_Cursor_Next(int iLog, TL_CURSOR *pCursor, TL_DATA_REC *pDest)
+{
+    TL_LOG_STORE *Store = &LogStore[iLog];
+    uint8_t buffer[TL_PACK_MAX];
+    uint32_t ulSpilled;
+    uint16_t usOffset;
+    unsigned i;
+    int len;
+
+    ulSpilled = TL_Segment_Count(iLog);
+    if (pCursor->ulIndex < ulSpilled) {
+        TL_Segment_Record_Read(
+            iLog, TL_First_Sequence(iLog) + pCursor->ulIndex, pDest);
+        pCursor->ulIndex++;
+        if (pCursor->ulIndex == ulSpilled) {
+            /* on to the oldest record in the log buffer */
+            pCursor->usOffset = Store->usTail;
+            pCursor->State = Store->Tail;
+        }
+        return 0;
+    }
+    if (((TL_First_Sequence(iLog) + pCursor->ulIndex) %
+         TL_CHECKPOINT_RECORDS) == 0) {
+        /* checkpoint records are packed without reference to earlier ones */
+        memset(&pCursor->State, 0, sizeof(pCursor->State));
+    }
+    usOffset = pCursor->usOffset;
+    for (i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = LogData[iLog][usOffset];
+        usOffset++;
+        if (usOffset >= TL_LOG_BUFFER_BYTES) {
+            usOffset = 0;
+        }
+    }
+    len = TL_Record_Unpack(buffer, &pCursor->State, pDest);
+    pCursor->usOffset = (pCursor->usOffset + len) % TL_LOG_BUFFER_BYTES;
+    pCursor->ulIndex++;
+
+    return len;
+}
+
+/**
+ * @brief Position a cursor at a record in a log
+ * @param iLog - Index of the log
+ * @param ulIndex - 0 based index of the record, oldest first
+ * @param pCursor - position in the log
+ */
+static void TL_Cursor_Seek(int iLog, uint32_t ulIndex, TL_CURSOR *pCursor)
+{
+    TL_LOG_STORE *Store = &LogStore[iLog];
+    TL_DATA_REC TempRec;
+    uint32_t ulSequence;
+    uint32_t ulSpilled;
+    uint32_t ulSkip;
+
+    ulSpilled = TL_Segment_Count(iLog);
+    if (ulIndex < ulSpilled) {
+        /* records in the segment store are read directly */
+        pCursor->ulIndex = ulIndex;
+        pCursor->usOffset = Store->usTail;
+        pCursor->State = Store->Tail;
+        return;
+    }
+    ulSequence = TL_First_Sequence(iLog) + ulIndex;
+    ulSkip = ulSequence % TL_CHECKPOINT_RECORDS;
+    if (ulSkip <= (ulIndex - ulSpilled)) {
+        /* start from the nearest checkpoint at or before the record */
+        pCursor->ulIndex = ulIndex - ulSkip;
+        pCursor->usOffset =
+            Store->usCheckpoint
+                [(ulSequence / TL_CHECKPOINT_RECORDS) % TL_CHECKPOINT_COUNT];
+        memset(&pCursor->State, 0, sizeof(pCursor->State));
+    } else {
+        /* no checkpoint between the oldest record and this one */
+        pCursor->ulIndex = ulSpilled;
+        pCursor->usOffset = Store->usTail;
+        pCursor->State = Store->Tail;
+    }
+    while (pCursor->ulIndex < ulIndex) {
+        (void)TL_Cursor_Next(iLog, pCursor, &TempRec);
+    }
+}
+
+/**
+ * @brief Clear all the records from a log
+ * @param iLog - Index of the log
+ */
+static void TL_Log_Purge(int iLog)
+{
+    TL_LOG_STORE *Store = &LogStore[iLog];
+
+    if (Store->Segment) {
+        (void)logseg_clear(
+            Store->Segment, LogInfo[iLog].ulTotalRecordCount + 1);
+    }
+    LogInfo[iLog].ulRecordCount = 0;
+    Store->ulCount = 0;
+    Store->usHead = 0;
+    Store->usTail = 0;
+    Store->usUsed = 0;
+    memset(&Store->Head, 0, sizeof(Store->Head));
+    memset(&Store->Tail, 0, sizeof(Store->Tail));
+}
+
+/**
+ * @brief Remove the oldest record from a log
+ * @param iLog - Index of the log
+ */
+static void TL_Log_Remove_Oldest(int iLog)
+{
+    TL_LOG_STORE *Store = &LogStore[iLog];
+    TL_CURSOR Cursor;
+    TL_DATA_REC TempRec;
+    int len;
+
+    Cursor.ulIndex = TL_Segment_Count(iLog);
+    Cursor.usOffset = Store->usTail;
+    Cursor.State = Store->Tail;
+    len = TL_Cursor_Next(iLog, &Cursor, &TempRec);
+    Store->usTail = Cursor.usOffset;
+    Store->Tail = Cursor.State;
+    Store->usUsed -= len;
+    Store->ulCount--;
+    if (!Store->Segment) {
+        LogInfo[iLog].ulRecordCount--;
+    }
+}
+
+/**
+ * @brief Work out the number of records in a log from the records in the
+ *  log buffer and those older ones that are still in the segment store.
+ * @param iLog - Index of the log
+ */
+static void TL_Log_Count_Update(int iLog)
+{
+    TL_LOG_STORE *Store = &LogStore[iLog];
+    uint32_t ulSpilled;
+
+    LogInfo[iLog].ulRecordCount = Store->ulCount;
+    if (Store->Segment) {
+        /* records in the store from its oldest up to the log buffer */
+        ulSpilled = (LogInfo[iLog].ulTotalRecordCount - Store->ulCount + 1) -
+            logseg_first_sequence(Store->Segment);
+        if (ulSpilled <= logseg_count(Store->Segment)) {
+            LogInfo[iLog].ulRecordCount += ulSpilled;
+        }
+    }
+}
+
+/**
+ * @brief Add a record to a log, removing the oldest records if there is
+ *  no room for it.
+ * @param iLog - Index of the log
+ * @param pSource - record to add
+ */
+static void TL_Log_Record_Add(int iLog, const TL_DATA_REC *pSource)
+{
+    TL_LOG_INFO *CurrentLog = &LogInfo[iLog];
+    TL_LOG_STORE *Store = &LogStore[iLog];
+    uint8_t buffer[TL_PACK_MAX];
+    TL_PACK_STATE State;
+    uint32_t ulSequence;
+    int len;
+    int i;
+
+    ulSequence = CurrentLog->ulTotalRecordCount + 1;
+    State = Store->Head;
+    if ((ulSequence % TL_CHECKPOINT_RECORDS) == 0) {
+        memset(&State, 0, sizeof(State));
+    }
+    len = TL_Record_Pack(buffer, &State, pSource);
+    while ((Store->ulCount > 0) &&
+           ((Store->ulCount >= TL_MAX_ENTRIES) ||
+            ((TL_LOG_BUFFER_BYTES - Store->usUsed) < len))) {
+        TL_Log_Remove_Oldest(iLog);
+    }
+    if ((ulSequence % TL_CHECKPOINT_RECORDS) == 0) {
+        Store->usCheckpoint
+            [(ulSequence / TL_CHECKPOINT_RECORDS) % TL_CHECKPOINT_COUNT] =
+            Store->usHead;
+    }
+    for (i = 0; i < len; i++) {
+        LogData[iLog][Store->usHead] = buffer[i];
+        Store->usHead++;
+        if (Store->usHead >= TL_LOG_BUFFER_BYTES) {
+            Store->usHead = 0;
+        }
+    }
+    Store->usUsed += len;
+    Store->Head = State;
+    Store->ulCount++;
+    CurrentLog->ulTotalRecordCount = ulSequence;
+    if (Store->Segment) {
+        memset(&State, 0, sizeof(State));
+        len = TL_Record_Pack(buffer, &State, pSource);
+        (void)logseg_append(Store->Segment, ulSequence, buffer, len);
+    }
+    TL_Log_Count_Update(iLog);
+}
+
+/**
+ * @brief Get the number of records a log can hold
+ * @note With a segment store, this is the number of the largest records
+ *  that fit in all but one of its pages, since the oldest page is erased
+ *  to make room.
+ * @param iLog - Index of the log
+ * @return number of records
+ */
+static uint32_t TL_Buffer_Size(int iLog)
+{
+    const BACNET_LOG_SEGMENT *Segment = LogStore[iLog].Segment;
+    uint32_t ulSize = TL_MAX_ENTRIES;
+    uint32_t ulPerPage;
+
+    if (Segment) {
+        ulPerPage = (Segment->driver->page_size - LOGSEG_PAGE_HEADER_SIZE) /
+            (TL_PACK_MAX + LOGSEG_RECORD_OVERHEAD);
+        if ((ulPerPage * (Segment->driver->page_count - 1U)) > ulSize) {
+            ulSize = ulPerPage * (Segment->driver->page_count - 1U);
+        }
+    }
+
+    return ulSize;
+}
+
+/**
+ * @brief Determine if a log has no room for another record without
+ *  removing the oldest one.
+ * @param iLog - Index of the log
+ * @return true if the log is full
+ */
+static bool TL_Log_Full(int iLog)
+{
+    if (LogStore[iLog].Segment) {
+        return LogInfo[iLog].ulRecordCount >= TL_Buffer_Size(iLog);
+    }
+
+    return (LogInfo[iLog].ulRecordCount >= TL_MAX_ENTRIES) ||
+        ((TL_LOG_BUFFER_BYTES - LogStore[iLog].usUsed) < TL_PACK_MAX);
+}
+
+/**
+ * @brief Determine if a record is at or after the point a time search
+ *  is looking for.
+ * @param pRecord - record to check
+ * @param tRefTime - reference time
+ * @param bInclusive - true to also match records at the reference time
+ * @return true if the record matches
+ */
+static bool TL_Record_After(
+    const TL_DATA_REC *pRecord, bacnet_time_t tRefTime, bool bInclusive)
+{
+    return (pRecord->tTimeStamp > tRefTime) ||
+        ((pRecord->tTimeStamp == tRefTime) && bInclusive);
+}
+
+/**
+ * @brief Find the first record in a log with a time stamp after a
+ *  reference time.
+ * @note Records are added in time order, so the checkpoints are binary
+ *  searched and then at most two blocks of records are unpacked. Records
+ *  in the segment store are binary searched one by one.
+ * @param iLog - Index of the log
+ * @param tRefTime - reference time
+ * @param bInclusive - true to also match records at the reference time
+ * @return 0 based index of the record, or the record count if none
+ */
+static uint32_t
+TL_Log_Time_Index(int iLog, bacnet_time_t tRefTime, bool bInclusive)
+{
+    TL_CURSOR Cursor;
+    TL_DATA_REC TempRec;
+    uint32_t ulRecordCount;
+    uint32_t ulSpilled;
+    uint32_t ulFirstCheckpoint;
+    uint32_t ulLow = 0;
+    uint32_t ulHigh = 0;
+    uint32_t ulMid;
+
+    ulRecordCount = LogInfo[iLog].ulRecordCount;
+    ulSpilled = TL_Segment_Count(iLog);
+    if (ulSpilled > 0) {
+        TL_Cursor_Seek(iLog, ulSpilled - 1, &Cursor);
+        (void)TL_Cursor_Next(iLog, &Cursor, &TempRec);
+        if (TL_Record_After(&TempRec, tRefTime, bInclusive)) {
+            /* the record is in the segment store */
+            ulHigh = ulSpilled - 1;
+            while (ulLow < ulHigh) {
+                ulMid = ulLow + ((ulHigh - ulLow) / 2);
+                TL_Cursor_Seek(iLog, ulMid, &Cursor);
+                (void)TL_Cursor_Next(iLog, &Cursor, &TempRec);
+                if (TL_Record_After(&TempRec, tRefTime, bInclusive)) {
+                    ulHigh = ulMid;
+                } else {
+                    ulLow = ulMid + 1;
+                }
+            }
+            return ulLow;
+        }
+    }
+    /* index of the oldest checkpoint record in the log buffer */
+    ulFirstCheckpoint = ulSpilled +
+        ((TL_CHECKPOINT_RECORDS -
+          ((TL_First_Sequence(iLog) + ulSpilled) % TL_CHECKPOINT_RECORDS)) %
+         TL_CHECKPOINT_RECORDS);
+    if (ulRecordCount > ulFirstCheckpoint) {
+        ulHigh = (ulRecordCount - ulFirstCheckpoint +
+                  TL_CHECKPOINT_RECORDS - 1) /
+            TL_CHECKPOINT_RECORDS;
+    }
+    while (ulLow < ulHigh) {
+        ulMid = ulLow + ((ulHigh - ulLow) / 2);
+        TL_Cursor_Seek(
+            iLog, ulFirstCheckpoint + (ulMid * TL_CHECKPOINT_RECORDS),
+            &Cursor);
+        (void)TL_Cursor_Next(iLog, &Cursor, &TempRec);
+        if (TL_Record_After(&TempRec, tRefTime, bInclusive)) {
+            ulHigh = ulMid;
+        } else {
+            ulLow = ulMid + 1;
+        }
+    }
+    if (ulLow == 0) {
+        TL_Cursor_Seek(iLog, ulSpilled, &Cursor);
+    } else {
+        TL_Cursor_Seek(
+            iLog, ulFirstCheckpoint + ((ulLow - 1) * TL_CHECKPOINT_RECORDS),
+            &Cursor);
+    }
+    while (Cursor.ulIndex < ulRecordCount) {
+        ulMid = Cursor.ulIndex;
+        (void)TL_Cursor_Next(iLog, &Cursor, &TempRec);
+        if (TL_Record_After(&TempRec, tRefTime, bInclusive)) {
+            return ulMid;
+        }
+    }
+
+    return ulRecordCount;
+}
+
 /*
  * Things to do when starting up the stack for Trend Logs.
  * Should be called whenever we reset the device or power it up
@@ -172,6 +873,7 @@ void Trend_Log_Init(void)
     BACNET_DATE_TIME bdatetime = { 0 };
     bacnet_time_t tClock;
     uint8_t month;
+    TL_DATA_REC TempRec = { 0 };
 
     if (!initialized) {
         initialized = true;
@@ -198,17 +900,19 @@ void Trend_Log_Init(void)
             month = iLog + 1;
             datetime_set_values(&bdatetime, 2009, month, 1, 0, 0, 0, 0);
             tClock = datetime_seconds_since_epoch(&bdatetime);
+            TL_Log_Purge(iLog);
             for (iEntry = 0; iEntry < TL_MAX_ENTRIES; iEntry++) {
-                Logs[iLog][iEntry].tTimeStamp = tClock;
-                Logs[iLog][iEntry].ucRecType = TL_TYPE_REAL;
-                Logs[iLog][iEntry].Datum.fReal =
+                TempRec.tTimeStamp = tClock;
+                TempRec.ucRecType = TL_TYPE_REAL;
+                TempRec.Datum.fReal =
                     (float)(iEntry + (iLog * TL_MAX_ENTRIES));
                 /* Put status flags with every second log */
                 if ((iLog & 1) == 0) {
-                    Logs[iLog][iEntry].ucStatus = 128;
+                    TempRec.ucStatus = 128;
                 } else {
-                    Logs[iLog][iEntry].ucStatus = 0;
+                    TempRec.ucStatus = 0;
                 }
+                TL_Log_Record_Add(iLog, &TempRec);
                 /* advance 15 minutes, in seconds */
                 tClock += 900;
             }
@@ -222,10 +926,7 @@ void Trend_Log_Init(void)
             LogInfo[iLog].Source.arrayIndex = 0;
             LogInfo[iLog].ucTimeFlags = 0;
             LogInfo[iLog].ulIntervalOffset = 0;
-            LogInfo[iLog].iIndex = 0;
             LogInfo[iLog].ulLogInterval = 900;
-            LogInfo[iLog].ulRecordCount = TL_MAX_ENTRIES;
-            LogInfo[iLog].ulTotalRecordCount = 10000;
 
             LogInfo[iLog].Source.deviceIdentifier.instance =
                 Device_Object_Instance_Number();
@@ -249,22 +950,71 @@ void Trend_Log_Init(void)
     return;
 }
 
+/**
+ * @brief Give a Trend Log a segment store in flash or EEPROM, so that it
+ *  can hold many more records than fit in its log buffer.
+ * @note The records already in the store become the records of the log,
+ *  replacing those in the log buffer, so the log carries on after a
+ *  reset from where it left off.
+ * @param object_instance - object-instance number of the object
+ * @param store - segment store, already initialized, or NULL for none
+ * @return true if the store was set
+ */
+bool Trend_Log_Segment_Store_Set(
+    uint32_t object_instance, BACNET_LOG_SEGMENT *store)
+{
+    TL_LOG_STORE *Store;
+    int iLog;
+
+    iLog = Trend_Log_Instance_To_Index(object_instance);
+    if (iLog >= MAX_TREND_LOGS) {
+        return false;
+    }
+    Store = &LogStore[iLog];
+    Store->Segment = NULL;
+    TL_Log_Purge(iLog);
+    if (store && (logseg_record_size_max(store) < TL_PACK_MAX)) {
+        return false;
+    }
+    Store->Segment = store;
+    if (store && (logseg_count(store) > 0)) {
+        LogInfo[iLog].ulTotalRecordCount =
+            logseg_first_sequence(store) + logseg_count(store) - 1;
+        TL_Log_Count_Update(iLog);
+    }
+
+    return true;
+}
+
 /*
  * Note: we use the instance number here and build the name based
  * on the assumption that there is a 1 to 1 correspondence. If there
  * is not we need to convert to index before proceeding.
  */
+static bool Trend_Log_Object_Name_View(
+    uint32_t object_instance,
+    BACNET_CHARACTER_STRING_VIEW *object_name,
+    char *text,
+    size_t text_size)
+{
+    if (object_instance >= MAX_TREND_LOGS) {
+        return false;
+    }
+
+    return characterstring_view_object_name(
+        object_name, NULL, "Trend Log %lu", object_instance, text, text_size);
+}
+
 bool Trend_Log_Object_Name(
     uint32_t object_instance, BACNET_CHARACTER_STRING *object_name)
 {
+    BACNET_CHARACTER_STRING_VIEW name;
     char text[32] = "";
     bool status = false;
 
-    if (object_instance < MAX_TREND_LOGS) {
-        snprintf(
-            text, sizeof(text), "Trend Log %lu",
-            (unsigned long)object_instance);
-        status = characterstring_init_ansi(object_name, text);
+    if (Trend_Log_Object_Name_View(
+            object_instance, &name, text, sizeof(text))) {
+        status = characterstring_view_copy(object_name, &name);
     }
 
     return status;
@@ -277,7 +1027,8 @@ int Trend_Log_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
     int apdu_len = 0; /* return value */
     int len = 0; /* apdu len intermediate value */
     BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
+    BACNET_CHARACTER_STRING_VIEW char_string;
+    char name_text[32];
     TL_LOG_INFO *CurrentLog;
     uint8_t *apdu = NULL;
     int log_index;
@@ -303,9 +1054,11 @@ int Trend_Log_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
 
         case PROP_DESCRIPTION:
         case PROP_OBJECT_NAME:
-            Trend_Log_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+            Trend_Log_Object_Name_View(
+                rpdata->object_instance, &char_string, name_text,
+                sizeof(name_text));
+            apdu_len = encode_application_character_string_view(
+                &apdu[0], &char_string);
             break;
 
         case PROP_OBJECT_TYPE:
@@ -323,7 +1076,8 @@ int Trend_Log_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
 
         case PROP_BUFFER_SIZE:
-            apdu_len = encode_application_unsigned(&apdu[0], TL_MAX_ENTRIES);
+            apdu_len = encode_application_unsigned(
+                &apdu[0], TL_Buffer_Size(log_index));
             break;
 
         case PROP_LOG_BUFFER:
@@ -473,7 +1227,7 @@ bool Trend_Log_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
                  * set */
                 if ((CurrentLog->bEnable == false) &&
                     (CurrentLog->bStopWhenFull == true) &&
-                    (CurrentLog->ulRecordCount == TL_MAX_ENTRIES) &&
+                    TL_Log_Full(log_index) &&
                     (value.type.Boolean == true)) {
                     status = false;
                     wp_data->error_class = ERROR_CLASS_OBJECT;
@@ -516,7 +1270,7 @@ bool Trend_Log_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
                     CurrentLog->bStopWhenFull = value.type.Boolean;
 
                     if ((value.type.Boolean == true) &&
-                        (CurrentLog->ulRecordCount == TL_MAX_ENTRIES) &&
+                        TL_Log_Full(log_index) &&
                         (CurrentLog->bEnable == true)) {
                         /* When full log is switched from normal to stop when
                          * full disable the log and record the fact - see
@@ -545,8 +1299,7 @@ bool Trend_Log_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
             if (status) {
                 if (value.type.Unsigned_Int == 0) {
                     /* Time to clear down the log */
-                    CurrentLog->ulRecordCount = 0;
-                    CurrentLog->iIndex = 0;
+                    TL_Log_Purge(log_index);
                     TL_Insert_Status_Rec(
                         log_index, LOG_STATUS_BUFFER_PURGED, true);
                 }
@@ -711,8 +1464,7 @@ bool Trend_Log_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
                     &TempSource, &CurrentLog->Source,
                     sizeof(BACNET_DEVICE_OBJECT_PROPERTY_REFERENCE)) != 0) {
                 /* Clear buffer if property being logged is changed */
-                CurrentLog->ulRecordCount = 0;
-                CurrentLog->iIndex = 0;
+                TL_Log_Purge(log_index);
                 TL_Insert_Status_Rec(log_index, LOG_STATUS_BUFFER_PURGED, true);
             }
             CurrentLog->Source = TempSource;
@@ -829,11 +1581,8 @@ bool TrendLogGetRRInfo(
 
 void TL_Insert_Status_Rec(int iLog, BACNET_LOG_STATUS eStatus, bool bState)
 {
-    TL_LOG_INFO *CurrentLog;
     TL_DATA_REC TempRec;
 
-    CurrentLog = &LogInfo[iLog];
-
     TempRec.tTimeStamp = Trend_Log_Epoch_Seconds_Now();
     TempRec.ucRecType = TL_TYPE_STATUS;
     TempRec.ucStatus = 0;
@@ -858,16 +1607,7 @@ void TL_Insert_Status_Rec(int iLog, BACNET_LOG_STATUS eStatus, bool bState)
             break;
     }
 
-    Logs[iLog][CurrentLog->iIndex++] = TempRec;
-    if (CurrentLog->iIndex >= TL_MAX_ENTRIES) {
-        CurrentLog->iIndex = 0;
-    }
-
-    CurrentLog->ulTotalRecordCount++;
-
-    if (CurrentLog->ulRecordCount < TL_MAX_ENTRIES) {
-        CurrentLog->ulRecordCount++;
-    }
+    TL_Log_Record_Add(iLog, &TempRec);
 }
 
 /*****************************************************************************
@@ -1012,29 +1752,218 @@ int rr_trend_log_encode(uint8_t *apdu, BACNET_READ_RANGE_DATA *pRequest)
 }
 
 /**
- * @brief Handle encoding for the By Position and All options.
- * @note Performs the All option by converting to a By Position
- *  request starting at index 1 and of maximum log size length.
+ * @brief Encode an unpacked log record into the APDU buffer.
  * @param apdu - Pointer to the buffer to encode into.
- * @param pRequest - Pointer to the request data structure containing
- * the request parameters.
- * @return APDU length, which could be 0
+ * @param pSource - the unpacked log record
+ * @return APDU length
  */
-int TL_encode_by_position(uint8_t *apdu, BACNET_READ_RANGE_DATA *pRequest)
+static int TL_encode_record(uint8_t *apdu, const TL_DATA_REC *pSource)
 {
-    int log_index = 0;
     int iLen = 0;
-    int32_t iTemp = 0;
-    TL_LOG_INFO *CurrentLog = NULL;
+    BACNET_BIT_STRING TempBits;
+    uint8_t ucCount = 0;
+    BACNET_DATE_TIME TempTime;
+
+    /* First stick the time stamp in with tag [0] */
+    TL_Local_Time_To_BAC(&TempTime, pSource->tTimeStamp);
+    iLen += bacapp_encode_context_datetime(apdu, 0, &TempTime);
+
+    /* Next comes the actual entry with tag [1] */
+    iLen += encode_opening_tag(&apdu[iLen], 1);
+    /* The data entry is tagged individually [0] - [10]
+       to indicate which type */
+    switch (pSource->ucRecType) {
+        case TL_TYPE_STATUS:
+            /* Build bit string directly from the stored octet */
+            bitstring_init(&TempBits);
+            bitstring_set_bits_used(&TempBits, 1, 5);
+            bitstring_set_octet(&TempBits, 0, pSource->Datum.ucLogStatus);
+            iLen += encode_context_bitstring(
+                &apdu[iLen], pSource->ucRecType, &TempBits);
+            break;
+
+        case TL_TYPE_BOOL:
+            iLen += encode_context_boolean(
+                &apdu[iLen], pSource->ucRecType, pSource->Datum.ucBoolean);
+            break;
+
+        case TL_TYPE_REAL:
+            iLen += encode_context_real(
+                &apdu[iLen], pSource->ucRecType, pSource->Datum.fReal);
+            break;
+
+        case TL_TYPE_ENUM:
+            iLen += encode_context_enumerated(
+                &apdu[iLen], pSource->ucRecType, pSource->Datum.ulEnum);
+            break;
+
+        case TL_TYPE_UNSIGN:
+            iLen += encode_context_unsigned(
+                &apdu[iLen], pSource->ucRecType, pSource->Datum.ulUValue);
+            break;
+
+        case TL_TYPE_SIGN:
+            iLen += encode_context_signed(
+                &apdu[iLen], pSource->ucRecType, pSource->Datum.lSValue);
+            break;
+
+        case TL_TYPE_BITS:
+            /* Rebuild bitstring directly from stored octets - which we
+             * have limited to 32 bits maximum as allowed by the standard
+             */
+            bitstring_init(&TempBits);
+            bitstring_set_bits_used(
+                &TempBits, (pSource->Datum.Bits.ucLen >> 4) & 0x0F,
+                pSource->Datum.Bits.ucLen & 0x0F);
+            for (ucCount = pSource->Datum.Bits.ucLen >> 4; ucCount > 0;
+                 ucCount--) {
+                bitstring_set_octet(
+                    &TempBits, ucCount - 1,
+                    pSource->Datum.Bits.ucStore[ucCount - 1]);
+            }
+
+            iLen += encode_context_bitstring(
+                &apdu[iLen], pSource->ucRecType, &TempBits);
+            break;
+
+        case TL_TYPE_NULL:
+            iLen += encode_context_null(&apdu[iLen], pSource->ucRecType);
+            break;
+
+        case TL_TYPE_ERROR:
+            iLen += encode_opening_tag(&apdu[iLen], TL_TYPE_ERROR);
+            iLen += encode_application_enumerated(
+                &apdu[iLen], pSource->Datum.Error.usClass);
+            iLen += encode_application_enumerated(
+                &apdu[iLen], pSource->Datum.Error.usCode);
+            iLen += encode_closing_tag(&apdu[iLen], TL_TYPE_ERROR);
+            break;
+
+        case TL_TYPE_DELTA:
+            iLen += encode_context_real(
+                &apdu[iLen], pSource->ucRecType, pSource->Datum.fTime);
+            break;
+
+        case TL_TYPE_ANY:
+            /* Should never happen as we don't support this at the moment */
+            break;
 
-    uint32_t uiIndex = 0; /* Current entry number */
-    uint32_t uiFirst = 0; /* Entry number we started encoding from */
-    uint32_t uiLast = 0; /* Entry number we finished encoding on */
-    uint32_t uiTarget = 0; /* Last entry we are required to encode */
+        default:
+            break;
+    }
+
+    iLen += encode_closing_tag(&apdu[iLen], 1);
+    /* Check if status bit string is required and insert with tag [2] */
+    if ((pSource->ucStatus & 128) == 128) {
+        bitstring_init(&TempBits);
+        bitstring_set_bits_used(&TempBits, 1, 4);
+        /* only insert the 1st 4 bits */
+        bitstring_set_octet(&TempBits, 0, (pSource->ucStatus & 0x0F));
+        iLen += encode_context_bitstring(&apdu[iLen], 2, &TempBits);
+    }
+
+    return (iLen);
+}
+
+/**
+ * @brief Encode a single log entry into the APDU buffer.
+ * @param apdu - Pointer to the buffer to encode into.
+ * @param iLog - Index of the log to encode from.
+ * @param iEntry - Index of the entry to encode (1 based).
+ */
+int TL_encode_entry(uint8_t *apdu, int iLog, int iEntry)
+{
+    TL_CURSOR Cursor;
+    TL_DATA_REC TempRec;
+
+    if ((iEntry < 1) || ((uint32_t)iEntry > LogInfo[iLog].ulRecordCount)) {
+        return 0;
+    }
+    /* Convert from BACnet 1 based to 0 based index and unpack the entry */
+    TL_Cursor_Seek(iLog, iEntry - 1, &Cursor);
+    (void)TL_Cursor_Next(iLog, &Cursor, &TempRec);
+
+    return TL_encode_record(apdu, &TempRec);
+}
+
+/**
+ * @brief Encode a run of log entries, unpacking each one as it is encoded.
+ * @param apdu - Pointer to the buffer to encode into.
+ * @param pRequest - Pointer to the request data structure containing
+ * the request parameters.
+ * @param iLog - Index of the log to encode from.
+ * @param ulIndex - 0 based index of the first entry to encode
+ * @param ulCount - number of entries to encode
+ * @return APDU length, which could be 0
+ */
+static int TL_encode_range(
+    uint8_t *apdu,
+    BACNET_READ_RANGE_DATA *pRequest,
+    int iLog,
+    uint32_t ulIndex,
+    uint32_t ulCount)
+{
+    int iLen = 0;
+    int iTemp = 0;
+    TL_CURSOR Cursor;
+    TL_DATA_REC TempRec;
+    uint32_t ulRecordCount;
     uint32_t uiRemaining = 0; /* Amount of unused space in packet */
 
     /* See how much space we have */
     uiRemaining = MAX_APDU - pRequest->Overhead;
+    ulRecordCount = LogInfo[iLog].ulRecordCount;
+    if (ulIndex >= ulRecordCount) {
+        return 0;
+    }
+    if (ulCount > (ulRecordCount - ulIndex)) {
+        /* Capped at end of list if necessary */
+        ulCount = ulRecordCount - ulIndex;
+    }
+    if (ulIndex == 0) {
+        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_FIRST_ITEM, true);
+    }
+    TL_Cursor_Seek(iLog, ulIndex, &Cursor);
+    while (ulCount > 0) {
+        if (uiRemaining < TL_MAX_ENC) {
+            /*
+             * Can't fit any more in! We just set the result flag to say
+             * there was more and drop out of the loop early
+             */
+            bitstring_set_bit(
+                &pRequest->ResultFlags, RESULT_FLAG_MORE_ITEMS, true);
+            break;
+        }
+        (void)TL_Cursor_Next(iLog, &Cursor, &TempRec);
+        iTemp = TL_encode_record(&apdu[iLen], &TempRec);
+        uiRemaining -= iTemp; /* Reduce the remaining space */
+        iLen += iTemp; /* and increase the length consumed */
+        pRequest->ItemCount++; /* Chalk up another one for the response count */
+        ulCount--;
+    }
+    if (Cursor.ulIndex == ulRecordCount) {
+        /* The last entry was encoded */
+        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_LAST_ITEM, true);
+    }
+
+    return iLen;
+}
+
+/**
+ * @brief Handle encoding for the By Position and All options.
+ * @note Performs the All option by converting to a By Position
+ *  request starting at index 1 and of maximum log size length.
+ * @param apdu - Pointer to the buffer to encode into.
+ * @param pRequest - Pointer to the request data structure containing
+ * the request parameters.
+ * @return APDU length, which could be 0
+ */
+int TL_encode_by_position(uint8_t *apdu, BACNET_READ_RANGE_DATA *pRequest)
+{
+    int log_index = 0;
+    int32_t iTemp = 0;
+    TL_LOG_INFO *CurrentLog = NULL;
+
     log_index = Trend_Log_Instance_To_Index(pRequest->object_instance);
     CurrentLog = &LogInfo[log_index];
     if (pRequest->RequestType == RR_READ_ALL) {
@@ -1077,59 +2006,24 @@ int TL_encode_by_position(uint8_t *apdu, BACNET_READ_RANGE_DATA *pRequest)
 
     /* From here on in we only have a starting point and a positive count */
 
-    if (pRequest->Range.RefIndex >
-        CurrentLog->ulRecordCount) { /* Nothing to return as we are past the
-                                      end of the list */
+    if ((pRequest->Range.RefIndex == 0) ||
+        (pRequest->Range.RefIndex > CurrentLog->ulRecordCount)) {
+        /* Nothing to return as we are past the end of the list */
         return (0);
     }
 
-    uiTarget = pRequest->Range.RefIndex + pRequest->Count -
-        1; /* Index of last required entry */
-    if (uiTarget >
-        CurrentLog->ulRecordCount) { /* Capped at end of list if necessary */
-        uiTarget = CurrentLog->ulRecordCount;
-    }
-
-    uiIndex = pRequest->Range.RefIndex;
-    uiFirst = uiIndex; /* Record where we started from */
-    while (uiIndex <= uiTarget) {
-        if (uiRemaining < TL_MAX_ENC) {
-            /*
-             * Can't fit any more in! We just set the result flag to say
-             * there was more and drop out of the loop early
-             */
-            bitstring_set_bit(
-                &pRequest->ResultFlags, RESULT_FLAG_MORE_ITEMS, true);
-            break;
-        }
-
-        iTemp = TL_encode_entry(&apdu[iLen], log_index, uiIndex);
-
-        uiRemaining -= iTemp; /* Reduce the remaining space */
-        iLen += iTemp; /* and increase the length consumed */
-        uiLast = uiIndex; /* Record the last entry encoded */
-        uiIndex++; /* and get ready for next one */
-        pRequest->ItemCount++; /* Chalk up another one for the response count */
-    }
-
-    /* Set remaining result flags if necessary */
-    if (uiFirst == 1) {
-        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_FIRST_ITEM, true);
-    }
-
-    if (uiLast == CurrentLog->ulRecordCount) {
-        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_LAST_ITEM, true);
-    }
-
-    return (iLen);
+    return TL_encode_range(
+        apdu, pRequest, log_index, pRequest->Range.RefIndex - 1,
+        pRequest->Count);
 }
 
 /**
  * @brief Handle encoding for the By Sequence option.
- * @note The fact that the buffer always has at least
- *  a single entry is used implicetly in the following
- *  implementationas we don't have to handle the case
- *  of an empty buffer.
+ * @note Sequence numbers are handled as offsets from the sequence number
+ *  of the oldest record, using unsigned arithmetic, so a log or request
+ *  range that wraps past the maximum for uint32_t needs no special cases.
+ *  The records in a Trend Log have consecutive sequence numbers, so the
+ *  offset is also the position of the record in the log.
  * @param apdu - Pointer to the buffer to encode into.
  * @param pRequest - Pointer to the request data structure containing
  * the request parameters.
@@ -1138,154 +2032,56 @@ int TL_encode_by_position(uint8_t *apdu, BACNET_READ_RANGE_DATA *pRequest)
 int TL_encode_by_sequence(uint8_t *apdu, BACNET_READ_RANGE_DATA *pRequest)
 {
     int log_index = 0;
-    int iLen = 0;
-    int32_t iTemp = 0;
     TL_LOG_INFO *CurrentLog = NULL;
-
-    uint32_t uiIndex = 0; /* Current entry number */
-    uint32_t uiFirst = 0; /* Entry number we started encoding from */
-    uint32_t uiLast = 0; /* Entry number we finished encoding on */
-    uint32_t uiSequence = 0; /* Tracking sequence number when encoding */
-    uint32_t uiRemaining = 0; /* Amount of unused space in packet */
     uint32_t uiFirstSeq = 0; /* Sequence number for 1st record in log */
+    uint32_t uiSpan = 0; /* Offset of the last record in the log */
+    uint32_t uiLength = 0; /* Number of sequence numbers requested, less 1 */
+    uint32_t uiBegin = 0; /* Starting offset for request */
+    uint32_t uiEnd = 0; /* Ending offset for request */
 
-    uint32_t uiBegin = 0; /* Starting Sequence number for request */
-    uint32_t uiEnd = 0; /* Ending Sequence number for request */
-    bool bWrapReq = false; /* Has request sequence range spanned the max for
-                              uint32_t? */
-    bool bWrapLog =
-        false; /* Has log sequence range spanned the max for uint32_t? */
-
-    /* See how much space we have */
-    uiRemaining = MAX_APDU - pRequest->Overhead;
     log_index = Trend_Log_Instance_To_Index(pRequest->object_instance);
     CurrentLog = &LogInfo[log_index];
-    /* Figure out the sequence number for the first record, last is
-     * ulTotalRecordCount */
-    uiFirstSeq =
-        CurrentLog->ulTotalRecordCount - (CurrentLog->ulRecordCount - 1);
-
-    /* Calculate start and end sequence numbers from request */
+    uiFirstSeq = TL_First_Sequence(log_index);
+    uiSpan = CurrentLog->ulRecordCount - 1;
+    /* Calculate start offset and range length from request */
     if (pRequest->Count < 0) {
-        uiBegin = pRequest->Range.RefSeqNum + pRequest->Count + 1;
-        uiEnd = pRequest->Range.RefSeqNum;
+        uiLength = (uint32_t)(-(pRequest->Count + 1));
+        uiBegin = pRequest->Range.RefSeqNum - uiLength - uiFirstSeq;
+    } else if (pRequest->Count > 0) {
+        uiLength = (uint32_t)(pRequest->Count - 1);
+        uiBegin = pRequest->Range.RefSeqNum - uiFirstSeq;
     } else {
-        uiBegin = pRequest->Range.RefSeqNum;
-        uiEnd = pRequest->Range.RefSeqNum + pRequest->Count - 1;
-    }
-    /* See if we have any wrap around situations */
-    if (uiBegin > uiEnd) {
-        bWrapReq = true;
-    }
-    if (uiFirstSeq > CurrentLog->ulTotalRecordCount) {
-        bWrapLog = true;
-    }
-
-    if ((bWrapReq == false) && (bWrapLog == false)) { /* Simple case no wraps */
-        /* If no overlap between request range and buffer contents bail out
-         */
-        if ((uiEnd < uiFirstSeq) ||
-            (uiBegin > CurrentLog->ulTotalRecordCount)) {
-            return (0);
-        }
-
-        /* Truncate range if necessary so it is guaranteed to lie
-         * between the first and last sequence numbers in the buffer
-         * inclusive.
-         */
-        if (uiBegin < uiFirstSeq) {
-            uiBegin = uiFirstSeq;
-        }
-
-        if (uiEnd > CurrentLog->ulTotalRecordCount) {
-            uiEnd = CurrentLog->ulTotalRecordCount;
-        }
-    } else { /* There are wrap arounds to contend with */
-        /* First check for non overlap condition as it is common to all */
-        if ((uiBegin > CurrentLog->ulTotalRecordCount) &&
-            (uiEnd < uiFirstSeq)) {
-            return (0);
-        }
-
-        if (bWrapLog == false) { /* Only request range wraps */
-            if (uiEnd < uiFirstSeq) {
-                uiEnd = CurrentLog->ulTotalRecordCount;
-                if (uiBegin < uiFirstSeq) {
-                    uiBegin = uiFirstSeq;
-                }
-            } else {
-                uiBegin = uiFirstSeq;
-                if (uiEnd > CurrentLog->ulTotalRecordCount) {
-                    uiEnd = CurrentLog->ulTotalRecordCount;
-                }
-            }
-        } else if (bWrapReq == false) { /* Only log wraps */
-            if (uiBegin > CurrentLog->ulTotalRecordCount) {
-                if (uiBegin > uiFirstSeq) {
-                    uiBegin = uiFirstSeq;
-                }
-            } else {
-                if (uiEnd > CurrentLog->ulTotalRecordCount) {
-                    uiEnd = CurrentLog->ulTotalRecordCount;
-                }
-            }
-        } else { /* Both wrap */
-            if (uiBegin < uiFirstSeq) {
-                uiBegin = uiFirstSeq;
-            }
-
-            if (uiEnd > CurrentLog->ulTotalRecordCount) {
-                uiEnd = CurrentLog->ulTotalRecordCount;
-            }
-        }
+        return (0);
     }
-
-    /* We now have a range that lies completely within the log buffer
-     * and we need to figure out where that starts in the buffer.
+    /* Truncate range if necessary so it is guaranteed to lie
+     * between the first and last sequence numbers in the buffer
+     * inclusive.
      */
-    uiIndex = uiBegin - uiFirstSeq + 1;
-    uiSequence = uiBegin;
-    uiFirst = uiIndex; /* Record where we started from */
-    while (uiSequence != uiEnd + 1) {
-        if (uiRemaining < TL_MAX_ENC) {
-            /*
-             * Can't fit any more in! We just set the result flag to say
-             * there was more and drop out of the loop early
-             */
-            bitstring_set_bit(
-                &pRequest->ResultFlags, RESULT_FLAG_MORE_ITEMS, true);
-            break;
+    if (uiBegin <= uiSpan) {
+        if (uiLength > (uiSpan - uiBegin)) {
+            uiEnd = uiSpan;
+        } else {
+            uiEnd = uiBegin + uiLength;
         }
-
-        iTemp = TL_encode_entry(&apdu[iLen], log_index, uiIndex);
-
-        uiRemaining -= iTemp; /* Reduce the remaining space */
-        iLen += iTemp; /* and increase the length consumed */
-        uiLast = uiIndex; /* Record the last entry encoded */
-        uiIndex++; /* and get ready for next one */
-        uiSequence++;
-        pRequest->ItemCount++; /* Chalk up another one for the response count */
-    }
-
-    /* Set remaining result flags if necessary */
-    if (uiFirst == 1) {
-        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_FIRST_ITEM, true);
-    }
-
-    if (uiLast == CurrentLog->ulRecordCount) {
-        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_LAST_ITEM, true);
+    } else if ((0U - uiBegin) <= uiLength) {
+        /* request range starts before the log and wraps into it */
+        uiEnd = uiBegin + uiLength;
+        if (uiEnd > uiSpan) {
+            uiEnd = uiSpan;
+        }
+        uiBegin = 0;
+    } else {
+        /* If no overlap between request range and buffer contents bail out */
+        return (0);
     }
+    pRequest->FirstSequence = uiFirstSeq + uiBegin;
 
-    pRequest->FirstSequence = uiBegin;
-
-    return (iLen);
+    return TL_encode_range(
+        apdu, pRequest, log_index, uiBegin, uiEnd - uiBegin + 1);
 }
 
 /**
  * @brief Handle encoding for the By Time option.
- * @note The fact that the buffer always has at least a single entry
- *  is used implicetly in the following implementationas we don't
- *  have to handle the case of an empty buffer.
  * @param apdu - Pointer to the buffer to encode into.
  * @param pRequest - Pointer to the request data structure containing
  * the request parameters.
@@ -1294,263 +2090,49 @@ int TL_encode_by_sequence(uint8_t *apdu, BACNET_READ_RANGE_DATA *pRequest)
 int TL_encode_by_time(uint8_t *apdu, BACNET_READ_RANGE_DATA *pRequest)
 {
     int log_index = 0;
-    int iLen = 0;
-    int32_t iTemp = 0;
-    int iCount = 0;
     TL_LOG_INFO *CurrentLog = NULL;
-
-    uint32_t uiIndex = 0; /* Current entry number */
-    uint32_t uiFirst = 0; /* Entry number we started encoding from */
-    uint32_t uiLast = 0; /* Entry number we finished encoding on */
-    uint32_t uiRemaining = 0; /* Amount of unused space in packet */
-    uint32_t uiFirstSeq = 0; /* Sequence number for 1st record in log */
+    uint32_t uiIndex = 0; /* Entry number to start encoding from */
+    uint32_t uiCount = 0; /* Number of entries to encode */
     bacnet_time_t tRefTime = 0; /* The time from the request in local format */
 
-    /* See how much space we have */
-    uiRemaining = MAX_APDU - pRequest->Overhead;
     log_index = Trend_Log_Instance_To_Index(pRequest->object_instance);
     CurrentLog = &LogInfo[log_index];
-
     tRefTime = TL_BAC_Time_To_Local(&pRequest->Range.RefTime);
-    /* Find correct position for oldest entry in log */
-    if (CurrentLog->ulRecordCount < TL_MAX_ENTRIES) {
-        uiIndex = 0;
-    } else {
-        uiIndex = CurrentLog->iIndex;
-    }
-
     if (pRequest->Count < 0) {
-        /* Start at end of log and look for record which has
-         * timestamp greater than or equal to the reference.
+        /* Look for the last record which has a timestamp
+         * before the reference time.
          */
-        iCount = CurrentLog->ulRecordCount - 1;
-        /* Start out with the sequence number for the last record */
-        uiFirstSeq = CurrentLog->ulTotalRecordCount;
-        for (;;) {
-            if (Logs[log_index][(uiIndex + iCount) % TL_MAX_ENTRIES]
-                    .tTimeStamp < tRefTime) {
-                break;
-            }
-
-            uiFirstSeq--;
-            iCount--;
-            if (iCount < 0) {
-                return (0);
-            }
+        uiIndex = TL_Log_Time_Index(log_index, tRefTime, true);
+        if (uiIndex == 0) {
+            return (0);
         }
-
-        /* We have an and point for our request,
-         * now work backwards to find where we should start from
+        uiIndex--;
+        /* We have an end point for our request,
+         * now work backwards to find where we should start from.
+         * If count would bring us back beyond the limits
+         * Of the buffer then pin it to the start of the buffer.
          */
-
-        pRequest->Count = -pRequest->Count; /* Conveert to +ve count */
-        /* If count would bring us back beyond the limits
-         * Of the buffer then pin it to the start of the buffer
-         * otherwise adjust starting point and sequence number
-         * appropriately.
-         */
-        iTemp = pRequest->Count - 1;
-        if (iTemp > iCount) {
-            uiFirstSeq -= iCount;
-            pRequest->Count = iCount + 1;
-            iCount = 0;
+        uiCount = (uint32_t)(-(pRequest->Count + 1)) + 1;
+        if ((uiCount - 1) > uiIndex) {
+            uiCount = uiIndex + 1;
+            uiIndex = 0;
         } else {
-            uiFirstSeq -= iTemp;
-            iCount -= iTemp;
+            uiIndex -= uiCount - 1;
         }
+        pRequest->Count = uiCount;
     } else {
-        /* Start at beginning of log and look for 1st record which has
+        /* Look for 1st record which has
          * timestamp greater than the reference time.
          */
-        iCount = 0;
-        /* Figure out the sequence number for the first record, last is
-         * ulTotalRecordCount */
-        uiFirstSeq =
-            CurrentLog->ulTotalRecordCount - (CurrentLog->ulRecordCount - 1);
-        for (;;) {
-            if (Logs[log_index][(uiIndex + iCount) % TL_MAX_ENTRIES]
-                    .tTimeStamp > tRefTime) {
-                break;
-            }
-
-            uiFirstSeq++;
-            iCount++;
-            if ((uint32_t)iCount == CurrentLog->ulRecordCount) {
-                return (0);
-            }
-        }
-    }
-
-    /* We now have a starting point for the operation and a +ve count */
-
-    uiIndex = iCount + 1; /* Convert to BACnet 1 based reference */
-    uiFirst = uiIndex; /* Record where we started from */
-    iCount = pRequest->Count;
-    while (iCount != 0) {
-        if (uiRemaining < TL_MAX_ENC) {
-            /*
-             * Can't fit any more in! We just set the result flag to say
-             * there was more and drop out of the loop early
-             */
-            bitstring_set_bit(
-                &pRequest->ResultFlags, RESULT_FLAG_MORE_ITEMS, true);
-            break;
-        }
-
-        iTemp = TL_encode_entry(&apdu[iLen], log_index, uiIndex);
-
-        uiRemaining -= iTemp; /* Reduce the remaining space */
-        iLen += iTemp; /* and increase the length consumed */
-        uiLast = uiIndex; /* Record the last entry encoded */
-        uiIndex++; /* and get ready for next one */
-        pRequest->ItemCount++; /* Chalk up another one for the response count */
-        iCount--; /* And finally cross another one off the requested count
-                   */
-
-        if (uiIndex > CurrentLog->ulRecordCount) { /* Finish up if we hit
-                                                      the end of the log */
-            break;
+        uiIndex = TL_Log_Time_Index(log_index, tRefTime, false);
+        if (uiIndex >= CurrentLog->ulRecordCount) {
+            return (0);
         }
+        uiCount = pRequest->Count;
     }
+    pRequest->FirstSequence = TL_First_Sequence(log_index) + uiIndex;
 
-    /* Set remaining result flags if necessary */
-    if (uiFirst == 1) {
-        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_FIRST_ITEM, true);
-    }
-
-    if (uiLast == CurrentLog->ulRecordCount) {
-        bitstring_set_bit(&pRequest->ResultFlags, RESULT_FLAG_LAST_ITEM, true);
-    }
-
-    pRequest->FirstSequence = uiFirstSeq;
-
-    return (iLen);
-}
-
-/**
- * @brief Encode a single log entry into the APDU buffer.
- * @param apdu - Pointer to the buffer to encode into.
- * @param iLog - Index of the log to encode from.
- * @param iEntry - Index of the entry to encode (1 based).
- */
-int TL_encode_entry(uint8_t *apdu, int iLog, int iEntry)
-{
-    int iLen = 0;
-    TL_DATA_REC *pSource = NULL;
-    BACNET_BIT_STRING TempBits;
-    uint8_t ucCount = 0;
-    BACNET_DATE_TIME TempTime;
-
-    /* Convert from BACnet 1 based to 0 based array index and then
-     * handle wrap around of the circular buffer */
-
-    if (LogInfo[iLog].ulRecordCount < TL_MAX_ENTRIES) {
-        pSource = &Logs[iLog][(iEntry - 1) % TL_MAX_ENTRIES];
-    } else {
-        pSource =
-            &Logs[iLog][(LogInfo[iLog].iIndex + iEntry - 1) % TL_MAX_ENTRIES];
-    }
-
-    iLen = 0;
-    /* First stick the time stamp in with tag [0] */
-    TL_Local_Time_To_BAC(&TempTime, pSource->tTimeStamp);
-    iLen += bacapp_encode_context_datetime(apdu, 0, &TempTime);
-
-    /* Next comes the actual entry with tag [1] */
-    iLen += encode_opening_tag(&apdu[iLen], 1);
-    /* The data entry is tagged individually [0] - [10]
-       to indicate which type */
-    switch (pSource->ucRecType) {
-        case TL_TYPE_STATUS:
-            /* Build bit string directly from the stored octet */
-            bitstring_init(&TempBits);
-            bitstring_set_bits_used(&TempBits, 1, 5);
-            bitstring_set_octet(&TempBits, 0, pSource->Datum.ucLogStatus);
-            iLen += encode_context_bitstring(
-                &apdu[iLen], pSource->ucRecType, &TempBits);
-            break;
-
-        case TL_TYPE_BOOL:
-            iLen += encode_context_boolean(
-                &apdu[iLen], pSource->ucRecType, pSource->Datum.ucBoolean);
-            break;
-
-        case TL_TYPE_REAL:
-            iLen += encode_context_real(
-                &apdu[iLen], pSource->ucRecType, pSource->Datum.fReal);
-            break;
-
-        case TL_TYPE_ENUM:
-            iLen += encode_context_enumerated(
-                &apdu[iLen], pSource->ucRecType, pSource->Datum.ulEnum);
-            break;
-
-        case TL_TYPE_UNSIGN:
-            iLen += encode_context_unsigned(
-                &apdu[iLen], pSource->ucRecType, pSource->Datum.ulUValue);
-            break;
-
-        case TL_TYPE_SIGN:
-            iLen += encode_context_signed(
-                &apdu[iLen], pSource->ucRecType, pSource->Datum.lSValue);
-            break;
-
-        case TL_TYPE_BITS:
-            /* Rebuild bitstring directly from stored octets - which we
-             * have limited to 32 bits maximum as allowed by the standard
-             */
-            bitstring_init(&TempBits);
-            bitstring_set_bits_used(
-                &TempBits, (pSource->Datum.Bits.ucLen >> 4) & 0x0F,
-                pSource->Datum.Bits.ucLen & 0x0F);
-            for (ucCount = pSource->Datum.Bits.ucLen >> 4; ucCount > 0;
-                 ucCount--) {
-                bitstring_set_octet(
-                    &TempBits, ucCount - 1,
-                    pSource->Datum.Bits.ucStore[ucCount - 1]);
-            }
-
-            iLen += encode_context_bitstring(
-                &apdu[iLen], pSource->ucRecType, &TempBits);
-            break;
-
-        case TL_TYPE_NULL:
-            iLen += encode_context_null(&apdu[iLen], pSource->ucRecType);
-            break;
-
-        case TL_TYPE_ERROR:
-            iLen += encode_opening_tag(&apdu[iLen], TL_TYPE_ERROR);
-            iLen += encode_application_enumerated(
-                &apdu[iLen], pSource->Datum.Error.usClass);
-            iLen += encode_application_enumerated(
-                &apdu[iLen], pSource->Datum.Error.usCode);
-            iLen += encode_closing_tag(&apdu[iLen], TL_TYPE_ERROR);
-            break;
-
-        case TL_TYPE_DELTA:
-            iLen += encode_context_real(
-                &apdu[iLen], pSource->ucRecType, pSource->Datum.fTime);
-            break;
-
-        case TL_TYPE_ANY:
-            /* Should never happen as we don't support this at the moment */
-            break;
-
-        default:
-            break;
-    }
-
-    iLen += encode_closing_tag(&apdu[iLen], 1);
-    /* Check if status bit string is required and insert with tag [2] */
-    if ((pSource->ucStatus & 128) == 128) {
-        bitstring_init(&TempBits);
-        bitstring_set_bits_used(&TempBits, 1, 4);
-        /* only insert the 1st 4 bits */
-        bitstring_set_octet(&TempBits, 0, (pSource->ucStatus & 0x0F));
-        iLen += encode_context_bitstring(&apdu[iLen], 2, &TempBits);
-    }
-
-    return (iLen);
+    return TL_encode_range(apdu, pRequest, log_index, uiIndex, uiCount);
 }
 
 static int local_read_property(
@@ -1712,16 +2294,7 @@ static void TL_fetch_property(int iLog)
         TempRec.ucStatus = 128 | bitstring_octet(&TempBits, 0);
     }
 
-    Logs[iLog][CurrentLog->iIndex++] = TempRec;
-    if (CurrentLog->iIndex >= TL_MAX_ENTRIES) {
-        CurrentLog->iIndex = 0;
-    }
-
-    CurrentLog->ulTotalRecordCount++;
-
-    if (CurrentLog->ulRecordCount < TL_MAX_ENTRIES) {
-        CurrentLog->ulRecordCount++;
-    }
+    TL_Log_Record_Add(iLog, &TempRec);
 }
 
 /**
@@ -23,6 +23,8 @@
 #include "../../../bacnet/rp.h"
 //#include "bacnet/wp.h"
 #include "../../../bacnet/wp.h"
+//#include "bacnet/basic/sys/logseg.h"
+#include "../../../bacnet/basic/sys/logseg.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,14 +44,14 @@ typedef struct tl_bits {
     uint8_t ucStore[4];
 } TL_BITS;
 
-/* Storage structure for Trend Log data
+/* Unpacked form of a Trend Log data record
  *
- * Note. I've tried to minimize the storage requirements here
- * as the memory requirements for logging in embedded
- * implementations are frequently a big issue. For PC or
- * embedded Linux type setupz this may seem like overkill
- * but if you have limited memory and need to squeeze as much
- * logging capacity as possible every little byte counts!
+ * Note. The log buffer does not hold these structures. Each record
+ * is packed into a few bytes of a per log ring buffer, with the time
+ * stamp stored as a delta from the previous record and REAL values
+ * stored as the difference from the previous REAL value. Records are
+ * unpacked into this structure one at a time while a ReadRange
+ * response is being encoded.
  */
 
 typedef struct tl_data_record {
@@ -73,7 +75,15 @@ typedef struct tl_data_record {
 #define TL_T_START_WILD 1 /* Start time is wild carded */
 #define TL_T_STOP_WILD 2 /* Stop Time is wild carded */
 
+#ifndef TL_MAX_ENTRIES
 #define TL_MAX_ENTRIES 1000 /* Entries per datalog */
+#endif
+
+/* Bytes of packed record storage per datalog. A log holds up to
+   TL_MAX_ENTRIES records, or fewer if they do not fit in these bytes. */
+#ifndef TL_LOG_BUFFER_BYTES
+#define TL_LOG_BUFFER_BYTES 2048
+#endif
 
 /* Structure containing config and status info for a Trend Log */
 
@@ -96,7 +106,6 @@ typedef struct tl_log_info {
     /* Offset from start of period for taking reading in seconds */
     uint32_t ulIntervalOffset;
     bool bTrigger; /* Set to 1 to cause a reading to be taken */
-    int iIndex; /* Current insertion point */
     bacnet_time_t tLastDataTime;
 } TL_LOG_INFO;
 
@@ -146,6 +155,9 @@ BACNET_STACK_EXPORT
 bool Trend_Log_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data);
 BACNET_STACK_EXPORT
 void Trend_Log_Init(void);
+BACNET_STACK_EXPORT
+bool Trend_Log_Segment_Store_Set(
+    uint32_t object_instance, BACNET_LOG_SEGMENT *store);
 
 BACNET_STACK_EXPORT
 void TL_Insert_Status_Rec(int iLog, BACNET_LOG_STATUS eStatus, bool bState);
@@ -142,6 +142,21 @@
 #define UBASIC_LABEL_LEN_MAX 10
 #endif
 
+/* number of tokens of the program that ubasic_load_program() compiles into
+   a token stream, so that statements are not tokenized again each time they
+   run and goto/gosub do not search the program text for the label. A larger
+   program is run from its text. Each token takes 8 bytes of RAM in every
+   struct ubasic_data, so the default of 512 costs 4 KB per program; it is
+   off on AVR, where that is more than the whole RAM of many boards. Zero
+   disables the token stream; the limit is 32767 tokens. */
+#ifndef UBASIC_TOKEN_STREAM_MAX
+#if defined(__AVR__)
+#define UBASIC_TOKEN_STREAM_MAX 0
+#else
+#define UBASIC_TOKEN_STREAM_MAX 512
+#endif
+#endif
+
 #if defined(UBASIC_VARIABLE_TYPE_STRING)
 #define UBASIC_STRING_BUFFER_LEN_MAX 256
 #define UBASIC_STRING_VAR_LEN_MAX 26
@@ -396,6 +396,9 @@ int8_t tokenizer_stringlookahead(struct ubasic_tokenizer *tree)
     const char *savenextptr = tree->nextptr;
     uint8_t token = tree->current_token;
     int8_t si = -1;
+#if UBASIC_TOKEN_STREAM_MAX
+    uint16_t index = tree->token_index;
+#endif
 
     while (si == -1) {
         if (token == UBASIC_TOKENIZER_EOL ||
@@ -418,6 +421,13 @@ int8_t tokenizer_stringlookahead(struct ubasic_tokenizer *tree)
             si = 0; /* numeric function */
         }
 
+#if UBASIC_TOKEN_STREAM_MAX
+        if (tree->token_count) {
+            /* the end of input always stops, so the next token is there */
+            token = tree->tokens[++index].token;
+            continue;
+        }
+#endif
         token = tokenizer_next_token(tree);
     }
     tree->ptr = saveptr;
@@ -426,13 +436,137 @@ int8_t tokenizer_stringlookahead(struct ubasic_tokenizer *tree)
 }
 #endif
 /*---------------------------------------------------------------------------*/
+#if UBASIC_TOKEN_STREAM_MAX
+/*---------------------------------------------------------------------------*/
+static void
+tokenizer_stream_index(struct ubasic_tokenizer *tree, uint16_t index)
+{
+    const struct ubasic_token *t = &tree->tokens[index];
+
+    tree->token_index = index;
+    tree->ptr = tree->prog + t->offset;
+    tree->nextptr = tree->ptr + t->length;
+    tree->current_token = t->token;
+}
+/*---------------------------------------------------------------------------*/
+static void
+tokenizer_stream_offset(struct ubasic_tokenizer *tree, uint16_t offset)
+{
+    uint16_t low = 0, high, mid;
+
+    /* the first token at or after the offset; the last token, which is
+       the end of input, when there is none */
+    high = tree->token_count - 1;
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+        if (tree->tokens[mid].offset < offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    tokenizer_stream_index(tree, low);
+}
+/*---------------------------------------------------------------------------*/
+static uint16_t tokenizer_stream_label(
+    struct ubasic_tokenizer *tree, const struct ubasic_token *label)
+{
+    const struct ubasic_token *t;
+    uint16_t i;
+
+    for (i = 1; i < tree->token_count; i++) {
+        t = &tree->tokens[i];
+        if ((t->token == UBASIC_TOKENIZER_LABEL) &&
+            (tree->tokens[i - 1].token == UBASIC_TOKENIZER_COLON) &&
+            (t->length == label->length) &&
+            (memcmp(
+                 tree->prog + t->offset, tree->prog + label->offset,
+                 t->length) == 0)) {
+            /* the label is never the last token */
+            return i + 1;
+        }
+    }
+
+    /* an unknown label goes to the end of input */
+    return tree->token_count - 1;
+}
+#endif
+/*---------------------------------------------------------------------------*/
 void tokenizer_init(struct ubasic_tokenizer *tree, const char *program)
 {
     tree->ptr = program;
     tree->prog = program;
+#if UBASIC_TOKEN_STREAM_MAX
+    tree->token_count = 0;
+    tree->token_index = 0;
+#endif
     tree->current_token = tokenizer_next_token(tree);
 }
 /*---------------------------------------------------------------------------*/
+/**
+ * @brief Compile the program into a token stream, with the numbers parsed
+ *  and the labels of goto and gosub resolved, and start at its first token.
+ * @param tree - tokenizer data
+ * @param program - the program text, which must stay unchanged while used
+ * @return true if the program is compiled, false if it has an error or does
+ *  not fit the token stream and the tokens are read from the program text
+ */
+bool tokenizer_compile(struct ubasic_tokenizer *tree, const char *program)
+{
+#if UBASIC_TOKEN_STREAM_MAX
+    struct ubasic_token *t;
+    size_t offset, length;
+    uint16_t count = 0, i;
+
+    tokenizer_init(tree, program);
+    while ((count < UBASIC_TOKEN_STREAM_MAX) &&
+           (tree->current_token != UBASIC_TOKENIZER_ERROR)) {
+        offset = tree->ptr - tree->prog;
+        length = 0;
+        if (tree->current_token != UBASIC_TOKENIZER_ENDOFINPUT) {
+            length = tree->nextptr - tree->ptr;
+        }
+        if ((offset > UINT16_MAX) || (length > UINT8_MAX)) {
+            break;
+        }
+        t = &tree->tokens[count];
+        t->offset = (uint16_t)offset;
+        t->length = (uint8_t)length;
+        t->token = tree->current_token;
+        t->value = 0;
+        if (t->token == UBASIC_TOKENIZER_NUMBER) {
+            t->value = tokenizer_num(tree);
+        } else if (t->token == UBASIC_TOKENIZER_INT) {
+            t->value = tokenizer_int(tree);
+        }
+#if defined(UBASIC_VARIABLE_TYPE_FLOAT_AS_FIXEDPT_24_8) || \
+    defined(UBASIC_VARIABLE_TYPE_FLOAT_AS_FIXEDPT_22_10)
+        else if (t->token == UBASIC_TOKENIZER_FLOAT) {
+            t->value = tokenizer_float(tree);
+        }
+#endif
+        count++;
+        if (t->token == UBASIC_TOKENIZER_ENDOFINPUT) {
+            tree->token_count = count;
+            for (i = 1; i < count; i++) {
+                t = &tree->tokens[i];
+                if ((t->token == UBASIC_TOKENIZER_LABEL) &&
+                    ((tree->tokens[i - 1].token == UBASIC_TOKENIZER_GOTO) ||
+                     (tree->tokens[i - 1].token == UBASIC_TOKENIZER_GOSUB))) {
+                    t->value = tokenizer_stream_label(tree, t);
+                }
+            }
+            tokenizer_stream_index(tree, 0);
+            return true;
+        }
+        tokenizer_next(tree);
+    }
+#endif
+    tokenizer_init(tree, program);
+
+    return false;
+}
+/*---------------------------------------------------------------------------*/
 uint8_t tokenizer_token(struct ubasic_tokenizer *tree)
 {
     return tree->current_token;
@@ -443,6 +577,13 @@ void tokenizer_next(struct ubasic_tokenizer *tree)
     if (tokenizer_finished(tree)) {
         return;
     }
+#if UBASIC_TOKEN_STREAM_MAX
+    if (tree->token_count) {
+        /* not finished, so this is not the last token */
+        tokenizer_stream_index(tree, tree->token_index + 1);
+        return;
+    }
+#endif
 
     tree->ptr = tree->nextptr;
 
@@ -460,6 +601,11 @@ UBASIC_VARIABLE_TYPE tokenizer_num(struct ubasic_tokenizer *tree)
     const char *c = tree->ptr;
     UBASIC_VARIABLE_TYPE rval = 0;
 
+#if UBASIC_TOKEN_STREAM_MAX
+    if (tree->token_count) {
+        return tree->tokens[tree->token_index].value;
+    }
+#endif
     while (1) {
         if (*c < '0' || *c > '9') {
             break;
@@ -477,6 +623,12 @@ UBASIC_VARIABLE_TYPE tokenizer_int(struct ubasic_tokenizer *tree)
 {
     const char *c = tree->ptr;
     UBASIC_VARIABLE_TYPE rval = 0;
+
+#if UBASIC_TOKEN_STREAM_MAX
+    if (tree->token_count) {
+        return tree->tokens[tree->token_index].value;
+    }
+#endif
     if ((*c == '0') && (*(c + 1) == 'x' || *(c + 1) == 'X')) {
         c += 2;
         while (1) {
@@ -524,6 +676,11 @@ UBASIC_VARIABLE_TYPE tokenizer_int(struct ubasic_tokenizer *tree)
 /*---------------------------------------------------------------------------*/
 UBASIC_VARIABLE_TYPE tokenizer_float(struct ubasic_tokenizer *tree)
 {
+#if UBASIC_TOKEN_STREAM_MAX
+    if (tree->token_count) {
+        return tree->tokens[tree->token_index].value;
+    }
+#endif
     return str_fixedpt(
         tree->ptr, tree->nextptr - tree->ptr, FIXEDPT_FBITS >> 1);
 }
@@ -623,8 +780,15 @@ uint16_t tokenizer_save_offset(struct ubasic_tokenizer *tree)
 
 void tokenizer_jump_offset(struct ubasic_tokenizer *tree, uint16_t offset)
 {
-    tree->ptr = (tree->prog + offset);
-    tree->current_token = tokenizer_next_token(tree);
+#if UBASIC_TOKEN_STREAM_MAX
+    if (tree->token_count) {
+        tokenizer_stream_offset(tree, offset);
+    } else
+#endif
+    {
+        tree->ptr = (tree->prog + offset);
+        tree->current_token = tokenizer_next_token(tree);
+    }
     while ((tree->current_token == UBASIC_TOKENIZER_EOL) &&
            !tokenizer_finished(tree)) {
         tokenizer_next(tree);
@@ -632,6 +796,26 @@ void tokenizer_jump_offset(struct ubasic_tokenizer *tree, uint16_t offset)
     return;
 }
 
+/**
+ * @brief Get where a goto or gosub label goes in a compiled program
+ * @param tree - tokenizer data, at the label after goto or gosub
+ * @return the program offset after the label, or -1 if the program is not
+ *  compiled and the label has to be found in the program text
+ */
+int32_t tokenizer_label_offset(struct ubasic_tokenizer *tree)
+{
+#if UBASIC_TOKEN_STREAM_MAX
+    if (tree->token_count &&
+        (tree->current_token == UBASIC_TOKENIZER_LABEL)) {
+        return tree->tokens[tree->tokens[tree->token_index].value].offset;
+    }
+#else
+    (void)tree;
+#endif
+
+    return -1;
+}
+
 const char *tokenizer_name(UBASIC_VARIABLE_TYPE token)
 {
     const struct keyword_token *kt;
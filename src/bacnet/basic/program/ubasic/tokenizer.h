@@ -177,14 +177,34 @@ enum {
     /* */
 };
 
+#if UBASIC_TOKEN_STREAM_MAX
+/* one token of the compiled program */
+struct ubasic_token {
+    /* offset of the token in the program text */
+    uint16_t offset;
+    uint8_t length;
+    uint8_t token;
+    /* the number, or the token index after the label that a goto or gosub
+       label refers to */
+    UBASIC_VARIABLE_TYPE value;
+};
+#endif
+
 struct ubasic_tokenizer {
     const char *ptr;
     const char *nextptr;
     const char *prog;
     uint8_t current_token;
+#if UBASIC_TOKEN_STREAM_MAX
+    /* zero if the tokens are read from the program text */
+    uint16_t token_count;
+    uint16_t token_index;
+    struct ubasic_token tokens[UBASIC_TOKEN_STREAM_MAX];
+#endif
 };
 
 void tokenizer_init(struct ubasic_tokenizer *data, const char *program);
+bool tokenizer_compile(struct ubasic_tokenizer *data, const char *program);
 void tokenizer_next(struct ubasic_tokenizer *data);
 uint8_t tokenizer_token(struct ubasic_tokenizer *data);
 UBASIC_VARIABLE_TYPE tokenizer_num(struct ubasic_tokenizer *data);
@@ -205,6 +225,7 @@ int8_t tokenizer_stringlookahead(struct ubasic_tokenizer *data);
 void tokenizer_label(struct ubasic_tokenizer *data, char *dest, uint8_t len);
 uint16_t tokenizer_save_offset(struct ubasic_tokenizer *data);
 void tokenizer_jump_offset(struct ubasic_tokenizer *data, uint16_t offset);
+int32_t tokenizer_label_offset(struct ubasic_tokenizer *data);
 
 const char *tokenizer_name(UBASIC_VARIABLE_TYPE token);
 
@@ -566,7 +566,7 @@ void ubasic_load_program(struct ubasic_data *data, const char *program)
     }
     if (data->program) {
         data->program_ptr = data->program;
-        tokenizer_init(&data->tree, data->program_ptr);
+        tokenizer_compile(&data->tree, data->program_ptr);
         data->status.bit.isRunning = 1;
     }
 }
@@ -1541,11 +1541,17 @@ static UBASIC_VARIABLE_TYPE relation(struct ubasic_data *data)
 }
 
 /* TODO: error handling? */
-static uint8_t jump_label(struct ubasic_data *data, char *label)
+static uint8_t
+jump_label(struct ubasic_data *data, char *label, int32_t label_offset)
 {
     char currLabel[UBASIC_LABEL_LEN_MAX] = { '\0' };
     struct ubasic_tokenizer *tree = &data->tree;
 
+    if (label_offset >= 0) {
+        /* resolved when the program was compiled */
+        tokenizer_jump_offset(tree, (uint16_t)label_offset);
+        return !tokenizer_finished(tree);
+    }
     tokenizer_init(tree, data->program_ptr);
 
     while (tokenizer_token(tree) != UBASIC_TOKENIZER_ENDOFINPUT) {
@@ -1573,12 +1579,14 @@ static uint8_t jump_label(struct ubasic_data *data, char *label)
 static void gosub_statement(struct ubasic_data *data)
 {
     char tmpstring[UBASIC_STRINGLEN_MAX];
+    int32_t label_offset;
     struct ubasic_tokenizer *tree = &data->tree;
 
     accept(data, UBASIC_TOKENIZER_GOSUB);
     if (tokenizer_token(tree) == UBASIC_TOKENIZER_LABEL) {
         /* copy label */
         tokenizer_label(tree, tmpstring, UBASIC_STRINGLEN_MAX);
+        label_offset = tokenizer_label_offset(tree);
         tokenizer_next(tree);
         /* check for the end of line */
         while (tokenizer_token(tree) == UBASIC_TOKENIZER_EOL) {
@@ -1588,7 +1596,7 @@ static void gosub_statement(struct ubasic_data *data)
             data->gosub_stack[data->gosub_stack_ptr] =
                 tokenizer_save_offset(tree);
             data->gosub_stack_ptr++;
-            jump_label(data, tmpstring);
+            jump_label(data, tmpstring, label_offset);
             return;
         }
     }
@@ -1617,14 +1625,16 @@ static void return_statement(struct ubasic_data *data)
 static void goto_statement(struct ubasic_data *data)
 {
     char tmpstring[UBASIC_STRINGLEN_MAX];
+    int32_t label_offset;
     struct ubasic_tokenizer *tree = &data->tree;
 
     accept(data, UBASIC_TOKENIZER_GOTO);
 
     if (tokenizer_token(tree) == UBASIC_TOKENIZER_LABEL) {
         tokenizer_label(tree, tmpstring, sizeof(tmpstring));
+        label_offset = tokenizer_label_offset(tree);
         tokenizer_next(tree);
-        jump_label(data, tmpstring);
+        jump_label(data, tmpstring, label_offset);
         return;
     }
 
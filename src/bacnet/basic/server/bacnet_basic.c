@@ -42,6 +42,13 @@
 //#include "bacnet/basic/server/bacnet_port.h"
 #include "../../../bacnet/basic/server/bacnet_port.h"
 
+#if defined(BACDL_BIP) && BBMD_ENABLED
+/* room in front of each received BVLL message, so that the BBMD
+   forwards broadcasts without copying them */
+#define RX_HEADROOM BVLC_RECEIVE_HEADROOM
+#else
+#define RX_HEADROOM 0
+#endif
 /* 1s timer for basic non-critical timed tasks */
 static struct mstimer BACnet_Task_Timer;
 /* task timer for object functionality */
@@ -231,12 +238,15 @@ void bacnet_basic_init(void)
     }
     Device_Write_Property_Store_Callback_Set(bacnet_basic_write_property_store);
     Device_Init(NULL);
+#if defined(BACDL_BIP) && BBMD_ENABLED
+    bvlc_receive_headroom_set(RX_HEADROOM);
+#endif
     /* initialize user data in this thread */
     bacnet_init_callback_handler();
 }
 
 /* local buffer for incoming PDUs to process */
-static uint8_t PDUBuffer[MAX_MPDU];
+static uint8_t PDUBuffer[RX_HEADROOM + MAX_MPDU];
 
 /**
  * @brief non-blocking BACnet task
@@ -279,9 +289,9 @@ void bacnet_basic_task(void)
         Device_Timer(elapsed_milliseconds);
     }
     /* handle the messaging */
-    pdu_len = datalink_receive(&src, &PDUBuffer[0], sizeof(PDUBuffer), 0);
+    pdu_len = datalink_receive(&src, &PDUBuffer[RX_HEADROOM], MAX_MPDU, 0);
     if (pdu_len) {
-        npdu_handler(&src, &PDUBuffer[0], pdu_len);
+        npdu_handler(&src, &PDUBuffer[RX_HEADROOM], pdu_len);
         BACnet_Packet_Count++;
     }
     /* call user task in this thread */
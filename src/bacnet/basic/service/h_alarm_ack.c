@@ -34,6 +34,8 @@
 /* basic objects, services, TSM, and datalink */
 //#include "bacnet/basic/object/device.h"
 #include "../../../bacnet/basic/object/device.h"
+//#include "bacnet/basic/object/event_engine.h"
+#include "../../../bacnet/basic/object/event_engine.h"
 //#include "bacnet/basic/tsm/tsm.h"
 #include "../../../bacnet/basic/tsm/tsm.h"
 //#include "bacnet/basic/sys/debug.h"
@@ -138,6 +140,11 @@ void handler_alarm_ack(
             Alarm_Ack[data.eventObjectIdentifier.type](&data, &error_code);
         switch (ack_result) {
             case 1:
+                /* update the list of active events, and send the
+                   acknowledgment notification */
+                event_engine_acknowledge(
+                    data.eventObjectIdentifier.type,
+                    data.eventObjectIdentifier.instance);
                 len = encode_simple_ack(
                     &Handler_Transmit_Buffer[pdu_len], service_data->invoke_id,
                     SERVICE_CONFIRMED_ACKNOWLEDGE_ALARM);
@@ -282,52 +282,77 @@ static int cov_encode_subscription(
     return apdu_len;
 }
 
+/**
+ * @brief Determine the number of bytes in an encoded COV subscription,
+ *  without encoding it
+ * @param cov_subscription - subscription to be encoded
+ * @return number of bytes, or zero if the subscription has no address
+ */
+static int cov_subscription_encoded_size(
+    const BACNET_COV_SUBSCRIPTION *cov_subscription)
+{
+    int len = 0;
+    const BACNET_ADDRESS *dest = NULL;
+
+    dest = cov_address_get(cov_subscription->dest_index);
+    if (!dest) {
+        return 0;
+    }
+    /* Recipient, recipient, address - opening and closing */
+    len += 2 * (3 * bacnet_tag_encoded_size(0, 0));
+    len += bacnet_unsigned_application_encoded_size(dest->net);
+    if (dest->net) {
+        len += bacnet_octet_string_application_encoded_size(dest->len);
+    } else {
+        len += bacnet_octet_string_application_encoded_size(dest->mac_len);
+    }
+    len += bacnet_unsigned_context_encoded_size(
+        1, cov_subscription->subscriberProcessIdentifier);
+    /* MonitoredPropertyReference - opening and closing */
+    len += 2 * bacnet_tag_encoded_size(1, 0);
+    len += bacnet_object_id_context_encoded_size(0);
+    len += bacnet_enumerated_context_encoded_size(1, PROP_PRESENT_VALUE);
+    len += bacnet_boolean_context_encoded_size(2);
+    len += bacnet_unsigned_context_encoded_size(3, cov_subscription->lifetime);
+
+    return len;
+}
+
 /** Handle a request to list all the COV subscriptions.
  * @ingroup DSCOV
  *  Invoked by a request to read the Device object's
  * PROP_ACTIVE_COV_SUBSCRIPTIONS. Loops through the list of COV Subscriptions,
- * and, for each valid one, adds its description to the APDU.
+ * and, for each valid one, adds its description to the APDU. The size of
+ * each one is known before it is encoded, so it is encoded in place.
  *  @param apdu [out] Buffer in which the APDU contents are built.
  *  @param max_apdu [in] Max length of the APDU buffer.
  *  @return How many bytes were encoded in the buffer, or -2 if the response
  *          would not fit within the buffer.
  */
-/* Maximume length for an encoded COV subscription  - 31 bytes for BACNET IP6
- * 35 bytes for IPv4 (longest MAC) with the maximum length
- * of PID (5 bytes) and lets round it up to the 64bit machine word
- * alignment */
-#define MAX_COV_SUB_SIZE (40)
 int handler_cov_encode_subscriptions(uint8_t *apdu, int max_apdu)
 {
-    if (apdu) {
-        uint8_t cov_sub[MAX_COV_SUB_SIZE] = {
-            0,
-        };
-        unsigned index = 0;
-        int apdu_len = 0;
+    unsigned index = 0;
+    int apdu_len = 0;
+    int len = 0;
 
-        for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
-            if (COV_Subscriptions[index].flag.valid) {
-                /* Lets encode a COV subscription into an intermediate buffer
-                 * that can hold it */
-                int len = cov_encode_subscription(
-                    &cov_sub[0], max_apdu - apdu_len,
+    if (!apdu) {
+        return 0;
+    }
+    for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
+        if (COV_Subscriptions[index].flag.valid) {
+            len = cov_subscription_encoded_size(&COV_Subscriptions[index]);
+            if ((apdu_len + len) > max_apdu) {
+                return -2;
+            }
+            if (len > 0) {
+                apdu_len += cov_encode_subscription(
+                    &apdu[apdu_len], max_apdu - apdu_len,
                     &COV_Subscriptions[index]);
-
-                if ((apdu_len + len) > max_apdu) {
-                    return -2;
-                }
-
-                /* Lets copy if and only if it fits in the buffer */
-                memcpy(&apdu[apdu_len], cov_sub, len);
-                apdu_len += len;
             }
         }
-
-        return apdu_len;
     }
 
-    return 0;
+    return apdu_len;
 }
 
 /** Handler to initialize the COV list, clearing and disabling each entry.
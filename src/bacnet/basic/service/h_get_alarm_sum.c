@@ -25,7 +25,9 @@
 #include "../../../bacnet/abort.h"
 //#include "bacnet/reject.h"
 #include "../../../bacnet/reject.h"
-/* basic services, TSM, and datalink */
+/* basic objects, services, TSM, and datalink */
+//#include "bacnet/basic/object/event_engine.h"
+#include "../../../bacnet/basic/object/event_engine.h"
 //#include "bacnet/basic/tsm/tsm.h"
 #include "../../../bacnet/basic/tsm/tsm.h"
 //#include "bacnet/basic/services.h"
@@ -37,6 +39,31 @@
 
 static get_alarm_summary_function Get_Alarm_Summary[MAX_BACNET_OBJECT_TYPE];
 
+/**
+ * @brief Find the function that lists the alarms of an object type
+ * @param object_type [in] The object type, or MAX_BACNET_OBJECT_TYPE for
+ *  the objects that the event engine keeps a list of
+ * @return The function, or NULL if there is none for the type
+ */
+static get_alarm_summary_function get_alarm_summary_function_find(
+    unsigned object_type)
+{
+#if BACNET_EVENT_ENGINE_ENABLED
+    if (object_type == MAX_BACNET_OBJECT_TYPE) {
+        return event_engine_alarm_summary;
+    }
+    if (event_engine_type_valid((BACNET_OBJECT_TYPE)object_type)) {
+        /* listed by the event engine */
+        return NULL;
+    }
+#endif
+    if (object_type < MAX_BACNET_OBJECT_TYPE) {
+        return Get_Alarm_Summary[object_type];
+    }
+
+    return NULL;
+}
+
 void handler_get_alarm_summary_set(
     BACNET_OBJECT_TYPE object_type, get_alarm_summary_function pFunction)
 {
@@ -62,6 +89,7 @@ void handler_get_alarm_summary(
     BACNET_ADDRESS my_address;
     BACNET_NPDU_DATA npdu_data;
     BACNET_GET_ALARM_SUMMARY_DATA getalarm_data;
+    get_alarm_summary_function get_alarm_summary = NULL;
 
     (void)service_request;
     (void)service_len;
@@ -90,10 +118,11 @@ void handler_get_alarm_summary(
     apdu_len = get_alarm_summary_ack_encode_apdu_init(
         &Handler_Transmit_Buffer[pdu_len], service_data->invoke_id);
 
-    for (i = 0; i < MAX_BACNET_OBJECT_TYPE; i++) {
-        if (Get_Alarm_Summary[i]) {
+    for (i = 0; i <= MAX_BACNET_OBJECT_TYPE; i++) {
+        get_alarm_summary = get_alarm_summary_function_find(i);
+        if (get_alarm_summary) {
             for (j = 0; j < 0xffff; j++) {
-                alarm_value = Get_Alarm_Summary[i](j, &getalarm_data);
+                alarm_value = get_alarm_summary(j, &getalarm_data);
                 if (alarm_value > 0) {
                     len = get_alarm_summary_ack_encode_apdu_data(
                         &Handler_Transmit_Buffer[pdu_len + apdu_len],
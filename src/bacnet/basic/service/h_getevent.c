@@ -32,6 +32,8 @@
 /* basic objects, services, TSM, and datalink */
 //#include "bacnet/basic/object/device.h"
 #include "../../../bacnet/basic/object/device.h"
+//#include "bacnet/basic/object/event_engine.h"
+#include "../../../bacnet/basic/object/event_engine.h"
 //#include "bacnet/basic/tsm/tsm.h"
 #include "../../../bacnet/basic/tsm/tsm.h"
 //#include "bacnet/basic/services.h"
@@ -43,6 +45,31 @@
 
 static get_event_info_function Get_Event_Info[MAX_BACNET_OBJECT_TYPE];
 
+/**
+ * @brief Find the function that lists the events of an object type
+ * @param object_type [in] The object type, or MAX_BACNET_OBJECT_TYPE for
+ *  the objects that the event engine keeps a list of
+ * @return The function, or NULL if there is none for the type
+ */
+static get_event_info_function get_event_info_function_find(
+    unsigned object_type)
+{
+#if BACNET_EVENT_ENGINE_ENABLED
+    if (object_type == MAX_BACNET_OBJECT_TYPE) {
+        return event_engine_event_information;
+    }
+    if (event_engine_type_valid((BACNET_OBJECT_TYPE)object_type)) {
+        /* listed by the event engine */
+        return NULL;
+    }
+#endif
+    if (object_type < MAX_BACNET_OBJECT_TYPE) {
+        return Get_Event_Info[object_type];
+    }
+
+    return NULL;
+}
+
 /**
  * @brief print the data for a GetEventInformation service request
  * @param data [in]  The data to print
@@ -110,7 +137,9 @@ void handler_get_event_information(
     BACNET_ADDRESS my_address;
     BACNET_OBJECT_ID object_id;
     unsigned i = 0, j = 0; /* counter */
+    unsigned first_type = 0, first_index = 0;
     BACNET_GET_EVENT_INFORMATION_DATA getevent_data = { 0 };
+    get_event_info_function get_event_info = NULL;
     int valid_event = 0;
 
     /* initialize type of 'Last Received Object Identifier' using max value */
@@ -150,10 +179,22 @@ void handler_get_event_information(
     }
     pdu_len += len;
     apdu_len = len;
-    for (i = 0; i < MAX_BACNET_OBJECT_TYPE; i++) {
-        if (Get_Event_Info[i]) {
-            for (j = 0; j < 0xffff; j++) {
-                valid_event = Get_Event_Info[i](j, &getevent_data);
+#if BACNET_EVENT_ENGINE_ENABLED
+    if ((object_id.type != MAX_BACNET_OBJECT_TYPE) &&
+        event_engine_type_valid(object_id.type)) {
+        /* the last object received came from the sorted list of the
+           event engine: resume right after it instead of rescanning */
+        first_type = MAX_BACNET_OBJECT_TYPE;
+        first_index =
+            event_engine_active_next(object_id.type, object_id.instance);
+        object_id.type = MAX_BACNET_OBJECT_TYPE;
+    }
+#endif
+    for (i = first_type; i <= MAX_BACNET_OBJECT_TYPE; i++) {
+        get_event_info = get_event_info_function_find(i);
+        if (get_event_info) {
+            for (j = (i == first_type) ? first_index : 0; j < 0xffff; j++) {
+                valid_event = get_event_info(j, &getevent_data);
                 if (valid_event > 0) {
                     /* encode GetEvent_data only when type of object_id has max
                      * value */
@@ -32,6 +32,8 @@
 #include "../../../bacnet/bacerror.h"
 //#include "bacnet/rpm.h"
 #include "../../../bacnet/rpm.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
 /* basic objects, services, TSM, and datalink */
 //#include "bacnet/basic/object/device.h"
 #include "../../../bacnet/basic/object/device.h"
@@ -165,7 +167,7 @@ static int RPM_Encode_Property(
     } else if (!read_property_bacnet_array_valid(&rpdata)) {
         len = BACNET_STATUS_ERROR;
     } else {
-        len = Device_Read_Property(&rpdata);
+        len = rp_cache_read_property(&rpdata, Device_Read_Property);
     }
 
     if (len < 0) {
@@ -206,7 +208,7 @@ static int RPM_Encode_Property(
  * - an Abort if
  *   - the message is segmented
  *   - if decoding fails
- *   - if the response would be too large
+ *   - if the response would be too large, and cannot be segmented
  * - the result from each included read request, if it succeeds
  * - an Error if processing fails for all, or individual errors if only some
  * fail, or there isn't enough room in the APDU to fit the data.
@@ -235,12 +237,30 @@ void handler_read_property_multiple(
     int apdu_len = 0;
     int npdu_len = 0;
     int error = 0;
+    uint8_t *apdu = NULL;
+    uint16_t apdu_max = MAX_APDU;
+    bool segmented = false;
+#if BACNET_SEGMENTATION_ENABLED
+    uint8_t *segment_buffer = NULL;
+#endif
 
     if (service_data) {
         datalink_get_my_address(&my_address);
         npdu_encode_npdu_data(&npdu_data, false, service_data->priority);
         npdu_len = npdu_encode_pdu(
             &Handler_Transmit_Buffer[0], src, &my_address, &npdu_data);
+        apdu = &Handler_Transmit_Buffer[npdu_len];
+#if BACNET_SEGMENTATION_ENABLED
+        if (service_data->segmented_response_accepted) {
+            /* build the reply in a segment buffer, so that it can
+               be sent in segments if it is too big for one APDU */
+            segment_buffer = tsm_segment_buffer_alloc();
+            if (segment_buffer) {
+                apdu = segment_buffer;
+                apdu_max = BACNET_SEGMENTATION_BUFFER_SIZE;
+            }
+        }
+#endif
         if (service_len == 0) {
             rpmdata.error_code = ERROR_CODE_REJECT_MISSING_REQUIRED_PARAMETER;
             error = BACNET_STATUS_REJECT;
@@ -252,8 +272,7 @@ void handler_read_property_multiple(
         } else {
             /* decode apdu request & encode apdu reply
                encode complex ack, invoke id, service choice */
-            apdu_len = rpm_ack_encode_apdu_init(
-                &Handler_Transmit_Buffer[npdu_len], service_data->invoke_id);
+            apdu_len = rpm_ack_encode_apdu_init(apdu, service_data->invoke_id);
 
             for (;;) {
                 /* Start by looking for an object ID */
@@ -295,9 +314,8 @@ void handler_read_property_multiple(
 #endif
                 /* Stick this object id into the reply - if it will fit */
                 len = rpm_ack_encode_apdu_object_begin(&Temp_Buf[0], &rpmdata);
-                copy_len = memcopy(
-                    &Handler_Transmit_Buffer[npdu_len], &Temp_Buf[0], apdu_len,
-                    len, MAX_APDU);
+                copy_len =
+                    memcopy(apdu, &Temp_Buf[0], apdu_len, len, apdu_max);
                 if (copy_len == 0) {
                     debug_print("RPM: Response too big!\n");
                     rpmdata.error_code =
@@ -335,8 +353,7 @@ void handler_read_property_multiple(
                         if (!Device_Valid_Object_Id(
                                 rpmdata.object_type, rpmdata.object_instance)) {
                             len = RPM_Encode_Property(
-                                &Handler_Transmit_Buffer[npdu_len],
-                                (uint16_t)apdu_len, MAX_APDU, &rpmdata);
+                                apdu, (uint16_t)apdu_len, apdu_max, &rpmdata);
                             if (len > 0) {
                                 apdu_len += len;
                             } else {
@@ -355,8 +372,7 @@ void handler_read_property_multiple(
                                 rpmdata.array_index);
 
                             copy_len = memcopy(
-                                &Handler_Transmit_Buffer[npdu_len],
-                                &Temp_Buf[0], apdu_len, len, MAX_APDU);
+                                apdu, &Temp_Buf[0], apdu_len, len, apdu_max);
 
                             if (copy_len == 0) {
                                 debug_print(
@@ -376,8 +392,7 @@ void handler_read_property_multiple(
                                 ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY);
 
                             copy_len = memcopy(
-                                &Handler_Transmit_Buffer[npdu_len],
-                                &Temp_Buf[0], apdu_len, len, MAX_APDU);
+                                apdu, &Temp_Buf[0], apdu_len, len, apdu_max);
 
                             if (copy_len == 0) {
                                 debug_print("RPM: Too full to encode error!\n");
@@ -410,8 +425,8 @@ void handler_read_property_multiple(
                                         rpmdata.object_type,
                                         rpmdata.object_instance)) {
                                     len = RPM_Encode_Property(
-                                        &Handler_Transmit_Buffer[npdu_len],
-                                        (uint16_t)apdu_len, MAX_APDU, &rpmdata);
+                                        apdu, (uint16_t)apdu_len, apdu_max,
+                                        &rpmdata);
                                     if (len > 0) {
                                         apdu_len += len;
                                     } else {
@@ -432,8 +447,8 @@ void handler_read_property_multiple(
                                             &property_list,
                                             special_object_property, index);
                                     len = RPM_Encode_Property(
-                                        &Handler_Transmit_Buffer[npdu_len],
-                                        (uint16_t)apdu_len, MAX_APDU, &rpmdata);
+                                        apdu, (uint16_t)apdu_len, apdu_max,
+                                        &rpmdata);
                                     if (len > 0) {
                                         apdu_len += len;
                                     } else {
@@ -451,8 +466,7 @@ void handler_read_property_multiple(
                     } else {
                         /* handle an individual property */
                         len = RPM_Encode_Property(
-                            &Handler_Transmit_Buffer[npdu_len],
-                            (uint16_t)apdu_len, MAX_APDU, &rpmdata);
+                            apdu, (uint16_t)apdu_len, apdu_max, &rpmdata);
                         if (len > 0) {
                             apdu_len += len;
                         } else {
@@ -473,8 +487,7 @@ void handler_read_property_multiple(
                         decode_len++;
                         len = rpm_ack_encode_apdu_object_end(&Temp_Buf[0]);
                         copy_len = memcopy(
-                            &Handler_Transmit_Buffer[npdu_len], &Temp_Buf[0],
-                            apdu_len, len, MAX_APDU);
+                            apdu, &Temp_Buf[0], apdu_len, len, apdu_max);
                         if (copy_len == 0) {
                             debug_print(
                                 "RPM: Too full to encode object end!\n");
@@ -502,7 +515,24 @@ void handler_read_property_multiple(
             }
             /* If not having an error so far, check the remaining space. */
             if (!berror) {
-                if (apdu_len > service_data->max_resp) {
+                if ((apdu_len <= service_data->max_resp) &&
+                    (apdu_len <= MAX_APDU)) {
+                    if (apdu != &Handler_Transmit_Buffer[npdu_len]) {
+                        memcpy(
+                            &Handler_Transmit_Buffer[npdu_len], apdu,
+                            apdu_len);
+                    }
+#if BACNET_SEGMENTATION_ENABLED
+                } else if (
+                    segment_buffer &&
+                    tsm_segmented_complex_ack_send(
+                        src, &npdu_data, service_data, segment_buffer,
+                        (uint16_t)apdu_len)) {
+                    /* the TSM owns the buffer and sends the segments */
+                    segment_buffer = NULL;
+                    segmented = true;
+#endif
+                } else {
                     /* too big for the sender - send an abort */
                     rpmdata.error_code =
                         ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
@@ -511,6 +541,9 @@ void handler_read_property_multiple(
                 }
             }
         }
+#if BACNET_SEGMENTATION_ENABLED
+        tsm_segment_buffer_free(segment_buffer);
+#endif
         /* Error fallback. */
         if (error) {
             if (error == BACNET_STATUS_ABORT) {
@@ -531,11 +564,13 @@ void handler_read_property_multiple(
                 debug_print("RPM: Sending Reject!\n");
             }
         }
-        pdu_len = apdu_len + npdu_len;
-        bytes_sent = datalink_send_pdu(
-            src, &npdu_data, &Handler_Transmit_Buffer[0], pdu_len);
-        if (bytes_sent <= 0) {
-            debug_perror("RPM: Failed to send PDU");
+        if (!segmented) {
+            pdu_len = apdu_len + npdu_len;
+            bytes_sent = datalink_send_pdu(
+                src, &npdu_data, &Handler_Transmit_Buffer[0], pdu_len);
+            if (bytes_sent <= 0) {
+                debug_perror("RPM: Failed to send PDU");
+            }
         }
     }
 }
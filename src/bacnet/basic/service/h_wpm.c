@@ -29,6 +29,8 @@
 #include "../../../bacnet/reject.h"
 //#include "bacnet/wpm.h"
 #include "../../../bacnet/wpm.h"
+//#include "bacnet/rp_cache.h"
+#include "../../../bacnet/rp_cache.h"
 /* basic objects, services, TSM, and datalink */
 //#include "bacnet/basic/object/device.h"
 #include "../../../bacnet/basic/object/device.h"
@@ -93,6 +95,9 @@ static int write_property_multiple_decode(
                             if (device_write_property(wp_data) == false) {
                                 return BACNET_STATUS_ERROR;
                             }
+                            rp_cache_object_invalidate(
+                                wp_data->object_type,
+                                wp_data->object_instance);
                         }
                     } else {
                         debug_printf_stderr("WPM: Bad Encoding!\n");
@@ -0,0 +1,479 @@
+/**
+ * @file
+ * @brief An outbox of event notifications to the recipients of a
+ *  Notification Class. Each notification is encoded once and shared by
+ *  all of its recipients; only the process identifier differs between
+ *  them. Confirmed notifications wait in the outbox until the TSM has a
+ *  free transaction and the recipient is bound, and are sent again with
+ *  a growing back-off when a transaction fails.
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "../../../bacnet/bacdef.h"
+/* BACnet Stack API */
+//#include "bacnet/bacdcode.h"
+#include "../../../bacnet/bacdcode.h"
+//#include "bacnet/dcc.h"
+#include "../../../bacnet/dcc.h"
+//#include "bacnet/event.h"
+#include "../../../bacnet/event.h"
+//#include "bacnet/npdu.h"
+#include "../../../bacnet/npdu.h"
+//#include "bacnet/datalink/datalink.h"
+#include "../../../bacnet/datalink/datalink.h"
+//#include "bacnet/basic/binding/address.h"
+#include "../../../bacnet/basic/binding/address.h"
+//#include "bacnet/basic/services.h"
+#include "../../../bacnet/basic/services.h"
+//#include "bacnet/basic/sys/debug.h"
+#include "../../../bacnet/basic/sys/debug.h"
+//#include "bacnet/basic/tsm/tsm.h"
+#include "../../../bacnet/basic/tsm/tsm.h"
+//#include "bacnet/basic/service/s_event_outbox.h"
+#include "../../../bacnet/basic/service/s_event_outbox.h"
+
+#if BACNET_EVENT_OUTBOX_ENABLED
+/* one encoded EventNotification service request */
+struct event_outbox_message {
+    /* the caller and each delivery hold a reference */
+    uint8_t references;
+    /* where the request continues after the process identifier */
+    uint8_t offset;
+    uint16_t length;
+    uint8_t request[BACNET_EVENT_OUTBOX_MESSAGE_SIZE];
+};
+/* one confirmed notification to one recipient */
+struct event_outbox_delivery {
+    /* message number, 1 to N, or zero if the delivery is unused */
+    uint8_t message;
+    /* invoke ID while a transaction is in progress, else zero */
+    uint8_t invoke_id;
+    /* the SimpleACK for the transaction in progress has arrived */
+    bool acked;
+    uint8_t retries;
+    uint16_t backoff;
+    uint32_t process_id;
+    /* outbox time when queued, and of the next attempt */
+    uint32_t queued_time;
+    uint32_t next_time;
+    BACNET_RECIPIENT recipient;
+};
+static struct event_outbox_message Outbox_Message[BACNET_EVENT_OUTBOX_MESSAGES];
+static struct event_outbox_delivery
+    Outbox_Delivery[BACNET_EVENT_OUTBOX_DELIVERIES];
+static BACNET_EVENT_OUTBOX_STATS Outbox_Stats;
+/* milliseconds, advanced by Event_Outbox_Timer() */
+static uint32_t Outbox_Time;
+
+/**
+ * @brief Encode a notification to one recipient, with its process
+ *  identifier in front of the shared part of the request
+ * @param pdu - buffer for the PDU
+ * @param pdu_size - size of the buffer
+ * @param dest - destination address
+ * @param message - the encoded notification
+ * @param process_id - process identifier of the recipient
+ * @param invoke_id - invoke ID of a confirmed request, or zero for an
+ *  unconfirmed request
+ * @param npdu_data - returns the NPDU data used
+ * @param apdu_len - returns the length of the APDU
+ * @return length of the PDU, or zero if it does not fit
+ */
+static int event_outbox_pdu_encode(
+    uint8_t *pdu,
+    uint16_t pdu_size,
+    BACNET_ADDRESS *dest,
+    const struct event_outbox_message *message,
+    uint32_t process_id,
+    uint8_t invoke_id,
+    BACNET_NPDU_DATA *npdu_data,
+    unsigned *apdu_len)
+{
+    BACNET_ADDRESS my_address;
+    uint8_t header[4];
+    int header_len;
+    int len;
+    int pdu_len;
+    uint16_t body_len;
+
+    if (invoke_id) {
+        header[0] = PDU_TYPE_CONFIRMED_SERVICE_REQUEST;
+        header[1] = encode_max_segs_max_apdu(0, MAX_APDU);
+        header[2] = invoke_id;
+        header[3] = SERVICE_CONFIRMED_EVENT_NOTIFICATION;
+        header_len = 4;
+    } else {
+        header[0] = PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST;
+        header[1] = SERVICE_UNCONFIRMED_EVENT_NOTIFICATION;
+        header_len = 2;
+    }
+    body_len = message->length - message->offset;
+    datalink_get_my_address(&my_address);
+    npdu_encode_npdu_data(npdu_data, invoke_id != 0, MESSAGE_PRIORITY_NORMAL);
+    pdu_len = npdu_encode_pdu(NULL, dest, &my_address, npdu_data);
+    len = header_len + encode_context_unsigned(NULL, 0, process_id) +
+        body_len;
+    if ((pdu_len + len) > pdu_size) {
+        return 0;
+    }
+    pdu_len = npdu_encode_pdu(pdu, dest, &my_address, npdu_data);
+    memcpy(&pdu[pdu_len], header, header_len);
+    pdu_len += header_len;
+    pdu_len += encode_context_unsigned(&pdu[pdu_len], 0, process_id);
+    memcpy(&pdu[pdu_len], &message->request[message->offset], body_len);
+    pdu_len += body_len;
+    *apdu_len = (unsigned)len;
+
+    return pdu_len;
+}
+
+/**
+ * @brief Free a delivery and its reference to the message
+ * @param delivery - delivery to be freed
+ */
+static void event_outbox_delivery_free(struct event_outbox_delivery *delivery)
+{
+    Event_Outbox_Message_Release(delivery->message);
+    delivery->message = 0;
+    delivery->invoke_id = 0;
+    delivery->acked = false;
+    if (Outbox_Stats.depth) {
+        Outbox_Stats.depth--;
+    }
+}
+
+/**
+ * @brief Schedule the next attempt of a delivery that failed, doubling
+ *  the back-off each time, or give it up after too many attempts
+ * @param delivery - delivery that failed
+ */
+static void event_outbox_delivery_retry(struct event_outbox_delivery *delivery)
+{
+    delivery->retries++;
+    if (delivery->retries > BACNET_EVENT_OUTBOX_RETRIES) {
+        debug_printf_stderr(
+            "Event Outbox: gave up on notification after %u attempts\n",
+            (unsigned)delivery->retries);
+        Outbox_Stats.dropped++;
+        event_outbox_delivery_free(delivery);
+        return;
+    }
+    Outbox_Stats.retries++;
+    delivery->next_time = Outbox_Time + delivery->backoff;
+    if (delivery->backoff < (BACNET_EVENT_OUTBOX_BACKOFF_MAX / 2)) {
+        delivery->backoff *= 2;
+    } else {
+        delivery->backoff = BACNET_EVENT_OUTBOX_BACKOFF_MAX;
+    }
+}
+
+/**
+ * @brief Move a confirmed delivery along: check on the transaction in
+ *  progress, or start one when the TSM and the binding allow it.
+ * @param delivery - delivery in use
+ */
+static void event_outbox_delivery_task(struct event_outbox_delivery *delivery)
+{
+    struct event_outbox_message *message;
+    BACNET_ADDRESS dest = { 0 };
+    BACNET_NPDU_DATA npdu_data;
+    unsigned max_apdu = MAX_APDU;
+    unsigned apdu_len = 0;
+    uint32_t device_id;
+    uint32_t latency;
+    uint8_t invoke_id;
+    int pdu_len;
+
+    if (delivery->invoke_id) {
+        if (tsm_invoke_id_failed(delivery->invoke_id)) {
+            tsm_free_invoke_id(delivery->invoke_id);
+            delivery->invoke_id = 0;
+            event_outbox_delivery_retry(delivery);
+        } else if (tsm_invoke_id_free(delivery->invoke_id)) {
+            if (!delivery->acked) {
+                /* an Error, Reject or Abort freed the transaction;
+                   sending the same request again would not help */
+                debug_printf_stderr(
+                    "Event Outbox: notification refused by recipient\n");
+                Outbox_Stats.refused++;
+                event_outbox_delivery_free(delivery);
+                return;
+            }
+            latency = Outbox_Time - delivery->queued_time;
+            Outbox_Stats.delivered++;
+            Outbox_Stats.latency_last = latency;
+            Outbox_Stats.latency_total += latency;
+            if (latency > Outbox_Stats.latency_max) {
+                Outbox_Stats.latency_max = latency;
+            }
+            event_outbox_delivery_free(delivery);
+        }
+        return;
+    }
+    if ((int32_t)(Outbox_Time - delivery->next_time) < 0) {
+        return;
+    }
+    if (!dcc_communication_enabled()) {
+        return;
+    }
+    if (delivery->recipient.tag == BACNET_RECIPIENT_TAG_DEVICE) {
+        device_id = delivery->recipient.type.device.instance;
+        if (!address_get_by_device(device_id, &max_apdu, &dest)) {
+            if (!address_bind_request(device_id, &max_apdu, &dest)) {
+                Send_WhoIs(device_id, device_id);
+            }
+            event_outbox_delivery_retry(delivery);
+            return;
+        }
+    } else {
+        dest = delivery->recipient.type.address;
+    }
+    /* wait, without counting a retry, until a transaction is free */
+    invoke_id = tsm_next_free_invokeID();
+    if (!invoke_id) {
+        return;
+    }
+    message = &Outbox_Message[delivery->message - 1];
+    pdu_len = event_outbox_pdu_encode(
+        Handler_Transmit_Buffer, sizeof(Handler_Transmit_Buffer), &dest,
+        message, delivery->process_id, invoke_id, &npdu_data, &apdu_len);
+    if ((pdu_len <= 0) || (apdu_len > max_apdu)) {
+        tsm_free_invoke_id(invoke_id);
+        debug_printf_stderr(
+            "Event Outbox: notification exceeds destination maximum APDU\n");
+        Outbox_Stats.dropped++;
+        event_outbox_delivery_free(delivery);
+        return;
+    }
+    tsm_set_confirmed_unsegmented_transaction(
+        invoke_id, &dest, &npdu_data, Handler_Transmit_Buffer,
+        (uint16_t)pdu_len);
+    if (datalink_send_pdu(
+            &dest, &npdu_data, Handler_Transmit_Buffer, pdu_len) <= 0) {
+        debug_perror("Failed to Send ConfirmedEventNotification Request");
+    }
+    delivery->acked = false;
+    delivery->invoke_id = invoke_id;
+}
+
+/**
+ * @brief Encode an event notification once, for all of its recipients
+ * @param data - the notification; its process identifier is replaced
+ *  for each recipient
+ * @return message number, 1 to N, to pass to Event_Outbox_Send() and
+ *  then Event_Outbox_Message_Release(), or zero if the outbox has no
+ *  room for the notification
+ */
+uint8_t Event_Outbox_Message_Encode(const BACNET_EVENT_NOTIFICATION_DATA *data)
+{
+    struct event_outbox_message *message;
+    int len;
+    uint8_t index;
+
+    if (!data) {
+        return 0;
+    }
+    len = event_notify_encode_service_request(NULL, data);
+    if ((len <= 0) || (len > BACNET_EVENT_OUTBOX_MESSAGE_SIZE)) {
+        return 0;
+    }
+    for (index = 0; index < BACNET_EVENT_OUTBOX_MESSAGES; index++) {
+        message = &Outbox_Message[index];
+        if (message->references == 0) {
+            message->length =
+                (uint16_t)event_notify_encode_service_request(
+                    message->request, data);
+            message->offset = (uint8_t)encode_context_unsigned(
+                NULL, 0, data->processIdentifier);
+            message->references = 1;
+            return index + 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Drop a reference to an encoded notification. The message is
+ *  free again once the caller and every delivery have released it.
+ * @param message - message number, 1 to N
+ */
+void Event_Outbox_Message_Release(uint8_t message)
+{
+    if ((message > 0) && (message <= BACNET_EVENT_OUTBOX_MESSAGES)) {
+        if (Outbox_Message[message - 1].references) {
+            Outbox_Message[message - 1].references--;
+        }
+    }
+}
+
+/**
+ * @brief Send an encoded notification to one recipient. An unconfirmed
+ *  notification is sent now, if the recipient is bound. A confirmed one
+ *  is queued and started now if the TSM has room, else by a later
+ *  Event_Outbox_Timer().
+ * @param message - message number, 1 to N
+ * @param process_id - process identifier of the recipient
+ * @param recipient - a device or an address
+ * @param confirmed - true for a ConfirmedEventNotification
+ * @return true if the notification was sent or queued
+ */
+bool Event_Outbox_Send(
+    uint8_t message,
+    uint32_t process_id,
+    const BACNET_RECIPIENT *recipient,
+    bool confirmed)
+{
+    struct event_outbox_delivery *delivery;
+    BACNET_ADDRESS dest = { 0 };
+    BACNET_NPDU_DATA npdu_data;
+    unsigned max_apdu = 0;
+    unsigned apdu_len = 0;
+    int pdu_len;
+    uint8_t index;
+
+    if ((message == 0) || (message > BACNET_EVENT_OUTBOX_MESSAGES) ||
+        !recipient) {
+        return false;
+    }
+    if (!confirmed) {
+        if (recipient->tag == BACNET_RECIPIENT_TAG_DEVICE) {
+            if (!address_get_by_device(
+                    recipient->type.device.instance, &max_apdu, &dest)) {
+                return false;
+            }
+        } else {
+            dest = recipient->type.address;
+        }
+        pdu_len = event_outbox_pdu_encode(
+            Handler_Transmit_Buffer, sizeof(Handler_Transmit_Buffer), &dest,
+            &Outbox_Message[message - 1], process_id, 0, &npdu_data,
+            &apdu_len);
+        if (pdu_len <= 0) {
+            return false;
+        }
+        if (datalink_send_pdu(
+                &dest, &npdu_data, Handler_Transmit_Buffer, pdu_len) <= 0) {
+            debug_perror("Failed to Send EventNotification Request");
+        }
+        Outbox_Stats.unconfirmed++;
+        return true;
+    }
+    for (index = 0; index < BACNET_EVENT_OUTBOX_DELIVERIES; index++) {
+        delivery = &Outbox_Delivery[index];
+        if (delivery->message == 0) {
+            delivery->message = message;
+            delivery->invoke_id = 0;
+            delivery->acked = false;
+            delivery->retries = 0;
+            delivery->backoff = BACNET_EVENT_OUTBOX_BACKOFF;
+            delivery->process_id = process_id;
+            delivery->queued_time = Outbox_Time;
+            delivery->next_time = Outbox_Time;
+            delivery->recipient = *recipient;
+            Outbox_Message[message - 1].references++;
+            Outbox_Stats.depth++;
+            if (Outbox_Stats.depth > Outbox_Stats.depth_max) {
+                Outbox_Stats.depth_max = Outbox_Stats.depth;
+            }
+            event_outbox_delivery_task(delivery);
+            return true;
+        }
+    }
+    debug_printf_stderr("Event Outbox: no room for notification\n");
+    Outbox_Stats.dropped++;
+
+    return false;
+}
+
+/**
+ * @brief Handle the SimpleACK of a ConfirmedEventNotification sent from
+ *  the outbox. Only an acknowledged delivery is counted as delivered;
+ *  one whose transaction ends any other way was refused. Register this
+ *  with apdu_set_confirmed_simple_ack_handler().
+ * @param src - source address of the SimpleACK
+ * @param invoke_id - invoke ID of the acknowledged request
+ */
+void Event_Outbox_SimpleACK_Handler(BACNET_ADDRESS *src, uint8_t invoke_id)
+{
+    uint8_t index;
+
+    (void)src;
+    if (invoke_id == 0) {
+        return;
+    }
+    for (index = 0; index < BACNET_EVENT_OUTBOX_DELIVERIES; index++) {
+        if (Outbox_Delivery[index].message &&
+            (Outbox_Delivery[index].invoke_id == invoke_id)) {
+            Outbox_Delivery[index].acked = true;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Move the queued confirmed notifications along. Call this
+ *  periodically, as for tsm_timer_milliseconds().
+ * @param milliseconds - time since the last call
+ */
+void Event_Outbox_Timer(uint16_t milliseconds)
+{
+    uint8_t index;
+
+    Outbox_Time += milliseconds;
+    for (index = 0; index < BACNET_EVENT_OUTBOX_DELIVERIES; index++) {
+        if (Outbox_Delivery[index].message) {
+            event_outbox_delivery_task(&Outbox_Delivery[index]);
+        }
+    }
+}
+
+/**
+ * @brief Get the number of confirmed notifications in the outbox
+ * @return number of notifications waiting or in progress
+ */
+uint16_t Event_Outbox_Depth(void)
+{
+    return Outbox_Stats.depth;
+}
+
+/**
+ * @brief Get the counters of the outbox
+ * @param stats - returns a copy of the counters
+ */
+void Event_Outbox_Stats(BACNET_EVENT_OUTBOX_STATS *stats)
+{
+    if (stats) {
+        *stats = Outbox_Stats;
+    }
+}
+
+/**
+ * @brief Clear the counters of the outbox, except its depth
+ */
+void Event_Outbox_Stats_Reset(void)
+{
+    uint16_t depth = Outbox_Stats.depth;
+
+    memset(&Outbox_Stats, 0, sizeof(Outbox_Stats));
+    Outbox_Stats.depth = depth;
+    Outbox_Stats.depth_max = depth;
+}
+
+/**
+ * @brief Empty the outbox and clear its counters
+ */
+void Event_Outbox_Init(void)
+{
+    memset(Outbox_Message, 0, sizeof(Outbox_Message));
+    memset(Outbox_Delivery, 0, sizeof(Outbox_Delivery));
+    memset(&Outbox_Stats, 0, sizeof(Outbox_Stats));
+    Outbox_Time = 0;
+}
+#endif
@@ -0,0 +1,84 @@
+/**
+ * @file
+ * @brief API for an outbox of event notifications to the recipients
+ *  of a Notification Class
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef SEND_EVENT_OUTBOX_H
+#define SEND_EVENT_OUTBOX_H
+#include <stdbool.h>
+#include <stdint.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "../../../bacnet/bacdef.h"
+/* BACnet Stack API */
+//#include "bacnet/bacdest.h"
+#include "../../../bacnet/bacdest.h"
+//#include "bacnet/event.h"
+#include "../../../bacnet/event.h"
+
+/**
+ * Counters of the outbox, for finding out how an alarm storm was handled.
+ * Latency is the time from queuing a confirmed notification until its
+ * SimpleACK arrives, in milliseconds.
+ * @{
+ */
+struct bacnet_event_outbox_stats {
+    /* confirmed notifications waiting or in progress */
+    uint16_t depth;
+    uint16_t depth_max;
+    /* confirmed notifications acknowledged by the recipient */
+    uint32_t delivered;
+    /* notifications given up on, or with no room in the outbox */
+    uint32_t dropped;
+    /* confirmed notifications answered by an Error, Reject or Abort */
+    uint32_t refused;
+    /* attempts after a failed transaction or a missing binding */
+    uint32_t retries;
+    /* unconfirmed notifications sent */
+    uint32_t unconfirmed;
+    uint32_t latency_last;
+    uint32_t latency_max;
+    /* sum of the latency of the delivered notifications */
+    uint32_t latency_total;
+};
+typedef struct bacnet_event_outbox_stats BACNET_EVENT_OUTBOX_STATS;
+/** @} */
+
+#if BACNET_EVENT_OUTBOX_ENABLED
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+uint8_t Event_Outbox_Message_Encode(
+    const BACNET_EVENT_NOTIFICATION_DATA *data);
+BACNET_STACK_EXPORT
+void Event_Outbox_Message_Release(uint8_t message);
+BACNET_STACK_EXPORT
+bool Event_Outbox_Send(
+    uint8_t message,
+    uint32_t process_id,
+    const BACNET_RECIPIENT *recipient,
+    bool confirmed);
+BACNET_STACK_EXPORT
+void Event_Outbox_SimpleACK_Handler(BACNET_ADDRESS *src, uint8_t invoke_id);
+BACNET_STACK_EXPORT
+void Event_Outbox_Timer(uint16_t milliseconds);
+BACNET_STACK_EXPORT
+uint16_t Event_Outbox_Depth(void);
+BACNET_STACK_EXPORT
+void Event_Outbox_Stats(BACNET_EVENT_OUTBOX_STATS *stats);
+BACNET_STACK_EXPORT
+void Event_Outbox_Stats_Reset(void);
+BACNET_STACK_EXPORT
+void Event_Outbox_Init(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
+#endif
@@ -118,6 +118,8 @@
 #include "../../bacnet/basic/service/s_delete_object.h"
 //#include "bacnet/basic/service/s_error.h"
 #include "../../bacnet/basic/service/s_error.h"
+//#include "bacnet/basic/service/s_event_outbox.h"
+#include "../../bacnet/basic/service/s_event_outbox.h"
 //#include "bacnet/basic/service/s_get_alarm_sum.h"
 #include "../../bacnet/basic/service/s_get_alarm_sum.h"
 //#include "bacnet/basic/service/s_get_event.h"
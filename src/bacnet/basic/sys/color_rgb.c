@@ -14,6 +14,7 @@
 //#include "bacnet/basic/sys/color_rgb.h"
 #include "../../../bacnet/basic/sys/color_rgb.h"
 
+#if !BACNET_COLOR_RGB_FIXED_POINT
 /**
  * @brief Clamp a double precision value between two limits
  * @param d - value to be clamped
@@ -30,7 +31,368 @@ static double clamp(double d, double min, double max)
         return t > max ? max : t;
     }
 }
+#endif
+
+#if BACNET_COLOR_RGB_FIXED_POINT
+/* Fixed point versions of the conversions, for processors without a
+   floating point unit. Values from 0.0 to 1.0 are held in Q16, where
+   65536 is 1.0, and the matrix coefficients in Q14 or Q13. */
+#define COLOR_Q16_ONE ((uint32_t)65536UL)
+#define COLOR_Q14(c) ((uint32_t)((c) * 16384.0 + 0.5))
+#define COLOR_Q13(c) ((int32_t)((c) * 8192.0 + 0.5))
+#define COLOR_Q16(c) ((int32_t)((c) * 65536.0 + 0.5))
+#define COLOR_Q12(c) ((int32_t)((c) * 4096.0 + 0.5))
+#define COLOR_Q8(c) ((int32_t)((c) * 256.0 + 0.5))
+
+/* sRGB 0..255 to linear light in Q16, with the sRGB gamma curve:
+   v/12.92 below 0.04045, else ((v + 0.055) / 1.055) ^ 2.4 */
+static const uint16_t Color_RGB_Linear[256] = {
+    0, 20, 40, 60, 80, 99, 119, 139, 159, 179, 199, 219, 241, 264, 288, 313,
+    340, 367, 396, 427, 458, 491, 526, 562, 599, 637, 677, 718, 761, 805, 851,
+    898, 947, 997, 1048, 1101, 1156, 1212, 1270, 1330, 1391, 1453, 1517, 1583,
+    1651, 1720, 1791, 1863, 1937, 2013, 2090, 2170, 2250, 2333, 2418, 2504,
+    2592, 2681, 2773, 2866, 2961, 3058, 3157, 3258, 3360, 3464, 3570, 3678,
+    3788, 3900, 4014, 4129, 4247, 4366, 4488, 4611, 4736, 4864, 4993, 5124,
+    5257, 5392, 5530, 5669, 5810, 5953, 6099, 6246, 6395, 6547, 6701, 6856,
+    7014, 7174, 7336, 7500, 7666, 7834, 8004, 8177, 8352, 8529, 8708, 8889,
+    9072, 9258, 9446, 9636, 9828, 10022, 10219, 10418, 10619, 10822, 11028,
+    11236, 11446, 11658, 11873, 12090, 12309, 12531, 12754, 12981, 13209, 13440,
+    13673, 13909, 14147, 14387, 14629, 14874, 15122, 15372, 15624, 15878, 16135,
+    16394, 16656, 16920, 17187, 17456, 17727, 18001, 18278, 18556, 18838, 19121,
+    19408, 19696, 19988, 20281, 20578, 20876, 21178, 21481, 21788, 22096, 22408,
+    22722, 23038, 23357, 23679, 24003, 24329, 24659, 24991, 25325, 25662, 26002,
+    26344, 26689, 27036, 27387, 27739, 28095, 28453, 28813, 29177, 29543, 29911,
+    30283, 30657, 31033, 31413, 31795, 32180, 32567, 32957, 33350, 33746, 34144,
+    34545, 34949, 35355, 35765, 36177, 36591, 37009, 37429, 37852, 38278, 38707,
+    39138, 39572, 40009, 40449, 40892, 41337, 41786, 42237, 42691, 43147, 43607,
+    44069, 44534, 45003, 45474, 45947, 46424, 46904, 47386, 47871, 48360, 48851,
+    49345, 49842, 50342, 50844, 51350, 51859, 52370, 52884, 53402, 53922, 54445,
+    54972, 55501, 56033, 56568, 57106, 57647, 58191, 58738, 59288, 59841, 60397,
+    60956, 61518, 62083, 62651, 63222, 63796, 64373, 64953, 65535,
+};
+
+/**
+ * @brief Convert an sRGB value to linear light
+ * @param value - sRGB value 0..255
+ * @param gamma_correction - true if gamma correction is applied
+ * @return linear light 0..1.0 in Q16
+ */
+static uint32_t color_rgb_linear_q16(uint8_t value, bool gamma_correction)
+{
+    if (gamma_correction) {
+        return Color_RGB_Linear[value];
+    }
+
+    /* value / 255 */
+    return ((uint32_t)value * 257UL) + (value >> 7);
+}
+
+/**
+ * @brief Convert linear light to an sRGB value, truncated as the
+ *  floating point conversion is.
+ * @param linear - linear light 0..1.0 in Q16
+ * @param gamma_correction - true if gamma correction is applied
+ * @return sRGB value 0..255
+ */
+static uint8_t color_rgb_from_linear_q16(uint32_t linear, bool gamma_correction)
+{
+    uint8_t low = 0, high = 255, middle;
+
+    if (linear >= COLOR_Q16_ONE) {
+        return 255;
+    }
+    if (!gamma_correction) {
+        return (uint8_t)((linear * 255UL) >> 16);
+    }
+    /* the largest value whose linear light does not exceed it */
+    while (low < high) {
+        middle = (uint8_t)(low + ((high - low + 1) / 2));
+        if (Color_RGB_Linear[middle] <= linear) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * @brief Convert sRGB to CIE xy in fixed point
+ * @param r - R value of sRGB 0..255
+ * @param g - G value of sRGB 0..255
+ * @param b - B value of sRGB 0..255
+ * @param x_coordinate - return x of CIE xy 0.0..1.0
+ * @param y_coordinate - return y of CIE xy 0.0..1.0
+ * @param brightness - return brightness of the CIE xy color 0..255
+ * @param gamma_correction - true if gamma correction is applied
+ */
+static void color_rgb_to_xy_fixed(
+    uint8_t r,
+    uint8_t g,
+    uint8_t b,
+    float *x_coordinate,
+    float *y_coordinate,
+    uint8_t *brightness,
+    bool gamma_correction)
+{
+    uint32_t red, green, blue;
+    /* XYZ in Q30; the sum of all three fits in 32 bits */
+    uint32_t X, Y, Z, sum;
+    uint32_t x = 0, y = 0;
+
+    red = color_rgb_linear_q16(r, gamma_correction);
+    green = color_rgb_linear_q16(g, gamma_correction);
+    blue = color_rgb_linear_q16(b, gamma_correction);
+    /*  Wide RGB D65 conversion formula */
+    X = red * COLOR_Q14(0.649926) + green * COLOR_Q14(0.103455) +
+        blue * COLOR_Q14(0.197109);
+    Y = red * COLOR_Q14(0.234327) + green * COLOR_Q14(0.743075) +
+        blue * COLOR_Q14(0.022598);
+    Z = green * COLOR_Q14(0.053077) + blue * COLOR_Q14(1.035763);
+    sum = X + Y + Z;
+    /*  Use the Y value of XYZ as brightness */
+    if (brightness) {
+        if ((Y >> 14) >= COLOR_Q16_ONE) {
+            *brightness = 255;
+        } else {
+            *brightness = (uint8_t)(((Y >> 14) * 255UL) >> 16);
+        }
+    }
+    if (sum > 0) {
+        /* scale the sum into 16 bits so the quotients fit in 32 bits */
+        while (sum > 0xFFFFUL) {
+            sum >>= 1;
+            X >>= 1;
+            Y >>= 1;
+        }
+        x = (X << 16) / sum;
+        y = (Y << 16) / sum;
+    }
+    if (x_coordinate) {
+        *x_coordinate = (float)x / 65536.0f;
+    }
+    if (y_coordinate) {
+        *y_coordinate = (float)y / 65536.0f;
+    }
+}
+
+/**
+ * @brief Scale a fixed point dot product of x, y and z by Y / y
+ * @param dot - x, y and z times one row of the XYZ to RGB matrix, Q16
+ * @param brightness - brightness of the CIE xy color 0..255
+ * @param y - y of CIE xy in Q16, not zero
+ * @return linear light 0..1.0 in Q16
+ */
+static uint32_t color_rgb_xyz_scale(int32_t dot, uint8_t brightness, uint32_t y)
+{
+    uint32_t numerator, denominator, quotient, remainder;
+
+    if (dot <= 0) {
+        return 0;
+    }
+    /* dot * (brightness / 255) / y */
+    numerator = (uint32_t)dot * brightness;
+    denominator = 255UL * y;
+    if (numerator >= denominator) {
+        return COLOR_Q16_ONE;
+    }
+    /* (numerator << 16) / denominator, 8 bits at a time */
+    quotient = (numerator << 8) / denominator;
+    remainder = (numerator << 8) % denominator;
+    quotient = (quotient << 8) | ((remainder << 8) / denominator);
+
+    return quotient;
+}
+
+/**
+ * @brief Convert a float 0.0..1.0 to Q16
+ * @param value - value to convert
+ * @return value clamped to 0..1.0 in Q16
+ */
+static uint32_t color_rgb_float_q16(float value)
+{
+    if (!(value > 0.0f)) {
+        return 0;
+    }
+    if (value >= 1.0f) {
+        return COLOR_Q16_ONE;
+    }
+
+    return (uint32_t)(value * 65536.0f);
+}
+
+/**
+ * @brief Convert sRGB from CIE xy and brightness in fixed point
+ * @param red - return R value of sRGB
+ * @param green - return G value of sRGB
+ * @param blue - return B value of sRGB
+ * @param x_coordinate - x of CIE xy
+ * @param y_coordinate - y of CIE xy
+ * @param brightness - brightness of the CIE xy color
+ * @param gamma_correction - true if gamma correction is needed
+ */
+static void color_rgb_from_xy_fixed(
+    uint8_t *red,
+    uint8_t *green,
+    uint8_t *blue,
+    float x_coordinate,
+    float y_coordinate,
+    uint8_t brightness,
+    bool gamma_correction)
+{
+    int32_t x, y, z;
+    int32_t r = 0, g = 0, b = 0;
+
+    x = (int32_t)color_rgb_float_q16(x_coordinate);
+    y = (int32_t)color_rgb_float_q16(y_coordinate);
+    z = (int32_t)COLOR_Q16_ONE - x - y;
+    if (y > 0) {
+        /*  X = x * (Y / y), Z = z * (Y / y), so each row of the
+            matrix is taken over x, y and z, then scaled by Y / y */
+        r = (x * COLOR_Q13(1.4628067) - y * COLOR_Q13(0.1840623) -
+             z * COLOR_Q13(0.2743606)) >> 13;
+        g = (-x * COLOR_Q13(0.5217933) + y * COLOR_Q13(1.4472381) +
+             z * COLOR_Q13(0.0677227)) >> 13;
+        b = (x * COLOR_Q13(0.0349342) - y * COLOR_Q13(0.0968930) +
+             z * COLOR_Q13(1.2884099)) >> 13;
+        r = (int32_t)color_rgb_xyz_scale(r, brightness, (uint32_t)y);
+        g = (int32_t)color_rgb_xyz_scale(g, brightness, (uint32_t)y);
+        b = (int32_t)color_rgb_xyz_scale(b, brightness, (uint32_t)y);
+    }
+    if (red) {
+        *red = color_rgb_from_linear_q16((uint32_t)r, gamma_correction);
+    }
+    if (green) {
+        *green = color_rgb_from_linear_q16((uint32_t)g, gamma_correction);
+    }
+    if (blue) {
+        *blue = color_rgb_from_linear_q16((uint32_t)b, gamma_correction);
+    }
+}
 
+/**
+ * @brief Base 2 logarithm of an integer
+ * @param value - integer 1..65535
+ * @return log2 of the value in Q16
+ */
+static int32_t color_log2_q16(uint16_t value)
+{
+    int32_t result = 0;
+    uint32_t mantissa;
+    uint8_t exponent = 0;
+    uint8_t i;
+
+    while ((value >> exponent) > 1) {
+        exponent++;
+    }
+    result = (int32_t)exponent << 16;
+    /* 1.0 <= mantissa < 2.0 in Q15 */
+    mantissa = ((uint32_t)value << 15) >> exponent;
+    for (i = 0; i < 16; i++) {
+        mantissa = (mantissa * mantissa) >> 15;
+        if (mantissa >= (2UL << 15)) {
+            mantissa >>= 1;
+            result |= 1L << (15 - i);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Base 2 power of a fixed point value, as an integer
+ * @param value - exponent 0.0..15.0 in Q16
+ * @return 2 to the power of the value, truncated to an integer
+ */
+static uint32_t color_exp2_q16(int32_t value)
+{
+    uint32_t fraction, result;
+
+    if (value <= 0) {
+        return value == 0 ? 1 : 0;
+    }
+    fraction = (uint32_t)value & 0xFFFFUL;
+    /* 2^f - 1 = f * (a + f * (b + f * c)) for 0 <= f < 1 */
+    result = (COLOR_Q16(0.0773806) * fraction) >> 16;
+    result = ((COLOR_Q16(0.2269401) + result) * fraction) >> 16;
+    result = ((COLOR_Q16(0.6954300) + result) * fraction) >> 16;
+    result += COLOR_Q16_ONE;
+
+    return (result << (value >> 16)) >> 16;
+}
+
+/**
+ * @brief Clamp an integer color value to 0..255
+ * @param value - value to be clamped
+ * @return value clamped between 0 and 255 inclusive
+ */
+static uint8_t color_clamp_u8(int32_t value)
+{
+    if (value < 0) {
+        return 0;
+    }
+    if (value > 255) {
+        return 255;
+    }
+
+    return (uint8_t)value;
+}
+
+/**
+ * @brief Return an RGB color from a color temperature in Kelvin,
+ *  in fixed point. The same curves as the floating point version:
+ *  a * t ^ k is computed as 2 ^ (log2(a) + k * log2(t)), and
+ *  a * ln(t) as a * ln(2) * log2(t).
+ * @param temperature - color temperature in hundreds of Kelvin, 10..400
+ * @param r - return R value of sRGB
+ * @param g - return G value of sRGB
+ * @param b - return B value of sRGB
+ */
+static void color_rgb_from_temperature_fixed(
+    uint16_t temperature, uint8_t *r, uint8_t *g, uint8_t *b)
+{
+    int32_t red, green, blue;
+    int32_t log2_q12;
+
+    if (temperature <= 66) {
+        red = 255;
+        log2_q12 = color_log2_q16(temperature) >> 4;
+        green = ((log2_q12 * COLOR_Q8(99.4708025861 * 0.69314718056)) >> 8) -
+            COLOR_Q12(161.1195681661);
+        green >>= 12;
+    } else {
+        log2_q12 = color_log2_q16(temperature - 60) >> 4;
+        red = (int32_t)color_exp2_q16(
+            COLOR_Q16(8.3650045084) -
+            ((log2_q12 * COLOR_Q16(0.1332047592)) >> 12));
+        green = (int32_t)color_exp2_q16(
+            COLOR_Q16(8.1705368626) -
+            ((log2_q12 * COLOR_Q16(0.0755148492)) >> 12));
+    }
+    if (temperature >= 66) {
+        blue = 255;
+    } else if (temperature <= 19) {
+        blue = 0;
+    } else {
+        log2_q12 = color_log2_q16(temperature - 10) >> 4;
+        blue = ((log2_q12 * COLOR_Q8(138.5177312231 * 0.69314718056)) >> 8) -
+            COLOR_Q12(305.0447927307);
+        blue >>= 12;
+    }
+    if (r) {
+        *r = color_clamp_u8(red);
+    }
+    if (g) {
+        *g = color_clamp_u8(green);
+    }
+    if (b) {
+        *b = color_clamp_u8(blue);
+    }
+}
+#endif
+
+#if !BACNET_COLOR_RGB_FIXED_POINT
 /**
  * @brief Convert sRGB to CIE xy
  * @param r - R value of sRGB 0..255
@@ -112,6 +474,7 @@ static void color_rgb_to_xy_gamma_correction(
         *brightness = (uint8_t)Y;
     }
 }
+#endif
 
 /**
  * @brief Convert sRGB to CIE xy
@@ -131,8 +494,13 @@ void color_rgb_to_xy(
     float *y_coordinate,
     uint8_t *brightness)
 {
+#if BACNET_COLOR_RGB_FIXED_POINT
+    color_rgb_to_xy_fixed(
+        r, g, b, x_coordinate, y_coordinate, brightness, false);
+#else
     color_rgb_to_xy_gamma_correction(
         r, g, b, x_coordinate, y_coordinate, brightness, false);
+#endif
 }
 
 /**
@@ -153,10 +521,16 @@ void color_rgb_to_xy_gamma(
     float *y_coordinate,
     uint8_t *brightness)
 {
+#if BACNET_COLOR_RGB_FIXED_POINT
+    color_rgb_to_xy_fixed(
+        r, g, b, x_coordinate, y_coordinate, brightness, true);
+#else
     color_rgb_to_xy_gamma_correction(
         r, g, b, x_coordinate, y_coordinate, brightness, true);
+#endif
 }
 
+#if !BACNET_COLOR_RGB_FIXED_POINT
 /**
  * @brief Convert sRGB from CIE xy and brightness
  * @param red - return R value of sRGB
@@ -228,6 +602,7 @@ static void color_rgb_from_xy_gamma_correction(
         *blue = (uint8_t)b;
     }
 }
+#endif
 
 /**
  * @brief Convert sRGB from CIE xy and brightness
@@ -247,8 +622,13 @@ void color_rgb_from_xy(
     float y_coordinate,
     uint8_t brightness)
 {
+#if BACNET_COLOR_RGB_FIXED_POINT
+    color_rgb_from_xy_fixed(
+        red, green, blue, x_coordinate, y_coordinate, brightness, false);
+#else
     color_rgb_from_xy_gamma_correction(
         red, green, blue, x_coordinate, y_coordinate, brightness, false);
+#endif
 }
 
 /**
@@ -269,8 +649,13 @@ void color_rgb_from_xy_gamma(
     float y_coordinate,
     uint8_t brightness)
 {
+#if BACNET_COLOR_RGB_FIXED_POINT
+    color_rgb_from_xy_fixed(
+        red, green, blue, x_coordinate, y_coordinate, brightness, true);
+#else
     color_rgb_from_xy_gamma_correction(
         red, green, blue, x_coordinate, y_coordinate, brightness, true);
+#endif
 }
 
 /* table for converting RGB to and from ASCII color names */
@@ -546,7 +931,9 @@ unsigned color_rgb_count(void)
 void color_rgb_from_temperature(
     uint16_t temperature_kelvin, uint8_t *r, uint8_t *g, uint8_t *b)
 {
+#if !BACNET_COLOR_RGB_FIXED_POINT
     float red = 0, green = 0, blue = 0;
+#endif
 
     if (temperature_kelvin < 1000) {
         temperature_kelvin = 1000;
@@ -554,7 +941,9 @@ void color_rgb_from_temperature(
         temperature_kelvin = 40000;
     }
     temperature_kelvin /= 100;
-
+#if BACNET_COLOR_RGB_FIXED_POINT
+    color_rgb_from_temperature_fixed(temperature_kelvin, r, g, b);
+#else
     /* Calculate Red */
     if (temperature_kelvin <= 66) {
         /* Red values below 6600 K are always 255 */
@@ -595,4 +984,5 @@ void color_rgb_from_temperature(
     if (b) {
         *b = (uint8_t)blue;
     }
+#endif
 }
@@ -0,0 +1,871 @@
+/**
+ * @file
+ * @brief An append-only log segment store in flash or EEPROM pages.
+ *
+ * Each page starts with a header:
+ *
+ *   magic (2), generation (4), tail generation (4), first sequence (4),
+ *   CRC-16 of the header (2)
+ *
+ * followed by records packed front to back:
+ *
+ *   length (2), data (length), CRC-16 of the length and data (2)
+ *
+ * The generation counts pages as they are opened, so the head page is the
+ * one with the highest generation, and the tail generation in its header
+ * says how far back the ring of pages goes. Records are numbered from the
+ * first sequence in the header of their page. A record that was only
+ * partly written before a reset fails its CRC, and appending resumes on
+ * the next page.
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#if defined(BACNET_LOG_SEGMENT_FILE)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#endif
+//#include "bacnet/bacint.h"
+#include "../../../bacnet/bacint.h"
+//#include "bacnet/datalink/crc.h"
+#include "../../../bacnet/datalink/crc.h"
+//#include "bacnet/basic/sys/logseg.h"
+#include "../../../bacnet/basic/sys/logseg.h"
+
+#define LOGSEG_PAGE_MAGIC 0x4C53
+/* length of a page that has not been written past this point */
+#define LOGSEG_RECORD_FREE 0xFFFF
+
+/**
+ * @brief Calculate the CRC of a block of bytes
+ * @param crc - CRC of the bytes before this block
+ * @param buffer - bytes to add to the CRC
+ * @param length - number of bytes
+ * @return CRC of all the bytes
+ */
+static uint16_t
+logseg_crc(uint16_t crc, const uint8_t *buffer, size_t length)
+{
+    size_t i;
+
+    for (i = 0; i < length; i++) {
+        crc = CRC_Calc_Data(buffer[i], crc);
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Get the address of a position in a page
+ * @param store - log segment store
+ * @param page - page number
+ * @param offset - offset within the page
+ * @return address for the driver
+ */
+static uint32_t
+logseg_address(const BACNET_LOG_SEGMENT *store, uint16_t page, uint32_t offset)
+{
+    return ((uint32_t)page * store->driver->page_size) + offset;
+}
+
+/**
+ * @brief Read bytes from a page
+ * @param store - log segment store
+ * @param page - page number
+ * @param offset - offset within the page
+ * @param buffer - where to put the bytes
+ * @param length - number of bytes
+ * @return true if all the bytes were read
+ */
+static bool logseg_page_read(
+    const BACNET_LOG_SEGMENT *store,
+    uint16_t page,
+    uint32_t offset,
+    uint8_t *buffer,
+    size_t length)
+{
+    int len;
+
+    len = store->driver->read(
+        store->driver->context, logseg_address(store, page, offset), buffer,
+        length);
+
+    return (len >= 0) && ((size_t)len == length);
+}
+
+/**
+ * @brief Write bytes into a page
+ * @param store - log segment store
+ * @param page - page number
+ * @param offset - offset within the page
+ * @param buffer - bytes to write
+ * @param length - number of bytes
+ * @return true if all the bytes were written
+ */
+static bool logseg_page_write(
+    const BACNET_LOG_SEGMENT *store,
+    uint16_t page,
+    uint32_t offset,
+    const uint8_t *buffer,
+    size_t length)
+{
+    int len;
+
+    len = store->driver->write(
+        store->driver->context, logseg_address(store, page, offset), buffer,
+        length);
+
+    return (len >= 0) && ((size_t)len == length);
+}
+
+/**
+ * @brief Read and check the header of a page
+ * @param store - log segment store
+ * @param page - page number
+ * @param generation - where to put the generation of the page
+ * @param tail_generation - where to put the generation of the tail page
+ * @param first_sequence - where to put the sequence of the first record
+ * @return true if the page has a valid header
+ */
+static bool logseg_page_header(
+    const BACNET_LOG_SEGMENT *store,
+    uint16_t page,
+    uint32_t *generation,
+    uint32_t *tail_generation,
+    uint32_t *first_sequence)
+{
+    uint8_t header[LOGSEG_PAGE_HEADER_SIZE];
+    uint16_t magic = 0;
+    uint16_t crc = 0;
+
+    if (!logseg_page_read(store, page, 0, header, sizeof(header))) {
+        return false;
+    }
+    decode_unsigned16(&header[0], &magic);
+    decode_unsigned16(&header[14], &crc);
+    if ((magic != LOGSEG_PAGE_MAGIC) ||
+        (crc != logseg_crc(0xFFFF, header, 14))) {
+        return false;
+    }
+    if (generation) {
+        decode_unsigned32(&header[2], generation);
+    }
+    if (tail_generation) {
+        decode_unsigned32(&header[6], tail_generation);
+    }
+    if (first_sequence) {
+        decode_unsigned32(&header[10], first_sequence);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Erase a page and write its header
+ * @param store - log segment store
+ * @param page - page number
+ * @param generation - generation of the page
+ * @param tail_generation - generation of the tail page
+ * @param first_sequence - sequence of the first record in the page
+ * @return true if the page is ready for records
+ */
+static bool logseg_page_open(
+    const BACNET_LOG_SEGMENT *store,
+    uint16_t page,
+    uint32_t generation,
+    uint32_t tail_generation,
+    uint32_t first_sequence)
+{
+    uint8_t header[LOGSEG_PAGE_HEADER_SIZE];
+
+    if (!store->driver->erase(store->driver->context, page)) {
+        return false;
+    }
+    encode_unsigned16(&header[0], LOGSEG_PAGE_MAGIC);
+    encode_unsigned32(&header[2], generation);
+    encode_unsigned32(&header[6], tail_generation);
+    encode_unsigned32(&header[10], first_sequence);
+    encode_unsigned16(&header[14], logseg_crc(0xFFFF, header, 14));
+
+    return logseg_page_write(store, page, 0, header, sizeof(header));
+}
+
+/**
+ * @brief Read the length of the record at an offset in a page
+ * @param store - log segment store
+ * @param page - page number
+ * @param offset - offset of the record within the page
+ * @param length - where to put the length of the record data
+ * @return true if a record fits at the offset, false if the page is
+ *  free or invalid from the offset onwards
+ */
+static bool logseg_record_length(
+    const BACNET_LOG_SEGMENT *store,
+    uint16_t page,
+    uint32_t offset,
+    uint16_t *length)
+{
+    uint8_t buffer[2];
+
+    if ((offset + LOGSEG_RECORD_OVERHEAD) > store->driver->page_size) {
+        return false;
+    }
+    if (!logseg_page_read(store, page, offset, buffer, sizeof(buffer))) {
+        return false;
+    }
+    decode_unsigned16(buffer, length);
+    if (*length == LOGSEG_RECORD_FREE) {
+        return false;
+    }
+    if ((offset + LOGSEG_RECORD_OVERHEAD + *length) >
+        store->driver->page_size) {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Check the CRC of a record, optionally copying out its data
+ * @param store - log segment store
+ * @param page - page number
+ * @param offset - offset of the record within the page
+ * @param length - length of the record data
+ * @param buffer - where to put the data, or NULL
+ * @return true if the record is intact
+ */
+static bool logseg_record_check(
+    const BACNET_LOG_SEGMENT *store,
+    uint16_t page,
+    uint32_t offset,
+    uint16_t length,
+    uint8_t *buffer)
+{
+    uint8_t chunk[32];
+    uint16_t crc = 0xFFFF;
+    uint16_t record_crc = 0;
+    uint16_t remaining;
+    uint16_t len;
+
+    encode_unsigned16(chunk, length);
+    crc = logseg_crc(crc, chunk, 2);
+    offset += 2;
+    if (buffer) {
+        if (!logseg_page_read(store, page, offset, buffer, length)) {
+            return false;
+        }
+        crc = logseg_crc(crc, buffer, length);
+        offset += length;
+    } else {
+        remaining = length;
+        while (remaining > 0) {
+            len = remaining;
+            if (len > sizeof(chunk)) {
+                len = sizeof(chunk);
+            }
+            if (!logseg_page_read(store, page, offset, chunk, len)) {
+                return false;
+            }
+            crc = logseg_crc(crc, chunk, len);
+            offset += len;
+            remaining -= len;
+        }
+    }
+    if (!logseg_page_read(store, page, offset, chunk, 2)) {
+        return false;
+    }
+    decode_unsigned16(chunk, &record_crc);
+
+    return crc == record_crc;
+}
+
+/**
+ * @brief Start a new ring of pages, forgetting all the records
+ * @param store - log segment store
+ * @param sequence - sequence number of the next record
+ * @return true if the new ring was started
+ */
+static bool logseg_restart(BACNET_LOG_SEGMENT *store, uint32_t sequence)
+{
+    uint16_t page;
+
+    page = (store->head_page + 1) % store->driver->page_count;
+    store->read_valid = false;
+    store->page_used = 0;
+    store->count = 0;
+    store->first_sequence = sequence;
+    store->generation++;
+    if (!logseg_page_open(
+            store, page, store->generation, store->generation, sequence)) {
+        return false;
+    }
+    store->head_page = page;
+    store->tail_page = page;
+    store->page_used = 1;
+    store->head_offset = LOGSEG_PAGE_HEADER_SIZE;
+
+    return true;
+}
+
+/**
+ * @brief Move appending on to the next page, dropping the oldest page
+ *  if the ring is full
+ * @param store - log segment store
+ * @param sequence - sequence number of the next record
+ * @return true if the next page is ready for records
+ */
+static bool logseg_page_next(BACNET_LOG_SEGMENT *store, uint32_t sequence)
+{
+    uint16_t page;
+    uint32_t first_sequence = 0;
+
+    page = (store->head_page + 1) % store->driver->page_count;
+    if (store->page_used >= store->driver->page_count) {
+        /* the next page is the tail page */
+        store->read_valid = false;
+        store->tail_page = (store->tail_page + 1) % store->driver->page_count;
+        store->page_used--;
+        if (!logseg_page_header(
+                store, store->tail_page, NULL, NULL, &first_sequence)) {
+            return logseg_restart(store, sequence);
+        }
+        store->count -= first_sequence - store->first_sequence;
+        store->first_sequence = first_sequence;
+    }
+    store->generation++;
+    if (!logseg_page_open(
+            store, page, store->generation,
+            store->generation - store->page_used, sequence)) {
+        /* the tail page is still good, so just stop appending */
+        store->generation--;
+        store->head_offset = store->driver->page_size;
+        return false;
+    }
+    store->head_page = page;
+    store->page_used++;
+    store->head_offset = LOGSEG_PAGE_HEADER_SIZE;
+
+    return true;
+}
+
+/**
+ * @brief Find the records already in the pages after a reset
+ * @param store - log segment store
+ * @param driver - access to the pages
+ * @return true if the store is ready to use
+ */
+bool logseg_init(
+    BACNET_LOG_SEGMENT *store, const BACNET_LOG_SEGMENT_DRIVER *driver)
+{
+    uint32_t generation = 0;
+    uint32_t tail_generation = 0;
+    uint32_t first_sequence = 0;
+    uint32_t head_sequence = 0;
+    uint32_t offset;
+    uint16_t length = 0;
+    uint16_t page;
+    uint16_t used;
+    bool found = false;
+
+    if (!store || !driver || (driver->page_count < 2) ||
+        (driver->page_size <=
+         (LOGSEG_PAGE_HEADER_SIZE + LOGSEG_RECORD_OVERHEAD)) ||
+        !driver->read || !driver->write || !driver->erase) {
+        return false;
+    }
+    store->driver = driver;
+    store->read_valid = false;
+    store->page_used = 0;
+    store->count = 0;
+    store->first_sequence = 0;
+    store->generation = 0;
+    store->head_page = driver->page_count - 1;
+    store->tail_page = 0;
+    store->head_offset = driver->page_size;
+    /* the head page has the newest generation */
+    for (page = 0; page < driver->page_count; page++) {
+        if (logseg_page_header(store, page, &generation, NULL, NULL)) {
+            if (!found || ((int32_t)(generation - store->generation) > 0)) {
+                found = true;
+                store->generation = generation;
+                store->head_page = page;
+            }
+        }
+    }
+    if (!found) {
+        return true;
+    }
+    (void)logseg_page_header(
+        store, store->head_page, NULL, &tail_generation, &head_sequence);
+    /* walk back to the tail page, stopping at any page that was lost */
+    used = 1;
+    page = store->head_page;
+    first_sequence = head_sequence;
+    while ((used < driver->page_count) &&
+           ((store->generation - tail_generation) >= used)) {
+        page = (page + driver->page_count - 1) % driver->page_count;
+        if (!logseg_page_header(store, page, &generation, NULL, &offset) ||
+            (generation != (store->generation - used))) {
+            break;
+        }
+        first_sequence = offset;
+        used++;
+    }
+    store->page_used = used;
+    store->tail_page =
+        (store->head_page + driver->page_count - (used - 1)) %
+        driver->page_count;
+    store->first_sequence = first_sequence;
+    /* count the intact records in the head page */
+    store->count = head_sequence - first_sequence;
+    offset = LOGSEG_PAGE_HEADER_SIZE;
+    while (logseg_record_length(store, store->head_page, offset, &length)) {
+        if (!logseg_record_check(
+                store, store->head_page, offset, length, NULL)) {
+            /* torn write: close the page */
+            offset = driver->page_size;
+            break;
+        }
+        store->count++;
+        offset += length + LOGSEG_RECORD_OVERHEAD;
+    }
+    if ((offset < driver->page_size) && (length != LOGSEG_RECORD_FREE)) {
+        /* unreadable or corrupt length: close the page */
+        offset = driver->page_size;
+    }
+    store->head_offset = offset;
+
+    return true;
+}
+
+/**
+ * @brief Forget all the records in the store
+ * @param store - log segment store
+ * @param sequence - sequence number of the next record
+ * @return true if the store was cleared
+ */
+bool logseg_clear(BACNET_LOG_SEGMENT *store, uint32_t sequence)
+{
+    if (!store || !store->driver) {
+        return false;
+    }
+
+    return logseg_restart(store, sequence);
+}
+
+/**
+ * @brief Append a record to the store
+ * @note Sequence numbers are consecutive. A record that does not follow
+ *  on from the newest record in the store starts the store over.
+ * @param store - log segment store
+ * @param sequence - sequence number of the record
+ * @param data - record data
+ * @param length - number of bytes of record data
+ * @return true if the record was appended
+ */
+bool logseg_append(
+    BACNET_LOG_SEGMENT *store,
+    uint32_t sequence,
+    const uint8_t *data,
+    uint16_t length)
+{
+    uint8_t buffer[2];
+    uint16_t crc;
+    uint32_t offset;
+
+    if (!store || !store->driver ||
+        (length > logseg_record_size_max(store))) {
+        return false;
+    }
+    if ((store->page_used == 0) ||
+        (sequence != (store->first_sequence + store->count))) {
+        if (!logseg_restart(store, sequence)) {
+            return false;
+        }
+    } else if (
+        (store->head_offset + length + LOGSEG_RECORD_OVERHEAD) >
+        store->driver->page_size) {
+        if (!logseg_page_next(store, sequence)) {
+            return false;
+        }
+    }
+    offset = store->head_offset;
+    /* close the page on any failure, since the rest of it is unknown */
+    store->head_offset = store->driver->page_size;
+    encode_unsigned16(buffer, length);
+    crc = logseg_crc(0xFFFF, buffer, 2);
+    crc = logseg_crc(crc, data, length);
+    if (!logseg_page_write(store, store->head_page, offset, buffer, 2)) {
+        return false;
+    }
+    offset += 2;
+    if (!logseg_page_write(store, store->head_page, offset, data, length)) {
+        return false;
+    }
+    offset += length;
+    encode_unsigned16(buffer, crc);
+    if (!logseg_page_write(store, store->head_page, offset, buffer, 2)) {
+        return false;
+    }
+    offset += 2;
+    store->head_offset = offset;
+    store->count++;
+
+    return true;
+}
+
+/**
+ * @brief Find the record after the one last read, which is either next
+ *  in the same page or the first record of the next page
+ * @param store - log segment store
+ * @param sequence - sequence number of the record
+ * @param page - where to put the page of the record
+ * @param offset - where to put the offset of the record within the page
+ * @param length - where to put the length of the record data
+ * @return true if a record with a valid length is at the position
+ */
+static bool logseg_record_next(
+    const BACNET_LOG_SEGMENT *store,
+    uint32_t sequence,
+    uint16_t *page,
+    uint32_t *offset,
+    uint16_t *length)
+{
+    uint32_t first_sequence = 0;
+
+    *page = store->read_page;
+    *offset = store->read_offset;
+    if (logseg_record_length(store, *page, *offset, length)) {
+        return true;
+    }
+    if (*page == store->head_page) {
+        return false;
+    }
+    /* the record starts the next page, if its header says so */
+    *page = (*page + 1) % store->driver->page_count;
+    *offset = LOGSEG_PAGE_HEADER_SIZE;
+    if (!logseg_page_header(store, *page, NULL, NULL, &first_sequence) ||
+        (first_sequence != sequence)) {
+        return false;
+    }
+
+    return logseg_record_length(store, *page, *offset, length);
+}
+
+/**
+ * @brief Find a record by searching the page headers
+ * @param store - log segment store
+ * @param sequence - sequence number of the record, which is in the store
+ * @param page - where to put the page of the record
+ * @param offset - where to put the offset of the record within the page
+ * @param length - where to put the length of the record data
+ * @return true if the record was found
+ */
+static bool logseg_record_search(
+    const BACNET_LOG_SEGMENT *store,
+    uint32_t sequence,
+    uint16_t *page,
+    uint32_t *offset,
+    uint16_t *length)
+{
+    uint32_t index;
+    uint32_t first_sequence = 0;
+    uint16_t low, high, mid;
+
+    /* binary search for the last page starting at or before it */
+    index = sequence - store->first_sequence;
+    low = 0;
+    high = store->page_used - 1;
+    while (low < high) {
+        mid = low + ((high - low + 1) / 2);
+        *page = (store->tail_page + mid) % store->driver->page_count;
+        if (!logseg_page_header(store, *page, NULL, NULL, &first_sequence)) {
+            return false;
+        }
+        if ((first_sequence - store->first_sequence) <= index) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    *page = (store->tail_page + low) % store->driver->page_count;
+    if (!logseg_page_header(store, *page, NULL, NULL, &first_sequence)) {
+        return false;
+    }
+    /* then step over the records before it in the page */
+    index = sequence - first_sequence;
+    *offset = LOGSEG_PAGE_HEADER_SIZE;
+    for (;;) {
+        if (!logseg_record_length(store, *page, *offset, length)) {
+            return false;
+        }
+        if (index == 0) {
+            break;
+        }
+        *offset += *length + LOGSEG_RECORD_OVERHEAD;
+        index--;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Read a record from the store
+ * @note Reading the record after the one last read does not need to
+ *  search the store, unless the page it was in was closed early by a
+ *  torn or failed write.
+ * @param store - log segment store
+ * @param sequence - sequence number of the record
+ * @param buffer - where to put the record data
+ * @param buffer_size - size of the buffer
+ * @return number of bytes of record data, or -1 if the record is not in
+ *  the store, does not fit the buffer, or is corrupt
+ */
+int logseg_read(
+    BACNET_LOG_SEGMENT *store,
+    uint32_t sequence,
+    uint8_t *buffer,
+    uint16_t buffer_size)
+{
+    uint32_t offset = 0;
+    uint16_t length = 0;
+    uint16_t page = 0;
+    bool valid = false;
+
+    if (!store || !store->driver) {
+        return -1;
+    }
+    if ((sequence - store->first_sequence) >= store->count) {
+        return -1;
+    }
+    if (store->read_valid && (store->read_sequence == sequence) &&
+        logseg_record_next(store, sequence, &page, &offset, &length) &&
+        (length <= buffer_size)) {
+        valid = logseg_record_check(store, page, offset, length, buffer);
+    }
+    if (!valid) {
+        /* not the record after the last one read, or a torn write left
+           what looks like a record at the end of its page */
+        valid =
+            logseg_record_search(store, sequence, &page, &offset, &length) &&
+            (length <= buffer_size) &&
+            logseg_record_check(store, page, offset, length, buffer);
+    }
+    if (!valid) {
+        store->read_valid = false;
+        return -1;
+    }
+    store->read_valid = true;
+    store->read_page = page;
+    store->read_offset = offset + length + LOGSEG_RECORD_OVERHEAD;
+    store->read_sequence = sequence + 1;
+
+    return length;
+}
+
+/**
+ * @brief Get the number of records in the store
+ * @param store - log segment store
+ * @return number of records
+ */
+uint32_t logseg_count(const BACNET_LOG_SEGMENT *store)
+{
+    if (!store) {
+        return 0;
+    }
+
+    return store->count;
+}
+
+/**
+ * @brief Get the sequence number of the oldest record in the store
+ * @param store - log segment store
+ * @return sequence number of the oldest record
+ */
+uint32_t logseg_first_sequence(const BACNET_LOG_SEGMENT *store)
+{
+    if (!store) {
+        return 0;
+    }
+
+    return store->first_sequence;
+}
+
+/**
+ * @brief Get the largest record that fits in a page
+ * @param store - log segment store
+ * @return maximum number of bytes of record data
+ */
+uint16_t logseg_record_size_max(const BACNET_LOG_SEGMENT *store)
+{
+    uint32_t size;
+
+    if (!store || !store->driver) {
+        return 0;
+    }
+    size = store->driver->page_size - LOGSEG_PAGE_HEADER_SIZE -
+        LOGSEG_RECORD_OVERHEAD;
+    if (size >= LOGSEG_RECORD_FREE) {
+        size = LOGSEG_RECORD_FREE - 1;
+    }
+
+    return (uint16_t)size;
+}
+
+#if defined(BACNET_LOG_SEGMENT_FILE)
+/* a file that stands in for flash pages on a host computer */
+struct logseg_file {
+    FILE *pFile;
+    uint32_t page_size;
+};
+
+/**
+ * @brief Read bytes from a log segment file
+ * @param context - the file
+ * @param address - offset in the file
+ * @param buffer - where to put the bytes
+ * @param length - number of bytes
+ * @return number of bytes read, or -1 on error
+ */
+static int logseg_file_read(
+    void *context, uint32_t address, uint8_t *buffer, size_t length)
+{
+    struct logseg_file *file = context;
+
+    if (fseek(file->pFile, (long)address, SEEK_SET) != 0) {
+        return -1;
+    }
+
+    return (int)fread(buffer, 1, length, file->pFile);
+}
+
+/**
+ * @brief Write bytes into a log segment file
+ * @param context - the file
+ * @param address - offset in the file
+ * @param buffer - bytes to write
+ * @param length - number of bytes
+ * @return number of bytes written, or -1 on error
+ */
+static int logseg_file_write(
+    void *context, uint32_t address, const uint8_t *buffer, size_t length)
+{
+    struct logseg_file *file = context;
+    size_t len;
+
+    if (fseek(file->pFile, (long)address, SEEK_SET) != 0) {
+        return -1;
+    }
+    len = fwrite(buffer, 1, length, file->pFile);
+    if (fflush(file->pFile) != 0) {
+        return -1;
+    }
+
+    return (int)len;
+}
+
+/**
+ * @brief Erase a page of a log segment file to all 0xFF
+ * @param context - the file
+ * @param page - page number
+ * @return true if the page was erased
+ */
+static bool logseg_file_erase(void *context, uint16_t page)
+{
+    struct logseg_file *file = context;
+    uint8_t buffer[64];
+    uint32_t remaining;
+    size_t len;
+
+    if (fseek(file->pFile, (long)page * (long)file->page_size, SEEK_SET) !=
+        0) {
+        return false;
+    }
+    memset(buffer, 0xFF, sizeof(buffer));
+    remaining = file->page_size;
+    while (remaining > 0) {
+        len = sizeof(buffer);
+        if (len > remaining) {
+            len = remaining;
+        }
+        if (fwrite(buffer, 1, len, file->pFile) != len) {
+            return false;
+        }
+        remaining -= len;
+    }
+
+    return fflush(file->pFile) == 0;
+}
+
+/**
+ * @brief Set up a driver that keeps the log pages in a file, for testing
+ *  and for host computers. A new file is created erased.
+ * @param driver - driver to set up
+ * @param pathname - name of the file
+ * @param page_size - size of each page, in bytes
+ * @param page_count - number of pages
+ * @return true if the file is ready
+ */
+bool logseg_file_open(
+    BACNET_LOG_SEGMENT_DRIVER *driver,
+    const char *pathname,
+    uint32_t page_size,
+    uint16_t page_count)
+{
+    struct logseg_file *file;
+    uint16_t page;
+    bool status = true;
+
+    if (!driver || !pathname) {
+        return false;
+    }
+    file = calloc(1, sizeof(struct logseg_file));
+    if (!file) {
+        return false;
+    }
+    file->page_size = page_size;
+    file->pFile = fopen(pathname, "r+b");
+    if (!file->pFile) {
+        file->pFile = fopen(pathname, "w+b");
+        for (page = 0; file->pFile && status && (page < page_count);
+             page++) {
+            status = logseg_file_erase(file, page);
+        }
+    }
+    if (!file->pFile || !status) {
+        if (file->pFile) {
+            fclose(file->pFile);
+        }
+        free(file);
+        return false;
+    }
+    driver->page_size = page_size;
+    driver->page_count = page_count;
+    driver->read = logseg_file_read;
+    driver->write = logseg_file_write;
+    driver->erase = logseg_file_erase;
+    driver->context = file;
+
+    return true;
+}
+
+/**
+ * @brief Close the file of a driver set up by logseg_file_open()
+ * @param driver - driver to close
+ */
+void logseg_file_close(BACNET_LOG_SEGMENT_DRIVER *driver)
+{
+    struct logseg_file *file;
+
+    if (driver && driver->context) {
+        file = driver->context;
+        fclose(file->pFile);
+        free(file);
+        driver->context = NULL;
+    }
+}
+#endif
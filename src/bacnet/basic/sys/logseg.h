@@ -0,0 +1,120 @@
+/**
+ * @file
+ * @brief API for an append-only log segment store in flash or EEPROM pages
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_SYS_LOGSEG_H
+#define BACNET_SYS_LOGSEG_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "../../../bacnet/bacdef.h"
+
+/* bytes at the start of each page that identify it */
+#define LOGSEG_PAGE_HEADER_SIZE 16
+/* bytes of framing around each record: length and CRC */
+#define LOGSEG_RECORD_OVERHEAD 4
+
+/**
+ * Access to the non-volatile memory that holds the log pages. Pages are
+ * erased to 0xFF and then written once, front to back, so this fits
+ * flash as well as EEPROM.
+ * @{
+ */
+struct bacnet_log_segment_driver {
+    /** size of an erase page, in bytes */
+    uint32_t page_size;
+    /** number of pages given to the store, at least 2 */
+    uint16_t page_count;
+    /** read bytes at an address, returning the number of bytes read */
+    int (*read)(
+        void *context, uint32_t address, uint8_t *buffer, size_t length);
+    /** write bytes at an address, returning the number of bytes written */
+    int (*write)(
+        void *context, uint32_t address, const uint8_t *buffer, size_t length);
+    /** erase a page to all 0xFF, returning true if successful */
+    bool (*erase)(void *context, uint16_t page);
+    /** passed to each of the functions above */
+    void *context;
+};
+typedef struct bacnet_log_segment_driver BACNET_LOG_SEGMENT_DRIVER;
+/** @} */
+
+/**
+ * A store of numbered log records. The pages are used in turn as a ring,
+ * so each is erased once per trip around the ring, and the oldest page
+ * is dropped when the ring is full.
+ * @{
+ */
+struct bacnet_log_segment {
+    const BACNET_LOG_SEGMENT_DRIVER *driver;
+    /** page that records are appended to */
+    uint16_t head_page;
+    /** page that holds the oldest records */
+    uint16_t tail_page;
+    /** number of pages that hold records */
+    uint16_t page_used;
+    /** where the next record goes in the head page */
+    uint32_t head_offset;
+    /** erase generation of the head page */
+    uint32_t generation;
+    /** sequence number of the oldest record */
+    uint32_t first_sequence;
+    /** number of records in the store */
+    uint32_t count;
+    /** position of the record after the last one read */
+    bool read_valid;
+    uint16_t read_page;
+    uint32_t read_offset;
+    uint32_t read_sequence;
+};
+typedef struct bacnet_log_segment BACNET_LOG_SEGMENT;
+/** @} */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+bool logseg_init(
+    BACNET_LOG_SEGMENT *store, const BACNET_LOG_SEGMENT_DRIVER *driver);
+BACNET_STACK_EXPORT
+bool logseg_clear(BACNET_LOG_SEGMENT *store, uint32_t sequence);
+BACNET_STACK_EXPORT
+bool logseg_append(
+    BACNET_LOG_SEGMENT *store,
+    uint32_t sequence,
+    const uint8_t *data,
+    uint16_t length);
+BACNET_STACK_EXPORT
+int logseg_read(
+    BACNET_LOG_SEGMENT *store,
+    uint32_t sequence,
+    uint8_t *buffer,
+    uint16_t buffer_size);
+BACNET_STACK_EXPORT
+uint32_t logseg_count(const BACNET_LOG_SEGMENT *store);
+BACNET_STACK_EXPORT
+uint32_t logseg_first_sequence(const BACNET_LOG_SEGMENT *store);
+BACNET_STACK_EXPORT
+uint16_t logseg_record_size_max(const BACNET_LOG_SEGMENT *store);
+
+#if defined(BACNET_LOG_SEGMENT_FILE)
+BACNET_STACK_EXPORT
+bool logseg_file_open(
+    BACNET_LOG_SEGMENT_DRIVER *driver,
+    const char *pathname,
+    uint32_t page_size,
+    uint16_t page_count);
+BACNET_STACK_EXPORT
+void logseg_file_close(BACNET_LOG_SEGMENT_DRIVER *driver);
+#endif
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
@@ -0,0 +1,177 @@
+/**
+ * @file
+ * @brief Packet buffer with reserved headroom, so that protocol headers
+ * can be prepended in front of a payload without copying it.
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+//#include "bacnet/basic/sys/pktbuf.h"
+#include "../../../bacnet/basic/sys/pktbuf.h"
+
+/**
+ * @brief Initialize an empty packet with headroom reserved at the front
+ * @param pkt - packet buffer structure
+ * @param buffer - block of memory for the packet
+ * @param size - actual size, in bytes, of the block of memory
+ * @param headroom - number of bytes to reserve for headers
+ * @return true if the packet buffer was initialized
+ */
+bool pktbuf_init(
+    BACNET_PACKET_BUFFER *pkt,
+    uint8_t *buffer,
+    uint16_t size,
+    uint16_t headroom)
+{
+    return pktbuf_attach(pkt, buffer, size, headroom, 0);
+}
+
+/**
+ * @brief Wrap packet data that already sits in a larger block of memory
+ * @param pkt - packet buffer structure
+ * @param buffer - block of memory holding the packet
+ * @param size - actual size, in bytes, of the block of memory
+ * @param offset - start of the packet data in the block
+ * @param length - number of bytes of packet data
+ * @return true if the packet buffer was initialized
+ */
+bool pktbuf_attach(
+    BACNET_PACKET_BUFFER *pkt,
+    uint8_t *buffer,
+    uint16_t size,
+    uint16_t offset,
+    uint16_t length)
+{
+    bool status = false;
+
+    if (pkt && buffer && (offset <= size) && (length <= (size - offset))) {
+        pkt->buffer = buffer;
+        pkt->size = size;
+        pkt->offset = offset;
+        pkt->length = length;
+        status = true;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Get the packet data
+ * @param pkt - packet buffer structure
+ * @return the start of the packet data, or NULL if not initialized
+ */
+uint8_t *pktbuf_data(BACNET_PACKET_BUFFER const *pkt)
+{
+    return ((pkt && pkt->buffer) ? &pkt->buffer[pkt->offset] : NULL);
+}
+
+/**
+ * @brief Get the length of the packet data
+ * @param pkt - packet buffer structure
+ * @return the number of bytes of packet data
+ */
+uint16_t pktbuf_length(BACNET_PACKET_BUFFER const *pkt)
+{
+    return (pkt ? pkt->length : 0);
+}
+
+/**
+ * @brief Get the space available in front of the packet data
+ * @param pkt - packet buffer structure
+ * @return the number of bytes of headroom
+ */
+uint16_t pktbuf_headroom(BACNET_PACKET_BUFFER const *pkt)
+{
+    return (pkt ? pkt->offset : 0);
+}
+
+/**
+ * @brief Get the space available after the packet data
+ * @param pkt - packet buffer structure
+ * @return the number of bytes of tailroom
+ */
+uint16_t pktbuf_tailroom(BACNET_PACKET_BUFFER const *pkt)
+{
+    return (pkt ? (uint16_t)(pkt->size - pkt->offset - pkt->length) : 0);
+}
+
+/**
+ * @brief Grow the packet at the front, into the headroom, so that a
+ *  header can be encoded in place.
+ * @param pkt - packet buffer structure
+ * @param len - number of bytes to add in front of the packet data
+ * @return the new start of the packet data, or NULL if not enough headroom
+ */
+uint8_t *pktbuf_push(BACNET_PACKET_BUFFER *pkt, uint16_t len)
+{
+    uint8_t *data = NULL;
+
+    if (pkt && pkt->buffer && (len <= pkt->offset)) {
+        pkt->offset -= len;
+        pkt->length += len;
+        data = &pkt->buffer[pkt->offset];
+    }
+
+    return data;
+}
+
+/**
+ * @brief Shrink the packet at the front, returning a header to headroom
+ * @param pkt - packet buffer structure
+ * @param len - number of bytes to remove from the front of the packet data
+ * @return the new start of the packet data, or NULL if the packet is shorter
+ */
+uint8_t *pktbuf_pull(BACNET_PACKET_BUFFER *pkt, uint16_t len)
+{
+    uint8_t *data = NULL;
+
+    if (pkt && pkt->buffer && (len <= pkt->length)) {
+        pkt->offset += len;
+        pkt->length -= len;
+        data = &pkt->buffer[pkt->offset];
+    }
+
+    return data;
+}
+
+/**
+ * @brief Grow the packet at the end, into the tailroom
+ * @param pkt - packet buffer structure
+ * @param len - number of bytes to add after the packet data
+ * @return the start of the added space, or NULL if not enough tailroom
+ */
+uint8_t *pktbuf_put(BACNET_PACKET_BUFFER *pkt, uint16_t len)
+{
+    uint8_t *data = NULL;
+
+    if (pkt && pkt->buffer && (len <= pktbuf_tailroom(pkt))) {
+        data = &pkt->buffer[pkt->offset + pkt->length];
+        pkt->length += len;
+    }
+
+    return data;
+}
+
+/**
+ * @brief Append a copy of some data to the end of the packet
+ * @param pkt - packet buffer structure
+ * @param data - data to append
+ * @param data_len - number of bytes of data to append
+ * @return true if there was enough tailroom for the data
+ */
+bool pktbuf_append(
+    BACNET_PACKET_BUFFER *pkt, const uint8_t *data, uint16_t data_len)
+{
+    uint8_t *tail;
+
+    tail = pktbuf_put(pkt, data_len);
+    if (tail && data && data_len) {
+        memcpy(tail, data, data_len);
+    }
+
+    return (tail != NULL);
+}
@@ -0,0 +1,78 @@
+/**
+ * @file
+ * @brief API for a packet buffer with reserved headroom, so that protocol
+ * headers can be prepended in front of a payload without copying it.
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_SYS_PKTBUF_H
+#define BACNET_SYS_PKTBUF_H
+#include <stdint.h>
+#include <stdbool.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "../../../bacnet/bacdef.h"
+
+/* The data of the packet is buffer[offset] .. buffer[offset + length - 1].
+   The octets in front of the data are the headroom, and the octets after
+   the data are the tailroom. */
+struct packet_buffer_t {
+    uint8_t *buffer; /* block of memory holding the packet */
+    uint16_t size; /* actual size, in bytes, of the block of memory */
+    uint16_t offset; /* start of the packet data in the block */
+    uint16_t length; /* number of bytes of packet data */
+};
+typedef struct packet_buffer_t BACNET_PACKET_BUFFER;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* initialize an empty packet with the given headroom */
+BACNET_STACK_EXPORT
+bool pktbuf_init(
+    BACNET_PACKET_BUFFER *pkt,
+    uint8_t *buffer,
+    uint16_t size,
+    uint16_t headroom);
+/* wrap existing packet data that sits in a larger block of memory */
+BACNET_STACK_EXPORT
+bool pktbuf_attach(
+    BACNET_PACKET_BUFFER *pkt,
+    uint8_t *buffer,
+    uint16_t size,
+    uint16_t offset,
+    uint16_t length);
+
+/* returns the packet data, or NULL if not initialized */
+BACNET_STACK_EXPORT
+uint8_t *pktbuf_data(BACNET_PACKET_BUFFER const *pkt);
+/* returns the number of bytes of packet data */
+BACNET_STACK_EXPORT
+uint16_t pktbuf_length(BACNET_PACKET_BUFFER const *pkt);
+/* returns the number of bytes available in front of the packet data */
+BACNET_STACK_EXPORT
+uint16_t pktbuf_headroom(BACNET_PACKET_BUFFER const *pkt);
+/* returns the number of bytes available after the packet data */
+BACNET_STACK_EXPORT
+uint16_t pktbuf_tailroom(BACNET_PACKET_BUFFER const *pkt);
+
+/* grows the packet at the front; returns the new start, or NULL */
+BACNET_STACK_EXPORT
+uint8_t *pktbuf_push(BACNET_PACKET_BUFFER *pkt, uint16_t len);
+/* shrinks the packet at the front; returns the new start, or NULL */
+BACNET_STACK_EXPORT
+uint8_t *pktbuf_pull(BACNET_PACKET_BUFFER *pkt, uint16_t len);
+/* grows the packet at the end; returns the added space, or NULL */
+BACNET_STACK_EXPORT
+uint8_t *pktbuf_put(BACNET_PACKET_BUFFER *pkt, uint16_t len);
+/* appends a copy of the data; returns true if there was enough room */
+BACNET_STACK_EXPORT
+bool pktbuf_append(
+    BACNET_PACKET_BUFFER *pkt, const uint8_t *data, uint16_t data_len);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
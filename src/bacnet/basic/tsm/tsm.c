@@ -9,6 +9,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 /* BACnet Stack defines - first */
 //#include "bacnet/bacdef.h"
 #include "../../../bacnet/bacdef.h"
@@ -19,6 +20,8 @@
 #include "../../../bacnet/bacaddr.h"
 //#include "bacnet/bacdcode.h"
 #include "../../../bacnet/bacdcode.h"
+//#include "bacnet/abort.h"
+#include "../../../bacnet/abort.h"
 //#include "bacnet/basic/tsm/tsm.h"
 #include "../../../bacnet/basic/tsm/tsm.h"
 //#include "bacnet/basic/sys/debug.h"
@@ -40,7 +43,21 @@ uint8_t Handler_Transmit_Buffer[MAX_PDU];
 /* If we are only a server and only initiate broadcasts, */
 /* then we don't need a TSM layer. */
 
+#if BACNET_SEGMENTATION_ENABLED
+/* octets in the header of a segmented and an unsegmented ComplexACK */
+#define SEGMENTED_COMPLEX_ACK_HEADER 5
+#define COMPLEX_ACK_HEADER 3
+/* pool of buffers, each holding one whole segmented message */
+static uint8_t Segment_Buffer[BACNET_SEGMENTATION_BUFFERS]
+                            [BACNET_SEGMENTATION_BUFFER_SIZE];
+static bool Segment_Buffer_In_Use[BACNET_SEGMENTATION_BUFFERS];
+/* segmented ComplexACKs that we send, at most one for each buffer */
+static BACNET_TSM_SEGMENT_DATA Segment_List[BACNET_SEGMENTATION_BUFFERS];
+/* one segment, SegmentACK or Abort on its way out */
+static uint8_t Segment_Transmit_Buffer[MAX_PDU];
+#else
 /* FIXME: not coded for segmentation */
+#endif
 
 /* declare space for the TSM transactions, and set it up in the init. */
 /* table rules: an Invoke ID = 0 is an unused spot in the table */
@@ -299,6 +316,543 @@ bool tsm_get_transaction_pdu(
     return found;
 }
 
+#if BACNET_SEGMENTATION_ENABLED
+/** Take a buffer for a segmented message from the pool.
+ *
+ * @return A buffer of BACNET_SEGMENTATION_BUFFER_SIZE bytes,
+ *         or NULL if all of them are in use.
+ */
+uint8_t *tsm_segment_buffer_alloc(void)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < BACNET_SEGMENTATION_BUFFERS; i++) {
+        if (!Segment_Buffer_In_Use[i]) {
+            Segment_Buffer_In_Use[i] = true;
+            return &Segment_Buffer[i][0];
+        }
+    }
+
+    return NULL;
+}
+
+/** Give a buffer back to the segment pool.
+ *
+ * @param buffer  Buffer from tsm_segment_buffer_alloc(), or NULL.
+ */
+void tsm_segment_buffer_free(const uint8_t *buffer)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < BACNET_SEGMENTATION_BUFFERS; i++) {
+        if (buffer == &Segment_Buffer[i][0]) {
+            Segment_Buffer_In_Use[i] = false;
+            break;
+        }
+    }
+}
+
+/** Send a PDU made of an APDU header and optional data.
+ *
+ * @param dest  Pointer to the BACnet destination address.
+ * @param npdu_data  Pointer to the NPDU structure.
+ * @param header  APDU header octets.
+ * @param header_len  Number of header octets.
+ * @param data  Octets that follow the header, or NULL.
+ * @param data_len  Number of data octets.
+ */
+static void tsm_segment_pdu_send(
+    BACNET_ADDRESS *dest,
+    BACNET_NPDU_DATA *npdu_data,
+    const uint8_t *header,
+    unsigned header_len,
+    const uint8_t *data,
+    unsigned data_len)
+{
+    BACNET_ADDRESS my_address;
+    int pdu_len = 0;
+    int bytes_sent = 0;
+
+    datalink_get_my_address(&my_address);
+    pdu_len = npdu_encode_pdu(
+        &Segment_Transmit_Buffer[0], dest, &my_address, npdu_data);
+    memcpy(&Segment_Transmit_Buffer[pdu_len], header, header_len);
+    pdu_len += header_len;
+    if (data && (data_len > 0)) {
+        memcpy(&Segment_Transmit_Buffer[pdu_len], data, data_len);
+        pdu_len += data_len;
+    }
+    bytes_sent = datalink_send_pdu(
+        dest, npdu_data, &Segment_Transmit_Buffer[0], pdu_len);
+    if (bytes_sent <= 0) {
+        debug_perror("TSM: Failed to send segment PDU");
+    }
+}
+
+/** Send one segment of a segmented ComplexACK.
+ *
+ * @param plist  Segmented response.
+ * @param index  Segment to send, counting from zero.
+ */
+static void tsm_segment_send(BACNET_TSM_SEGMENT_DATA *plist, uint16_t index)
+{
+    uint8_t header[SEGMENTED_COMPLEX_ACK_HEADER];
+    unsigned offset = 0;
+    unsigned data_len = 0;
+
+    offset = COMPLEX_ACK_HEADER + ((unsigned)index * plist->SegmentSize);
+    data_len = plist->apdu_len - offset;
+    header[0] = PDU_TYPE_COMPLEX_ACK | BIT(3);
+    if (data_len > plist->SegmentSize) {
+        data_len = plist->SegmentSize;
+        /* more follows */
+        header[0] |= BIT(2);
+    }
+    header[1] = plist->InvokeID;
+    /* sequence numbers count modulo 256 */
+    header[2] = (uint8_t)index;
+    header[3] = BACNET_SEGMENTATION_WINDOW_SIZE;
+    /* service choice */
+    header[4] = plist->apdu[2];
+    tsm_segment_pdu_send(
+        &plist->dest, &plist->npdu_data, header, sizeof(header),
+        &plist->apdu[offset], data_len);
+}
+
+/** Send the window of segments that starts at InitialSegment,
+ *  and start the timer that waits for its SegmentACK.
+ *
+ * @param plist  Segmented response.
+ */
+static void tsm_segment_window_send(BACNET_TSM_SEGMENT_DATA *plist)
+{
+    uint16_t index = plist->InitialSegment;
+    uint8_t count = 0;
+
+    while ((count < plist->ActualWindowSize) &&
+           (index < plist->SegmentCount)) {
+        tsm_segment_send(plist, index);
+        index++;
+        count++;
+    }
+    plist->SegmentTimer = BACNET_SEGMENTATION_TIMEOUT;
+}
+
+/** End a segmented response and give back its buffer.
+ *
+ * @param plist  Segmented response.
+ */
+static void tsm_segmented_response_free(BACNET_TSM_SEGMENT_DATA *plist)
+{
+    tsm_segment_buffer_free(plist->apdu);
+    plist->apdu = NULL;
+    plist->apdu_len = 0;
+    plist->InvokeID = 0;
+    plist->state = TSM_STATE_IDLE;
+}
+
+/** Find the segmented response to a requester.
+ *
+ * @param src  Address of the requester.
+ * @param invoke_id  Invoke ID of the request.
+ *
+ * @return The segmented response, or NULL if there is none.
+ */
+static BACNET_TSM_SEGMENT_DATA *
+tsm_segmented_response_find(const BACNET_ADDRESS *src, uint8_t invoke_id)
+{
+    unsigned i = 0;
+    BACNET_TSM_SEGMENT_DATA *plist = &Segment_List[0];
+
+    for (i = 0; i < BACNET_SEGMENTATION_BUFFERS; i++, plist++) {
+        if ((plist->state == TSM_STATE_SEGMENTED_RESPONSE) &&
+            (plist->InvokeID == invoke_id) &&
+            bacnet_address_same(&plist->dest, src)) {
+            return plist;
+        }
+    }
+
+    return NULL;
+}
+
+/** Start sending a ComplexACK that is too large for one APDU
+ *  as a segmented ComplexACK. The first segment goes out now;
+ *  the rest follow in windows as SegmentACKs arrive.
+ *
+ * @param dest  Pointer to the BACnet address of the requester.
+ * @param npdu_data  Pointer to the NPDU structure for the reply.
+ * @param service_data  The confirmed request being answered.
+ * @param apdu  The whole ComplexACK, in a buffer taken with
+ *              tsm_segment_buffer_alloc(). On success the TSM owns
+ *              the buffer and frees it when the response ends.
+ * @param apdu_len  Bytes valid in the ComplexACK.
+ *
+ * @return true if the response was started, false if the requester
+ *         cannot take it or no segmented response is free.
+ */
+bool tsm_segmented_complex_ack_send(
+    const BACNET_ADDRESS *dest,
+    const BACNET_NPDU_DATA *npdu_data,
+    const BACNET_CONFIRMED_SERVICE_DATA *service_data,
+    uint8_t *apdu,
+    uint16_t apdu_len)
+{
+    BACNET_TSM_SEGMENT_DATA *plist = NULL;
+    unsigned max_apdu = 0;
+    unsigned segment_size = 0;
+    unsigned segment_count = 0;
+    unsigned i = 0;
+
+    if (!dest || !npdu_data || !service_data || !apdu ||
+        (apdu_len <= COMPLEX_ACK_HEADER)) {
+        return false;
+    }
+    if (!service_data->segmented_response_accepted) {
+        return false;
+    }
+    max_apdu = (unsigned)service_data->max_resp;
+    if (max_apdu > MAX_APDU) {
+        max_apdu = MAX_APDU;
+    }
+    if (max_apdu <= SEGMENTED_COMPLEX_ACK_HEADER) {
+        return false;
+    }
+    segment_size = max_apdu - SEGMENTED_COMPLEX_ACK_HEADER;
+    segment_count =
+        (apdu_len - COMPLEX_ACK_HEADER + segment_size - 1) / segment_size;
+    /* zero is unspecified, and 65 is more than 64 segments */
+    if ((service_data->max_segs > 0) && (service_data->max_segs <= 64) &&
+        (segment_count > (unsigned)service_data->max_segs)) {
+        return false;
+    }
+    /* a retried request replaces the response already in progress */
+    plist = tsm_segmented_response_find(dest, service_data->invoke_id);
+    if (plist) {
+        tsm_segmented_response_free(plist);
+    } else {
+        for (i = 0; i < BACNET_SEGMENTATION_BUFFERS; i++) {
+            if (Segment_List[i].state == TSM_STATE_IDLE) {
+                plist = &Segment_List[i];
+                break;
+            }
+        }
+    }
+    if (!plist) {
+        return false;
+    }
+    plist->state = TSM_STATE_SEGMENTED_RESPONSE;
+    plist->InvokeID = service_data->invoke_id;
+    plist->SegmentRetryCount = 0;
+    plist->SegmentCount = (uint16_t)segment_count;
+    plist->SegmentSize = (uint16_t)segment_size;
+    plist->apdu = apdu;
+    plist->apdu_len = apdu_len;
+    npdu_copy_data(&plist->npdu_data, npdu_data);
+    bacnet_address_copy(&plist->dest, dest);
+    /* the first segment goes alone; the requester answers
+       with the window size that it will take */
+    plist->InitialSegment = 0;
+    plist->ActualWindowSize = 1;
+    tsm_segment_window_send(plist);
+
+    return true;
+}
+
+/** Handle a SegmentACK for a segmented response that we are sending.
+ *
+ * @param src  Pointer to the BACnet address of the sender.
+ * @param apdu  Pointer to the received SegmentACK APDU.
+ * @param apdu_len  Bytes valid in the APDU.
+ */
+void tsm_segment_ack_handler(
+    const BACNET_ADDRESS *src, const uint8_t *apdu, uint16_t apdu_len)
+{
+    BACNET_TSM_SEGMENT_DATA *plist = NULL;
+    uint8_t offset = 0;
+    uint16_t index = 0;
+    uint8_t window_size = 0;
+
+    if (!src || !apdu || (apdu_len < 4)) {
+        return;
+    }
+    if ((apdu[0] & 0xF0) != PDU_TYPE_SEGMENT_ACK) {
+        return;
+    }
+    if (apdu[0] & BIT(0)) {
+        /* sent by a server; we do not send segmented requests */
+        return;
+    }
+    plist = tsm_segmented_response_find(src, apdu[1]);
+    if (!plist) {
+        return;
+    }
+    offset = (uint8_t)(apdu[2] - (uint8_t)plist->InitialSegment);
+    if (offset >= plist->ActualWindowSize) {
+        /* a duplicate from an earlier window */
+        plist->SegmentTimer = BACNET_SEGMENTATION_TIMEOUT;
+        return;
+    }
+    index = plist->InitialSegment + offset;
+    if ((index + 1U) >= plist->SegmentCount) {
+        /* the final segment was received */
+        tsm_segmented_response_free(plist);
+        return;
+    }
+    /* a positive or negative ACK both ask for the segments after it */
+    window_size = apdu[3];
+    if (window_size == 0) {
+        window_size = 1;
+    } else if (window_size > BACNET_SEGMENTATION_WINDOW_SIZE) {
+        window_size = BACNET_SEGMENTATION_WINDOW_SIZE;
+    }
+    plist->ActualWindowSize = window_size;
+    plist->InitialSegment = index + 1;
+    plist->SegmentRetryCount = 0;
+    tsm_segment_window_send(plist);
+}
+
+/** Stop a segmented response when the requester aborts it.
+ *
+ * @param src  Pointer to the BACnet address of the requester.
+ * @param invoke_id  Invoke ID of the aborted request.
+ */
+void tsm_segmented_response_abort(
+    const BACNET_ADDRESS *src, uint8_t invoke_id)
+{
+    BACNET_TSM_SEGMENT_DATA *plist;
+
+    plist = tsm_segmented_response_find(src, invoke_id);
+    if (plist) {
+        tsm_segmented_response_free(plist);
+    }
+}
+
+/** Run the segment timers of the responses that we are sending,
+ *  sending a window again when its SegmentACK is late.
+ *
+ * @param milliseconds - Count of milliseconds passed, since the last call.
+ */
+static void tsm_segmented_response_timer(uint16_t milliseconds)
+{
+    unsigned i = 0;
+    BACNET_TSM_SEGMENT_DATA *plist = &Segment_List[0];
+
+    for (i = 0; i < BACNET_SEGMENTATION_BUFFERS; i++, plist++) {
+        if (plist->state != TSM_STATE_SEGMENTED_RESPONSE) {
+            continue;
+        }
+        if (plist->SegmentTimer > milliseconds) {
+            plist->SegmentTimer -= milliseconds;
+        } else if (plist->SegmentRetryCount < apdu_retries()) {
+            plist->SegmentRetryCount++;
+            tsm_segment_window_send(plist);
+        } else {
+            tsm_segmented_response_free(plist);
+        }
+    }
+}
+
+/** Send a SegmentACK for the segmented ComplexACK being received.
+ *
+ * @param plist  Transaction that receives the segments.
+ * @param sequence_number  Last segment received in order.
+ * @param nak  true if a segment was received out of order.
+ */
+static void tsm_segment_ack_send(
+    BACNET_TSM_DATA *plist, uint8_t sequence_number, bool nak)
+{
+    uint8_t header[4];
+    BACNET_NPDU_DATA npdu_data;
+
+    header[0] = PDU_TYPE_SEGMENT_ACK;
+    if (nak) {
+        header[0] |= BIT(1);
+    }
+    header[1] = plist->InvokeID;
+    header[2] = sequence_number;
+    header[3] = plist->ActualWindowSize;
+    npdu_encode_npdu_data(&npdu_data, false, plist->npdu_data.priority);
+    tsm_segment_pdu_send(
+        &plist->dest, &npdu_data, header, sizeof(header), NULL, 0);
+}
+
+/** Give up on the segmented ComplexACK being received.
+ *  The transaction is left IDLE with a valid invoke ID,
+ *  which marks a failed message.
+ *
+ * @param plist  Transaction that receives the segments.
+ */
+static void tsm_segmented_confirmation_fail(BACNET_TSM_DATA *plist)
+{
+    tsm_segment_buffer_free(plist->segment_buffer);
+    plist->segment_buffer = NULL;
+    plist->segment_len = 0;
+    plist->state = TSM_STATE_IDLE;
+}
+
+/** Abort the segmented ComplexACK being received.
+ *
+ * @param plist  Transaction that receives the segments.
+ * @param reason  Abort reason sent to the server.
+ */
+static void
+tsm_segmented_confirmation_abort(BACNET_TSM_DATA *plist, uint8_t reason)
+{
+    uint8_t header[3];
+    BACNET_NPDU_DATA npdu_data;
+    int len = 0;
+
+    len = abort_encode_apdu(&header[0], plist->InvokeID, reason, false);
+    npdu_encode_npdu_data(&npdu_data, false, plist->npdu_data.priority);
+    tsm_segment_pdu_send(
+        &plist->dest, &npdu_data, header, (unsigned)len, NULL, 0);
+    tsm_segmented_confirmation_fail(plist);
+}
+
+/** Add the service data of a segment to the receive buffer.
+ *
+ * @param plist  Transaction that receives the segments.
+ * @param data  Service data of the segment.
+ * @param data_len  Number of service data octets.
+ *
+ * @return true if added, false if the message was aborted.
+ */
+static bool tsm_segment_data_append(
+    BACNET_TSM_DATA *plist, const uint8_t *data, uint16_t data_len)
+{
+    if (data_len > (BACNET_SEGMENTATION_BUFFER_SIZE - plist->segment_len)) {
+        tsm_segmented_confirmation_abort(plist, ABORT_REASON_BUFFER_OVERFLOW);
+        return false;
+    }
+    memcpy(&plist->segment_buffer[plist->segment_len], data, data_len);
+    plist->segment_len += data_len;
+
+    return true;
+}
+
+/** Receive one segment of a segmented ComplexACK that answers one
+ *  of our confirmed requests, and acknowledge it as needed.
+ *
+ * @param src  Pointer to the BACnet address of the server.
+ * @param apdu  Pointer to the received ComplexACK APDU.
+ * @param apdu_len  Bytes valid in the APDU.
+ * @param service_choice  Takes the service choice of the whole message.
+ * @param service_request  Takes the service data of the whole message.
+ * @param service_request_len  Takes the length of the service data.
+ *
+ * @return true when the last segment completes the message. The service
+ *         data is valid until tsm_free_invoke_id() is called.
+ */
+bool tsm_segmented_complex_ack_receive(
+    const BACNET_ADDRESS *src,
+    const uint8_t *apdu,
+    uint16_t apdu_len,
+    uint8_t *service_choice,
+    uint8_t **service_request,
+    uint16_t *service_request_len)
+{
+    BACNET_TSM_DATA *plist = NULL;
+    uint8_t index = 0;
+    uint8_t sequence_number = 0;
+    uint8_t window_size = 0;
+    bool more_follows = false;
+    const uint8_t *data = NULL;
+    uint16_t data_len = 0;
+
+    if (!src || !apdu || (apdu_len < SEGMENTED_COMPLEX_ACK_HEADER)) {
+        return false;
+    }
+    if (((apdu[0] & 0xF0) != PDU_TYPE_COMPLEX_ACK) || !(apdu[0] & BIT(3))) {
+        return false;
+    }
+    index = tsm_find_invokeID_index(apdu[1]);
+    if (index >= MAX_TSM_TRANSACTIONS) {
+        return false;
+    }
+    plist = &TSM_List[index];
+    if (!bacnet_address_same(&plist->dest, src)) {
+        return false;
+    }
+    more_follows = (apdu[0] & BIT(2)) ? true : false;
+    sequence_number = apdu[2];
+    window_size = apdu[3];
+    data = &apdu[SEGMENTED_COMPLEX_ACK_HEADER];
+    data_len = apdu_len - SEGMENTED_COMPLEX_ACK_HEADER;
+    if (plist->state == TSM_STATE_AWAIT_CONFIRMATION) {
+        if (sequence_number != 0) {
+            tsm_segmented_confirmation_abort(
+                plist, ABORT_REASON_INVALID_APDU_IN_THIS_STATE);
+            return false;
+        }
+        if ((window_size == 0) || (window_size > 127)) {
+            tsm_segmented_confirmation_abort(
+                plist, ABORT_REASON_WINDOW_SIZE_OUT_OF_RANGE);
+            return false;
+        }
+        plist->segment_buffer = tsm_segment_buffer_alloc();
+        if (!plist->segment_buffer) {
+            tsm_segmented_confirmation_abort(
+                plist, ABORT_REASON_OUT_OF_RESOURCES);
+            return false;
+        }
+        plist->state = TSM_STATE_SEGMENTED_CONFIRMATION;
+        plist->service_choice = apdu[4];
+        plist->segment_len = 0;
+        plist->InitialSequenceNumber = 0;
+        plist->LastSequenceNumber = 0;
+        if (window_size > BACNET_SEGMENTATION_WINDOW_SIZE) {
+            window_size = BACNET_SEGMENTATION_WINDOW_SIZE;
+        }
+        plist->ActualWindowSize = window_size;
+        if (!tsm_segment_data_append(plist, data, data_len)) {
+            return false;
+        }
+        /* the first segment is acknowledged at once,
+           which tells the server our window size */
+        tsm_segment_ack_send(plist, 0, false);
+    } else if (plist->state == TSM_STATE_SEGMENTED_CONFIRMATION) {
+        plist->SegmentTimer = BACNET_SEGMENTATION_TIMEOUT * 4;
+        if (sequence_number != (uint8_t)(plist->LastSequenceNumber + 1)) {
+            /* out of order: ask again for the segments after
+               the last one received in order */
+            tsm_segment_ack_send(plist, plist->LastSequenceNumber, true);
+            plist->InitialSequenceNumber = plist->LastSequenceNumber;
+            return false;
+        }
+        if (!tsm_segment_data_append(plist, data, data_len)) {
+            return false;
+        }
+        plist->LastSequenceNumber = sequence_number;
+        if (!more_follows) {
+            tsm_segment_ack_send(plist, sequence_number, false);
+        } else if (
+            sequence_number ==
+            (uint8_t)(plist->InitialSequenceNumber +
+                      plist->ActualWindowSize)) {
+            tsm_segment_ack_send(plist, sequence_number, false);
+            plist->InitialSequenceNumber = sequence_number;
+        }
+    } else {
+        return false;
+    }
+    plist->SegmentTimer = BACNET_SEGMENTATION_TIMEOUT * 4;
+    if (more_follows) {
+        return false;
+    }
+    if (service_choice) {
+        *service_choice = plist->service_choice;
+    }
+    if (service_request) {
+        *service_request = plist->segment_buffer;
+    }
+    if (service_request_len) {
+        *service_request_len = plist->segment_len;
+    }
+
+    return true;
+}
+#endif
+
 /** Called once a millisecond or slower.
  *  This function calls the handler for a
  *  timeout 'Timeout_Function', if necessary.
@@ -346,8 +900,23 @@ void tsm_timer_milliseconds(uint16_t milliseconds)
                     }
                 }
             }
+#if BACNET_SEGMENTATION_ENABLED
+        } else if (plist->state == TSM_STATE_SEGMENTED_CONFIRMATION) {
+            if (plist->SegmentTimer > milliseconds) {
+                plist->SegmentTimer -= milliseconds;
+            } else {
+                /* no segment for 4 x Tseg: the response has failed */
+                tsm_segmented_confirmation_fail(plist);
+                if (Timeout_Function) {
+                    Timeout_Function(plist->InvokeID);
+                }
+            }
+#endif
         }
     }
+#if BACNET_SEGMENTATION_ENABLED
+    tsm_segmented_response_timer(milliseconds);
+#endif
 }
 
 /** Frees the invokeID and sets its state to IDLE
@@ -364,6 +933,11 @@ void tsm_free_invoke_id(uint8_t invokeID)
         plist = &TSM_List[index];
         plist->state = TSM_STATE_IDLE;
         plist->InvokeID = 0;
+#if BACNET_SEGMENTATION_ENABLED
+        tsm_segment_buffer_free(plist->segment_buffer);
+        plist->segment_buffer = NULL;
+        plist->segment_len = 0;
+#endif
     }
 }
 
@@ -17,6 +17,8 @@
 /* BACnet Stack API */
 //#include "bacnet/npdu.h"
 #include "../../../bacnet/npdu.h"
+//#include "bacnet/apdu.h"
+#include "../../../bacnet/apdu.h"
 
 /* note: TSM functionality is optional - only needed if we are
    doing client requests */
@@ -32,6 +34,14 @@ BACNET_STACK_EXPORT extern uint8_t Handler_Transmit_Buffer[MAX_PDU];
 }
 #endif /* __cplusplus */
 
+/* segmentation that we support, for I-Am and the Device object:
+   the TSM sends segmented ComplexACKs but not segmented requests */
+#if BACNET_SEGMENTATION_ENABLED && (MAX_TSM_TRANSACTIONS)
+#define TSM_SEGMENTATION_SUPPORTED SEGMENTATION_TRANSMIT
+#else
+#define TSM_SEGMENTATION_SUPPORTED SEGMENTATION_NONE
+#endif
+
 #if (!MAX_TSM_TRANSACTIONS)
 #define tsm_free_invoke_id(x) (void)x;
 #else
@@ -40,7 +50,8 @@ typedef enum {
     TSM_STATE_AWAIT_CONFIRMATION,
     TSM_STATE_AWAIT_RESPONSE,
     TSM_STATE_SEGMENTED_REQUEST,
-    TSM_STATE_SEGMENTED_CONFIRMATION
+    TSM_STATE_SEGMENTED_CONFIRMATION,
+    TSM_STATE_SEGMENTED_RESPONSE
 } BACNET_TSM_STATE;
 
 /* 5.4.1 Variables And Parameters */
@@ -53,17 +64,24 @@ typedef struct BACnet_TSM_Data {
     /*uint8_t SegmentRetryCount;  */
     /* used to control APDU retries and the acceptance of server replies */
     /*bool SentAllSegments;  */
+    /* stores the window size proposed by the segment sender */
+    /*uint8_t ProposedWindowSize;  */
+#if BACNET_SEGMENTATION_ENABLED
     /* stores the sequence number of the last segment received in order */
-    /*uint8_t LastSequenceNumber; */
+    uint8_t LastSequenceNumber;
     /* stores the sequence number of the first segment of */
     /* a sequence of segments that fill a window */
-    /*uint8_t InitialSequenceNumber; */
+    uint8_t InitialSequenceNumber;
     /* stores the current window size */
-    /*uint8_t ActualWindowSize; */
-    /* stores the window size proposed by the segment sender */
-    /*uint8_t ProposedWindowSize;  */
-    /*  used to perform timeout on PDU segments */
-    /*uint8_t SegmentTimer; */
+    uint8_t ActualWindowSize;
+    /*  used to perform timeout on PDU segments, in milliseconds */
+    uint16_t SegmentTimer;
+    /* service choice of the segmented ComplexACK being received */
+    uint8_t service_choice;
+    /* pool buffer that collects the service data of the segments */
+    uint8_t *segment_buffer;
+    uint16_t segment_len;
+#endif
     /* used to perform timeout on Confirmed Requests */
     /* in milliseconds */
     uint16_t RequestTimer;
@@ -80,6 +98,37 @@ typedef struct BACnet_TSM_Data {
     unsigned apdu_len;
 } BACNET_TSM_DATA;
 
+#if BACNET_SEGMENTATION_ENABLED
+/* A segmented ComplexACK that we send in reply to a confirmed request.
+   The requester chose the invoke ID, so these are kept apart from the
+   transactions that we initiate. */
+typedef struct BACnet_TSM_Segment_Data {
+    /* used to count segment retries */
+    uint8_t SegmentRetryCount;
+    /* index of the first segment of the window being sent */
+    uint16_t InitialSegment;
+    /* stores the current window size */
+    uint8_t ActualWindowSize;
+    /*  used to perform timeout on PDU segments, in milliseconds */
+    uint16_t SegmentTimer;
+    /* number of segments in the message */
+    uint16_t SegmentCount;
+    /* octets of service data carried by each segment */
+    uint16_t SegmentSize;
+    /* invoke ID of the request */
+    uint8_t InvokeID;
+    /* IDLE or SEGMENTED_RESPONSE */
+    BACNET_TSM_STATE state;
+    /* the address we send it to */
+    BACNET_ADDRESS dest;
+    /* the network layer info */
+    BACNET_NPDU_DATA npdu_data;
+    /* the whole ComplexACK, in a buffer from the segment pool */
+    uint8_t *apdu;
+    uint16_t apdu_len;
+} BACNET_TSM_SEGMENT_DATA;
+#endif
+
 typedef void (*tsm_timeout_function)(uint8_t invoke_id);
 
 #ifdef __cplusplus
@@ -125,6 +174,34 @@ bool tsm_invoke_id_free(uint8_t invokeID);
 BACNET_STACK_EXPORT
 bool tsm_invoke_id_failed(uint8_t invokeID);
 
+#if BACNET_SEGMENTATION_ENABLED
+BACNET_STACK_EXPORT
+uint8_t *tsm_segment_buffer_alloc(void);
+BACNET_STACK_EXPORT
+void tsm_segment_buffer_free(const uint8_t *buffer);
+BACNET_STACK_EXPORT
+bool tsm_segmented_complex_ack_send(
+    const BACNET_ADDRESS *dest,
+    const BACNET_NPDU_DATA *npdu_data,
+    const BACNET_CONFIRMED_SERVICE_DATA *service_data,
+    uint8_t *apdu,
+    uint16_t apdu_len);
+BACNET_STACK_EXPORT
+void tsm_segment_ack_handler(
+    const BACNET_ADDRESS *src, const uint8_t *apdu, uint16_t apdu_len);
+BACNET_STACK_EXPORT
+void tsm_segmented_response_abort(
+    const BACNET_ADDRESS *src, uint8_t invoke_id);
+BACNET_STACK_EXPORT
+bool tsm_segmented_complex_ack_receive(
+    const BACNET_ADDRESS *src,
+    const uint8_t *apdu,
+    uint16_t apdu_len,
+    uint8_t *service_choice,
+    uint8_t **service_request,
+    uint16_t *service_request_len);
+#endif
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -10,6 +10,9 @@
 
 /* Arduino configuration - use only MS/TP datalink with minimal RAM */
 #if defined(ARDUINO)
+/* board tier and the feature switches of each tier, shared with the C++
+   library so that both are built with the same features */
+#include "../BACnetBoard.h"
 #if !defined(BACDL_MSTP)
 #define BACDL_MSTP 1
 #endif
@@ -185,6 +188,242 @@
 #if !defined(MAX_TSM_TRANSACTIONS)
 #define MAX_TSM_TRANSACTIONS 3
 #endif
+/* Cache of encoded ReadProperty values for properties that seldom
+   change, used by the ReadProperty and ReadPropertyMultiple handlers.
+   Values longer than BACNET_RP_CACHE_VALUE_SIZE are not cached. */
+#if !defined(BACNET_RP_CACHE_ENABLED)
+#define BACNET_RP_CACHE_ENABLED 0
+#endif
+#if BACNET_RP_CACHE_ENABLED
+#if !defined(BACNET_RP_CACHE_ENTRIES)
+#define BACNET_RP_CACHE_ENTRIES 32
+#endif
+#if !defined(BACNET_RP_CACHE_VALUE_SIZE)
+#define BACNET_RP_CACHE_VALUE_SIZE 64
+#endif
+#if (BACNET_RP_CACHE_VALUE_SIZE > 255)
+#error "BACNET_RP_CACHE_VALUE_SIZE must fit in 8 bits"
+#endif
+#endif
+
+/* Index from object name to object identifier, used by Who-Has and by
+   the name uniqueness check of WriteProperty instead of reading the name
+   of every object.  BACNET_OBJECT_NAME_INDEX_SIZE is a power of two, at
+   least twice the number of objects in the device. */
+#if !defined(BACNET_OBJECT_NAME_INDEX_ENABLED)
+#define BACNET_OBJECT_NAME_INDEX_ENABLED 0
+#endif
+#if BACNET_OBJECT_NAME_INDEX_ENABLED
+#if !defined(BACNET_OBJECT_NAME_INDEX_SIZE)
+#define BACNET_OBJECT_NAME_INDEX_SIZE 256
+#endif
+#if (BACNET_OBJECT_NAME_INDEX_SIZE & (BACNET_OBJECT_NAME_INDEX_SIZE - 1))
+#error "BACNET_OBJECT_NAME_INDEX_SIZE must be a power of two"
+#endif
+#endif
+
+/* Fixed point sRGB to and from CIE xy and color temperature conversions
+   in basic/sys/color_rgb.c, with a gamma lookup table in place of pow(),
+   for processors that do floating point math in software. */
+#if !defined(BACNET_COLOR_RGB_FIXED_POINT)
+#define BACNET_COLOR_RGB_FIXED_POINT 0
+#endif
+
+/* Outbox for event notifications from the Notification Class objects.
+   Each notification is encoded once for all of its recipients, and
+   confirmed notifications wait in the outbox until a TSM transaction is
+   free and the recipient is bound, instead of being lost.  A failed
+   delivery is tried again after BACNET_EVENT_OUTBOX_BACKOFF milliseconds,
+   doubling up to BACNET_EVENT_OUTBOX_BACKOFF_MAX, up to
+   BACNET_EVENT_OUTBOX_RETRIES times. */
+#if !defined(BACNET_EVENT_OUTBOX_ENABLED)
+#define BACNET_EVENT_OUTBOX_ENABLED 0
+#endif
+#if BACNET_EVENT_OUTBOX_ENABLED
+/* notifications held at once, and the size of each encoded request */
+#if !defined(BACNET_EVENT_OUTBOX_MESSAGES)
+#define BACNET_EVENT_OUTBOX_MESSAGES 4
+#endif
+#if !defined(BACNET_EVENT_OUTBOX_MESSAGE_SIZE)
+#define BACNET_EVENT_OUTBOX_MESSAGE_SIZE 192
+#endif
+/* confirmed notifications queued at once, to all recipients */
+#if !defined(BACNET_EVENT_OUTBOX_DELIVERIES)
+#define BACNET_EVENT_OUTBOX_DELIVERIES 16
+#endif
+#if !defined(BACNET_EVENT_OUTBOX_RETRIES)
+#define BACNET_EVENT_OUTBOX_RETRIES 8
+#endif
+#if !defined(BACNET_EVENT_OUTBOX_BACKOFF)
+#define BACNET_EVENT_OUTBOX_BACKOFF 1000
+#endif
+#if !defined(BACNET_EVENT_OUTBOX_BACKOFF_MAX)
+#define BACNET_EVENT_OUTBOX_BACKOFF_MAX 30000
+#endif
+#if (!MAX_TSM_TRANSACTIONS)
+#error "BACNET_EVENT_OUTBOX_ENABLED requires MAX_TSM_TRANSACTIONS"
+#endif
+#if (BACNET_EVENT_OUTBOX_MESSAGES > 255) || \
+    (BACNET_EVENT_OUTBOX_DELIVERIES > 255)
+#error "BACNET_EVENT_OUTBOX_MESSAGES and _DELIVERIES must fit in 8 bits"
+#endif
+#if (BACNET_EVENT_OUTBOX_BACKOFF_MAX > 65535)
+#error "BACNET_EVENT_OUTBOX_BACKOFF_MAX must fit in 16 bits"
+#endif
+#endif
+
+/* Change-driven intrinsic reporting in basic/object/event_engine.c.  An
+   object is evaluated when its value or event configuration changes, or
+   when a time delay runs out, instead of by Device_local_reporting()
+   every second, and GetEventInformation and GetAlarmSummary read a list
+   of the objects with an active event.  BACNET_EVENT_ENGINE_OBJECTS is
+   the number of objects that can be tracked, and
+   BACNET_EVENT_ENGINE_TYPES the number of object types. */
+#if !defined(BACNET_EVENT_ENGINE_ENABLED)
+#define BACNET_EVENT_ENGINE_ENABLED 0
+#endif
+#if BACNET_EVENT_ENGINE_ENABLED
+#if !defined(BACNET_EVENT_ENGINE_OBJECTS)
+#define BACNET_EVENT_ENGINE_OBJECTS 32
+#endif
+#if !defined(BACNET_EVENT_ENGINE_TYPES)
+#define BACNET_EVENT_ENGINE_TYPES 4
+#endif
+#if (BACNET_EVENT_ENGINE_OBJECTS > 65534)
+#error "BACNET_EVENT_ENGINE_OBJECTS must fit in 16 bits"
+#endif
+#endif
+
+/* dlmstp.c ships as dlmstp.c.disabled and no MS/TP datalink is built in
+   this tree, so nothing runs the MS/TP node state machines.  Define
+   BACNET_DLMSTP_ENABLED to 1 when the application builds dlmstp.c; the
+   MS/TP switches below only do something then, and the board tiers in
+   BACnetBoard.h turn them on only then. */
+#if !defined(BACNET_DLMSTP_ENABLED)
+#define BACNET_DLMSTP_ENABLED 0
+#endif
+
+/* Adaptive Poll For Master in the MS/TP master node state machine.  The
+   port keeps a map of the master nodes heard on the link and of the
+   addresses that did not reply to a Poll For Master.  An address known
+   to be empty is polled only once every 2^n maintenance cycles, where n
+   grows by one after each such cycle up to
+   BACNET_MSTP_ADAPTIVE_POLL_BACKOFF_MAX and goes back to zero when a new
+   master is heard.  MSTP_Max_Master_Suggested() gives the highest master
+   address seen, as a tighter value for Max_Master.  The back-off is in
+   mstp.c but only dlmstp.c runs that state machine, and
+   dlmstp_max_master_suggested() lives in dlmstp.c, so none of this does
+   anything until BACNET_DLMSTP_ENABLED. */
+#if !defined(BACNET_MSTP_ADAPTIVE_POLL_ENABLED)
+#define BACNET_MSTP_ADAPTIVE_POLL_ENABLED 0
+#endif
+#if BACNET_MSTP_ADAPTIVE_POLL_ENABLED
+#if !defined(BACNET_MSTP_ADAPTIVE_POLL_BACKOFF_MAX)
+#define BACNET_MSTP_ADAPTIVE_POLL_BACKOFF_MAX 5
+#endif
+#if (BACNET_MSTP_ADAPTIVE_POLL_BACKOFF_MAX > 7)
+#error "BACNET_MSTP_ADAPTIVE_POLL_BACKOFF_MAX must be 7 or less"
+#endif
+#endif
+
+/* Dynamic Max_Info_Frames in the MS/TP master node state machine.  When
+   the node receives the token, it may send as many frames as are waiting
+   in its send queue, up to BACNET_MSTP_INFO_FRAMES_CAP, instead of
+   Nmax_info_frames; with a shallow or empty queue it sends at most
+   Nmax_info_frames as before.  The cap bounds how long a busy node holds
+   the token, so that the other nodes get their share of the link.  Only
+   the budget is in mstp.c; the SendQueueDepth callback that feeds it,
+   the queue wait statistics, and the 4 PDU send queue are all in
+   dlmstp.c, so the feature is dead until BACNET_DLMSTP_ENABLED. */
+#if !defined(BACNET_MSTP_DYNAMIC_INFO_FRAMES_ENABLED)
+#define BACNET_MSTP_DYNAMIC_INFO_FRAMES_ENABLED 0
+#endif
+#if BACNET_MSTP_DYNAMIC_INFO_FRAMES_ENABLED
+#if !defined(BACNET_MSTP_INFO_FRAMES_CAP)
+#define BACNET_MSTP_INFO_FRAMES_CAP 4
+#endif
+#if (BACNET_MSTP_INFO_FRAMES_CAP < 1) || (BACNET_MSTP_INFO_FRAMES_CAP > 255)
+#error "BACNET_MSTP_INFO_FRAMES_CAP must be 1 to 255"
+#endif
+#endif
+
+/* Transmit queue with classes in dlmstp.c: replies to confirmed requests
+   are sent before anything else, and confirmed requests, unconfirmed
+   unicasts such as COV notifications, and broadcasts share the token by
+   weight, so that a burst of notifications or I-Am cannot hold back a
+   ComplexACK until the client gives up.  Urgent and higher priority
+   messages go with the confirmed requests.  The classes share the
+   DLMSTP_MAX_INFO_FRAMES PDU buffers; see dlmstp.h for the weights,
+   limits, and drop policy of each class.  The whole queue is in
+   dlmstp.c, so it is dead until BACNET_DLMSTP_ENABLED. */
+#if !defined(BACNET_MSTP_PRIORITY_QUEUE_ENABLED)
+#define BACNET_MSTP_PRIORITY_QUEUE_ENABLED 0
+#endif
+
+/* MS/TP link statistics: frames received and sent by frame type, header
+   and data CRC errors, aborted frames, token retries, reply timeouts,
+   postponed and late replies, and Poll For Master cycles, with
+   histograms of token rotation time and reply latency.  dlmstp.c
+   publishes them as tables and a compact dump, and the Network Port
+   object as proprietary properties of an MS/TP port. */
+#if !defined(BACNET_MSTP_STATISTICS_ENABLED)
+#define BACNET_MSTP_STATISTICS_ENABLED 0
+#endif
+
+/* Fast answer of simple ReadProperty requests on MS/TP.  When a Data
+   Expecting Reply frame arrives, dlmstp offers it to a hook before it is
+   handed to the application; fast_reply_handler() answers a ReadProperty
+   of Present_Value, Status_Flags or Object_Name from a table of encoded
+   values that the object modules keep current, so the reply goes out
+   within Treply_delay instead of after a Reply Postponed frame.  Values
+   longer than BACNET_FAST_REPLY_VALUE_SIZE, and properties that do not
+   fit in the BACNET_FAST_REPLY_ENTRIES table, take the normal path. */
+#if !defined(BACNET_MSTP_FAST_REPLY_ENABLED)
+#define BACNET_MSTP_FAST_REPLY_ENABLED 0
+#endif
+#if BACNET_MSTP_FAST_REPLY_ENABLED
+#if !defined(BACNET_FAST_REPLY_ENTRIES)
+#define BACNET_FAST_REPLY_ENTRIES 16
+#endif
+#if !defined(BACNET_FAST_REPLY_VALUE_SIZE)
+#define BACNET_FAST_REPLY_VALUE_SIZE 32
+#endif
+#if (BACNET_FAST_REPLY_VALUE_SIZE > 255)
+#error "BACNET_FAST_REPLY_VALUE_SIZE must fit in 8 bits"
+#endif
+#endif
+
+/* Segmented ComplexACK transmit and receive in the TSM, so that a reply
+   larger than one APDU (a whole Object_List, a large RPM) can be sent
+   or received in one transaction.  Each segmented message in progress
+   holds one buffer from a pool of BACNET_SEGMENTATION_BUFFERS buffers,
+   each BACNET_SEGMENTATION_BUFFER_SIZE bytes. */
+#if !defined(BACNET_SEGMENTATION_ENABLED)
+#define BACNET_SEGMENTATION_ENABLED 0
+#endif
+#if BACNET_SEGMENTATION_ENABLED
+/* number of segments we propose to send, or accept, per SegmentACK */
+#if !defined(BACNET_SEGMENTATION_WINDOW_SIZE)
+#define BACNET_SEGMENTATION_WINDOW_SIZE 4
+#endif
+#if !defined(BACNET_SEGMENTATION_BUFFERS)
+#define BACNET_SEGMENTATION_BUFFERS 2
+#endif
+#if !defined(BACNET_SEGMENTATION_BUFFER_SIZE)
+#define BACNET_SEGMENTATION_BUFFER_SIZE (MAX_APDU * 8)
+#endif
+/* Tseg: time to wait for a SegmentACK, in milliseconds */
+#if !defined(BACNET_SEGMENTATION_TIMEOUT)
+#define BACNET_SEGMENTATION_TIMEOUT 2000
+#endif
+#if (BACNET_SEGMENTATION_WINDOW_SIZE < 1) || \
+    (BACNET_SEGMENTATION_WINDOW_SIZE > 127)
+#error "BACNET_SEGMENTATION_WINDOW_SIZE must be 1..127"
+#endif
+#if (BACNET_SEGMENTATION_BUFFER_SIZE > 65535)
+#error "BACNET_SEGMENTATION_BUFFER_SIZE must fit in 16 bits"
+#endif
+#endif
 /* The address cache is used for binding to BACnet devices */
 /* The number of entries corresponds to the number of */
 /* devices that might respond to an I-Am on the network. */
@@ -6,6 +6,7 @@
  * @copyright SPDX-License-Identifier: GPL-2.0-or-later WITH GCC-exception-2.0
  */
 #include <stdint.h>
+#include <string.h>
 /* BACnet Stack defines - first */
 //#include "bacnet/bacdef.h"
 #include "bacdef.h"
@@ -25,6 +26,82 @@ COV Notification
 Unconfirmed COV Notification
 */
 
+/**
+ * @brief Determine if a list of values starts with the Present_Value REAL
+ *  and Status_Flags pair that most objects report, so that it can be
+ *  encoded from a fixed layout
+ * @param value  first value in the list
+ * @return true if the first two values have the fixed layout
+ */
+static bool cov_value_list_real_fixed(const BACNET_PROPERTY_VALUE *value)
+{
+    const BACNET_PROPERTY_VALUE *flags;
+
+    if (!value || !value->next) {
+        return false;
+    }
+    flags = value->next;
+    if ((value->propertyIdentifier != PROP_PRESENT_VALUE) ||
+        (value->propertyArrayIndex != BACNET_ARRAY_ALL) ||
+        (value->priority != BACNET_NO_PRIORITY) ||
+        value->value.context_specific ||
+        (value->value.tag != BACNET_APPLICATION_TAG_REAL) ||
+        (value->value.next != NULL)) {
+        return false;
+    }
+    if ((flags->propertyIdentifier != PROP_STATUS_FLAGS) ||
+        (flags->propertyArrayIndex != BACNET_ARRAY_ALL) ||
+        (flags->priority != BACNET_NO_PRIORITY) ||
+        flags->value.context_specific ||
+        (flags->value.tag != BACNET_APPLICATION_TAG_BIT_STRING) ||
+        (flags->value.next != NULL) ||
+        (bitstring_bits_used(&flags->value.type.Bit_String) != 4)) {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Encode the Present_Value REAL and Status_Flags pair from a fixed
+ *  layout, patching only the value and the flags. The result is the same
+ *  as bacapp_property_value_encode() of each value.
+ * @param apdu  Pointer to the buffer, or NULL for length
+ * @param value  first value in the list
+ * @return number of bytes encoded
+ */
+static int cov_value_list_real_encode(
+    uint8_t *apdu, const BACNET_PROPERTY_VALUE *value)
+{
+    static const uint8_t layout[] = {
+        BACNET_CONTEXT_TAG_OCTET(0, 1),
+        PROP_PRESENT_VALUE,
+        BACNET_OPENING_TAG_OCTET(2),
+        BACNET_APPLICATION_TAG_OCTET(BACNET_APPLICATION_TAG_REAL, 4),
+        0,
+        0,
+        0,
+        0,
+        BACNET_CLOSING_TAG_OCTET(2),
+        BACNET_CONTEXT_TAG_OCTET(0, 1),
+        PROP_STATUS_FLAGS,
+        BACNET_OPENING_TAG_OCTET(2),
+        BACNET_APPLICATION_TAG_OCTET(BACNET_APPLICATION_TAG_BIT_STRING, 2),
+        4, /* unused bits */
+        0,
+        BACNET_CLOSING_TAG_OCTET(2)
+    };
+
+    if (apdu) {
+        memcpy(apdu, layout, sizeof(layout));
+        encode_bacnet_real(value->value.type.Real, &apdu[4]);
+        apdu[14] = bacnet_byte_reverse_bits(
+            bitstring_octet(&value->next->value.type.Bit_String, 0));
+    }
+
+    return sizeof(layout);
+}
+
 /**
  * @brief Encode APDU for COV Notification.
  * @param apdu  Pointer to the buffer, or NULL for length
@@ -75,6 +152,14 @@ int cov_notify_encode_apdu(uint8_t *apdu, const BACNET_COV_DATA *data)
     }
     /* the first value includes a pointer to the next value, etc */
     value = data->listOfValues;
+    if (cov_value_list_real_fixed(value)) {
+        len = cov_value_list_real_encode(apdu, value);
+        apdu_len += len;
+        if (apdu) {
+            apdu += len;
+        }
+        value = value->next->next;
+    }
     while (value != NULL) {
         len = bacapp_property_value_encode(apdu, value);
         apdu_len += len;
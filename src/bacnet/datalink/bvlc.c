@@ -1101,6 +1101,41 @@ int bvlc_encode_forwarded_npdu(
     return bytes_encoded;
 }
 
+/**
+ * @brief Encode only the BVLC Forwarded-NPDU header, for an NPDU that is
+ *  already in place directly after the header, such as in the headroom
+ *  of a packet buffer.
+ *
+ * @param pdu - buffer to store the encoding, at least
+ *  BVLC_FORWARDED_NPDU_HEADER_LEN octets in front of the NPDU
+ * @param pdu_size - size of the buffer to store the header encoding
+ * @param bip_address - Original-Source-B/IPv4-Address
+ * @param npdu_len - size of the BACnet NPDU that follows the header
+ *
+ * @return number of bytes encoded
+ */
+int bvlc_encode_forwarded_npdu_header(
+    uint8_t *pdu,
+    uint16_t pdu_size,
+    const BACNET_IP_ADDRESS *bip_address,
+    uint16_t npdu_len)
+{
+    int bytes_encoded = 0;
+    uint16_t length = BVLC_FORWARDED_NPDU_HEADER_LEN;
+
+    if (pdu && (pdu_size >= length) &&
+        (npdu_len <= (UINT16_MAX - BVLC_FORWARDED_NPDU_HEADER_LEN))) {
+        bytes_encoded = bvlc_encode_header(
+            pdu, pdu_size, BVLC_FORWARDED_NPDU, length + npdu_len);
+        if (bytes_encoded == 4) {
+            bvlc_encode_address(&pdu[4], pdu_size - 4, bip_address);
+            bytes_encoded = (int)length;
+        }
+    }
+
+    return bytes_encoded;
+}
+
 /**
  * @brief Decode the BVLC Forwarded-NPDU message, after decoded header
  *
@@ -79,6 +79,8 @@ typedef struct BACnet_IP_Address {
 } BACNET_IP_ADDRESS;
 /* number of bytes in the B/IPv4 address */
 #define BIP_ADDRESS_MAX 6
+/* number of bytes in front of the NPDU in a Forwarded-NPDU */
+#define BVLC_FORWARDED_NPDU_HEADER_LEN (4 + BIP_ADDRESS_MAX)
 
 /**
  * BACnet IPv4 Broadcast Distribution Mask
@@ -512,6 +514,13 @@ int bvlc_encode_forwarded_npdu(
     const uint8_t *npdu,
     uint16_t npdu_len);
 
+BACNET_STACK_EXPORT
+int bvlc_encode_forwarded_npdu_header(
+    uint8_t *pdu,
+    uint16_t pdu_size,
+    const BACNET_IP_ADDRESS *address,
+    uint16_t npdu_len);
+
 BACNET_STACK_EXPORT
 int bvlc_decode_forwarded_npdu(
     const uint8_t *pdu,
@@ -117,3 +117,41 @@ uint16_t CRC_Calc_Data(uint8_t dataValue, uint16_t crcValue)
         (crcLow >> 4) ^ (crcLow & 0x0f) ^ ((crcLow & 0x0f) << 7);
 }
 #endif
+
+/**
+ * @brief Accumulate a block of octets into a header CRC
+ * @param data - octets to accumulate
+ * @param length - number of octets
+ * @param crcValue - CRC so far
+ * @return updated CRC
+ */
+uint8_t
+CRC_Calc_Header_Block(const uint8_t *data, size_t length, uint8_t crcValue)
+{
+    while (length > 0) {
+        crcValue = CRC_Calc_Header(*data, crcValue);
+        data++;
+        length--;
+    }
+
+    return crcValue;
+}
+
+/**
+ * @brief Accumulate a block of octets into a data CRC
+ * @param data - octets to accumulate
+ * @param length - number of octets
+ * @param crcValue - CRC so far
+ * @return updated CRC
+ */
+uint16_t
+CRC_Calc_Data_Block(const uint8_t *data, size_t length, uint16_t crcValue)
+{
+    while (length > 0) {
+        crcValue = CRC_Calc_Data(*data, crcValue);
+        data++;
+        length--;
+    }
+
+    return crcValue;
+}
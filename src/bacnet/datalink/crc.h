@@ -24,6 +24,12 @@ BACNET_STACK_EXPORT
 uint8_t CRC_Calc_Header(uint8_t dataValue, uint8_t crcValue);
 BACNET_STACK_EXPORT
 uint16_t CRC_Calc_Data(uint8_t dataValue, uint16_t crcValue);
+BACNET_STACK_EXPORT
+uint8_t
+CRC_Calc_Header_Block(const uint8_t *data, size_t length, uint8_t crcValue);
+BACNET_STACK_EXPORT
+uint16_t
+CRC_Calc_Data_Block(const uint8_t *data, size_t length, uint16_t crcValue);
 
 #ifdef __cplusplus
 }
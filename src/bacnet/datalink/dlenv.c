@@ -270,6 +270,7 @@ static int bbmd_register_as_foreign_device(void)
                 bdt_table = bvlc_bdt_list();
                 bvlc_broadcast_distribution_table_entry_append(
                     bdt_table, &BBMD_Table_Entry);
+                bvlc_bdt_list_changed();
                 if (Datalink_Debug) {
                     fprintf(
                         stderr, "BBMD %4u: %u.%u.%u.%u:%u %u.%u.%u.%u\n",
@@ -29,12 +29,81 @@
 #define DLMSTP_HEADER_MAX (2 + 1 + 1 + 1 + 2 + 1 + 2)
 #define DLMSTP_MPDU_MAX (DLMSTP_HEADER_MAX + MAX_PDU)
 
+#if BACNET_MSTP_PRIORITY_QUEUE_ENABLED
+/* transmit queue classes, from the highest priority: replies to
+   confirmed requests are always sent first, and the other classes
+   share the token by weight; the queue is implemented only in
+   dlmstp.c, which ships disabled */
+#define DLMSTP_QUEUE_REPLY 0
+#define DLMSTP_QUEUE_CONFIRMED 1
+#define DLMSTP_QUEUE_UNCONFIRMED 2
+#define DLMSTP_QUEUE_BROADCAST 3
+#define DLMSTP_QUEUE_CLASSES 4
+/* marks the end of a list of PDU buffers */
+#define DLMSTP_QUEUE_NONE 255
+#endif
+
+#if BACNET_MSTP_STATISTICS_ENABLED
+/* slots of the frame type counters: the standard frame types 0 to 7,
+   then the COBS encoded frame types 32 to 127, then any other type */
+#define DLMSTP_FRAME_TYPE_EXTENDED 8
+#define DLMSTP_FRAME_TYPE_OTHER 9
+#define DLMSTP_FRAME_TYPES 10
+/* buckets of the timing histograms: below 5, 10, 20, 50, 100, 200 and
+   500 milliseconds, and the rest */
+#define DLMSTP_HISTOGRAM_BUCKETS 8
+/* version of the layout of dlmstp_statistics_encode() */
+#define DLMSTP_STATISTICS_VERSION 1
+
+/* the tables of link statistics, each a list of unsigned values */
+typedef enum dlmstp_statistics_table {
+    DLMSTP_STATISTICS_COUNTERS = 0,
+    DLMSTP_STATISTICS_RECEIVE_FRAME_TYPES = 1,
+    DLMSTP_STATISTICS_TRANSMIT_FRAME_TYPES = 2,
+    DLMSTP_STATISTICS_TOKEN_ROTATION = 3,
+    DLMSTP_STATISTICS_REPLY_LATENCY = 4,
+    DLMSTP_STATISTICS_TABLES = 5
+} DLMSTP_STATISTICS_TABLE;
+
+/* the values of the DLMSTP_STATISTICS_COUNTERS table */
+typedef enum dlmstp_counter {
+    DLMSTP_COUNTER_TRANSMIT_FRAME = 0,
+    DLMSTP_COUNTER_RECEIVE_VALID_FRAME = 1,
+    DLMSTP_COUNTER_RECEIVE_INVALID_FRAME = 2,
+    DLMSTP_COUNTER_RECEIVE_NOT_FOR_US = 3,
+    DLMSTP_COUNTER_TRANSMIT_PDU = 4,
+    DLMSTP_COUNTER_RECEIVE_PDU = 5,
+    DLMSTP_COUNTER_LOST_TOKEN = 6,
+    DLMSTP_COUNTER_POLL_FOR_MASTER = 7,
+    DLMSTP_COUNTER_HEADER_CRC_ERROR = 8,
+    DLMSTP_COUNTER_DATA_CRC_ERROR = 9,
+    DLMSTP_COUNTER_FRAME_ABORT = 10,
+    DLMSTP_COUNTER_TOKEN_RETRY = 11,
+    DLMSTP_COUNTER_REPLY_TIMEOUT = 12,
+    DLMSTP_COUNTER_REPLY_POSTPONED = 13,
+    DLMSTP_COUNTER_REPLY_LATE = 14,
+    DLMSTP_COUNTER_POLL_CYCLE = 15,
+    DLMSTP_COUNTER_TOKEN_ROTATION_MILLISECONDS = 16,
+    DLMSTP_COUNTER_TOKEN_ROTATION_MAX_MILLISECONDS = 17,
+    DLMSTP_COUNTER_REPLY_LATENCY_MILLISECONDS = 18,
+    DLMSTP_COUNTER_REPLY_LATENCY_MAX_MILLISECONDS = 19,
+    DLMSTP_COUNTERS = 20
+} DLMSTP_COUNTER;
+#endif
+
 typedef struct dlmstp_packet {
     bool ready; /* true if ready to be sent or received */
     BACNET_ADDRESS address; /* source address */
     uint8_t frame_type; /* type of message */
     uint16_t pdu_len; /* packet length */
     uint8_t pdu[DLMSTP_MPDU_MAX]; /* packet */
+#if BACNET_MSTP_PRIORITY_QUEUE_ENABLED
+    uint8_t queue_class; /* transmit queue class */
+    uint8_t next; /* next packet in the same list */
+#endif
+#if BACNET_MSTP_DYNAMIC_INFO_FRAMES_ENABLED
+    uint32_t queued_milliseconds; /* time when the packet was queued */
+#endif
 } DLMSTP_PACKET;
 
 /* container for packet and token statistics */
@@ -48,11 +117,87 @@ typedef struct dlmstp_statistics {
     uint32_t lost_token_counter;
     uint32_t bad_crc_counter;
     uint32_t poll_for_master_counter;
+#if BACNET_MSTP_DYNAMIC_INFO_FRAMES_ENABLED
+    /* token holds in which PDUs were sent, the PDUs sent in them,
+       and the most PDUs sent in one token hold */
+    uint32_t token_pdu_hold_counter;
+    uint32_t token_pdu_counter;
+    uint32_t token_pdu_max;
+    /* total and longest time that sent PDUs waited in the queue;
+       these counters are kept only by dlmstp.c */
+    uint32_t transmit_wait_milliseconds;
+    uint32_t transmit_wait_max_milliseconds;
+#endif
+#if BACNET_MSTP_PRIORITY_QUEUE_ENABLED
+    /* PDUs dropped or refused in each transmit class when it was full,
+       and the most PDUs each class held at once */
+    uint32_t queue_drop_counter[DLMSTP_QUEUE_CLASSES];
+    uint32_t queue_depth_max[DLMSTP_QUEUE_CLASSES];
+#endif
+#if BACNET_MSTP_STATISTICS_ENABLED
+    /* valid frames heard and frames sent, by frame type slot */
+    uint32_t receive_frame_type_counter[DLMSTP_FRAME_TYPES];
+    uint32_t transmit_frame_type_counter[DLMSTP_FRAME_TYPES];
+    /* replies sent more than Treply_delay after the request */
+    uint32_t reply_late_counter;
+    /* time between Token frames received by this node: the total,
+       the longest, and a histogram of the times */
+    uint32_t token_rotation_milliseconds;
+    uint32_t token_rotation_max_milliseconds;
+    uint32_t token_rotation_histogram[DLMSTP_HISTOGRAM_BUCKETS];
+    /* time from the end of a request to the reply sent by this node */
+    uint32_t reply_latency_milliseconds;
+    uint32_t reply_latency_max_milliseconds;
+    uint32_t reply_latency_histogram[DLMSTP_HISTOGRAM_BUCKETS];
+#endif
+#if BACNET_MSTP_FAST_REPLY_ENABLED
+    /* Data Expecting Reply frames for this node, those answered by the
+       fast reply hook, and the Reply Postponed frames sent for them */
+    uint32_t reply_request_counter;
+    uint32_t reply_fast_counter;
+    uint32_t reply_postponed_counter;
+#endif
 } DLMSTP_STATISTICS;
 
 #ifndef DLMSTP_MAX_INFO_FRAMES
+#if BACNET_MSTP_DYNAMIC_INFO_FRAMES_ENABLED || \
+    BACNET_MSTP_PRIORITY_QUEUE_ENABLED
+/* the send queue needs room for a backlog; a power of two */
+#define DLMSTP_MAX_INFO_FRAMES 4
+#else
 #define DLMSTP_MAX_INFO_FRAMES DEFAULT_MAX_INFO_FRAMES
 #endif
+#endif
+#if BACNET_MSTP_PRIORITY_QUEUE_ENABLED
+#if (DLMSTP_MAX_INFO_FRAMES >= DLMSTP_QUEUE_NONE)
+#error "DLMSTP_MAX_INFO_FRAMES must be less than 255"
+#endif
+/* share of the token for each class in a weighted round */
+#ifndef DLMSTP_QUEUE_WEIGHT_CONFIRMED
+#define DLMSTP_QUEUE_WEIGHT_CONFIRMED 4
+#endif
+#ifndef DLMSTP_QUEUE_WEIGHT_UNCONFIRMED
+#define DLMSTP_QUEUE_WEIGHT_UNCONFIRMED 2
+#endif
+#ifndef DLMSTP_QUEUE_WEIGHT_BROADCAST
+#define DLMSTP_QUEUE_WEIGHT_BROADCAST 1
+#endif
+/* most PDUs that the unconfirmed and broadcast classes may hold, so that
+   a burst of them leaves room for replies and confirmed requests */
+#ifndef DLMSTP_QUEUE_LIMIT_UNCONFIRMED
+#define DLMSTP_QUEUE_LIMIT_UNCONFIRMED ((DLMSTP_MAX_INFO_FRAMES + 1) / 2)
+#endif
+#ifndef DLMSTP_QUEUE_LIMIT_BROADCAST
+#define DLMSTP_QUEUE_LIMIT_BROADCAST ((DLMSTP_MAX_INFO_FRAMES + 1) / 2)
+#endif
+/* bit for each class that drops its oldest PDU to make room for a new
+   one, such as a stale COV notification; the other classes refuse the
+   new PDU when full */
+#ifndef DLMSTP_QUEUE_DROP_OLDEST
+#define DLMSTP_QUEUE_DROP_OLDEST \
+    ((1U << DLMSTP_QUEUE_UNCONFIRMED) | (1U << DLMSTP_QUEUE_BROADCAST))
+#endif
+#endif
 #ifndef DLMSTP_MAX_MASTER
 #define DLMSTP_MAX_MASTER DEFAULT_MAX_MASTER
 #endif
@@ -100,6 +245,16 @@ typedef void (*dlmstp_hook_frame_rx_complete_cb)(
     uint8_t *pdu,
     uint16_t pdu_len);
 
+/* callback to answer a Data Expecting Reply frame before the application:
+   returns the length of the reply NPDU put in the reply buffer, or 0 if
+   the request is to be handed to the application */
+typedef int (*dlmstp_hook_fast_reply_cb)(
+    uint8_t src,
+    const uint8_t *pdu,
+    uint16_t pdu_len,
+    uint8_t *reply,
+    uint16_t reply_size);
+
 /**
  * An example structure of user data for BACnet MS/TP
  */
@@ -111,8 +266,27 @@ struct dlmstp_user_data_t {
     dlmstp_hook_frame_rx_complete_cb Valid_Frame_Not_For_Us_Rx_Callback;
     dlmstp_hook_frame_rx_complete_cb Invalid_Frame_Rx_Callback;
     uint32_t Valid_Frame_Milliseconds;
+#if BACNET_MSTP_FAST_REPLY_ENABLED
+    dlmstp_hook_fast_reply_cb Fast_Reply_Callback;
+#endif
+#if BACNET_MSTP_STATISTICS_ENABLED
+    /* time when the last Token frame for this node was received */
+    uint32_t Token_Milliseconds;
+    bool Token_Received;
+#endif
+#if BACNET_MSTP_PRIORITY_QUEUE_ENABLED
+    /* the PDU buffers are linked into a free list and into a list for
+       each transmit class, in the order they were queued */
+    uint8_t PDU_Free;
+    uint8_t PDU_Head[DLMSTP_QUEUE_CLASSES];
+    uint8_t PDU_Tail[DLMSTP_QUEUE_CLASSES];
+    uint8_t PDU_Count[DLMSTP_QUEUE_CLASSES];
+    /* PDUs each class may still send in the current weighted round */
+    uint8_t PDU_Credit[DLMSTP_QUEUE_CLASSES];
+#else
     /* the PDU Queue is made of Nmax_info_frames x dlmstp_packet's */
     RING_BUFFER PDU_Queue;
+#endif
     struct dlmstp_packet PDU_Buffer[DLMSTP_MAX_INFO_FRAMES];
     bool Initialized;
     bool ReceivePacketPending;
@@ -171,6 +345,12 @@ BACNET_STACK_EXPORT
 void dlmstp_set_max_master(uint8_t max_master);
 BACNET_STACK_EXPORT
 uint8_t dlmstp_max_master(void);
+#if BACNET_MSTP_ADAPTIVE_POLL_ENABLED
+/* highest master address heard on the link; only in dlmstp.c, which
+   ships disabled, so it is unresolved until BACNET_DLMSTP_ENABLED */
+BACNET_STACK_EXPORT
+uint8_t dlmstp_max_master_suggested(void);
+#endif
 
 /* MAC address 0-127 */
 BACNET_STACK_EXPORT
@@ -217,6 +397,10 @@ BACNET_STACK_EXPORT
 bool dlmstp_send_pdu_queue_empty(void);
 BACNET_STACK_EXPORT
 bool dlmstp_send_pdu_queue_full(void);
+#if BACNET_MSTP_PRIORITY_QUEUE_ENABLED
+BACNET_STACK_EXPORT
+unsigned dlmstp_send_pdu_queue_depth(unsigned queue_class);
+#endif
 
 BACNET_STACK_EXPORT
 uint8_t dlmstp_max_info_frames_limit(void);
@@ -258,6 +442,20 @@ void dlmstp_set_invalid_frame_rx_complete_callback(
 BACNET_STACK_EXPORT
 void dlmstp_set_frame_rx_start_callback(dlmstp_hook_frame_rx_start_cb cb_func);
 
+#if BACNET_MSTP_FAST_REPLY_ENABLED
+/* Set the callback function offered each Data Expecting Reply frame */
+/* for this node before it is handed to the application, so that it can */
+/* be answered within Treply_delay.  The callback runs in the datalink */
+/* and should only look up an answer that is ready, such as */
+/* fast_reply_handler() */
+BACNET_STACK_EXPORT
+void dlmstp_set_fast_reply_callback(dlmstp_hook_fast_reply_cb cb_func);
+/* Percent of the Data Expecting Reply frames for this node that were */
+/* answered without a Reply Postponed frame */
+BACNET_STACK_EXPORT
+unsigned dlmstp_reply_immediate_percent(void);
+#endif
+
 /* Reset the statistics counters on the MS/TP datalink */
 BACNET_STACK_EXPORT
 void dlmstp_reset_statistics(void);
@@ -268,6 +466,18 @@ void dlmstp_reset_statistics(void);
 BACNET_STACK_EXPORT
 void dlmstp_fill_statistics(struct dlmstp_statistics *statistics);
 
+#if BACNET_MSTP_STATISTICS_ENABLED
+/* Retrieve the link statistics, including the counters kept by the */
+/* MS/TP state machines, one table of unsigned values at a time */
+BACNET_STACK_EXPORT
+unsigned dlmstp_statistics_count(unsigned table);
+BACNET_STACK_EXPORT
+bool dlmstp_statistics_value(unsigned table, unsigned index, uint32_t *value);
+/* Encode every table into a compact dump for host tools */
+BACNET_STACK_EXPORT
+int dlmstp_statistics_encode(uint8_t *buffer, size_t buffer_size);
+#endif
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
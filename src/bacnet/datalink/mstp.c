@@ -105,6 +105,14 @@ static __inline__ void printf_master(const char *format, ...)
             x++;                     \
     }
 
+/* count a link event in the port statistics */
+#if BACNET_MSTP_STATISTICS_ENABLED
+#define MSTP_STATISTICS_COUNT(mstp_port, counter) \
+    ((mstp_port)->Statistics.counter++)
+#else
+#define MSTP_STATISTICS_COUNT(mstp_port, counter) ((void)(mstp_port))
+#endif
+
 bool MSTP_Line_Active(const struct mstp_port_struct_t *mstp_port)
 {
     if (!mstp_port) {
@@ -292,6 +300,60 @@ static bool MSTP_Frame_For_Us(struct mstp_port_struct_t *mstp_port)
     return false;
 }
 
+/**
+ * @brief Act on a received frame header once its CRC octet is in:
+ *  reject a bad CRC, indicate a frame with no data, or choose whether
+ *  to receive or skip the data of the frame
+ * @param mstp_port MSTP port context data
+ */
+static void MSTP_Receive_Header_Complete(struct mstp_port_struct_t *mstp_port)
+{
+    if (mstp_port->HeaderCRC != 0x55) {
+        /* BadCRC */
+        /* indicate that an error has occurred during
+           the reception of a frame */
+        mstp_port->ReceivedInvalidFrame = true;
+        MSTP_STATISTICS_COUNT(mstp_port, header_crc_error_counter);
+        printf_receive_error(
+            "MSTP: Rx Header: BadCRC [%02X]\n", mstp_port->DataRegister);
+        /* wait for the start of the next frame. */
+        mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
+    } else {
+        if (mstp_port->DataLength == 0) {
+            /* NoData */
+            if (MSTP_Frame_For_Us(mstp_port)) {
+                printf_receive_data(
+                    "%s", mstptext_frame_type((unsigned)mstp_port->FrameType));
+                /* indicate that a frame with no data has been received */
+                mstp_port->ReceivedValidFrame = true;
+            } else {
+                /* NotForUs */
+                mstp_port->ReceivedValidFrameNotForUs = true;
+            }
+            /* wait for the start of the next frame. */
+            mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
+        } else {
+            if (MSTP_Frame_For_Us(mstp_port)) {
+                if (mstp_port->DataLength <= mstp_port->InputBufferSize) {
+                    /* Data */
+                    mstp_port->receive_state = MSTP_RECEIVE_STATE_DATA;
+                } else {
+                    /* FrameTooLong */
+                    printf_receive_error(
+                        "MSTP: Rx Header: FrameTooLong %u\n",
+                        (unsigned)mstp_port->DataLength);
+                    mstp_port->receive_state = MSTP_RECEIVE_STATE_SKIP_DATA;
+                }
+            } else {
+                /* DataNotForUs */
+                mstp_port->receive_state = MSTP_RECEIVE_STATE_SKIP_DATA;
+            }
+            mstp_port->Index = 0;
+            mstp_port->DataCRC = 0xFFFF;
+        }
+    }
+}
+
 /**
  * @brief Finite State Machine for receiving an MSTP frame
  * @param mstp_port MSTP port context data
@@ -379,6 +441,7 @@ void MSTP_Receive_Frame_FSM(struct mstp_port_struct_t *mstp_port)
                 /* indicate that an error has occurred during the reception of a
                  * frame */
                 mstp_port->ReceivedInvalidFrame = true;
+                MSTP_STATISTICS_COUNT(mstp_port, frame_abort_counter);
                 /* wait for the start of a frame. */
                 mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
                 printf_receive_error(
@@ -393,6 +456,7 @@ void MSTP_Receive_Frame_FSM(struct mstp_port_struct_t *mstp_port)
                 /* indicate that an error has occurred during the reception of a
                  * frame */
                 mstp_port->ReceivedInvalidFrame = true;
+                MSTP_STATISTICS_COUNT(mstp_port, frame_abort_counter);
                 printf_receive_error("MSTP: Rx Header: ReceiveError\n");
                 /* wait for the start of a frame. */
                 mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
@@ -434,57 +498,7 @@ void MSTP_Receive_Frame_FSM(struct mstp_port_struct_t *mstp_port)
                         mstp_port->DataRegister, mstp_port->HeaderCRC);
                     mstp_port->HeaderCRCActual = mstp_port->DataRegister;
                     /* don't wait for next state - do it here */
-                    if (mstp_port->HeaderCRC != 0x55) {
-                        /* BadCRC */
-                        /* indicate that an error has occurred during
-                           the reception of a frame */
-                        mstp_port->ReceivedInvalidFrame = true;
-                        printf_receive_error(
-                            "MSTP: Rx Header: BadCRC [%02X]\n",
-                            mstp_port->DataRegister);
-                        /* wait for the start of the next frame. */
-                        mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
-                    } else {
-                        if (mstp_port->DataLength == 0) {
-                            /* NoData */
-                            if (MSTP_Frame_For_Us(mstp_port)) {
-                                printf_receive_data(
-                                    "%s",
-                                    mstptext_frame_type(
-                                        (unsigned)mstp_port->FrameType));
-                                /* indicate that a frame with no data has been
-                                 * received */
-                                mstp_port->ReceivedValidFrame = true;
-                            } else {
-                                /* NotForUs */
-                                mstp_port->ReceivedValidFrameNotForUs = true;
-                            }
-                            /* wait for the start of the next frame. */
-                            mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
-                        } else {
-                            if (MSTP_Frame_For_Us(mstp_port)) {
-                                if (mstp_port->DataLength <=
-                                    mstp_port->InputBufferSize) {
-                                    /* Data */
-                                    mstp_port->receive_state =
-                                        MSTP_RECEIVE_STATE_DATA;
-                                } else {
-                                    /* FrameTooLong */
-                                    printf_receive_error(
-                                        "MSTP: Rx Header: FrameTooLong %u\n",
-                                        (unsigned)mstp_port->DataLength);
-                                    mstp_port->receive_state =
-                                        MSTP_RECEIVE_STATE_SKIP_DATA;
-                                }
-                            } else {
-                                /* DataNotForUs */
-                                mstp_port->receive_state =
-                                    MSTP_RECEIVE_STATE_SKIP_DATA;
-                            }
-                            mstp_port->Index = 0;
-                            mstp_port->DataCRC = 0xFFFF;
-                        }
-                    }
+                    MSTP_Receive_Header_Complete(mstp_port);
                 } else {
                     /* not per MS/TP standard, but it is a case not covered */
                     mstp_port->ReceiveError = false;
@@ -512,6 +526,7 @@ void MSTP_Receive_Frame_FSM(struct mstp_port_struct_t *mstp_port)
                 /* indicate that an error has occurred during the reception of a
                  * frame */
                 mstp_port->ReceivedInvalidFrame = true;
+                MSTP_STATISTICS_COUNT(mstp_port, frame_abort_counter);
                 printf_receive_error(
                     "MSTP: Rx Data: SilenceTimer %ums > %dms\n",
                     (unsigned)mstp_port->SilenceTimer((void *)mstp_port),
@@ -525,6 +540,7 @@ void MSTP_Receive_Frame_FSM(struct mstp_port_struct_t *mstp_port)
                 /* indicate that an error has occurred during the reception of a
                  * frame */
                 mstp_port->ReceivedInvalidFrame = true;
+                MSTP_STATISTICS_COUNT(mstp_port, frame_abort_counter);
                 printf_receive_error("MSTP: Rx Data: ReceiveError\n");
                 /* wait for the start of the next frame. */
                 mstp_port->receive_state = MSTP_RECEIVE_STATE_IDLE;
@@ -583,6 +599,8 @@ void MSTP_Receive_Frame_FSM(struct mstp_port_struct_t *mstp_port)
                         } else {
                             /* BadCRC */
                             mstp_port->ReceivedInvalidFrame = true;
+                            MSTP_STATISTICS_COUNT(
+                                mstp_port, data_crc_error_counter);
                             printf_receive_error(
                                 "MSTP: Rx Data: BadCRC [%02X]\n",
                                 mstp_port->DataRegister);
@@ -602,6 +620,8 @@ void MSTP_Receive_Frame_FSM(struct mstp_port_struct_t *mstp_port)
                         } else {
                             /* BadCRC */
                             mstp_port->ReceivedInvalidFrame = true;
+                            MSTP_STATISTICS_COUNT(
+                                mstp_port, data_crc_error_counter);
                             printf_receive_error(
                                 "MSTP: Rx Data: BadCRC [%02X]\n",
                                 mstp_port->DataRegister);
@@ -628,6 +648,346 @@ void MSTP_Receive_Frame_FSM(struct mstp_port_struct_t *mstp_port)
     return;
 }
 
+/**
+ * @brief Give one received octet to the receive state machine
+ * @param mstp_port MSTP port context data
+ * @param octet - the received octet
+ */
+static void MSTP_Receive_Octet(
+    struct mstp_port_struct_t *mstp_port, uint8_t octet)
+{
+    mstp_port->DataRegister = octet;
+    mstp_port->DataAvailable = true;
+    MSTP_Receive_Frame_FSM(mstp_port);
+}
+
+/**
+ * @brief Count octets in the EventCount without rolling over
+ * @param mstp_port MSTP port context data
+ * @param count - number of octets received
+ */
+static void MSTP_Receive_Event_Count(
+    struct mstp_port_struct_t *mstp_port, size_t count)
+{
+    if (count < (size_t)(0xFF - mstp_port->EventCount)) {
+        mstp_port->EventCount += count;
+    } else {
+        mstp_port->EventCount = 0xFF;
+    }
+}
+
+/**
+ * @brief Receive a block of octets, such as a UART FIFO or a DMA buffer,
+ *  with the same result as giving them one at a time to
+ *  MSTP_Receive_Frame_FSM().  The preamble is found with memchr(), the
+ *  header is checked in one step, and the data is copied into the
+ *  InputBuffer with its CRC calculated over the block.
+ * @param mstp_port MSTP port context data
+ * @param data - the received octets
+ * @param length - number of received octets
+ * @return number of octets used. Reception stops when a frame has been
+ *  received, so that it can be handled before the rest is given.
+ */
+size_t MSTP_Receive_Frame_Block(
+    struct mstp_port_struct_t *mstp_port, const uint8_t *data, size_t length)
+{
+    const uint8_t *preamble;
+    size_t offset = 0;
+    size_t count;
+    size_t copy;
+    uint32_t crc_index;
+
+    while ((offset < length) && !mstp_port->ReceivedValidFrame &&
+           !mstp_port->ReceivedValidFrameNotForUs &&
+           !mstp_port->ReceivedInvalidFrame) {
+        if ((mstp_port->ReceiveError == true) ||
+            ((mstp_port->receive_state != MSTP_RECEIVE_STATE_IDLE) &&
+             (mstp_port->SilenceTimer((void *)mstp_port) >
+              mstp_port->Tframe_abort))) {
+            /* Error or Timeout */
+            mstp_port->DataAvailable = false;
+            MSTP_Receive_Frame_FSM(mstp_port);
+            continue;
+        }
+        switch (mstp_port->receive_state) {
+            case MSTP_RECEIVE_STATE_IDLE:
+                preamble = memchr(&data[offset], 0x55, length - offset);
+                if (preamble) {
+                    count = preamble - &data[offset];
+                } else {
+                    count = length - offset;
+                }
+                if (count > 0) {
+                    /* EatAnOctet */
+                    offset += count;
+                    mstp_port->DataRegister = data[offset - 1];
+                    mstp_port->SilenceTimerReset((void *)mstp_port);
+                    MSTP_Receive_Event_Count(mstp_port, count);
+                }
+                if (preamble) {
+                    /* Preamble1 */
+                    MSTP_Receive_Octet(mstp_port, data[offset]);
+                    offset++;
+                }
+                break;
+            case MSTP_RECEIVE_STATE_HEADER:
+                if ((mstp_port->Index == 0) && ((length - offset) >= 6)) {
+                    mstp_port->FrameType = data[offset];
+                    mstp_port->DestinationAddress = data[offset + 1];
+                    mstp_port->SourceAddress = data[offset + 2];
+                    mstp_port->DataLength =
+                        (data[offset + 3] * 256) + data[offset + 4];
+                    mstp_port->HeaderCRC = CRC_Calc_Header_Block(
+                        &data[offset], 6, mstp_port->HeaderCRC);
+                    mstp_port->HeaderCRCActual = data[offset + 5];
+                    mstp_port->DataRegister = data[offset + 5];
+                    mstp_port->Index = 5;
+                    MSTP_Receive_Header_Complete(mstp_port);
+                    offset += 6;
+                    mstp_port->SilenceTimerReset((void *)mstp_port);
+                    MSTP_Receive_Event_Count(mstp_port, 6);
+                } else {
+                    MSTP_Receive_Octet(mstp_port, data[offset]);
+                    offset++;
+                }
+                break;
+            case MSTP_RECEIVE_STATE_DATA:
+            case MSTP_RECEIVE_STATE_SKIP_DATA:
+                /* the last CRC octet completes the frame octet by octet */
+                crc_index = mstp_port->DataLength + 1;
+                if (mstp_port->Index < crc_index) {
+                    count = crc_index - mstp_port->Index;
+                    if (count > (length - offset)) {
+                        count = length - offset;
+                    }
+                    if (mstp_port->Index < mstp_port->InputBufferSize) {
+                        copy = mstp_port->InputBufferSize - mstp_port->Index;
+                        if (copy > count) {
+                            copy = count;
+                        }
+                        memcpy(
+                            &mstp_port->InputBuffer[mstp_port->Index],
+                            &data[offset], copy);
+                    }
+                    mstp_port->DataCRC = CRC_Calc_Data_Block(
+                        &data[offset], count, mstp_port->DataCRC);
+                    mstp_port->Index += count;
+                    offset += count;
+                    mstp_port->DataRegister = data[offset - 1];
+                    if (mstp_port->Index > mstp_port->DataLength) {
+                        /* CRC1 */
+                        mstp_port->DataCRCActualMSB = data[offset - 1];
+                    }
+                    mstp_port->SilenceTimerReset((void *)mstp_port);
+                } else {
+                    MSTP_Receive_Octet(mstp_port, data[offset]);
+                    offset++;
+                }
+                break;
+            default:
+                MSTP_Receive_Octet(mstp_port, data[offset]);
+                offset++;
+                break;
+        }
+    }
+
+    return offset;
+}
+
+#if BACNET_MSTP_DYNAMIC_INFO_FRAMES_ENABLED
+/* the frames that may be sent in this token hold */
+#define MSTP_INFO_FRAMES(mstp_port) ((mstp_port)->Info_Frames_Budget)
+
+/**
+ * @brief Choose how many information frames to send before passing the
+ *  token: as many as are waiting in the send queue, up to the fairness
+ *  cap, and never fewer than Nmax_info_frames.
+ * @param mstp_port MSTP port context data
+ * @return number of frames for this token hold
+ */
+static uint8_t MSTP_Info_Frames_Policy(struct mstp_port_struct_t *mstp_port)
+{
+    unsigned frames = mstp_port->Nmax_info_frames;
+    unsigned depth;
+
+    if (mstp_port->SendQueueDepth) {
+        depth = mstp_port->SendQueueDepth((void *)mstp_port);
+        if (depth > BACNET_MSTP_INFO_FRAMES_CAP) {
+            depth = BACNET_MSTP_INFO_FRAMES_CAP;
+        }
+        if (depth > frames) {
+            frames = depth;
+        }
+    }
+
+    return (uint8_t)frames;
+}
+#else
+#define MSTP_INFO_FRAMES(mstp_port) ((mstp_port)->Nmax_info_frames)
+#endif
+
+#if BACNET_MSTP_ADAPTIVE_POLL_ENABLED
+/**
+ * @brief Get the bit of a MAC address in a station map
+ * @param map - one bit for each MAC address 0..127
+ * @param station - MAC address
+ * @return true if the bit is set, false if not set or not a master address
+ */
+static bool MSTP_Station_Map_Get(const uint8_t *map, uint8_t station)
+{
+    if (station > DEFAULT_MAX_MASTER) {
+        return false;
+    }
+
+    return (map[station / 8] & (1U << (station % 8))) != 0;
+}
+
+/**
+ * @brief Set or clear the bit of a MAC address in a station map
+ * @param map - one bit for each MAC address 0..127
+ * @param station - MAC address
+ * @param value - true to set the bit, false to clear it
+ */
+static void
+MSTP_Station_Map_Set(uint8_t *map, uint8_t station, bool value)
+{
+    if (station > DEFAULT_MAX_MASTER) {
+        return;
+    }
+    if (value) {
+        map[station / 8] |= (uint8_t)(1U << (station % 8));
+    } else {
+        map[station / 8] &= (uint8_t)~(1U << (station % 8));
+    }
+}
+
+/**
+ * @brief Learn from a valid frame: its source address is in use, and a
+ *  node that passes the token or polls for a master is a master node.
+ *  Hearing a new master starts polling the empty addresses again.
+ * @param mstp_port MSTP port context data
+ */
+static void MSTP_Station_Heard(struct mstp_port_struct_t *mstp_port)
+{
+    uint8_t station = mstp_port->SourceAddress;
+
+    MSTP_Station_Map_Set(mstp_port->Station_Empty, station, false);
+    switch (mstp_port->FrameType) {
+        case FRAME_TYPE_TOKEN:
+        case FRAME_TYPE_POLL_FOR_MASTER:
+        case FRAME_TYPE_REPLY_TO_POLL_FOR_MASTER:
+            if (!MSTP_Station_Map_Get(mstp_port->Station_Master, station)) {
+                MSTP_Station_Map_Set(mstp_port->Station_Master, station, true);
+                mstp_port->Poll_Backoff = 0;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Learn from a Poll For Master that got no reply at all:
+ *  the polled address is empty.
+ * @param mstp_port MSTP port context data
+ * @param station - the MAC address that was polled
+ */
+static void
+MSTP_Station_Silent(struct mstp_port_struct_t *mstp_port, uint8_t station)
+{
+    MSTP_Station_Map_Set(mstp_port->Station_Empty, station, true);
+    MSTP_Station_Map_Set(mstp_port->Station_Master, station, false);
+}
+
+/**
+ * @brief Skip the addresses known to be empty, unless this maintenance
+ *  cycle is one in which they are polled.
+ * @param mstp_port MSTP port context data
+ * @param station - the next address that the standard would poll
+ * @return the next address to poll, or Next_Station or This_Station if
+ *  no address before them needs a poll in this cycle
+ */
+static uint8_t
+MSTP_Poll_Station_Next(struct mstp_port_struct_t *mstp_port, uint8_t station)
+{
+    unsigned mask = (1U << mstp_port->Poll_Backoff) - 1;
+    unsigned count = 0;
+
+    if ((mstp_port->Poll_Cycle & mask) == 0) {
+        return station;
+    }
+    while ((station != mstp_port->Next_Station) &&
+           (station != mstp_port->This_Station) &&
+           (count <= mstp_port->Nmax_master) &&
+           MSTP_Station_Map_Get(mstp_port->Station_Empty, station)) {
+        station = (station + 1) % (mstp_port->Nmax_master + 1);
+        count++;
+    }
+
+    return station;
+}
+
+/**
+ * @brief Count a completed Poll For Master maintenance cycle. After a
+ *  cycle that polled the empty addresses, they are polled half as often.
+ * @param mstp_port MSTP port context data
+ */
+static void MSTP_Poll_Cycle_Complete(struct mstp_port_struct_t *mstp_port)
+{
+    unsigned mask = (1U << mstp_port->Poll_Backoff) - 1;
+
+    if (((mstp_port->Poll_Cycle & mask) == 0) &&
+        (mstp_port->Poll_Backoff < BACNET_MSTP_ADAPTIVE_POLL_BACKOFF_MAX)) {
+        mstp_port->Poll_Backoff++;
+    }
+    mstp_port->Poll_Cycle++;
+    mstp_port->Station_Map_Valid = true;
+}
+
+/**
+ * @brief Determine if a MAC address is a known master node
+ * @param mstp_port MSTP port context data
+ * @param station - MAC address
+ * @return true if a master node was heard at this address
+ */
+bool MSTP_Station_Master(
+    const struct mstp_port_struct_t *mstp_port, uint8_t station)
+{
+    if (station == mstp_port->This_Station) {
+        return true;
+    }
+
+    return MSTP_Station_Map_Get(mstp_port->Station_Master, station);
+}
+
+/**
+ * @brief Suggest a value for Max_Master from the masters heard on the link.
+ *  A master added later at a higher address is not found by the
+ *  Poll For Master of the other nodes until Max_Master is raised again.
+ * @param mstp_port MSTP port context data
+ * @return the highest known master address, or Nmax_master until a
+ *  maintenance cycle has completed
+ */
+uint8_t MSTP_Max_Master_Suggested(const struct mstp_port_struct_t *mstp_port)
+{
+    uint8_t max_master = mstp_port->This_Station;
+    uint8_t station;
+
+    if ((!mstp_port->Station_Map_Valid) ||
+        (mstp_port->This_Station > mstp_port->Nmax_master)) {
+        return mstp_port->Nmax_master;
+    }
+    for (station = max_master + 1; station <= mstp_port->Nmax_master;
+         station++) {
+        if (MSTP_Station_Map_Get(mstp_port->Station_Master, station)) {
+            max_master = station;
+        }
+    }
+
+    return max_master;
+}
+#endif
+
 /**
  * @brief Finite State Machine for receiving an MSTP frame
  * @param mstp_port MSTP port context data
@@ -663,6 +1023,12 @@ bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port)
         /* ignore the frame */
         mstp_port->ReceivedValidFrame = false;
     }
+#if BACNET_MSTP_ADAPTIVE_POLL_ENABLED
+    if ((mstp_port->ReceivedValidFrame == true) ||
+        (mstp_port->ReceivedValidFrameNotForUs == true)) {
+        MSTP_Station_Heard(mstp_port);
+    }
+#endif
     switch (mstp_port->master_state) {
         case MSTP_MASTER_STATE_INITIALIZE:
             if (mstp_port->CheckAutoBaud) {
@@ -814,10 +1180,16 @@ bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port)
             /* more data frames. These may be BACnet Data frames or */
             /* proprietary frames. */
             /* FIXME: We could wait for up to Tusage_delay */
+#if BACNET_MSTP_DYNAMIC_INFO_FRAMES_ENABLED
+            if (mstp_port->FrameCount == 0) {
+                mstp_port->Info_Frames_Budget =
+                    MSTP_Info_Frames_Policy(mstp_port);
+            }
+#endif
             length = (unsigned)MSTP_Get_Send(mstp_port, 0);
             if (length < 1) {
                 /* NothingToSend */
-                mstp_port->FrameCount = mstp_port->Nmax_info_frames;
+                mstp_port->FrameCount = MSTP_INFO_FRAMES(mstp_port);
                 mstp_port->master_state = MSTP_MASTER_STATE_DONE_WITH_TOKEN;
                 transition_now = true;
             } else {
@@ -858,7 +1230,8 @@ bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port)
                 mstp_port->Treply_timeout) {
                 /* ReplyTimeout */
                 /* assume that the request has failed */
-                mstp_port->FrameCount = mstp_port->Nmax_info_frames;
+                MSTP_STATISTICS_COUNT(mstp_port, reply_timeout_counter);
+                mstp_port->FrameCount = MSTP_INFO_FRAMES(mstp_port);
                 mstp_port->master_state = MSTP_MASTER_STATE_DONE_WITH_TOKEN;
                 /* Any retry of the data frame shall await the next entry */
                 /* to the USE_TOKEN state. (Because of the length of the
@@ -925,8 +1298,12 @@ bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port)
         case MSTP_MASTER_STATE_DONE_WITH_TOKEN:
             /* The DONE_WITH_TOKEN state either sends another data frame,  */
             /* passes the token, or initiates a Poll For Master cycle. */
+#if BACNET_MSTP_ADAPTIVE_POLL_ENABLED
+            next_poll_station =
+                MSTP_Poll_Station_Next(mstp_port, next_poll_station);
+#endif
             /* SendAnotherFrame */
-            if (mstp_port->FrameCount < mstp_port->Nmax_info_frames) {
+            if (mstp_port->FrameCount < MSTP_INFO_FRAMES(mstp_port)) {
                 /* then this node may send another information frame  */
                 /* before passing the token.  */
                 mstp_port->master_state = MSTP_MASTER_STATE_USE_TOKEN;
@@ -974,6 +1351,10 @@ bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port)
                     mstp_port->master_state = MSTP_MASTER_STATE_PASS_TOKEN;
                 }
             } else if (next_poll_station == mstp_port->Next_Station) {
+                MSTP_STATISTICS_COUNT(mstp_port, poll_cycle_counter);
+#if BACNET_MSTP_ADAPTIVE_POLL_ENABLED
+                MSTP_Poll_Cycle_Complete(mstp_port);
+#endif
                 if (mstp_port->SoleMaster == true) {
                     /* SoleMasterRestartMaintenancePFM */
                     mstp_port->Poll_Station = next_next_station;
@@ -1030,6 +1411,7 @@ bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port)
                 if (mstp_port->RetryCount < Nretry_token) {
                     /* RetrySendToken */
                     mstp_port->RetryCount++;
+                    MSTP_STATISTICS_COUNT(mstp_port, token_retry_counter);
                     /* Transmit a Token frame to NS */
                     MSTP_Create_And_Send_Frame(
                         mstp_port, FRAME_TYPE_TOKEN, mstp_port->Next_Station,
@@ -1150,6 +1532,12 @@ bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port)
                  mstp_port->Tusage_timeout) ||
                 (mstp_port->ReceivedInvalidFrame == true) ||
                 (mstp_port->ReceivedValidFrameNotForUs == true)) {
+#if BACNET_MSTP_ADAPTIVE_POLL_ENABLED
+                if ((mstp_port->ReceivedInvalidFrame == false) &&
+                    (mstp_port->ReceivedValidFrameNotForUs == false)) {
+                    MSTP_Station_Silent(mstp_port, mstp_port->Poll_Station);
+                }
+#endif
                 if (mstp_port->SoleMaster == true) {
                     /* SoleMaster */
                     /* There was no valid reply to the periodic poll  */
@@ -1172,6 +1560,10 @@ bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port)
                         mstp_port->RetryCount = 0;
                         mstp_port->master_state = MSTP_MASTER_STATE_PASS_TOKEN;
                     } else {
+#if BACNET_MSTP_ADAPTIVE_POLL_ENABLED
+                        next_poll_station = MSTP_Poll_Station_Next(
+                            mstp_port, next_poll_station);
+#endif
                         if (next_poll_station != mstp_port->This_Station) {
                             /* SendNextPFM */
                             mstp_port->Poll_Station = next_poll_station;
@@ -1236,6 +1628,7 @@ bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port)
                 MSTP_Create_And_Send_Frame(
                     mstp_port, FRAME_TYPE_REPLY_POSTPONED,
                     mstp_port->SourceAddress, mstp_port->This_Station, NULL, 0);
+                MSTP_STATISTICS_COUNT(mstp_port, reply_postponed_counter);
                 mstp_port->master_state = MSTP_MASTER_STATE_IDLE;
                 /* clear our flag we were holding for comparison */
                 mstp_port->ReceivedValidFrame = false;
@@ -1874,7 +2267,21 @@ void MSTP_Init(struct mstp_port_struct_t *mstp_port)
         mstp_port->SoleMaster = false;
         mstp_port->SourceAddress = 0;
         mstp_port->TokenCount = 0;
+#if BACNET_MSTP_DYNAMIC_INFO_FRAMES_ENABLED
+        mstp_port->Info_Frames_Budget = mstp_port->Nmax_info_frames;
+#endif
         /* zero config */
         mstp_port->Zero_Config_State = MSTP_ZERO_CONFIG_STATE_INIT;
+#if BACNET_MSTP_ADAPTIVE_POLL_ENABLED
+        memset(
+            mstp_port->Station_Master, 0, sizeof(mstp_port->Station_Master));
+        memset(mstp_port->Station_Empty, 0, sizeof(mstp_port->Station_Empty));
+        mstp_port->Poll_Backoff = 0;
+        mstp_port->Poll_Cycle = 0;
+        mstp_port->Station_Map_Valid = false;
+#endif
+#if BACNET_MSTP_STATISTICS_ENABLED
+        memset(&mstp_port->Statistics, 0, sizeof(mstp_port->Statistics));
+#endif
     }
 }
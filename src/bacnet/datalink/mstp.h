@@ -30,6 +30,28 @@
 /* size of the buffer used to send and validate a unique test request */
 #define MSTP_UUID_SIZE 16
 
+/* size of a map with one bit for each master MAC address 0..127 */
+#define MSTP_STATION_MAP_SIZE ((DEFAULT_MAX_MASTER + 1) / 8)
+
+#if BACNET_MSTP_STATISTICS_ENABLED
+/* link events seen only by the receive and node state machines */
+struct mstp_statistics {
+    /* frames received with a bad header CRC or a bad data CRC */
+    uint32_t header_crc_error_counter;
+    uint32_t data_crc_error_counter;
+    /* frames cut short by a receive error or by Tframe_abort */
+    uint32_t frame_abort_counter;
+    /* Token frames sent again because the successor did not use it */
+    uint32_t token_retry_counter;
+    /* requests sent by this node that got no reply within Treply_timeout */
+    uint32_t reply_timeout_counter;
+    /* Reply Postponed frames sent by this node */
+    uint32_t reply_postponed_counter;
+    /* Poll For Master maintenance cycles completed by this node */
+    uint32_t poll_cycle_counter;
+};
+#endif
+
 struct mstp_port_struct_t {
     MSTP_RECEIVE_STATE receive_state;
     /* When a master node is powered up or reset, */
@@ -240,6 +262,39 @@ struct mstp_port_struct_t {
     /* The zero-based index in TestBaudrates of the next baudrate to try. */
     unsigned BaudRateIndex;
 
+#if BACNET_MSTP_ADAPTIVE_POLL_ENABLED
+    /* One bit for each MAC address from which a Token, Poll For Master,
+       or Reply To Poll For Master frame was heard, i.e. the known masters */
+    uint8_t Station_Master[MSTP_STATION_MAP_SIZE];
+    /* One bit for each MAC address that did not reply to a Poll For Master
+       and has not been heard since */
+    uint8_t Station_Empty[MSTP_STATION_MAP_SIZE];
+    /* Empty addresses are polled once every 2^Poll_Backoff maintenance
+       cycles; Poll_Cycle counts the cycles of the Poll For Master
+       maintenance that this node has completed. */
+    uint8_t Poll_Backoff;
+    uint8_t Poll_Cycle;
+    /* A Boolean flag set to TRUE when a maintenance cycle has completed,
+       so that the map of masters covers the whole link */
+    unsigned Station_Map_Valid : 1;
+#endif
+
+#if BACNET_MSTP_DYNAMIC_INFO_FRAMES_ENABLED
+    /* The number of information frames this node may send during the
+       current token hold: Nmax_info_frames, raised to the depth of the
+       send queue up to BACNET_MSTP_INFO_FRAMES_CAP. It is set each time
+       the node starts to use the token. */
+    uint8_t Info_Frames_Budget;
+    /** Get the number of PDUs waiting to be sent, or NULL if unknown;
+        dlmstp.c sets it, and without it the budget stays at
+        Nmax_info_frames */
+    unsigned (*SendQueueDepth)(void *pArg);
+#endif
+
+#if BACNET_MSTP_STATISTICS_ENABLED
+    struct mstp_statistics Statistics;
+#endif
+
     /*Platform-specific port data */
     void *UserData;
 };
@@ -253,6 +308,9 @@ void MSTP_Init(struct mstp_port_struct_t *mstp_port);
 BACNET_STACK_EXPORT
 void MSTP_Receive_Frame_FSM(struct mstp_port_struct_t *mstp_port);
 BACNET_STACK_EXPORT
+size_t MSTP_Receive_Frame_Block(
+    struct mstp_port_struct_t *mstp_port, const uint8_t *data, size_t length);
+BACNET_STACK_EXPORT
 bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port);
 BACNET_STACK_EXPORT
 void MSTP_Slave_Node_FSM(struct mstp_port_struct_t *mstp_port);
@@ -298,6 +356,14 @@ uint32_t MSTP_Auto_Baud_Rate(unsigned baud_rate_index);
 BACNET_STACK_EXPORT
 void MSTP_Auto_Baud_FSM(struct mstp_port_struct_t *mstp_port);
 
+#if BACNET_MSTP_ADAPTIVE_POLL_ENABLED
+BACNET_STACK_EXPORT
+bool MSTP_Station_Master(
+    const struct mstp_port_struct_t *mstp_port, uint8_t station);
+BACNET_STACK_EXPORT
+uint8_t MSTP_Max_Master_Suggested(const struct mstp_port_struct_t *mstp_port);
+#endif
+
 /* functions used by the MS/TP state machine to put or get data */
 /* FIXME: developer must implement these in their DLMSTP module */
 
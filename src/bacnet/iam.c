@@ -6,6 +6,7 @@
  * @copyright SPDX-License-Identifier: GPL-2.0-or-later WITH GCC-exception-2.0
  */
 #include <stdint.h>
+#include <string.h>
 /* BACnet Stack defines - first */
 //#include "bacnet/bacdef.h"
 #include "bacdef.h"
@@ -88,6 +89,66 @@ size_t bacnet_iam_service_request_encode(
     return apdu_len;
 }
 
+/**
+ * @brief Encode an application tagged Unsigned or Enumerated value of
+ *  up to 16 bits in its shortest form
+ * @param apdu  Transmit buffer
+ * @param tag_number  BACNET_APPLICATION_TAG_UNSIGNED_INT or _ENUMERATED
+ * @param value  value to encode
+ * @return number of bytes encoded
+ */
+static int iam_fixed_unsigned16_encode(
+    uint8_t *apdu, uint8_t tag_number, uint16_t value)
+{
+    if (value <= UINT8_MAX) {
+        apdu[0] = BACNET_APPLICATION_TAG_OCTET(tag_number, 1);
+        apdu[1] = (uint8_t)value;
+        return 2;
+    }
+    apdu[0] = BACNET_APPLICATION_TAG_OCTET(tag_number, 2);
+    apdu[1] = (uint8_t)(value >> 8);
+    apdu[2] = (uint8_t)value;
+
+    return 3;
+}
+
+/**
+ * @brief Encode the I-Am APDU from a fixed layout, patching only the
+ *  variable fields. The result is the same as the generic encoding.
+ * @param apdu  Transmit buffer, with room for at least 15 bytes
+ * @param device_id  Device Id
+ * @param max_apdu  Transmit buffer size, 0..65535
+ * @param segmentation  #BACNET_SEGMENTATION enumeration
+ * @param vendor_id  Vendor Id
+ * @return Total length of the apdu
+ */
+static int iam_fixed_encode_apdu(
+    uint8_t *apdu,
+    uint32_t device_id,
+    uint16_t max_apdu,
+    uint8_t segmentation,
+    uint16_t vendor_id)
+{
+    static const uint8_t header[] = {
+        PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST, SERVICE_UNCONFIRMED_I_AM,
+        BACNET_APPLICATION_TAG_OCTET(BACNET_APPLICATION_TAG_OBJECT_ID, 4)
+    };
+    int apdu_len;
+
+    memcpy(apdu, header, sizeof(header));
+    apdu_len = sizeof(header);
+    apdu_len +=
+        encode_bacnet_object_id(&apdu[apdu_len], OBJECT_DEVICE, device_id);
+    apdu_len += iam_fixed_unsigned16_encode(
+        &apdu[apdu_len], BACNET_APPLICATION_TAG_UNSIGNED_INT, max_apdu);
+    apdu_len += iam_fixed_unsigned16_encode(
+        &apdu[apdu_len], BACNET_APPLICATION_TAG_ENUMERATED, segmentation);
+    apdu_len += iam_fixed_unsigned16_encode(
+        &apdu[apdu_len], BACNET_APPLICATION_TAG_UNSIGNED_INT, vendor_id);
+
+    return apdu_len;
+}
+
 /**
  * @brief Encode the I-Am service.
  *
@@ -109,6 +170,13 @@ int iam_encode_apdu(
     int len = 0; /* length of each encoding */
     int apdu_len = 0; /* total length of the apdu, return value */
 
+    if (apdu && (max_apdu <= UINT16_MAX) && (segmentation >= 0) &&
+        (segmentation <= UINT8_MAX)) {
+        /* the usual case has a fixed layout */
+        return iam_fixed_encode_apdu(
+            apdu, device_id, (uint16_t)max_apdu, (uint8_t)segmentation,
+            vendor_id);
+    }
     if (apdu) {
         apdu[0] = PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST;
         apdu[1] = SERVICE_UNCONFIRMED_I_AM; /* service choice */
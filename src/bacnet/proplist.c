@@ -158,12 +158,13 @@ int property_list_encode(
                             (pListRequired[i] == PROP_PROPERTY_LIST)) {
                             continue;
                         } else {
-                            len = encode_application_enumerated(
-                                &apdu[apdu_len], (uint32_t)pListRequired[i]);
+                            len = bacnet_enumerated_application_encoded_size(
+                                (uint32_t)pListRequired[i]);
                         }
                         /* add it if we have room */
                         if ((apdu_len + len) < max_apdu_len) {
-                            apdu_len += len;
+                            apdu_len += encode_application_enumerated(
+                                &apdu[apdu_len], (uint32_t)pListRequired[i]);
                         } else {
                             rpdata->error_code =
                                 ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
@@ -174,11 +175,12 @@ int property_list_encode(
                 }
                 if (optional_count) {
                     for (i = 0; i < optional_count; i++) {
-                        len = encode_application_enumerated(
-                            &apdu[apdu_len], (uint32_t)pListOptional[i]);
+                        len = bacnet_enumerated_application_encoded_size(
+                            (uint32_t)pListOptional[i]);
                         /* add it if we have room */
                         if ((apdu_len + len) < max_apdu_len) {
-                            apdu_len += len;
+                            apdu_len += encode_application_enumerated(
+                                &apdu[apdu_len], (uint32_t)pListOptional[i]);
                         } else {
                             rpdata->error_code =
                                 ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
@@ -189,11 +191,12 @@ int property_list_encode(
                 }
                 if (proprietary_count) {
                     for (i = 0; i < proprietary_count; i++) {
-                        len = encode_application_enumerated(
-                            &apdu[apdu_len], (uint32_t)pListProprietary[i]);
+                        len = bacnet_enumerated_application_encoded_size(
+                            (uint32_t)pListProprietary[i]);
                         /* add it if we have room */
                         if ((apdu_len + len) < max_apdu_len) {
-                            apdu_len += len;
+                            apdu_len += encode_application_enumerated(
+                                &apdu[apdu_len], (uint32_t)pListProprietary[i]);
                         } else {
                             rpdata->error_code =
                                 ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
@@ -7,6 +7,7 @@
  * @copyright SPDX-License-Identifier: GPL-2.0-or-later WITH GCC-exception-2.0
  */
 #include <stdint.h>
+#include <string.h>
 /* BACnet Stack defines - first */
 //#include "bacnet/bacdef.h"
 #include "bacdef.h"
@@ -420,6 +421,57 @@ int rp_ack_encode_apdu(
     return apdu_len;
 }
 
+/**
+ * @brief Encode the acknowledge of a REAL property, such as
+ *  Present_Value, from a fixed layout. The result is the same as
+ *  rp_ack_encode_apdu() of the application tagged REAL.
+ * @param apdu  Pointer to the buffer for encoding, or NULL for length
+ * @param invoke_id  Invoke Id
+ * @param object_type  Object type of the property
+ * @param object_instance  Object instance of the property
+ * @param object_property  Property identifier
+ * @param value  REAL value of the property
+ * @return Bytes encoded
+ */
+int rp_ack_encode_apdu_real(
+    uint8_t *apdu,
+    uint8_t invoke_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    float value)
+{
+    static const uint8_t header[] = {
+        PDU_TYPE_COMPLEX_ACK, 0, SERVICE_CONFIRMED_READ_PROPERTY,
+        BACNET_CONTEXT_TAG_OCTET(0, 4)
+    };
+    static const uint8_t value_header[] = {
+        BACNET_OPENING_TAG_OCTET(3),
+        BACNET_APPLICATION_TAG_OCTET(BACNET_APPLICATION_TAG_REAL, 4)
+    };
+    int apdu_len = sizeof(header) + 4;
+
+    if (apdu) {
+        memcpy(apdu, header, sizeof(header));
+        apdu[1] = invoke_id;
+        encode_bacnet_object_id(
+            &apdu[sizeof(header)], object_type, object_instance);
+        apdu_len += encode_context_enumerated(
+            &apdu[apdu_len], 1, (uint32_t)object_property);
+        memcpy(&apdu[apdu_len], value_header, sizeof(value_header));
+        apdu_len += sizeof(value_header);
+        apdu_len += encode_bacnet_real(value, &apdu[apdu_len]);
+        apdu[apdu_len] = BACNET_CLOSING_TAG_OCTET(3);
+        apdu_len++;
+    } else {
+        apdu_len +=
+            encode_context_enumerated(NULL, 1, (uint32_t)object_property);
+        apdu_len += sizeof(value_header) + 4 + 1;
+    }
+
+    return apdu_len;
+}
+
 #if BACNET_SVC_RP_A
 /** Decode the ReadProperty reply and store the result for one Property in a
  *  BACNET_READ_PROPERTY_DATA structure.
@@ -91,6 +91,14 @@ int rp_ack_encode_apdu_object_property_end(uint8_t *apdu);
 BACNET_STACK_EXPORT
 int rp_ack_encode_apdu(
     uint8_t *apdu, uint8_t invoke_id, const BACNET_READ_PROPERTY_DATA *rpdata);
+BACNET_STACK_EXPORT
+int rp_ack_encode_apdu_real(
+    uint8_t *apdu,
+    uint8_t invoke_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    float value);
 
 BACNET_STACK_EXPORT
 int rp_ack_decode_service_request(
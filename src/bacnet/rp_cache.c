@@ -0,0 +1,186 @@
+/**
+ * @file
+ * @brief A cache of encoded ReadProperty values of static properties
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "bacdef.h"
+/* BACnet Stack API */
+//#include "bacnet/rp.h"
+#include "rp.h"
+//#include "bacnet/rp_cache.h"
+#include "rp_cache.h"
+
+#if BACNET_RP_CACHE_ENABLED
+/* one encoded property value */
+struct rp_cache_entry {
+    /* revision of the object when the value was stored */
+    uint32_t revision;
+    uint32_t object_instance;
+    BACNET_ARRAY_INDEX array_index;
+    BACNET_PROPERTY_ID object_property;
+    BACNET_OBJECT_TYPE object_type;
+    /* length of the value; zero if the entry is empty */
+    uint8_t length;
+    uint8_t value[BACNET_RP_CACHE_VALUE_SIZE];
+};
+/* the cache is direct mapped: a key has exactly one entry */
+static struct rp_cache_entry RP_Cache[BACNET_RP_CACHE_ENTRIES];
+/* revision counters, shared by the objects that hash to each one;
+   an entry is valid only while its object revision is unchanged */
+static uint32_t Object_Revision[BACNET_RP_CACHE_ENTRIES];
+
+/**
+ * @brief Hash an object identifier
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ * @return hash of the object identifier
+ */
+static uint32_t
+rp_cache_object_hash(BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    uint32_t hash;
+
+    hash = ((uint32_t)object_type << 22) ^ object_instance;
+    hash *= 2654435761UL;
+
+    return hash ^ (hash >> 16);
+}
+
+/**
+ * @brief Find the revision counter of an object
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ * @return index of the revision counter
+ */
+static unsigned rp_cache_revision_index(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    return rp_cache_object_hash(object_type, object_instance) %
+        BACNET_RP_CACHE_ENTRIES;
+}
+
+/**
+ * @brief Find the entry for a property of an object
+ * @param rpdata - object, property and array index to be read
+ * @return index of the entry
+ */
+static unsigned rp_cache_entry_index(const BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    uint32_t hash;
+
+    hash = rp_cache_object_hash(rpdata->object_type, rpdata->object_instance);
+    hash ^= (uint32_t)rpdata->object_property * 2246822519UL;
+    hash ^= rpdata->array_index * 3266489917UL;
+    hash ^= hash >> 15;
+
+    return hash % BACNET_RP_CACHE_ENTRIES;
+}
+
+/**
+ * @brief Determine if a property value may be kept in the cache.
+ *  These change only through WriteProperty, or together with
+ *  the Database_Revision of the device.
+ * @param object_property - property identifier
+ * @return true if the value of the property may be cached
+ */
+bool rp_cache_property_cacheable(BACNET_PROPERTY_ID object_property)
+{
+    bool status = false;
+
+    switch (object_property) {
+        case PROP_OBJECT_IDENTIFIER:
+        case PROP_OBJECT_NAME:
+        case PROP_OBJECT_TYPE:
+        case PROP_DESCRIPTION:
+        case PROP_UNITS:
+        case PROP_PROPERTY_LIST:
+        case PROP_OBJECT_LIST:
+            status = true;
+            break;
+        default:
+            break;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Read a property value, from the cache if it holds the value,
+ *  otherwise from the object, keeping the value for the next read.
+ * @param rpdata - object, property, array index and the buffer for
+ *  the encoded value
+ * @param read_property - function that reads the property from the object
+ * @return The length of the apdu encoded or -1 for error or
+ *         -2 for abort message.
+ */
+int rp_cache_read_property(
+    BACNET_READ_PROPERTY_DATA *rpdata, read_property_function read_property)
+{
+    struct rp_cache_entry *entry;
+    uint32_t revision;
+    int len = BACNET_STATUS_ERROR;
+
+    if (!rpdata || !read_property) {
+        return BACNET_STATUS_ERROR;
+    }
+    if (!rp_cache_property_cacheable(rpdata->object_property)) {
+        return read_property(rpdata);
+    }
+    revision = Object_Revision[rp_cache_revision_index(
+        rpdata->object_type, rpdata->object_instance)];
+    entry = &RP_Cache[rp_cache_entry_index(rpdata)];
+    if ((entry->length > 0) && (entry->revision == revision) &&
+        (entry->object_instance == rpdata->object_instance) &&
+        (entry->object_type == rpdata->object_type) &&
+        (entry->object_property == rpdata->object_property) &&
+        (entry->array_index == rpdata->array_index) &&
+        (entry->length <= rpdata->application_data_len)) {
+        memcpy(rpdata->application_data, entry->value, entry->length);
+        return entry->length;
+    }
+    len = read_property(rpdata);
+    if ((len > 0) && (len <= BACNET_RP_CACHE_VALUE_SIZE)) {
+        memcpy(entry->value, rpdata->application_data, (size_t)len);
+        entry->length = (uint8_t)len;
+        entry->revision = revision;
+        entry->object_instance = rpdata->object_instance;
+        entry->object_type = rpdata->object_type;
+        entry->object_property = rpdata->object_property;
+        entry->array_index = rpdata->array_index;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Drop the cached values of an object, after one of its
+ *  properties was written
+ * @param object_type - BACnet object type
+ * @param object_instance - BACnet object instance number
+ */
+void rp_cache_object_invalidate(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
+{
+    Object_Revision[rp_cache_revision_index(object_type, object_instance)]++;
+}
+
+/**
+ * @brief Drop all of the cached values, after the Database_Revision
+ *  of the device changed
+ */
+void rp_cache_invalidate_all(void)
+{
+    unsigned i;
+
+    for (i = 0; i < BACNET_RP_CACHE_ENTRIES; i++) {
+        RP_Cache[i].length = 0;
+    }
+}
+#endif
@@ -0,0 +1,54 @@
+/**
+ * @file
+ * @brief API for a cache of encoded ReadProperty values of static properties
+ * @author George Arun <argeorun@gmail.com>
+ * @date 2025
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_RP_CACHE_H
+#define BACNET_RP_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+/* BACnet Stack defines - first */
+//#include "bacnet/bacdef.h"
+#include "bacdef.h"
+/* BACnet Stack API */
+//#include "bacnet/rp.h"
+#include "rp.h"
+
+/* The cache holds the encoded value of properties that are read far more
+   often than they change, such as Object_Name, Units or Property_List.
+   A WriteProperty to an object, or a change of the Database_Revision,
+   drops the cached values. Code that changes one of these properties
+   locally calls rp_cache_object_invalidate() for that object, as the
+   *_Name_Set, *_Description_Set and *_Units_Set functions do. Creating
+   or deleting an object changes the Object_List of the device, so the
+   *_Create and *_Delete functions call rp_cache_invalidate_all(). */
+#if BACNET_RP_CACHE_ENABLED
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+bool rp_cache_property_cacheable(BACNET_PROPERTY_ID object_property);
+BACNET_STACK_EXPORT
+int rp_cache_read_property(
+    BACNET_READ_PROPERTY_DATA *rpdata, read_property_function read_property);
+BACNET_STACK_EXPORT
+void rp_cache_object_invalidate(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance);
+BACNET_STACK_EXPORT
+void rp_cache_invalidate_all(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#else
+#define rp_cache_read_property(rpdata, read_property) (read_property)(rpdata)
+#define rp_cache_object_invalidate(object_type, object_instance) \
+    ((void)(object_type), (void)(object_instance))
+#define rp_cache_invalidate_all()
+#endif
+#endif
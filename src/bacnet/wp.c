@@ -327,6 +327,41 @@ bool write_property_type_valid(
     return (valid);
 }
 
+/**
+ * @brief simple validation of the next tag for Write Property argument,
+ *  when the value is decoded in place with a tag cursor
+ * @param wp_data - #BACNET_WRITE_PROPERTY_DATA data, including
+ *  requested data and space for the reply, or error response.
+ * @param cursor - #BACNET_TAG_CURSOR positioned at the value
+ * @param expected_tag - the application tag that is expected for this
+ *  property value
+ * @return true if the next tag is the expected application tag
+ */
+bool write_property_cursor_type_valid(
+    BACNET_WRITE_PROPERTY_DATA *wp_data,
+    BACNET_TAG_CURSOR *cursor,
+    uint8_t expected_tag)
+{
+    BACNET_TAG tag = { 0 };
+    bool valid = false;
+
+    if (!bacnet_tag_cursor_peek(cursor, &tag)) {
+        if (wp_data) {
+            wp_data->error_class = ERROR_CLASS_PROPERTY;
+            wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
+        }
+    } else if (!tag.application || (tag.number != expected_tag)) {
+        if (wp_data) {
+            wp_data->error_class = ERROR_CLASS_PROPERTY;
+            wp_data->error_code = ERROR_CODE_INVALID_DATA_TYPE;
+        }
+    } else {
+        valid = true;
+    }
+
+    return valid;
+}
+
 /**
  * @brief simple validation of character string value for Write Property
  * @param wp_data - #BACNET_WRITE_PROPERTY_DATA data, including
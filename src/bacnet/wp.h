@@ -18,6 +18,8 @@
 #include "bacdcode.h"
 //#include "bacnet/bacapp.h"
 #include "bacapp.h"
+//#include "bacnet/baccursor.h"
+#include "baccursor.h"
 
 /** @note: write property can have application tagged data, or context tagged
    data, or even complex data types (i.e. opening and closing tag around data).
@@ -100,6 +102,11 @@ bool write_property_type_valid(
     const BACNET_APPLICATION_DATA_VALUE *value,
     uint8_t expected_tag);
 BACNET_STACK_EXPORT
+bool write_property_cursor_type_valid(
+    BACNET_WRITE_PROPERTY_DATA *wp_data,
+    BACNET_TAG_CURSOR *cursor,
+    uint8_t expected_tag);
+BACNET_STACK_EXPORT
 bool write_property_string_valid(
     BACNET_WRITE_PROPERTY_DATA *wp_data,
     const BACNET_APPLICATION_DATA_VALUE *value,